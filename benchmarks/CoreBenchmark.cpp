@@ -0,0 +1,254 @@
+// Google Benchmark micro-benchmarks for the hot paths outside the I/O
+// threads: hex conversion, message construction and (de)serialization,
+// message history bookkeeping, group membership and history persistence.
+//
+// Results are written to SerialChat_bench.json (Google Benchmark's JSON
+// format) unless --benchmark_out is given, so runs of different releases can
+// be compared with tools/compare.py from the Google Benchmark repository.
+
+#include "ChatGroupInfo.h"
+#include "DataPersistence.h"
+#include "HexUtils.h"
+#include "Message.h"
+#include "MessageManager.h"
+#include <QCoreApplication>
+#include <QDir>
+#include <QFileInfo>
+#include <QJsonObject>
+#include <QTemporaryDir>
+#include <benchmark/benchmark.h>
+#include <cstring>
+#include <vector>
+
+namespace {
+// MessageManager keeps this many messages per port
+const int HISTORY_LIMIT = 1000;
+
+QByteArray payload(int size) {
+    QByteArray data(size, Qt::Uninitialized);
+    for (int i = 0; i < size; ++i) {
+        data[i] = static_cast<char>(i * 31 + 7);
+    }
+    return data;
+}
+
+QList<Message> history(const QString &portName, int count, int size) {
+    QList<Message> messages;
+    messages.reserve(count);
+    QByteArray data = payload(size);
+    for (int i = 0; i < count; ++i) {
+        messages.append(Message(portName, data, i % 2 ? MessageDirection::Sent : MessageDirection::Received,
+                                1767225600000000000LL + i * 1000000LL));
+    }
+    return messages;
+}
+
+// --- HexUtils ---
+
+void BM_HexToString(benchmark::State &state) {
+    QByteArray data = payload(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(HexUtils::byteArrayToHexString(data));
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+BENCHMARK(BM_HexToString)->Arg(16)->Arg(256)->Arg(4096);
+
+void BM_HexFromString(benchmark::State &state) {
+    QString hex = HexUtils::byteArrayToHexString(payload(static_cast<int>(state.range(0))));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(HexUtils::hexStringToByteArray(hex));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_HexFromString)->Arg(16)->Arg(256)->Arg(4096);
+
+void BM_HexValidate(benchmark::State &state) {
+    QString hex = HexUtils::byteArrayToHexString(payload(static_cast<int>(state.range(0))));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(HexUtils::isValidHexString(hex));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_HexValidate)->Arg(16)->Arg(256)->Arg(4096);
+
+void BM_HexFormat(benchmark::State &state) {
+    QString hex = HexUtils::byteArrayToHexString(payload(static_cast<int>(state.range(0))), QString());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(HexUtils::formatHexString(hex));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_HexFormat)->Arg(16)->Arg(256)->Arg(4096);
+
+// --- Message ---
+
+void BM_MessageConstruct(benchmark::State &state) {
+    QByteArray data = payload(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        Message message("COM1", data, MessageDirection::Received);
+        benchmark::DoNotOptimize(message);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MessageConstruct)->Arg(16)->Arg(1024);
+
+void BM_MessageToJson(benchmark::State &state) {
+    Message message("COM1", payload(static_cast<int>(state.range(0))), MessageDirection::Received);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(message.toJson());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MessageToJson)->Arg(16)->Arg(1024);
+
+void BM_MessageFromJson(benchmark::State &state) {
+    QJsonObject json = Message("COM1", payload(static_cast<int>(state.range(0))), MessageDirection::Received).toJson();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Message::fromJson(json));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MessageFromJson)->Arg(16)->Arg(1024);
+
+// --- MessageManager ---
+
+void BM_AddMessage(benchmark::State &state) {
+    // A full history, so every add also trims the oldest message
+    MessageManager manager;
+    for (const Message &message : history("COM1", HISTORY_LIMIT, 16)) {
+        manager.addMessage(message);
+    }
+    Message message("COM1", payload(16), MessageDirection::Received);
+    for (auto _ : state) {
+        manager.addMessage(message);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_AddMessage);
+
+void BM_GetMessages(benchmark::State &state) {
+    MessageManager manager;
+    for (const Message &message : history("COM1", HISTORY_LIMIT, 16)) {
+        manager.addMessage(message);
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(manager.getMessages("COM1"));
+    }
+}
+BENCHMARK(BM_GetMessages);
+
+void BM_GetMessagesLimit(benchmark::State &state) {
+    MessageManager manager;
+    for (const Message &message : history("COM1", HISTORY_LIMIT, 16)) {
+        manager.addMessage(message);
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(manager.getMessages("COM1", 100));
+    }
+}
+BENCHMARK(BM_GetMessagesLimit);
+
+void BM_GetAllMessages(benchmark::State &state) {
+    // Full histories on this many ports, merged and sorted by timestamp
+    MessageManager manager;
+    int ports = static_cast<int>(state.range(0));
+    for (int port = 0; port < ports; ++port) {
+        for (const Message &message : history(QString("COM%1").arg(port), HISTORY_LIMIT, 16)) {
+            manager.addMessage(message);
+        }
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(manager.getAllMessages());
+    }
+    state.SetItemsProcessed(state.iterations() * ports * HISTORY_LIMIT);
+}
+BENCHMARK(BM_GetAllMessages)->Arg(1)->Arg(8)->Arg(32);
+
+// --- ChatGroupInfo ---
+
+void BM_HasMember(benchmark::State &state) {
+    ChatGroupInfo group("bench");
+    int members = static_cast<int>(state.range(0));
+    for (int i = 0; i < members; ++i) {
+        group.addMember(QString("/dev/ttyUSB%1").arg(i));
+    }
+    // Checked for every forwarded message: half hits, half misses
+    const QString hit = QString("/dev/ttyUSB%1").arg(members - 1);
+    const QString miss = "/dev/ttyACM0";
+    bool toggle = false;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(group.hasMember(toggle ? hit : miss));
+        toggle = !toggle;
+    }
+}
+BENCHMARK(BM_HasMember)->Arg(2)->Arg(16)->Arg(128);
+
+// --- DataPersistence ---
+
+void BM_SaveMessages(benchmark::State &state) {
+    QTemporaryDir dir;
+    DataPersistence persistence;
+    persistence.setDataDirectory(dir.path());
+    QList<Message> messages = history("COM1", static_cast<int>(state.range(0)), 16);
+    for (auto _ : state) {
+        if (!persistence.saveMessages("COM1", messages)) {
+            state.SkipWithError("saveMessages failed");
+            break;
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * messages.size());
+    state.SetBytesProcessed(state.iterations() * QFileInfo(dir.filePath("messages/COM1.json")).size());
+}
+BENCHMARK(BM_SaveMessages)->Arg(1000)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+
+void BM_LoadMessages(benchmark::State &state) {
+    QTemporaryDir dir;
+    DataPersistence persistence;
+    persistence.setDataDirectory(dir.path());
+    int count = static_cast<int>(state.range(0));
+    if (!persistence.saveMessages("COM1", history("COM1", count, 16))) {
+        state.SkipWithError("saveMessages failed");
+        return;
+    }
+    for (auto _ : state) {
+        QList<Message> messages = persistence.loadMessages("COM1");
+        if (messages.size() != count) {
+            state.SkipWithError("loadMessages returned a different history");
+            break;
+        }
+        benchmark::DoNotOptimize(messages);
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+    state.SetBytesProcessed(state.iterations() * QFileInfo(dir.filePath("messages/COM1.json")).size());
+}
+BENCHMARK(BM_LoadMessages)->Arg(1000)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+} // namespace
+
+int main(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+
+    // JSON results next to the console table unless the caller chose a file
+    std::vector<char *> args(argv, argv + argc);
+    bool hasOut = false;
+    for (int i = 1; i < argc; ++i) {
+        hasOut = hasOut || std::strncmp(argv[i], "--benchmark_out=", 16) == 0;
+    }
+    char outArg[] = "--benchmark_out=SerialChat_bench.json";
+    char formatArg[] = "--benchmark_out_format=json";
+    if (!hasOut) {
+        args.push_back(outArg);
+        args.push_back(formatArg);
+    }
+    int benchArgc = static_cast<int>(args.size());
+
+    benchmark::Initialize(&benchArgc, args.data());
+    if (benchmark::ReportUnrecognizedArguments(benchArgc, args.data())) {
+        return 1;
+    }
+    benchmark::AddCustomContext("serialchat_version", PROJECT_VERSION);
+    benchmark::AddCustomContext("qt_version", qVersion());
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
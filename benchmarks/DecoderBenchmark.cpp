@@ -0,0 +1,133 @@
+// Throughput of the built-in protocol decoders in MB/s and records/s. Each
+// decoder is fed a synthetic capture of well-formed traffic in chunks the
+// size of a typical serial read, the way SerialPortWorker feeds it.
+
+#include "Checksum.h"
+#include "ModbusRtuDecoder.h"
+#include "NmeaDecoder.h"
+#include "SlipDecoder.h"
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QTextStream>
+
+namespace {
+QByteArray modbusStream(int size) {
+    // Alternating read requests and register responses from a handful of slaves
+    QByteArray stream;
+    stream.reserve(size + 64);
+    for (int i = 0; stream.size() < size; ++i) {
+        QByteArray request = QByteArray::fromHex("0103006B0004");
+        request[0] = static_cast<char>(1 + i % 16);
+        QByteArray response = QByteArray::fromHex("010308022B00640001FFFF");
+        response[0] = request[0];
+        response[4] = static_cast<char>(i);
+        stream += Checksum::append(ChecksumType::Crc16Modbus, request);
+        stream += Checksum::append(ChecksumType::Crc16Modbus, response);
+    }
+    return stream;
+}
+
+QByteArray nmeaSentence(const QByteArray &body) {
+    return '$' + body + '*' + Checksum::append(ChecksumType::Xor8, body).right(1).toHex().toUpper() + "\r\n";
+}
+
+QByteArray nmeaStream(int size) {
+    QByteArray stream;
+    stream.reserve(size + 256);
+    while (stream.size() < size) {
+        stream += nmeaSentence("GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,");
+        stream += nmeaSentence("GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W");
+        stream += nmeaSentence("GPGSV,3,1,11,03,03,111,00,04,15,270,00,06,01,010,00,13,06,292,00");
+    }
+    return stream;
+}
+
+QByteArray slipStream(int size) {
+    // 64-byte payloads with the occasional byte that needs escaping
+    QByteArray payload(64, Qt::Uninitialized);
+    for (int i = 0; i < payload.size(); ++i) {
+        payload[i] = static_cast<char>(i * 37 + 11);
+    }
+    QByteArray frame;
+    for (char c : payload) {
+        if (c == '\xC0') {
+            frame += "\xDB\xDC";
+        } else if (c == '\xDB') {
+            frame += "\xDB\xDD";
+        } else {
+            frame += c;
+        }
+    }
+    frame += '\xC0';
+
+    QByteArray stream;
+    stream.reserve(size + frame.size());
+    while (stream.size() < size) {
+        stream += frame;
+    }
+    return stream;
+}
+
+struct Result {
+    double megabytesPerSecond;
+    double recordsPerSecond;
+};
+
+Result measure(ProtocolDecoder &decoder, const QByteArray &stream, int chunkSize) {
+    QVector<DecodedRecord> records;
+    qint64 recordCount = 0;
+
+    QElapsedTimer timer;
+    timer.start();
+    for (int pos = 0; pos < stream.size(); pos += chunkSize) {
+        int length = qMin(chunkSize, stream.size() - pos);
+        recordCount += decoder.feed(stream.constData() + pos, length, records);
+        // The worker hands records to a message per read
+        records.clear();
+    }
+    recordCount += decoder.finish(records);
+    double seconds = qMax<qint64>(1, timer.nsecsElapsed()) / 1e9;
+    return {stream.size() / seconds / 1e6, recordCount / seconds};
+}
+} // namespace
+
+int main(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Measures protocol decoder throughput");
+    parser.addHelpOption();
+    QCommandLineOption sizeOption("megabytes", "Size of each synthetic capture in MB.", "MB", "16");
+    QCommandLineOption chunkOption("chunk", "Bytes handed to the decoder per read.", "bytes", "64");
+    parser.addOption(sizeOption);
+    parser.addOption(chunkOption);
+    parser.process(app);
+
+    int size = qBound(1, parser.value(sizeOption).toInt(), 1024) * 1024 * 1024;
+    int chunkSize = qMax(1, parser.value(chunkOption).toInt());
+
+    QTextStream out(stdout);
+    out << QString("%1%2%3%4\n")
+               .arg("decoder", -14)
+               .arg("MB/s", 12)
+               .arg("records/s", 16)
+               .arg("errors", 10);
+
+    const DecoderType types[] = {DecoderType::ModbusRtu, DecoderType::Nmea0183, DecoderType::Slip};
+    for (DecoderType type : types) {
+        QByteArray stream = type == DecoderType::ModbusRtu ? modbusStream(size)
+                            : type == DecoderType::Nmea0183 ? nmeaStream(size)
+                                                            : slipStream(size);
+        ProtocolDecoder *decoder = ProtocolDecoder::create(type, MessageDirection::Received);
+        Result result = measure(*decoder, stream, chunkSize);
+        out << QString("%1%2%3%4\n")
+                   .arg(ProtocolDecoder::name(type), -14)
+                   .arg(result.megabytesPerSecond, 12, 'f', 1)
+                   .arg(result.recordsPerSecond, 16, 'f', 0)
+                   .arg(decoder->errorCount(), 10);
+        out.flush();
+        delete decoder;
+    }
+    return 0;
+}
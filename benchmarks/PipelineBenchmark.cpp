@@ -0,0 +1,402 @@
+// End-to-end throughput and latency of the whole receive pipeline over
+// pseudo terminal loopback ports: device write -> pty -> I/O thread ->
+// framer -> SerialPortManager -> MessageManager::messageAdded, and for chat
+// groups on to the other members' devices. Each "device" writes
+// newline-framed messages carrying the time they were written at a rate
+// equivalent to the configured baud rate (10 bits per byte), so every
+// arriving message yields its own end-to-end latency.
+//
+// Topologies: one port, many ports in parallel, and a chat group whose
+// members all talk while ChatGroup forwards every message to the others.
+// The device side runs on the main thread next to MessageManager, as a
+// firmware rack's traffic would compete with the GUI thread.
+
+#include "ChatGroup.h"
+#include "LatencyHistogram.h"
+#include "MessageManager.h"
+#include "SerialPortManager.h"
+#include "TimeUtils.h"
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QFile>
+#include <QSocketNotifier>
+#include <QTextStream>
+#include <QTimer>
+#include <QVector>
+#include <fcntl.h>
+#include <memory>
+#include <unistd.h>
+
+namespace {
+// Writers are paced in steps of this many milliseconds
+const int TICK_MS = 1;
+
+// Time allowed for queued data to arrive after the writers stop
+const int DRAIN_TIMEOUT_MS = 5000;
+
+// Writer backlog per port; beyond it messages due are skipped and the port counts as falling behind
+const int MAX_PENDING_BYTES = 64 * 1024;
+
+// Port index, timestamp and the separators
+const int MIN_MESSAGE_SIZE = 32;
+
+enum class Topology { Single, Many, Group };
+
+struct Result {
+    QString name;
+    int ports = 0;
+    double offeredBytesPerSecond = 0.0; // 0: unthrottled
+    qint64 messagesSent = 0;
+    qint64 messagesSkipped = 0;
+    qint64 messagesReceived = 0;
+    qint64 bytesReceived = 0;
+    qint64 firstWriteNs = 0;
+    qint64 lastArrivalNs = 0;
+    LatencyHistogram latency;
+    qint64 rssConnectedBytes = 0;
+    qint64 rssEndBytes = 0;
+
+    double sustainedBytesPerSecond() const {
+        qint64 spanNs = lastArrivalNs - firstWriteNs;
+        return spanNs > 0 ? bytesReceived / (spanNs / 1e9) : 0.0;
+    }
+};
+
+qint64 residentBytes() {
+    QFile statm(QStringLiteral("/proc/self/statm"));
+    if (!statm.open(QIODevice::ReadOnly)) {
+        return 0;
+    }
+    QList<QByteArray> fields = statm.readAll().split(' ');
+    return fields.size() > 1 ? fields.at(1).toLongLong() * ::sysconf(_SC_PAGESIZE) : 0;
+}
+
+QByteArray stampedMessage(int port, int size) {
+    QByteArray message = QByteArray::number(port) + ':' + QByteArray::number(TimeUtils::timestampNs()) + ':';
+    message.append(qMax(0, size - message.size() - 1), 'x');
+    message.append('\n');
+    return message;
+}
+
+qint64 stampOf(const QByteArray &message) {
+    int first = message.indexOf(':');
+    int second = first < 0 ? -1 : message.indexOf(':', first + 1);
+    return second < 0 ? -1 : message.mid(first + 1, second - first - 1).toLongLong();
+}
+
+// The device end of one loopback port
+class Peer {
+  public:
+    Peer(int index, const QString &path)
+        : m_index(index), m_fd(::open(path.toLocal8Bit().constData(), O_RDWR | O_NOCTTY | O_NONBLOCK)) {}
+
+    ~Peer() {
+        if (m_fd >= 0) {
+            ::close(m_fd);
+        }
+    }
+
+    bool isOpen() const { return m_fd >= 0; }
+    int fd() const { return m_fd; }
+    bool hasPending() const { return !m_pending.isEmpty(); }
+    qint64 generated() const { return m_generated; }
+    qint64 skipped() const { return m_skipped; }
+
+    // Queues the messages due after elapsedNs and writes as much as the pty takes
+    void pump(qint64 elapsedNs, double bytesPerSecond, int size) {
+        if (bytesPerSecond > 0.0) {
+            qint64 due = static_cast<qint64>(elapsedNs / 1e9 * bytesPerSecond / size);
+            while (m_generated + m_skipped < due) {
+                if (m_pending.size() >= MAX_PENDING_BYTES) {
+                    m_skipped = due - m_generated;
+                    break;
+                }
+                m_pending += stampedMessage(m_index, size);
+                m_generated++;
+            }
+            flush();
+            return;
+        }
+
+        // Unthrottled: stamp each message just before the pty has room for it
+        for (int budget = MAX_PENDING_BYTES; budget > 0 && flush(); budget -= size) {
+            m_pending = stampedMessage(m_index, size);
+            m_generated++;
+        }
+        flush();
+    }
+
+    // True once everything queued has been written
+    bool flush() {
+        while (!m_pending.isEmpty()) {
+            ssize_t written = ::write(m_fd, m_pending.constData(), static_cast<size_t>(m_pending.size()));
+            if (written <= 0) {
+                return false;
+            }
+            m_pending.remove(0, static_cast<int>(written));
+        }
+        return true;
+    }
+
+    // Collects the messages ChatGroup forwarded to this device
+    void readForwarded(Result &result) {
+        char buffer[16384];
+        ssize_t bytesRead = 0;
+        while ((bytesRead = ::read(m_fd, buffer, sizeof(buffer))) > 0) {
+            m_readBuffer.append(buffer, static_cast<int>(bytesRead));
+        }
+
+        qint64 nowNs = TimeUtils::timestampNs();
+        int start = 0;
+        int end = 0;
+        while ((end = m_readBuffer.indexOf('\n', start)) >= 0) {
+            qint64 stamp = stampOf(m_readBuffer.mid(start, end - start));
+            if (stamp > 0) {
+                result.latency.record(nowNs - stamp);
+            }
+            result.messagesReceived++;
+            result.bytesReceived += end + 1 - start;
+            result.lastArrivalNs = nowNs;
+            start = end + 1;
+        }
+        m_readBuffer.remove(0, start);
+    }
+
+  private:
+    int m_index;
+    int m_fd;
+    QByteArray m_pending;
+    QByteArray m_readBuffer;
+    qint64 m_generated = 0;
+    qint64 m_skipped = 0;
+};
+
+SerialPortInfo loopbackInfo(const QString &portName) {
+    SerialPortInfo info(portName);
+    info.setTransport(TransportConfig(TransportType::Pty));
+    FramingConfig framing(FramingMode::Delimiter);
+    framing.setDelimiter("\n");
+    framing.setKeepDelimiter(true);
+    info.setFraming(framing);
+    return info;
+}
+
+bool runTopology(Topology topology, int portCount, double bytesPerSecond, int size, int seconds,
+                 QVector<Result> *results) {
+    const QString name = topology == Topology::Single ? QStringLiteral("single")
+                         : topology == Topology::Many ? QStringLiteral("many")
+                                                      : QStringLiteral("group");
+
+    SerialPortManager portManager;
+    MessageManager messageManager;
+
+    // Same wiring as MainWindow
+    QObject::connect(&portManager, &SerialPortManager::userMessageReceived, &messageManager,
+                     [&](const QString &, const Message &message) { messageManager.addMessage(message); });
+    QObject::connect(&portManager, &SerialPortManager::userMessageSent, &messageManager,
+                     [&](const QString &, const Message &message) { messageManager.addMessage(message); });
+
+    std::vector<std::unique_ptr<Peer>> peers;
+    ChatGroupInfo groupInfo(QStringLiteral("bench"));
+    for (int i = 0; i < portCount; ++i) {
+        QString portName = QString("bench%1").arg(i);
+        portManager.createUser(loopbackInfo(portName));
+        SerialPortUser *user = portManager.connectPort(portName) ? portManager.getUser(portName) : nullptr;
+        if (!user) {
+            QTextStream(stderr) << name << ": cannot open loopback port " << portName << "\n";
+            return false;
+        }
+        peers.emplace_back(new Peer(i, user->peerName()));
+        if (!peers.back()->isOpen()) {
+            QTextStream(stderr) << name << ": cannot open " << user->peerName() << "\n";
+            return false;
+        }
+        groupInfo.addMember(portName);
+    }
+
+    std::unique_ptr<ChatGroup> group;
+    if (topology == Topology::Group) {
+        group.reset(new ChatGroup(groupInfo, &portManager));
+        QObject::connect(group.get(), &ChatGroup::messageReceived, &messageManager,
+                         [&](const Message &message) { messageManager.addGroupMessage(groupInfo.id(), message); });
+    }
+
+    Result received;
+    received.name = name;
+    received.ports = portCount;
+    received.offeredBytesPerSecond = bytesPerSecond * portCount;
+    QObject::connect(&messageManager, &MessageManager::messageAdded, [&](const QString &, const Message &message) {
+        if (message.direction() != MessageDirection::Received) {
+            return;
+        }
+        qint64 nowNs = TimeUtils::timestampNs();
+        qint64 stamp = stampOf(message.data());
+        if (stamp > 0) {
+            received.latency.record(nowNs - stamp);
+        }
+        received.messagesReceived++;
+        received.bytesReceived += message.data().size();
+        received.lastArrivalNs = nowNs;
+    });
+
+    Result forwarded;
+    forwarded.name = name + QStringLiteral(" fwd");
+    forwarded.ports = portCount;
+    forwarded.offeredBytesPerSecond = received.offeredBytesPerSecond * (portCount - 1);
+    std::vector<std::unique_ptr<QSocketNotifier>> notifiers;
+    if (group) {
+        for (const auto &peer : peers) {
+            Peer *device = peer.get();
+            notifiers.emplace_back(new QSocketNotifier(device->fd(), QSocketNotifier::Read));
+            QObject::connect(notifiers.back().get(), &QSocketNotifier::activated,
+                             [device, &forwarded]() { device->readForwarded(forwarded); });
+        }
+    }
+
+    // Let the ports settle before the baseline
+    QCoreApplication::processEvents();
+    received.rssConnectedBytes = residentBytes();
+
+    QEventLoop loop;
+    QTimer tick;
+    tick.setTimerType(Qt::PreciseTimer);
+    QElapsedTimer clock;
+    const qint64 runNs = static_cast<qint64>(seconds) * 1000000000LL;
+    qint64 drainStartMs = -1;
+
+    auto generated = [&]() {
+        qint64 total = 0;
+        for (const auto &peer : peers) {
+            total += peer->generated();
+        }
+        return total;
+    };
+
+    QObject::connect(&tick, &QTimer::timeout, &loop, [&]() {
+        qint64 elapsedNs = clock.nsecsElapsed();
+        bool pending = false;
+        for (const auto &peer : peers) {
+            if (elapsedNs < runNs) {
+                peer->pump(elapsedNs, bytesPerSecond, size);
+            } else {
+                peer->flush();
+            }
+            pending = pending || peer->hasPending();
+        }
+        if (elapsedNs < runNs) {
+            return;
+        }
+
+        if (drainStartMs < 0) {
+            drainStartMs = clock.elapsed();
+        }
+        qint64 sent = generated();
+        bool done = !pending && received.messagesReceived >= sent &&
+                    (!group || forwarded.messagesReceived >= sent * (portCount - 1));
+        if (done || clock.elapsed() - drainStartMs > DRAIN_TIMEOUT_MS) {
+            loop.quit();
+        }
+    });
+
+    received.firstWriteNs = TimeUtils::timestampNs();
+    forwarded.firstWriteNs = received.firstWriteNs;
+    clock.start();
+    tick.start(TICK_MS);
+    loop.exec();
+    tick.stop();
+
+    received.messagesSent = generated();
+    for (const auto &peer : peers) {
+        received.messagesSkipped += peer->skipped();
+    }
+    received.rssEndBytes = residentBytes();
+    results->append(received);
+
+    if (group) {
+        forwarded.messagesSent = received.messagesSent * (portCount - 1);
+        forwarded.rssConnectedBytes = received.rssConnectedBytes;
+        forwarded.rssEndBytes = received.rssEndBytes;
+        results->append(forwarded);
+    }
+
+    notifiers.clear();
+    group.reset();
+    portManager.disconnectAll();
+    return true;
+}
+
+double us(qint64 ns) { return ns / 1000.0; }
+} // namespace
+
+int main(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Measures end-to-end throughput and latency over pseudo terminal loopback ports");
+    parser.addHelpOption();
+    QCommandLineOption portsOption("ports", "Ports in the many-port topology.", "count", "16");
+    QCommandLineOption groupOption("group-size", "Members of the chat group topology.", "count", "4");
+    QCommandLineOption baudOption("baud", "Per-port rate as a baud rate (10 bits per byte); 0 is unthrottled.",
+                                  "baud", "115200");
+    QCommandLineOption sizeOption("size", "Message size in bytes, including the newline.", "bytes", "64");
+    QCommandLineOption secondsOption("seconds", "Duration of each topology.", "seconds", "5");
+    QCommandLineOption topologyOption("topology", "single, many, group or all.", "name", "all");
+    parser.addOptions({portsOption, groupOption, baudOption, sizeOption, secondsOption, topologyOption});
+    parser.process(app);
+
+    int ports = qBound(1, parser.value(portsOption).toInt(), 256);
+    int groupSize = qBound(2, parser.value(groupOption).toInt(), 64);
+    double bytesPerSecond = qMax(0, parser.value(baudOption).toInt()) / 10.0;
+    int size = qBound(MIN_MESSAGE_SIZE, parser.value(sizeOption).toInt(), MAX_PENDING_BYTES);
+    int seconds = qMax(1, parser.value(secondsOption).toInt());
+    QString topology = parser.value(topologyOption);
+
+    QVector<Result> results;
+    bool ok = true;
+    if (topology == "all" || topology == "single") {
+        ok = runTopology(Topology::Single, 1, bytesPerSecond, size, seconds, &results) && ok;
+    }
+    if (topology == "all" || topology == "many") {
+        ok = runTopology(Topology::Many, ports, bytesPerSecond, size, seconds, &results) && ok;
+    }
+    if (topology == "all" || topology == "group") {
+        ok = runTopology(Topology::Group, groupSize, bytesPerSecond, size, seconds, &results) && ok;
+    }
+
+    QTextStream out(stdout);
+    out << QString("%1%2%3%4%5%6%7%8%9%10%11\n")
+               .arg("topology", -12)
+               .arg("ports", 6)
+               .arg("offered B/s", 14)
+               .arg("sustained B/s", 15)
+               .arg("messages", 11)
+               .arg("lost", 8)
+               .arg("skipped", 9)
+               .arg("p50 us", 10)
+               .arg("p99 us", 10)
+               .arg("max us", 10)
+               .arg("RSS MB (+KB)", 16);
+    for (const Result &result : qAsConst(results)) {
+        QString offered = result.offeredBytesPerSecond > 0.0 ? QString::number(result.offeredBytesPerSecond, 'f', 0)
+                                                             : QStringLiteral("max");
+        QString rss = QString("%1 (+%2)")
+                          .arg(result.rssEndBytes / (1024.0 * 1024.0), 0, 'f', 1)
+                          .arg(qMax<qint64>(0, result.rssEndBytes - result.rssConnectedBytes) / 1024);
+        out << QString("%1%2%3%4%5%6%7%8%9%10%11\n")
+                   .arg(result.name, -12)
+                   .arg(result.ports, 6)
+                   .arg(offered, 14)
+                   .arg(result.sustainedBytesPerSecond(), 15, 'f', 0)
+                   .arg(result.messagesReceived, 11)
+                   .arg(qMax<qint64>(0, result.messagesSent - result.messagesReceived), 8)
+                   .arg(result.messagesSkipped, 9)
+                   .arg(us(result.latency.percentile(50)), 10, 'f', 1)
+                   .arg(us(result.latency.percentile(99)), 10, 'f', 1)
+                   .arg(us(result.latency.max()), 10, 'f', 1)
+                   .arg(rss, 16);
+    }
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,246 @@
+// Compares the QSerialPort and native termios transports over a pseudo
+// terminal: round-trip latency of small messages and CPU time per MB of
+// bulk data. The benchmark writes to the pty master; the transport under
+// test reads from the slave side exactly as SerialPortWorker would.
+
+#include "PortTransport.h"
+#include "SerialPortInfo.h"
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QSocketNotifier>
+#include <QTextStream>
+#include <QTimer>
+#include <QVector>
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <ctime>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+// Give up on a run that stalls for this long
+const int RUN_TIMEOUT_MS = 30000;
+
+// Largest single write to the pty master
+const int MASTER_CHUNK_SIZE = 4096;
+
+struct Result {
+    QString name;
+    QVector<qint64> latenciesNs;
+    double megabytesPerSecond = 0.0;
+    double cpuMsPerMegabyte = 0.0;
+};
+
+// Opens a pty pair; returns the master descriptor and the slave path
+int openPseudoTerminal(QString *slavePath) {
+    int master = posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+    if (master < 0) {
+        return -1;
+    }
+    if (grantpt(master) != 0 || unlockpt(master) != 0) {
+        ::close(master);
+        return -1;
+    }
+    *slavePath = QString::fromLocal8Bit(ptsname(master));
+    return master;
+}
+
+qint64 processCpuNs() {
+    timespec ts = {};
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return static_cast<qint64>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+// Reads whatever the transport has; returns the number of bytes consumed
+qint64 drain(PortTransport *transport, QByteArray &buffer) {
+    qint64 total = 0;
+    qint64 bytesRead = 0;
+    while ((bytesRead = transport->read(buffer.data(), buffer.size())) > 0) {
+        total += bytesRead;
+    }
+    return total;
+}
+
+bool runLatency(PortTransport *transport, int master, int count, int size, Result *result) {
+    QByteArray payload(size, 'x');
+    QByteArray buffer(MASTER_CHUNK_SIZE, '\0');
+    QElapsedTimer timer;
+    QEventLoop loop;
+    qint64 received = 0;
+    bool ok = true;
+
+    auto send = [&]() {
+        received = 0;
+        timer.start();
+        if (::write(master, payload.constData(), static_cast<size_t>(size)) != size) {
+            ok = false;
+            loop.quit();
+        }
+    };
+
+    QObject::connect(transport, &PortTransport::readyRead, &loop, [&]() {
+        received += drain(transport, buffer);
+        if (received < size) {
+            return;
+        }
+        result->latenciesNs.append(timer.nsecsElapsed());
+        if (result->latenciesNs.size() == count) {
+            loop.quit();
+        } else {
+            send();
+        }
+    });
+    QTimer::singleShot(RUN_TIMEOUT_MS, &loop, [&]() {
+        ok = false;
+        loop.quit();
+    });
+
+    send();
+    loop.exec();
+    return ok;
+}
+
+bool runThroughput(PortTransport *transport, int master, qint64 totalBytes, Result *result) {
+    QByteArray chunk(MASTER_CHUNK_SIZE, 'y');
+    QByteArray buffer(64 * 1024, '\0');
+    QSocketNotifier notifier(master, QSocketNotifier::Write);
+    QEventLoop loop;
+    qint64 sent = 0;
+    qint64 received = 0;
+    bool ok = true;
+
+    QObject::connect(&notifier, &QSocketNotifier::activated, &loop, [&]() {
+        while (sent < totalBytes) {
+            size_t length = static_cast<size_t>(qMin<qint64>(chunk.size(), totalBytes - sent));
+            ssize_t written = ::write(master, chunk.constData(), length);
+            if (written <= 0) {
+                if (written < 0 && errno != EAGAIN) {
+                    ok = false;
+                    loop.quit();
+                }
+                return;
+            }
+            sent += written;
+        }
+        notifier.setEnabled(false);
+    });
+    QObject::connect(transport, &PortTransport::readyRead, &loop, [&]() {
+        received += drain(transport, buffer);
+        if (received >= totalBytes) {
+            loop.quit();
+        }
+    });
+    QTimer::singleShot(RUN_TIMEOUT_MS, &loop, [&]() {
+        ok = false;
+        loop.quit();
+    });
+
+    QElapsedTimer wall;
+    wall.start();
+    qint64 cpuStart = processCpuNs();
+    loop.exec();
+    qint64 cpuNs = processCpuNs() - cpuStart;
+    qint64 wallNs = wall.nsecsElapsed();
+
+    double megabytes = static_cast<double>(received) / (1024.0 * 1024.0);
+    if (megabytes > 0.0) {
+        result->megabytesPerSecond = megabytes / (static_cast<double>(wallNs) / 1e9);
+        result->cpuMsPerMegabyte = (static_cast<double>(cpuNs) / 1e6) / megabytes;
+    }
+    return ok;
+}
+
+bool runTransport(TransportType type, const QString &name, int count, int size, qint64 totalBytes,
+                  Result *result) {
+    result->name = name;
+
+    QString slavePath;
+    int master = openPseudoTerminal(&slavePath);
+    if (master < 0) {
+        QTextStream(stderr) << name << ": cannot open pseudo terminal\n";
+        return false;
+    }
+
+    SerialPortInfo info(slavePath);
+    info.setTransport(TransportConfig(type));
+
+    PortTransport *transport = PortTransport::create(type);
+    bool ok = transport && transport->open(info);
+    if (!ok) {
+        QTextStream(stderr) << name << ": " << (transport ? transport->errorString() : QString("unsupported"))
+                            << "\n";
+    } else {
+        // Same setting SerialPortWorker uses
+        transport->setReadBufferSize(SlabRingBuffer::DEFAULT_SLAB_SIZE);
+        ok = runLatency(transport, master, count, size, result);
+        QObject::disconnect(transport, &PortTransport::readyRead, nullptr, nullptr);
+        ok = ok && runThroughput(transport, master, totalBytes, result);
+        transport->close();
+    }
+
+    delete transport;
+    ::close(master);
+    return ok;
+}
+
+double percentileUs(const QVector<qint64> &sorted, double percentile) {
+    if (sorted.isEmpty()) {
+        return 0.0;
+    }
+    int index = qBound(0, static_cast<int>(percentile * (sorted.size() - 1) + 0.5), sorted.size() - 1);
+    return static_cast<double>(sorted.at(index)) / 1000.0;
+}
+} // namespace
+
+int main(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Compares serial transports over a pseudo terminal");
+    parser.addHelpOption();
+    QCommandLineOption countOption("messages", "Number of latency round trips.", "count", "2000");
+    QCommandLineOption sizeOption("size", "Latency message size in bytes.", "bytes", "16");
+    QCommandLineOption megabytesOption("megabytes", "Bulk transfer size in MB.", "mb", "64");
+    parser.addOptions({countOption, sizeOption, megabytesOption});
+    parser.process(app);
+
+    int count = qMax(1, parser.value(countOption).toInt());
+    int size = qBound(1, parser.value(sizeOption).toInt(), MASTER_CHUNK_SIZE);
+    qint64 totalBytes = qMax<qint64>(1, parser.value(megabytesOption).toLongLong()) * 1024 * 1024;
+
+    QVector<Result> results;
+    bool ok = true;
+    const QVector<QPair<TransportType, QString>> transports = {
+        {TransportType::QtSerialPort, QStringLiteral("QSerialPort")},
+        {TransportType::Termios, QStringLiteral("termios2+epoll")},
+    };
+    for (const auto &transport : transports) {
+        Result result;
+        ok = runTransport(transport.first, transport.second, count, size, totalBytes, &result) && ok;
+        std::sort(result.latenciesNs.begin(), result.latenciesNs.end());
+        results.append(result);
+    }
+
+    QTextStream out(stdout);
+    out << QString("%1 %2 %3 %4 %5 %6\n")
+               .arg("transport", -16)
+               .arg("p50 us", 10)
+               .arg("p99 us", 10)
+               .arg("max us", 10)
+               .arg("MB/s", 10)
+               .arg("CPU ms/MB", 10);
+    for (const Result &result : qAsConst(results)) {
+        out << QString("%1 %2 %3 %4 %5 %6\n")
+                   .arg(result.name, -16)
+                   .arg(percentileUs(result.latenciesNs, 0.50), 10, 'f', 1)
+                   .arg(percentileUs(result.latenciesNs, 0.99), 10, 'f', 1)
+                   .arg(percentileUs(result.latenciesNs, 1.0), 10, 'f', 1)
+                   .arg(result.megabytesPerSecond, 10, 'f', 1)
+                   .arg(result.cpuMsPerMegabyte, 10, 'f', 2);
+    }
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,93 @@
+#include "AutoResponder.h"
+#include "SerialPortUser.h"
+
+namespace {
+// Replies whose write never shows up (port closed, queue discarded) are forgotten beyond this
+const int MAX_PENDING_REPLIES = 1024;
+} // namespace
+
+AutoResponder::AutoResponder(SerialPortUser *user)
+    : QObject(user), m_user(user), m_framed(false), m_checksum(ChecksumType::None), m_state(AhoCorasick::ROOT), m_matchCount(0), m_replyCount(0),
+      m_failedCount(0) {
+    QObject::connect(user, &SerialPortUser::messageSent, this, &AutoResponder::onMessageSent);
+    QObject::connect(user, &SerialPortUser::connected, this, &AutoResponder::reset);
+}
+
+void AutoResponder::configure(const SerialPortInfo &info) {
+    m_framed = info.framing().mode() != FramingMode::None;
+    m_checksum = info.checksum();
+
+    QList<AutoReplyRule> rules = info.autoReplies();
+    if (rules == m_rules && m_matcher.isBuilt()) {
+        return;
+    }
+
+    m_rules = rules;
+    m_matcher.clear();
+    m_ruleOfPattern.clear();
+    for (int i = 0; i < m_rules.size(); ++i) {
+        const AutoReplyRule &rule = m_rules.at(i);
+        if (rule.isEnabled() && m_matcher.addPattern(rule.pattern()) >= 0) {
+            m_ruleOfPattern.append(i);
+        }
+    }
+    m_matcher.build();
+    m_hits = QVector<qint64>(m_rules.size(), 0);
+    reset();
+}
+
+void AutoResponder::process(const Message &message) {
+    // A device ignores frames that fail their checksum, and so do we
+    if (m_ruleOfPattern.isEmpty() || message.checksumStatus() == ChecksumStatus::Invalid) {
+        return;
+    }
+    if (m_framed) {
+        m_state = AhoCorasick::ROOT;
+    }
+
+    const QByteArray data = message.data();
+    int size = data.size();
+    if (message.checksumStatus() == ChecksumStatus::Valid) {
+        size -= Checksum::size(m_checksum);
+    }
+    m_state = m_matcher.scan(m_state, data.constData(), size, [&](int pattern, int) {
+        int rule = m_ruleOfPattern.at(pattern);
+        const QByteArray &response = m_rules.at(rule).response();
+        m_matchCount++;
+        m_hits[rule]++;
+
+        if (!m_user->sendData(response)) {
+            m_failedCount++;
+            return;
+        }
+        if (m_pending.size() >= MAX_PENDING_REPLIES) {
+            m_pending.dequeue();
+        }
+        m_pending.enqueue({Checksum::append(m_checksum, response), message.timestampNs()});
+        emit replied(rule, response);
+    });
+}
+
+void AutoResponder::reset() {
+    m_state = AhoCorasick::ROOT;
+    m_pending.clear();
+}
+
+void AutoResponder::resetStatistics() {
+    m_matchCount = 0;
+    m_replyCount = 0;
+    m_failedCount = 0;
+    m_hits.fill(0);
+    m_latency.clear();
+}
+
+void AutoResponder::onMessageSent(const Message &message) {
+    // Writes complete in queue order; anything else the user sent in between does not match
+    if (m_pending.isEmpty() || message.data() != m_pending.head().response) {
+        return;
+    }
+
+    PendingReply reply = m_pending.dequeue();
+    m_replyCount++;
+    m_latency.record(message.timestampNs() - reply.readNs);
+}
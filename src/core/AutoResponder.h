@@ -0,0 +1,94 @@
+#ifndef AUTO_RESPONDER_H
+#define AUTO_RESPONDER_H
+
+#include "AhoCorasick.h"
+#include "AutoReplyRule.h"
+#include "Checksum.h"
+#include "LatencyHistogram.h"
+#include "Message.h"
+#include <QList>
+#include <QObject>
+#include <QQueue>
+#include <QVector>
+
+class SerialPortInfo;
+class SerialPortUser;
+
+/**
+ * @brief Answers received patterns of a SerialPortUser with canned replies
+ *
+ * The enabled rules of SerialPortInfo::autoReplies() are compiled into one
+ * AhoCorasick automaton, so checking received data costs one table lookup
+ * per byte no matter how many rules there are. SerialPortUser feeds every
+ * received message to process() before it is delivered to anyone else.
+ *
+ * Without framing the automaton state carries over from one message to the
+ * next, so a pattern split across reads still matches. With framing a rule
+ * matches within a frame and the state starts over with every frame. The
+ * state is also reset when the port (re)connects.
+ *
+ * Every match sends the rule's response through SerialPortUser::sendData(),
+ * which appends the port's checksum if one is configured. Frames that were
+ * verified against it are matched without the checksum bytes; frames that
+ * failed verification are not answered.
+ *
+ * The reply latency is the time from the read that completed the pattern to
+ * the write of the reply, taken from the two messages' timestamps, and is
+ * kept in a LatencyHistogram.
+ */
+class AutoResponder : public QObject {
+    Q_OBJECT
+
+  public:
+    explicit AutoResponder(SerialPortUser *user);
+
+    // Recompiles only if the rules changed; the framing mode decides whether matches span messages
+    void configure(const SerialPortInfo &info);
+    QList<AutoReplyRule> rules() const { return m_rules; }
+    int activeRuleCount() const { return m_matcher.patternCount(); }
+
+    // Matches one received message and sends the replies
+    void process(const Message &message);
+    void reset();
+
+    // Statistics since the last resetStatistics()
+    qint64 matchCount() const { return m_matchCount; }
+    qint64 replyCount() const { return m_replyCount; }
+    qint64 failedCount() const { return m_failedCount; }
+    qint64 hitCount(int rule) const { return m_hits.value(rule); }
+    const LatencyHistogram &latency() const { return m_latency; }
+    void resetStatistics();
+
+  signals:
+    void replied(int rule, const QByteArray &response);
+
+  private slots:
+    void onMessageSent(const Message &message);
+
+  private:
+    struct PendingReply {
+        QByteArray response;
+        qint64 readNs;
+    };
+
+    SerialPortUser *m_user;
+    QList<AutoReplyRule> m_rules;
+    bool m_framed;
+    ChecksumType m_checksum;
+
+    // Automaton over the enabled rules; m_ruleOfPattern maps its pattern index to the rule
+    AhoCorasick m_matcher;
+    QVector<int> m_ruleOfPattern;
+    int m_state;
+
+    // Replies handed to the transmit queue, oldest first, until their write shows up
+    QQueue<PendingReply> m_pending;
+
+    qint64 m_matchCount;
+    qint64 m_replyCount;
+    qint64 m_failedCount;
+    QVector<qint64> m_hits;
+    LatencyHistogram m_latency;
+};
+
+#endif // AUTO_RESPONDER_H
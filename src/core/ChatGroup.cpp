@@ -133,9 +133,10 @@ void ChatGroup::connectMember(const QString& portName)
         return;
     }
     
-    // We rely on the manager's signal for message reception
+    // We rely on the manager's signal for message reception; one connection
+    // serves all members, otherwise every message is handled once per member
     QObject::connect(m_portManager, &SerialPortManager::userMessageReceived,
-                     this, &ChatGroup::onMemberMessageReceived);
+                     this, &ChatGroup::onMemberMessageReceived, Qt::UniqueConnection);
 }
 
 void ChatGroup::disconnectMember(const QString& portName)
@@ -156,6 +156,18 @@ QList<Message> DataPersistence::loadGroupMessages(const QString& groupId)
     return messages;
 }
 
+bool DataPersistence::appendMessages(const QString& portName, const QList<Message>& messages)
+{
+    ensureDirectoryExists(m_dataDirectory + "/messages");
+    return appendToJsonArray(messagesPath(portName), messages);
+}
+
+bool DataPersistence::appendGroupMessages(const QString& groupId, const QList<Message>& messages)
+{
+    ensureDirectoryExists(m_dataDirectory + "/group_messages");
+    return appendToJsonArray(groupMessagesPath(groupId), messages);
+}
+
 void DataPersistence::clearAllData()
 {
     QDir dir(m_dataDirectory);
@@ -222,6 +234,61 @@ bool DataPersistence::writeJsonFile(const QString& path, const QJsonDocument& do
     return true;
 }
 
+bool DataPersistence::appendToJsonArray(const QString& path, const QList<Message>& messages)
+{
+    if (messages.isEmpty()) {
+        return true;
+    }
+    
+    QFile file(path);
+    if (!file.open(QIODevice::ReadWrite)) {
+        emit error(tr("Cannot open file for writing: %1").arg(path));
+        return false;
+    }
+    
+    // Find the array's closing bracket; only the tail of the file is read
+    qint64 size = file.size();
+    qint64 closing = -1;
+    bool empty = true;
+    if (size > 0) {
+        qint64 tailStart = qMax<qint64>(0, size - 4096);
+        file.seek(tailStart);
+        QByteArray tail = file.read(size - tailStart);
+        int index = tail.size() - 1;
+        while (index >= 0 && QChar(tail.at(index)).isSpace()) {
+            --index;
+        }
+        if (index < 0 || tail.at(index) != ']') {
+            emit error(tr("Not a message history, left unchanged: %1").arg(path));
+            return false;
+        }
+        closing = tailStart + index;
+        --index;
+        while (index >= 0 && QChar(tail.at(index)).isSpace()) {
+            --index;
+        }
+        empty = index >= 0 && tail.at(index) == '[';
+    }
+    
+    QByteArray out;
+    if (closing < 0) {
+        out += "[";
+    }
+    for (const auto& msg : messages) {
+        out += empty ? "\n" : ",\n";
+        out += QJsonDocument(msg.toJson()).toJson(QJsonDocument::Compact);
+        empty = false;
+    }
+    out += "\n]\n";
+    
+    qint64 start = closing < 0 ? 0 : closing;
+    if (!file.seek(start) || file.write(out) != out.size() || !file.resize(start + out.size())) {
+        emit error(tr("Failed to write %1: %2").arg(path, file.errorString()));
+        return false;
+    }
+    return true;
+}
+
 QJsonDocument DataPersistence::readJsonFile(const QString& path)
 {
     QFile file(path);
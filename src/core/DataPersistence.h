@@ -36,6 +36,10 @@ public:
     bool saveGroupMessages(const QString& groupId, const QList<Message>& messages);
     QList<Message> loadGroupMessages(const QString& groupId);
     
+    // Add messages to the end of the stored history, keeping what is already there
+    bool appendMessages(const QString& portName, const QList<Message>& messages);
+    bool appendGroupMessages(const QString& groupId, const QList<Message>& messages);
+    
     // Clear data
     void clearAllData();
     void clearMessages();
@@ -61,6 +65,7 @@ private:
     bool ensureDirectoryExists(const QString& path);
     bool writeJsonFile(const QString& path, const QJsonDocument& doc);
     QJsonDocument readJsonFile(const QString& path);
+    bool appendToJsonArray(const QString& path, const QList<Message>& messages);
 };
 
 #endif // DATA_PERSISTENCE_H
@@ -0,0 +1,77 @@
+#include "EpollReactor.h"
+#include <QSocketNotifier>
+#include <QThreadStorage>
+#include <sys/epoll.h>
+#include <unistd.h>
+
+namespace {
+// Events collected per epoll_wait() call
+const int MAX_EVENTS = 64;
+
+QThreadStorage<EpollReactor *> reactors;
+} // namespace
+
+EpollReactor *EpollReactor::forCurrentThread() {
+    // QThreadStorage deletes the reactor when the thread exits
+    if (!reactors.hasLocalData()) {
+        reactors.setLocalData(new EpollReactor());
+    }
+    return reactors.localData();
+}
+
+EpollReactor::EpollReactor(QObject *parent)
+    : QObject(parent), m_epollFd(epoll_create1(EPOLL_CLOEXEC)), m_notifier(nullptr) {
+    if (m_epollFd >= 0) {
+        m_notifier = new QSocketNotifier(m_epollFd, QSocketNotifier::Read, this);
+        QObject::connect(m_notifier, &QSocketNotifier::activated, this, &EpollReactor::dispatch);
+    }
+}
+
+EpollReactor::~EpollReactor() {
+    delete m_notifier;
+    if (m_epollFd >= 0) {
+        ::close(m_epollFd);
+    }
+}
+
+bool EpollReactor::add(int fd, quint32 events, Handler handler) {
+    epoll_event event = {};
+    event.events = events;
+    event.data.fd = fd;
+    if (epoll_ctl(m_epollFd, EPOLL_CTL_ADD, fd, &event) != 0) {
+        return false;
+    }
+
+    m_handlers.insert(fd, std::move(handler));
+    return true;
+}
+
+bool EpollReactor::modify(int fd, quint32 events) {
+    epoll_event event = {};
+    event.events = events;
+    event.data.fd = fd;
+    return epoll_ctl(m_epollFd, EPOLL_CTL_MOD, fd, &event) == 0;
+}
+
+void EpollReactor::remove(int fd) {
+    if (m_handlers.remove(fd) > 0) {
+        epoll_ctl(m_epollFd, EPOLL_CTL_DEL, fd, nullptr);
+    }
+}
+
+void EpollReactor::dispatch() {
+    epoll_event events[MAX_EVENTS];
+    int count = 0;
+    do {
+        count = epoll_wait(m_epollFd, events, MAX_EVENTS, 0);
+        for (int i = 0; i < count; ++i) {
+            // A handler may remove itself or others, so look each one up again
+            auto it = m_handlers.constFind(events[i].data.fd);
+            if (it == m_handlers.constEnd()) {
+                continue;
+            }
+            Handler handler = it.value();
+            handler(events[i].events);
+        }
+    } while (count == MAX_EVENTS);
+}
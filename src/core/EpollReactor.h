@@ -0,0 +1,48 @@
+#ifndef EPOLL_REACTOR_H
+#define EPOLL_REACTOR_H
+
+#include <QHash>
+#include <QObject>
+#include <functional>
+
+class QSocketNotifier;
+
+/**
+ * @brief One epoll instance per thread, integrated into the Qt event loop
+ *
+ * Native transports register their file descriptors here instead of
+ * creating a QSocketNotifier each. The thread's event loop only watches
+ * the epoll descriptor; when it becomes readable all ready descriptors
+ * are collected with a single epoll_wait() and dispatched to their
+ * handlers.
+ *
+ * Linux only. All methods must be called on the owning thread.
+ */
+class EpollReactor : public QObject {
+    Q_OBJECT
+
+  public:
+    using Handler = std::function<void(quint32 events)>;
+
+    // Reactor of the calling thread, created on first use
+    static EpollReactor *forCurrentThread();
+
+    ~EpollReactor() override;
+
+    bool isValid() const { return m_epollFd >= 0; }
+
+    bool add(int fd, quint32 events, Handler handler);
+    bool modify(int fd, quint32 events);
+    void remove(int fd);
+
+  private:
+    explicit EpollReactor(QObject *parent = nullptr);
+
+    int m_epollFd;
+    QSocketNotifier *m_notifier;
+    QHash<int, Handler> m_handlers;
+
+    void dispatch();
+};
+
+#endif // EPOLL_REACTOR_H
@@ -0,0 +1,219 @@
+#include "HistoryReader.h"
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QObject>
+
+namespace {
+const int BLOCK_SIZE = 64 * 1024;
+
+// Nesting never gets deeper than this in either history format
+const int MAX_DEPTH = 64;
+}
+
+HistoryReader::HistoryReader()
+    : m_atEnd(true)
+    , m_size(0)
+    , m_bytesRead(0)
+    , m_messagesRead(0)
+    , m_scan(0)
+    , m_inString(false)
+    , m_escape(false)
+    , m_keyStart(-1)
+    , m_messageStart(-1)
+    , m_messageDepth(0)
+{
+}
+
+HistoryReader::~HistoryReader()
+{
+    close();
+}
+
+bool HistoryReader::open(const QString& path, const QString& portName)
+{
+    close();
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        m_errorString = QObject::tr("Cannot open %1: %2").arg(path, m_file.errorString());
+        return false;
+    }
+    m_portName = portName;
+    m_size = m_file.size();
+    m_atEnd = false;
+    return true;
+}
+
+void HistoryReader::close()
+{
+    m_file.close();
+    m_portName.clear();
+    m_errorString.clear();
+    m_atEnd = true;
+    m_size = 0;
+    m_bytesRead = 0;
+    m_messagesRead = 0;
+
+    m_buffer.clear();
+    m_scan = 0;
+    m_stack.clear();
+    m_inString = false;
+    m_escape = false;
+    m_keyStart = -1;
+    m_messageStart = -1;
+    m_messageDepth = 0;
+}
+
+bool HistoryReader::readNext(Message& message)
+{
+    while (isOpen() && !m_atEnd && !hasError()) {
+        QByteArray json;
+        if (!scanMessage(json)) {
+            if (!fillBuffer()) {
+                return false;
+            }
+            continue;
+        }
+
+        QJsonParseError error;
+        QJsonDocument doc = QJsonDocument::fromJson(json, &error);
+        if (error.error != QJsonParseError::NoError) {
+            fail(QObject::tr("JSON parse error: %1").arg(error.errorString()));
+            return false;
+        }
+        Message next = Message::fromJson(doc.object());
+        if (!m_portName.isEmpty() && next.portName() != m_portName) {
+            continue;
+        }
+        m_messagesRead++;
+        message = next;
+        return true;
+    }
+    return false;
+}
+
+bool HistoryReader::fillBuffer()
+{
+    // Drop what has been scanned, keeping a message or key still being read
+    int keep = m_scan;
+    if (m_messageStart >= 0) {
+        keep = qMin(keep, m_messageStart);
+    }
+    if (m_keyStart >= 0) {
+        keep = qMin(keep, m_keyStart);
+    }
+    m_buffer.remove(0, keep);
+    m_scan -= keep;
+    if (m_messageStart >= 0) {
+        m_messageStart -= keep;
+    }
+    if (m_keyStart >= 0) {
+        m_keyStart -= keep;
+    }
+
+    QByteArray block = m_file.read(BLOCK_SIZE);
+    if (block.isEmpty()) {
+        if (!m_stack.isEmpty() || m_inString) {
+            fail(QObject::tr("History file is truncated"));
+        }
+        m_atEnd = true;
+        return false;
+    }
+    m_bytesRead += block.size();
+    m_buffer.append(block);
+    return true;
+}
+
+bool HistoryReader::scanMessage(QByteArray& json)
+{
+    const char* data = m_buffer.constData();
+    const int size = m_buffer.size();
+
+    for (; m_scan < size; ++m_scan) {
+        const char c = data[m_scan];
+        if (m_inString) {
+            if (m_escape) {
+                m_escape = false;
+            } else if (c == '\\') {
+                m_escape = true;
+            } else if (c == '"') {
+                m_inString = false;
+                if (m_keyStart >= 0) {
+                    m_stack.last().key = m_buffer.mid(m_keyStart, m_scan - m_keyStart);
+                    m_keyStart = -1;
+                }
+            }
+            continue;
+        }
+
+        switch (c) {
+        case '"':
+            m_inString = true;
+            // Keys are only needed outside messages, to find the message arrays
+            if (m_messageStart < 0 && !m_stack.isEmpty() && m_stack.last().type == '{' && m_stack.last().expectKey) {
+                m_keyStart = m_scan + 1;
+            }
+            break;
+        case ':':
+            if (!m_stack.isEmpty() && m_stack.last().type == '{') {
+                m_stack.last().expectKey = false;
+            }
+            break;
+        case ',':
+            if (!m_stack.isEmpty() && m_stack.last().type == '{') {
+                m_stack.last().expectKey = true;
+            }
+            break;
+        case '{':
+        case '[': {
+            if (m_stack.size() >= MAX_DEPTH) {
+                fail(QObject::tr("History file is nested too deeply"));
+                return false;
+            }
+            bool startsMessage = c == '{' && m_messageStart < 0 && isMessageArray();
+            Container container = {c, false, c == '{', QByteArray()};
+            if (c == '[' && m_messageStart < 0) {
+                // Either the file is an array of messages or the array is a port in "portMessages"
+                container.messages = m_stack.isEmpty()
+                                     || (m_stack.size() == 2 && m_stack.at(0).type == '{'
+                                         && m_stack.at(0).key == "portMessages" && m_stack.at(1).type == '{');
+            }
+            m_stack.append(container);
+            if (startsMessage) {
+                m_messageStart = m_scan;
+                m_messageDepth = m_stack.size();
+            }
+            break;
+        }
+        case '}':
+        case ']': {
+            if (m_stack.isEmpty()) {
+                fail(QObject::tr("Unexpected '%1' in history file").arg(QLatin1Char(c)));
+                return false;
+            }
+            const int depth = m_stack.size();
+            m_stack.removeLast();
+            if (m_messageStart >= 0 && depth == m_messageDepth) {
+                json = m_buffer.mid(m_messageStart, m_scan + 1 - m_messageStart);
+                m_messageStart = -1;
+                ++m_scan;
+                return true;
+            }
+            break;
+        }
+        default:
+            break;
+        }
+    }
+    return false;
+}
+
+bool HistoryReader::isMessageArray() const
+{
+    return !m_stack.isEmpty() && m_stack.last().type == '[' && m_stack.last().messages;
+}
+
+void HistoryReader::fail(const QString& error)
+{
+    m_errorString = error;
+    m_atEnd = true;
+}
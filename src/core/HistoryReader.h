@@ -0,0 +1,76 @@
+#ifndef HISTORY_READER_H
+#define HISTORY_READER_H
+
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+#include <QVector>
+#include "Message.h"
+
+/**
+ * @brief Reads stored messages one at a time without loading the file
+ *
+ * Understands both history formats: the per-port arrays written by
+ * DataPersistence (messages/<port>.json) and the "portMessages" section of
+ * an exported history. The file is read in blocks and scanned for the
+ * message objects; each one is parsed on its own, so memory use depends on
+ * the largest message, not on the size of the capture.
+ *
+ * If a port name is given, only that port's messages are returned. Group
+ * messages in an exported history are skipped.
+ */
+class HistoryReader {
+public:
+    HistoryReader();
+    ~HistoryReader();
+
+    bool open(const QString& path, const QString& portName = QString());
+    void close();
+    bool isOpen() const { return m_file.isOpen(); }
+
+    // Reads the next message; false at the end of the file or on error
+    bool readNext(Message& message);
+    bool atEnd() const { return m_atEnd; }
+
+    bool hasError() const { return !m_errorString.isEmpty(); }
+    QString errorString() const { return m_errorString; }
+
+    // Progress
+    qint64 bytesRead() const { return m_bytesRead; }
+    qint64 size() const { return m_size; }
+    qint64 messagesRead() const { return m_messagesRead; }
+
+private:
+    // One open array or object on the path to the scan position
+    struct Container {
+        char type;          // '[' or '{'
+        bool messages;      // An array whose elements are messages
+        bool expectKey;     // Objects: the next string is a key
+        QByteArray key;     // Objects: the key of the current value
+    };
+
+    QFile m_file;
+    QString m_portName;
+    QString m_errorString;
+    bool m_atEnd;
+    qint64 m_size;
+    qint64 m_bytesRead;
+    qint64 m_messagesRead;
+
+    // Unscanned input, and the scanner state at m_scan
+    QByteArray m_buffer;
+    int m_scan;
+    QVector<Container> m_stack;
+    bool m_inString;
+    bool m_escape;
+    int m_keyStart;          // Start of the key being read, or -1
+    int m_messageStart;      // Start of the message object being read, or -1
+    int m_messageDepth;      // Stack depth that closes the message object
+
+    bool fillBuffer();
+    bool scanMessage(QByteArray& json);
+    bool isMessageArray() const;
+    void fail(const QString& error);
+};
+
+#endif // HISTORY_READER_H
@@ -0,0 +1,174 @@
+#include "HotplugWatcher.h"
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSocketNotifier>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+namespace {
+// udev creates the node, then fixes permissions and adds links; report once that settles
+const int SETTLE_TIME_MS = 50;
+
+// Room for a batch of inotify events with names
+const int EVENT_BUFFER_SIZE = 16 * 1024;
+
+// Levels between a tty's sysfs device and the USB device holding idVendor & co.
+const int USB_ATTRIBUTE_DEPTH = 4;
+
+const quint32 DEVICE_EVENTS = IN_CREATE | IN_DELETE | IN_ATTRIB | IN_MOVED_FROM | IN_MOVED_TO;
+const quint32 BY_ID_EVENTS = IN_CREATE | IN_DELETE | IN_MOVED_TO;
+
+QString readAttribute(const QDir &dir, const QString &name) {
+    QFile file(dir.filePath(name));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QString();
+    }
+    return QString::fromUtf8(file.readAll()).trimmed();
+}
+} // namespace
+
+HotplugWatcher::HotplugWatcher(QObject *parent)
+    : HotplugWatcher(QStringLiteral("/dev"), QStringLiteral("/sys/class/tty"), parent) {}
+
+HotplugWatcher::HotplugWatcher(const QString &deviceDir, const QString &sysfsDir, QObject *parent)
+    : QObject(parent), m_deviceDir(deviceDir), m_sysfsDir(sysfsDir), m_fd(-1), m_deviceWatch(-1), m_byIdWatch(-1),
+      m_notifier(nullptr), m_settleTimer(new QTimer(this)) {
+    m_settleTimer->setSingleShot(true);
+    m_settleTimer->setInterval(SETTLE_TIME_MS);
+    QObject::connect(m_settleTimer, &QTimer::timeout, this, &HotplugWatcher::flush);
+}
+
+HotplugWatcher::~HotplugWatcher() { stop(); }
+
+bool HotplugWatcher::start() {
+    if (isActive()) {
+        return true;
+    }
+
+    m_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_fd < 0) {
+        return false;
+    }
+
+    m_deviceWatch = inotify_add_watch(m_fd, QFile::encodeName(m_deviceDir).constData(), DEVICE_EVENTS);
+    if (m_deviceWatch < 0) {
+        stop();
+        return false;
+    }
+    watchById();
+
+    m_notifier = new QSocketNotifier(m_fd, QSocketNotifier::Read, this);
+    QObject::connect(m_notifier, &QSocketNotifier::activated, this, &HotplugWatcher::onNotification);
+    return true;
+}
+
+void HotplugWatcher::stop() {
+    delete m_notifier;
+    m_notifier = nullptr;
+
+    // Closing the descriptor drops all watches
+    if (m_fd >= 0) {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+    m_deviceWatch = -1;
+    m_byIdWatch = -1;
+
+    m_settleTimer->stop();
+    m_pending.clear();
+}
+
+bool HotplugWatcher::probe(const QString &name, PortDescriptor *port) const {
+    QString location = m_deviceDir + QLatin1Char('/') + name;
+    QFileInfo device(m_sysfsDir + QLatin1Char('/') + name + QStringLiteral("/device"));
+
+    // Virtual terminals and ptys have no backing device in sysfs
+    if (!QFileInfo::exists(location) || !device.exists()) {
+        return false;
+    }
+
+    *port = PortDescriptor();
+    port->portName = name;
+    port->systemLocation = location;
+
+    QDir dir(device.canonicalFilePath());
+    for (int level = 0; level < USB_ATTRIBUTE_DEPTH; ++level) {
+        if (dir.exists(QStringLiteral("idVendor"))) {
+            port->vendorId = readAttribute(dir, QStringLiteral("idVendor")).toUShort(nullptr, 16);
+            port->productId = readAttribute(dir, QStringLiteral("idProduct")).toUShort(nullptr, 16);
+            port->description = readAttribute(dir, QStringLiteral("product"));
+            port->manufacturer = readAttribute(dir, QStringLiteral("manufacturer"));
+            port->serialNumber = readAttribute(dir, QStringLiteral("serial"));
+            break;
+        }
+        if (!dir.cdUp()) {
+            break;
+        }
+    }
+    return true;
+}
+
+void HotplugWatcher::onNotification() {
+    alignas(inotify_event) char buffer[EVENT_BUFFER_SIZE];
+    ssize_t length = 0;
+    while ((length = ::read(m_fd, buffer, sizeof(buffer))) > 0) {
+        const char *end = buffer + length;
+        for (const char *ptr = buffer; ptr < end;) {
+            const auto *event = reinterpret_cast<const inotify_event *>(ptr);
+            ptr += sizeof(inotify_event) + event->len;
+
+            if (event->mask & IN_Q_OVERFLOW) {
+                // Anything could have changed; the owner has to look at everything
+                m_pending.clear();
+                m_settleTimer->stop();
+                emit overflowed();
+                continue;
+            }
+            if (event->wd == m_byIdWatch && (event->mask & IN_IGNORED)) {
+                // by-id is removed with the last USB serial device
+                m_byIdWatch = -1;
+                continue;
+            }
+            if (event->len == 0) {
+                continue;
+            }
+
+            QString name = QFile::decodeName(event->name);
+            if (event->wd == m_deviceWatch) {
+                if (event->mask & IN_ISDIR) {
+                    // /dev/serial appears with the first USB serial device
+                    watchById();
+                } else {
+                    m_pending.insert(name);
+                }
+            } else if (event->wd == m_byIdWatch) {
+                // Links point at the device node, e.g. ../../ttyUSB0
+                QString target = QFileInfo(byIdDir() + QLatin1Char('/') + name).symLinkTarget();
+                if (!target.isEmpty()) {
+                    m_pending.insert(QFileInfo(target).fileName());
+                }
+            }
+        }
+    }
+
+    if (!m_pending.isEmpty()) {
+        m_settleTimer->start();
+    }
+}
+
+void HotplugWatcher::flush() {
+    watchById();
+
+    QStringList names = m_pending.values();
+    m_pending.clear();
+    names.sort();
+    emit devicesChanged(names);
+}
+
+void HotplugWatcher::watchById() {
+    if (m_fd < 0 || m_byIdWatch >= 0) {
+        return;
+    }
+    m_byIdWatch = inotify_add_watch(m_fd, QFile::encodeName(byIdDir()).constData(), BY_ID_EVENTS);
+}
@@ -0,0 +1,64 @@
+#ifndef HOTPLUG_WATCHER_H
+#define HOTPLUG_WATCHER_H
+
+#include "PortInventory.h"
+#include <QObject>
+#include <QSet>
+#include <QStringList>
+#include <QTimer>
+
+class QSocketNotifier;
+
+/**
+ * @brief Reports serial device nodes appearing and disappearing (Linux)
+ *
+ * Watches the device directory (and /dev/serial/by-id, where udev adds its
+ * links once a device is fully set up) with inotify. Events are collected
+ * for a short settle time, then devicesChanged() lists the affected names.
+ * The watcher does not decide whether they were added or removed; probe()
+ * looks a single device up in /dev and sysfs so the caller can compare the
+ * result with what it knew before.
+ *
+ * If the kernel drops events (inotify queue overflow), overflowed() asks
+ * for a full rescan instead. The directories can be overridden for tests.
+ */
+class HotplugWatcher : public QObject {
+    Q_OBJECT
+
+  public:
+    explicit HotplugWatcher(QObject *parent = nullptr);
+    HotplugWatcher(const QString &deviceDir, const QString &sysfsDir, QObject *parent = nullptr);
+    ~HotplugWatcher() override;
+
+    bool start();
+    void stop();
+    bool isActive() const { return m_fd >= 0; }
+
+    // Looks up one device; false if it is not a present serial device
+    bool probe(const QString &name, PortDescriptor *port) const;
+
+  signals:
+    void devicesChanged(const QStringList &names);
+    void overflowed();
+
+  private slots:
+    void onNotification();
+    void flush();
+
+  private:
+    QString m_deviceDir;
+    QString m_sysfsDir;
+    int m_fd;
+    int m_deviceWatch;
+    int m_byIdWatch;
+    QSocketNotifier *m_notifier;
+
+    // Names seen since the last devicesChanged(); flushed once events settle
+    QSet<QString> m_pending;
+    QTimer *m_settleTimer;
+
+    QString byIdDir() const { return m_deviceDir + QStringLiteral("/serial/by-id"); }
+    void watchById();
+};
+
+#endif // HOTPLUG_WATCHER_H
@@ -0,0 +1,86 @@
+#include "IoWorkerPool.h"
+#include <QtGlobal>
+
+IoWorkerPool::IoWorkerPool(QObject *parent) : QObject(parent) { startThreads(defaultThreadCount()); }
+
+IoWorkerPool::IoWorkerPool(int threadCount, QObject *parent) : QObject(parent) { startThreads(threadCount); }
+
+IoWorkerPool::~IoWorkerPool() { stopThreads(); }
+
+int IoWorkerPool::defaultThreadCount() {
+    bool ok = false;
+    int count = qEnvironmentVariableIntValue("SERIALCHAT_IO_THREADS", &ok);
+    if (ok && count > 0) {
+        return count;
+    }
+    return qBound(1, QThread::idealThreadCount() / 2, 4);
+}
+
+bool IoWorkerPool::setThreadCount(int count) {
+    if (count < 1 || count == m_threads.size()) {
+        return count >= 1;
+    }
+
+    // Ports are pinned to their thread, so the pool can only be resized while idle
+    if (!m_assignments.isEmpty()) {
+        return false;
+    }
+
+    stopThreads();
+    startThreads(count);
+    return true;
+}
+
+QThread *IoWorkerPool::acquire(const QString &portName) {
+    if (m_assignments.contains(portName)) {
+        return m_assignments.value(portName);
+    }
+
+    int best = 0;
+    for (int i = 1; i < m_threads.size(); ++i) {
+        if (portCount(i) < portCount(best)) {
+            best = i;
+        }
+    }
+
+    QThread *thread = m_threads.at(best);
+    m_assignments.insert(portName, thread);
+    return thread;
+}
+
+void IoWorkerPool::release(const QString &portName) { m_assignments.remove(portName); }
+
+int IoWorkerPool::portCount(int threadIndex) const {
+    if (threadIndex < 0 || threadIndex >= m_threads.size()) {
+        return 0;
+    }
+
+    QThread *thread = m_threads.at(threadIndex);
+    int count = 0;
+    for (QThread *assigned : m_assignments) {
+        if (assigned == thread) {
+            count++;
+        }
+    }
+    return count;
+}
+
+void IoWorkerPool::startThreads(int count) {
+    for (int i = 0; i < count; ++i) {
+        QThread *thread = new QThread(this);
+        thread->setObjectName(QString("SerialChat-IO-%1").arg(i));
+        thread->start(QThread::HighPriority);
+        m_threads.append(thread);
+    }
+}
+
+void IoWorkerPool::stopThreads() {
+    for (QThread *thread : m_threads) {
+        thread->quit();
+    }
+    for (QThread *thread : m_threads) {
+        thread->wait();
+        delete thread;
+    }
+    m_threads.clear();
+}
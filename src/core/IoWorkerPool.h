@@ -0,0 +1,44 @@
+#ifndef IO_WORKER_POOL_H
+#define IO_WORKER_POOL_H
+
+#include <QList>
+#include <QMap>
+#include <QObject>
+#include <QString>
+#include <QThread>
+
+/**
+ * @brief Pool of I/O threads that serial port workers are sharded across
+ *
+ * Each port is pinned to one thread for its whole lifetime so that all of its
+ * QIODevice traffic stays on a single event loop. New ports go to the thread
+ * that currently serves the fewest ports.
+ */
+class IoWorkerPool : public QObject {
+    Q_OBJECT
+
+  public:
+    explicit IoWorkerPool(QObject *parent = nullptr);
+    explicit IoWorkerPool(int threadCount, QObject *parent = nullptr);
+    ~IoWorkerPool() override;
+
+    // Thread count
+    int threadCount() const { return m_threads.size(); }
+    bool setThreadCount(int count);
+    static int defaultThreadCount();
+
+    // Port assignment
+    QThread *acquire(const QString &portName);
+    void release(const QString &portName);
+    QThread *threadFor(const QString &portName) const { return m_assignments.value(portName, nullptr); }
+    int portCount(int threadIndex) const;
+
+  private:
+    QList<QThread *> m_threads;
+    QMap<QString, QThread *> m_assignments;
+
+    void startThreads(int count);
+    void stopThreads();
+};
+
+#endif // IO_WORKER_POOL_H
@@ -1,4 +1,5 @@
 #include "MessageManager.h"
+#include "Trace.h"
 
 MessageManager::MessageManager(QObject* parent)
     : QObject(parent)
@@ -12,6 +13,7 @@ MessageManager::~MessageManager()
 
 void MessageManager::addMessage(const Message& message)
 {
+    TRACE_SCOPE("MessageManager::addMessage");
     QString portName = message.portName();
     m_messages[portName].append(message);
     trimMessages(portName);
@@ -47,7 +49,7 @@ QList<Message> MessageManager::getAllMessages() const
     
     // Sort by timestamp
     std::sort(all.begin(), all.end(), [](const Message& a, const Message& b) {
-        return a.timestamp() < b.timestamp();
+        return a.timestampNs() < b.timestampNs();
     });
     
     return all;
@@ -106,6 +108,7 @@ void MessageManager::clearGroupMessages(const QString& groupId)
 
 void MessageManager::trimMessages(const QString& portName)
 {
+    TRACE_SCOPE("MessageManager::trimMessages");
     if (!m_messages.contains(portName)) {
         return;
     }
@@ -0,0 +1,320 @@
+#include "ModbusRtuDecoder.h"
+#include "Checksum.h"
+#include <QStringList>
+
+namespace {
+// Largest RTU frame (application data unit) including address and CRC
+const int MAX_FRAME_SIZE = 256;
+
+// Smallest frame: address, function, exception code, CRC
+const int MIN_FRAME_SIZE = 5;
+
+// Highest unicast slave address; 248-255 are reserved
+const int MAX_SLAVE_ADDRESS = 247;
+
+quint16 readUInt16(const unsigned char* data)
+{
+    return static_cast<quint16>((data[0] << 8) | data[1]);
+}
+
+bool crcMatches(const unsigned char* frame, int length)
+{
+    quint16 crc = Checksum::crc16Modbus(reinterpret_cast<const char*>(frame), length - 2);
+    return frame[length - 2] == (crc & 0xFF) && frame[length - 1] == (crc >> 8);
+}
+
+// Coil and input states, least significant bit of each byte first
+QString formatBits(const unsigned char* data, int byteCount, int bitCount)
+{
+    QString bits;
+    bits.reserve(bitCount * 2);
+    for (int i = 0; i < bitCount && i / 8 < byteCount; ++i) {
+        if (i > 0) {
+            bits += QLatin1Char(' ');
+        }
+        bits += (data[i / 8] >> (i % 8)) & 1 ? QLatin1Char('1') : QLatin1Char('0');
+    }
+    return bits;
+}
+
+QString formatRegisters(const unsigned char* data, int byteCount)
+{
+    QStringList values;
+    for (int i = 0; i + 1 < byteCount; i += 2) {
+        values.append(QString::number(readUInt16(data + i)));
+    }
+    return values.join(QLatin1Char(' '));
+}
+}
+
+ModbusRtuDecoder::ModbusRtuDecoder(MessageDirection direction)
+    : ProtocolDecoder(direction)
+    , m_resyncing(false)
+{
+    m_buffer.reserve(MAX_FRAME_SIZE * 2);
+}
+
+void ModbusRtuDecoder::reset()
+{
+    m_buffer.clear();
+    m_resyncing = false;
+}
+
+QString ModbusRtuDecoder::functionName(int function)
+{
+    switch (function) {
+    case 1:
+        return QStringLiteral("Read Coils");
+    case 2:
+        return QStringLiteral("Read Discrete Inputs");
+    case 3:
+        return QStringLiteral("Read Holding Registers");
+    case 4:
+        return QStringLiteral("Read Input Registers");
+    case 5:
+        return QStringLiteral("Write Single Coil");
+    case 6:
+        return QStringLiteral("Write Single Register");
+    case 15:
+        return QStringLiteral("Write Multiple Coils");
+    case 16:
+        return QStringLiteral("Write Multiple Registers");
+    default:
+        return QStringLiteral("Function %1").arg(function);
+    }
+}
+
+QString ModbusRtuDecoder::exceptionName(int code)
+{
+    switch (code) {
+    case 1:
+        return QStringLiteral("Illegal Function");
+    case 2:
+        return QStringLiteral("Illegal Data Address");
+    case 3:
+        return QStringLiteral("Illegal Data Value");
+    case 4:
+        return QStringLiteral("Server Device Failure");
+    case 5:
+        return QStringLiteral("Acknowledge");
+    case 6:
+        return QStringLiteral("Server Device Busy");
+    case 8:
+        return QStringLiteral("Memory Parity Error");
+    case 10:
+        return QStringLiteral("Gateway Path Unavailable");
+    case 11:
+        return QStringLiteral("Gateway Target Device Failed to Respond");
+    default:
+        return QStringLiteral("Exception %1").arg(code);
+    }
+}
+
+void ModbusRtuDecoder::decode(const char* data, qint64 length, QVector<DecodedRecord>& records)
+{
+    m_buffer.append(data, static_cast<int>(length));
+    decodeBuffer(records);
+}
+
+void ModbusRtuDecoder::decodeFinish(QVector<DecodedRecord>& records)
+{
+    decodeBuffer(records);
+
+    // The frame ended here; whatever is left can never be completed
+    if (!m_buffer.isEmpty()) {
+        countError();
+        m_buffer.clear();
+    }
+    m_resyncing = false;
+}
+
+void ModbusRtuDecoder::decodeBuffer(QVector<DecodedRecord>& records)
+{
+    const unsigned char* data = reinterpret_cast<const unsigned char*>(m_buffer.constData());
+    const int size = m_buffer.size();
+    int pos = 0;
+    while (pos < size) {
+        Kind kind = Kind::Request;
+        int length = frameLength(data + pos, size - pos, &kind);
+        if (length == 0) {
+            // Waiting only makes sense if no complete frame follows; otherwise pos was noise
+            int next = findFrame(data, pos + 1, size);
+            if (next < 0) {
+                break;
+            }
+            if (!m_resyncing) {
+                countError();
+            }
+            m_resyncing = true;
+            pos = next;
+            continue;
+        }
+        if (length < 0) {
+            // Count each run of skipped bytes once
+            if (!m_resyncing) {
+                countError();
+                m_resyncing = true;
+            }
+            pos++;
+            continue;
+        }
+
+        records.append(makeRecord(data + pos, length, kind));
+        m_resyncing = false;
+        pos += length;
+    }
+    m_buffer.remove(0, pos);
+}
+
+int ModbusRtuDecoder::findFrame(const unsigned char* data, int from, int size) const
+{
+    Kind kind = Kind::Request;
+    for (int pos = from; pos + MIN_FRAME_SIZE <= size; ++pos) {
+        if (frameLength(data + pos, size - pos, &kind) > 0) {
+            return pos;
+        }
+    }
+    return -1;
+}
+
+int ModbusRtuDecoder::frameLength(const unsigned char* frame, int available, Kind* kind) const
+{
+    if (available < 2) {
+        return 0;
+    }
+    if (frame[0] > MAX_SLAVE_ADDRESS) {
+        return -1;
+    }
+
+    // Candidate lengths, the interpretation preferred for this direction first; -1 until known
+    struct Candidate {
+        Kind kind;
+        int length;
+    };
+    Candidate candidates[2];
+    int count = 0;
+
+    const int function = frame[1];
+    const bool sent = direction() == MessageDirection::Sent;
+    if (function & 0x80) {
+        if (function == 0x80) {
+            return -1;
+        }
+        candidates[count++] = {Kind::Exception, MIN_FRAME_SIZE};
+    } else {
+        switch (function) {
+        case 1:
+        case 2:
+        case 3:
+        case 4: {
+            Candidate request = {Kind::Request, 8};
+            Candidate response = {Kind::Response, available >= 3 ? 5 + frame[2] : -1};
+            candidates[count++] = sent ? request : response;
+            candidates[count++] = sent ? response : request;
+            break;
+        }
+        case 5:
+        case 6:
+            // The response echoes the request
+            candidates[count++] = {sent ? Kind::Request : Kind::Response, 8};
+            break;
+        case 15:
+        case 16: {
+            Candidate request = {Kind::Request, available >= 7 ? 9 + frame[6] : -1};
+            Candidate response = {Kind::Response, 8};
+            candidates[count++] = sent ? request : response;
+            candidates[count++] = sent ? response : request;
+            break;
+        }
+        default:
+            return -1;
+        }
+    }
+
+    bool pending = false;
+    for (int i = 0; i < count; ++i) {
+        const Candidate& candidate = candidates[i];
+        if (candidate.length > MAX_FRAME_SIZE) {
+            continue;
+        }
+        if (candidate.length < 0 || candidate.length > available) {
+            pending = true;
+            continue;
+        }
+        if (crcMatches(frame, candidate.length)) {
+            *kind = candidate.kind;
+            return candidate.length;
+        }
+    }
+    return pending ? 0 : -1;
+}
+
+DecodedRecord ModbusRtuDecoder::makeRecord(const unsigned char* frame, int length, Kind kind) const
+{
+    const int slave = frame[0];
+    const int function = frame[1] & 0x7F;
+
+    static const char* const kindNames[] = {"request", "response", "exception"};
+    DecodedRecord record(QStringLiteral("Modbus RTU"),
+                         QStringLiteral("Slave %1 %2 %3")
+                             .arg(slave)
+                             .arg(functionName(function))
+                             .arg(QLatin1String(kindNames[static_cast<int>(kind)])));
+    record.addField(QStringLiteral("Slave"), QString::number(slave));
+    record.addField(QStringLiteral("Function"), QString::number(function));
+
+    const unsigned char* pdu = frame + 2;
+    const int pduSize = length - 4;
+    if (kind == Kind::Exception) {
+        record.addField(QStringLiteral("Exception"),
+                        QStringLiteral("%1 (%2)").arg(pdu[0]).arg(exceptionName(pdu[0])));
+        return record;
+    }
+
+    switch (function) {
+    case 1:
+    case 2:
+    case 3:
+    case 4:
+        if (kind == Kind::Request) {
+            record.addField(QStringLiteral("Address"), QString::number(readUInt16(pdu)));
+            record.addField(QStringLiteral("Quantity"), QString::number(readUInt16(pdu + 2)));
+        } else {
+            int byteCount = qMin<int>(pdu[0], pduSize - 1);
+            record.addField(QStringLiteral("Byte count"), QString::number(pdu[0]));
+            if (function <= 2) {
+                record.addField(QStringLiteral("Values"), formatBits(pdu + 1, byteCount, byteCount * 8));
+            } else {
+                record.addField(QStringLiteral("Registers"), formatRegisters(pdu + 1, byteCount));
+            }
+        }
+        break;
+    case 5: {
+        quint16 value = readUInt16(pdu + 2);
+        record.addField(QStringLiteral("Address"), QString::number(readUInt16(pdu)));
+        record.addField(QStringLiteral("Value"), value == 0xFF00 ? QStringLiteral("ON")
+                                                 : value == 0x0000 ? QStringLiteral("OFF")
+                                                                   : QString::number(value, 16));
+        break;
+    }
+    case 6:
+        record.addField(QStringLiteral("Address"), QString::number(readUInt16(pdu)));
+        record.addField(QStringLiteral("Value"), QString::number(readUInt16(pdu + 2)));
+        break;
+    case 15:
+    case 16:
+        record.addField(QStringLiteral("Address"), QString::number(readUInt16(pdu)));
+        record.addField(QStringLiteral("Quantity"), QString::number(readUInt16(pdu + 2)));
+        if (kind == Kind::Request) {
+            int byteCount = qMin<int>(pdu[4], pduSize - 5);
+            record.addField(QStringLiteral("Byte count"), QString::number(pdu[4]));
+            if (function == 15) {
+                record.addField(QStringLiteral("Values"), formatBits(pdu + 5, byteCount, readUInt16(pdu + 2)));
+            } else {
+                record.addField(QStringLiteral("Registers"), formatRegisters(pdu + 5, byteCount));
+            }
+        }
+        break;
+    }
+    return record;
+}
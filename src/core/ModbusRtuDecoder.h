@@ -0,0 +1,53 @@
+#ifndef MODBUS_RTU_DECODER_H
+#define MODBUS_RTU_DECODER_H
+
+#include "ProtocolDecoder.h"
+
+/**
+ * @brief Decodes Modbus RTU requests, responses and exceptions
+ *
+ * RTU frames are delimited by line silence, which a byte stream does not
+ * show, so the decoder finds them by their CRC: the function code gives the
+ * possible frame lengths (request, response or exception), and the first
+ * candidate whose CRC-16 checks out is taken. Where request and response
+ * have the same length, direction() decides: sent traffic is read as
+ * requests, received traffic as responses, as seen from a master. Bytes
+ * that cannot start a frame are skipped one at a time until the stream is
+ * back in sync. A frame that is still incomplete is waited for unless a
+ * complete, valid frame already follows it, in which case its first byte
+ * was noise; on framed ports finish() also ends every frame.
+ *
+ * Function codes 1-6, 15 and 16 are decoded; exception responses to any
+ * function are recognised.
+ */
+class ModbusRtuDecoder : public ProtocolDecoder {
+public:
+    explicit ModbusRtuDecoder(MessageDirection direction = MessageDirection::Received);
+
+    DecoderType type() const override { return DecoderType::ModbusRtu; }
+    void reset() override;
+
+    static QString functionName(int function);
+    static QString exceptionName(int code);
+
+protected:
+    void decode(const char* data, qint64 length, QVector<DecodedRecord>& records) override;
+    void decodeFinish(QVector<DecodedRecord>& records) override;
+
+private:
+    enum class Kind {
+        Request,
+        Response,
+        Exception
+    };
+
+    QByteArray m_buffer;
+    bool m_resyncing;
+
+    void decodeBuffer(QVector<DecodedRecord>& records);
+    int frameLength(const unsigned char* frame, int available, Kind* kind) const;
+    int findFrame(const unsigned char* data, int from, int size) const;
+    DecodedRecord makeRecord(const unsigned char* frame, int length, Kind kind) const;
+};
+
+#endif // MODBUS_RTU_DECODER_H
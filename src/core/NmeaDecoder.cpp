@@ -0,0 +1,226 @@
+#include "NmeaDecoder.h"
+#include <QList>
+
+namespace {
+// The standard allows 82 characters including "$" and CR/LF; proprietary sentences run longer
+const int MAX_SENTENCE_LENGTH = 128;
+
+bool isSpecial(char c)
+{
+    return c == '$' || c == '!' || c == '\r' || c == '\n';
+}
+
+QByteArray fieldAt(const QList<QByteArray>& fields, int index)
+{
+    return index < fields.size() ? fields.at(index) : QByteArray();
+}
+
+// "hhmmss.ss" -> "hh:mm:ss.ss"
+QString formatTime(const QByteArray& value)
+{
+    if (value.size() < 6) {
+        return QString::fromLatin1(value);
+    }
+    return QString::fromLatin1(value.left(2) + ':' + value.mid(2, 2) + ':' + value.mid(4));
+}
+
+// "ddmmyy" -> "yyyy-mm-dd"; two-digit years from 80 on are taken as 19xx
+QString formatDate(const QByteArray& value)
+{
+    if (value.size() != 6) {
+        return QString::fromLatin1(value);
+    }
+    QByteArray year = value.mid(4, 2);
+    QByteArray century = year.toInt() >= 80 ? "19" : "20";
+    return QString::fromLatin1(century + year + '-' + value.mid(2, 2) + '-' + value.left(2));
+}
+
+QString withUnit(const QByteArray& value, const QByteArray& unit)
+{
+    if (value.isEmpty()) {
+        return QString();
+    }
+    return QString::fromLatin1(unit.isEmpty() ? value : value + ' ' + unit);
+}
+
+QString sentenceDescription(const QByteArray& type)
+{
+    if (type == "GGA") {
+        return QStringLiteral("Fix data");
+    }
+    if (type == "RMC") {
+        return QStringLiteral("Recommended minimum data");
+    }
+    if (type == "GLL") {
+        return QStringLiteral("Geographic position");
+    }
+    if (type == "VTG") {
+        return QStringLiteral("Course and speed");
+    }
+    if (type == "GSA") {
+        return QStringLiteral("Active satellites");
+    }
+    if (type == "GSV") {
+        return QStringLiteral("Satellites in view");
+    }
+    if (type == "ZDA") {
+        return QStringLiteral("Time and date");
+    }
+    return QString();
+}
+}
+
+NmeaDecoder::NmeaDecoder(MessageDirection direction)
+    : ProtocolDecoder(direction)
+    , m_collecting(false)
+{
+    m_sentence.reserve(MAX_SENTENCE_LENGTH);
+}
+
+void NmeaDecoder::reset()
+{
+    m_sentence.clear();
+    m_collecting = false;
+}
+
+QString NmeaDecoder::formatCoordinate(const QByteArray& value, const QByteArray& hemisphere)
+{
+    // Degrees and minutes: ddmm.mmmm for latitude, dddmm.mmmm for longitude
+    int dot = value.indexOf('.');
+    int degreeDigits = (dot < 0 ? value.size() : dot) - 2;
+    if (degreeDigits < 1) {
+        return QString();
+    }
+    bool degreesOk = false;
+    bool minutesOk = false;
+    double degrees = value.left(degreeDigits).toDouble(&degreesOk);
+    double minutes = value.mid(degreeDigits).toDouble(&minutesOk);
+    if (!degreesOk || !minutesOk) {
+        return QString();
+    }
+    QString text = QString::number(degrees + minutes / 60.0, 'f', 6);
+    if (!hemisphere.isEmpty()) {
+        text += QLatin1Char(' ') + QString::fromLatin1(hemisphere);
+    }
+    return text;
+}
+
+void NmeaDecoder::decode(const char* data, qint64 length, QVector<DecodedRecord>& records)
+{
+    qint64 pos = 0;
+    while (pos < length) {
+        // Copy runs of ordinary characters in one go
+        if (m_collecting) {
+            qint64 run = pos;
+            while (run < length && !isSpecial(data[run])) {
+                run++;
+            }
+            if (run > pos) {
+                if (m_sentence.size() + (run - pos) > MAX_SENTENCE_LENGTH) {
+                    countError();
+                    reset();
+                } else {
+                    m_sentence.append(data + pos, static_cast<int>(run - pos));
+                }
+                pos = run;
+                continue;
+            }
+        }
+
+        char c = data[pos++];
+        if (c == '$' || c == '!') {
+            if (m_collecting) {
+                // The previous sentence was cut off
+                countError();
+            }
+            m_sentence.clear();
+            m_sentence.append(c);
+            m_collecting = true;
+        } else if (c == '\r' || c == '\n') {
+            complete(records);
+        }
+        // Other characters only reach here between sentences and are skipped
+    }
+}
+
+void NmeaDecoder::decodeFinish(QVector<DecodedRecord>& records)
+{
+    complete(records);
+}
+
+void NmeaDecoder::complete(QVector<DecodedRecord>& records)
+{
+    if (m_collecting && m_sentence.size() > 1) {
+        records.append(parse(m_sentence));
+    }
+    reset();
+}
+
+DecodedRecord NmeaDecoder::parse(const QByteArray& sentence) const
+{
+    // Checksum: XOR of everything between the start character and '*'
+    QByteArray body = sentence.mid(1);
+    bool valid = true;
+    int star = body.lastIndexOf('*');
+    if (star >= 0) {
+        quint8 computed = 0;
+        for (int i = 0; i < star; ++i) {
+            computed ^= static_cast<quint8>(body.at(i));
+        }
+        bool ok = false;
+        int expected = body.mid(star + 1, 2).toInt(&ok, 16);
+        valid = ok && expected == computed;
+        body.truncate(star);
+    }
+
+    const QList<QByteArray> fields = body.split(',');
+    const QByteArray address = fields.first();
+
+    // Proprietary sentences: 'P' followed by a manufacturer code
+    bool proprietary = address.startsWith('P');
+    QByteArray talker = proprietary ? QByteArray("P") : address.left(2);
+    QByteArray type = proprietary ? address.mid(1) : address.mid(2);
+
+    QString summary = QString::fromLatin1(address);
+    QString description = proprietary ? QString() : sentenceDescription(type);
+    if (!description.isEmpty()) {
+        summary += QLatin1Char(' ') + description;
+    }
+
+    DecodedRecord record(QStringLiteral("NMEA 0183"), summary);
+    record.setValid(valid);
+    record.addField(QStringLiteral("Talker"), QString::fromLatin1(talker));
+
+    if (!proprietary && type == "GGA") {
+        record.addField(QStringLiteral("Time"), formatTime(fieldAt(fields, 1)));
+        record.addField(QStringLiteral("Latitude"), formatCoordinate(fieldAt(fields, 2), fieldAt(fields, 3)));
+        record.addField(QStringLiteral("Longitude"), formatCoordinate(fieldAt(fields, 4), fieldAt(fields, 5)));
+        record.addField(QStringLiteral("Fix quality"), QString::fromLatin1(fieldAt(fields, 6)));
+        record.addField(QStringLiteral("Satellites"), QString::fromLatin1(fieldAt(fields, 7)));
+        record.addField(QStringLiteral("HDOP"), QString::fromLatin1(fieldAt(fields, 8)));
+        record.addField(QStringLiteral("Altitude"), withUnit(fieldAt(fields, 9), fieldAt(fields, 10)));
+    } else if (!proprietary && type == "RMC") {
+        record.addField(QStringLiteral("Time"), formatTime(fieldAt(fields, 1)));
+        record.addField(QStringLiteral("Status"), QString::fromLatin1(fieldAt(fields, 2)));
+        record.addField(QStringLiteral("Latitude"), formatCoordinate(fieldAt(fields, 3), fieldAt(fields, 4)));
+        record.addField(QStringLiteral("Longitude"), formatCoordinate(fieldAt(fields, 5), fieldAt(fields, 6)));
+        record.addField(QStringLiteral("Speed"), withUnit(fieldAt(fields, 7), "kn"));
+        record.addField(QStringLiteral("Course"), QString::fromLatin1(fieldAt(fields, 8)));
+        record.addField(QStringLiteral("Date"), formatDate(fieldAt(fields, 9)));
+    } else if (!proprietary && type == "GLL") {
+        record.addField(QStringLiteral("Latitude"), formatCoordinate(fieldAt(fields, 1), fieldAt(fields, 2)));
+        record.addField(QStringLiteral("Longitude"), formatCoordinate(fieldAt(fields, 3), fieldAt(fields, 4)));
+        record.addField(QStringLiteral("Time"), formatTime(fieldAt(fields, 5)));
+        record.addField(QStringLiteral("Status"), QString::fromLatin1(fieldAt(fields, 6)));
+    } else if (!proprietary && type == "VTG") {
+        record.addField(QStringLiteral("Course"), QString::fromLatin1(fieldAt(fields, 1)));
+        record.addField(QStringLiteral("Magnetic course"), QString::fromLatin1(fieldAt(fields, 3)));
+        record.addField(QStringLiteral("Speed"), withUnit(fieldAt(fields, 5), "kn"));
+        record.addField(QStringLiteral("Speed over ground"), withUnit(fieldAt(fields, 7), "km/h"));
+    } else {
+        for (int i = 1; i < fields.size(); ++i) {
+            record.addField(QString::number(i), QString::fromLatin1(fields.at(i)));
+        }
+    }
+    return record;
+}
@@ -0,0 +1,41 @@
+#ifndef NMEA_DECODER_H
+#define NMEA_DECODER_H
+
+#include "ProtocolDecoder.h"
+
+/**
+ * @brief Decodes NMEA 0183 sentences
+ *
+ * A sentence starts with '$' (or '!' for encapsulated data such as AIS) and
+ * ends with CR/LF; anything between sentences is skipped. The optional
+ * "*hh" checksum is verified and a mismatch marks the record invalid.
+ * Position, time and speed fields of GGA, RMC, GLL and VTG sentences are
+ * named and converted (coordinates to decimal degrees); other sentences
+ * list their fields by number.
+ *
+ * On framed ports finish() completes a sentence whose line ending was
+ * removed by the framer.
+ */
+class NmeaDecoder : public ProtocolDecoder {
+public:
+    explicit NmeaDecoder(MessageDirection direction = MessageDirection::Received);
+
+    DecoderType type() const override { return DecoderType::Nmea0183; }
+    void reset() override;
+
+    // "4807.038", "N" -> "48.117300 N"; empty if the field is empty or malformed
+    static QString formatCoordinate(const QByteArray& value, const QByteArray& hemisphere);
+
+protected:
+    void decode(const char* data, qint64 length, QVector<DecodedRecord>& records) override;
+    void decodeFinish(QVector<DecodedRecord>& records) override;
+
+private:
+    QByteArray m_sentence;
+    bool m_collecting;
+
+    void complete(QVector<DecodedRecord>& records);
+    DecodedRecord parse(const QByteArray& sentence) const;
+};
+
+#endif // NMEA_DECODER_H
@@ -0,0 +1,114 @@
+#include "PortInventory.h"
+
+#ifdef Q_OS_LINUX
+#include "HotplugWatcher.h"
+#endif
+
+namespace {
+// Rescan period where no hot-plug notification is available
+const int DEFAULT_POLL_INTERVAL_MS = 1000;
+} // namespace
+
+PortDescriptor PortDescriptor::fromSerialPortInfo(const QSerialPortInfo &info) {
+    PortDescriptor port;
+    port.portName = info.portName();
+    port.systemLocation = info.systemLocation();
+    port.description = info.description();
+    port.manufacturer = info.manufacturer();
+    port.serialNumber = info.serialNumber();
+    port.vendorId = info.hasVendorIdentifier() ? info.vendorIdentifier() : 0;
+    port.productId = info.hasProductIdentifier() ? info.productIdentifier() : 0;
+    return port;
+}
+
+PortInventory::PortInventory(QObject *parent)
+    : QObject(parent), m_watcher(nullptr), m_pollTimer(new QTimer(this)), m_stale(false) {
+    m_pollTimer->setInterval(DEFAULT_POLL_INTERVAL_MS);
+    QObject::connect(m_pollTimer, &QTimer::timeout, this, &PortInventory::rescan);
+
+#ifdef Q_OS_LINUX
+    m_watcher = new HotplugWatcher(this);
+    QObject::connect(m_watcher, &HotplugWatcher::devicesChanged, this, &PortInventory::onDevicesChanged);
+    QObject::connect(m_watcher, &HotplugWatcher::overflowed, this, &PortInventory::rescan);
+#endif
+
+    rescan();
+}
+
+PortInventory::~PortInventory() = default;
+
+void PortInventory::rescan() {
+    m_stale = false;
+
+    QMap<QString, PortDescriptor> current;
+    const auto ports = QSerialPortInfo::availablePorts();
+    for (const auto &info : ports) {
+        current.insert(info.portName(), PortDescriptor::fromSerialPortInfo(info));
+    }
+
+    const QStringList known = m_ports.keys();
+    for (const QString &name : known) {
+        if (!current.contains(name)) {
+            m_ports.remove(name);
+            emit portRemoved(name);
+        }
+    }
+    for (auto it = current.constBegin(); it != current.constEnd(); ++it) {
+        bool added = !m_ports.contains(it.key());
+        m_ports.insert(it.key(), it.value());
+        if (added) {
+            emit portAdded(it.value());
+        }
+    }
+}
+
+void PortInventory::setWatching(bool enabled) {
+    if (!enabled) {
+        if (m_watcher) {
+            m_watcher->stop();
+        }
+        m_pollTimer->stop();
+        m_stale = true;
+        return;
+    }
+
+    if (isWatching()) {
+        return;
+    }
+    if (m_watcher && m_watcher->start()) {
+        // Devices may have come and gone while nobody was watching
+        if (m_stale) {
+            rescan();
+        }
+        return;
+    }
+
+    // No hot-plug notification on this system; poll instead
+    m_pollTimer->start();
+}
+
+bool PortInventory::isWatching() const {
+    return (m_watcher && m_watcher->isActive()) || m_pollTimer->isActive();
+}
+
+void PortInventory::onDevicesChanged(const QStringList &names) {
+#ifdef Q_OS_LINUX
+    // Only the devices that changed are looked up
+    for (const QString &name : names) {
+        PortDescriptor port;
+        bool present = m_watcher->probe(name, &port);
+        bool known = m_ports.contains(name);
+        if (present) {
+            m_ports.insert(name, port);
+            if (!known) {
+                emit portAdded(port);
+            }
+        } else if (known) {
+            m_ports.remove(name);
+            emit portRemoved(name);
+        }
+    }
+#else
+    Q_UNUSED(names)
+#endif
+}
@@ -0,0 +1,77 @@
+#ifndef PORT_INVENTORY_H
+#define PORT_INVENTORY_H
+
+#include <QMap>
+#include <QObject>
+#include <QSerialPortInfo>
+#include <QString>
+#include <QTimer>
+
+class HotplugWatcher;
+
+/**
+ * @brief Description of a serial device present on the system
+ */
+struct PortDescriptor {
+    QString portName;
+    QString systemLocation;
+    QString description;
+    QString manufacturer;
+    QString serialNumber;
+    quint16 vendorId = 0;
+    quint16 productId = 0;
+
+    static PortDescriptor fromSerialPortInfo(const QSerialPortInfo &info);
+};
+
+/**
+ * @brief Cached list of the serial devices currently on the system
+ *
+ * The full QSerialPortInfo::availablePorts() scan runs once on construction
+ * and again only when rescan() is called explicitly. After that the cache
+ * is kept up to date incrementally: on Linux a HotplugWatcher reports
+ * device nodes appearing and disappearing in /dev, and only those devices
+ * are looked up in sysfs. Other platforms fall back to periodic rescans.
+ *
+ * Either way, changes are announced one device at a time through
+ * portAdded() and portRemoved(), so consumers never diff whole lists.
+ */
+class PortInventory : public QObject {
+    Q_OBJECT
+
+  public:
+    explicit PortInventory(QObject *parent = nullptr);
+    ~PortInventory() override;
+
+    QList<PortDescriptor> ports() const { return m_ports.values(); }
+    QStringList portNames() const { return m_ports.keys(); }
+    bool contains(const QString &portName) const { return m_ports.contains(portName); }
+    PortDescriptor port(const QString &portName) const { return m_ports.value(portName); }
+
+    // Full scan; announces whatever changed since the cache was last updated
+    void rescan();
+
+    // Hot-plug watching (Linux) or periodic rescans (elsewhere)
+    void setWatching(bool enabled);
+    bool isWatching() const;
+    void setPollInterval(int msec) { m_pollTimer->setInterval(msec); }
+
+  signals:
+    void portAdded(const PortDescriptor &port);
+    void portRemoved(const QString &portName);
+
+  private slots:
+    void onDevicesChanged(const QStringList &names);
+
+  private:
+    QMap<QString, PortDescriptor> m_ports;
+    HotplugWatcher *m_watcher;
+    QTimer *m_pollTimer;
+
+    // Set while nothing watches the system, so the cache may be out of date
+    bool m_stale;
+};
+
+Q_DECLARE_METATYPE(PortDescriptor)
+
+#endif // PORT_INVENTORY_H
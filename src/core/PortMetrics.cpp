@@ -0,0 +1,105 @@
+#include "PortMetrics.h"
+#include <cmath>
+
+namespace {
+const double NS_PER_SECOND = 1e9;
+
+// Time constants of the three averages
+const double ONE_SECOND_WINDOW_NS = 1e9;
+const double TEN_SECONDS_WINDOW_NS = 10e9;
+const double ONE_MINUTE_WINDOW_NS = 60e9;
+
+void decay(std::atomic<double> &average, double rate, double elapsedNs, double windowNs) {
+    double alpha = 1.0 - std::exp(-elapsedNs / windowNs);
+    double value = average.load(std::memory_order_relaxed);
+    average.store(value + alpha * (rate - value), std::memory_order_relaxed);
+}
+} // namespace
+
+RateMeter::RateMeter()
+    : m_lastCount(0), m_lastNs(0), m_seeded(false), m_oneSecond(0.0), m_tenSeconds(0.0), m_oneMinute(0.0) {}
+
+void RateMeter::reset(qint64 count, qint64 nowNs) {
+    m_lastCount = count;
+    m_lastNs = nowNs;
+    m_seeded = false;
+    m_oneSecond.store(0.0, std::memory_order_relaxed);
+    m_tenSeconds.store(0.0, std::memory_order_relaxed);
+    m_oneMinute.store(0.0, std::memory_order_relaxed);
+}
+
+void RateMeter::update(qint64 count, qint64 nowNs) {
+    double elapsed = static_cast<double>(nowNs - m_lastNs);
+    if (elapsed <= 0) {
+        return;
+    }
+
+    double rate = (count - m_lastCount) * NS_PER_SECOND / elapsed;
+    m_lastCount = count;
+    m_lastNs = nowNs;
+
+    if (!m_seeded) {
+        m_seeded = true;
+        m_oneSecond.store(rate, std::memory_order_relaxed);
+        m_tenSeconds.store(rate, std::memory_order_relaxed);
+        m_oneMinute.store(rate, std::memory_order_relaxed);
+        return;
+    }
+    decay(m_oneSecond, rate, elapsed, ONE_SECOND_WINDOW_NS);
+    decay(m_tenSeconds, rate, elapsed, TEN_SECONDS_WINDOW_NS);
+    decay(m_oneMinute, rate, elapsed, ONE_MINUTE_WINDOW_NS);
+}
+
+RateAverages RateMeter::averages() const {
+    RateAverages averages;
+    averages.oneSecond = m_oneSecond.load(std::memory_order_relaxed);
+    averages.tenSeconds = m_tenSeconds.load(std::memory_order_relaxed);
+    averages.oneMinute = m_oneMinute.load(std::memory_order_relaxed);
+    return averages;
+}
+
+PortMetrics::PortMetrics()
+    : m_rxBytes(0), m_txBytes(0), m_rxFrames(0), m_txFrames(0), m_parityErrors(0), m_framingErrors(0),
+      m_overruns(0), m_breaks(0), m_rxQueuePeak(0), m_txQueuePeak(0) {}
+
+void PortMetrics::reset(qint64 nowNs) {
+    for (std::atomic<qint64> *counter : {&m_rxBytes, &m_txBytes, &m_rxFrames, &m_txFrames, &m_parityErrors,
+                                         &m_framingErrors, &m_overruns, &m_breaks, &m_rxQueuePeak, &m_txQueuePeak}) {
+        counter->store(0, std::memory_order_relaxed);
+    }
+    m_rxByteRate.reset(0, nowNs);
+    m_txByteRate.reset(0, nowNs);
+    m_rxFrameRate.reset(0, nowNs);
+    m_txFrameRate.reset(0, nowNs);
+}
+
+void PortMetrics::setLineErrors(const LineErrorCounts &counts) {
+    m_parityErrors.store(counts.parity, std::memory_order_relaxed);
+    m_framingErrors.store(counts.framing, std::memory_order_relaxed);
+    m_overruns.store(counts.overrun, std::memory_order_relaxed);
+    m_breaks.store(counts.breaks, std::memory_order_relaxed);
+}
+
+void PortMetrics::sample(qint64 nowNs) {
+    m_rxByteRate.update(load(m_rxBytes), nowNs);
+    m_txByteRate.update(load(m_txBytes), nowNs);
+    m_rxFrameRate.update(load(m_rxFrames), nowNs);
+    m_txFrameRate.update(load(m_txFrames), nowNs);
+}
+
+void PortMetrics::snapshot(PortMetricsSnapshot *snapshot) const {
+    snapshot->rxBytes = load(m_rxBytes);
+    snapshot->txBytes = load(m_txBytes);
+    snapshot->rxFrames = load(m_rxFrames);
+    snapshot->txFrames = load(m_txFrames);
+    snapshot->lineErrors.parity = load(m_parityErrors);
+    snapshot->lineErrors.framing = load(m_framingErrors);
+    snapshot->lineErrors.overrun = load(m_overruns);
+    snapshot->lineErrors.breaks = load(m_breaks);
+    snapshot->rxQueuePeak = load(m_rxQueuePeak);
+    snapshot->txQueuePeak = load(m_txQueuePeak);
+    snapshot->rxByteRate = m_rxByteRate.averages();
+    snapshot->txByteRate = m_txByteRate.averages();
+    snapshot->rxFrameRate = m_rxFrameRate.averages();
+    snapshot->txFrameRate = m_txFrameRate.averages();
+}
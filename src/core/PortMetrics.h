@@ -0,0 +1,136 @@
+#ifndef PORT_METRICS_H
+#define PORT_METRICS_H
+
+#include "PortTransport.h"
+#include "SerialPortInfo.h"
+#include <QList>
+#include <QString>
+#include <atomic>
+
+/**
+ * @brief Exponentially weighted moving averages of a rate, per second
+ */
+struct RateAverages {
+    double oneSecond = 0.0;
+    double tenSeconds = 0.0;
+    double oneMinute = 0.0;
+};
+
+/**
+ * @brief Turns a growing counter into 1 s, 10 s and 60 s average rates
+ *
+ * update() is called periodically by the single writer with the counter's
+ * current value. Each average moves towards the rate seen since the last
+ * update by 1 - exp(-dt / window), so uneven sampling intervals are
+ * weighted correctly. The first update after reset() seeds all three
+ * averages. averages() may be read from any thread.
+ */
+class RateMeter {
+  public:
+    RateMeter();
+
+    void reset(qint64 count, qint64 nowNs);
+    void update(qint64 count, qint64 nowNs);
+    RateAverages averages() const;
+
+  private:
+    qint64 m_lastCount;
+    qint64 m_lastNs;
+    bool m_seeded;
+    std::atomic<double> m_oneSecond;
+    std::atomic<double> m_tenSeconds;
+    std::atomic<double> m_oneMinute;
+};
+
+/**
+ * @brief Point-in-time copy of a port's traffic metrics
+ */
+struct PortMetricsSnapshot {
+    QString portName;
+    PortStatus status = PortStatus::Offline;
+
+    // Totals since the port was opened; a reconnect does not reset them
+    qint64 rxBytes = 0;
+    qint64 txBytes = 0;
+    qint64 rxFrames = 0;
+    qint64 txFrames = 0;
+    LineErrorCounts lineErrors;
+    qint64 rxDroppedBytes = 0;
+
+    // Messages waiting for the consumer and payloads waiting to be written
+    qint64 rxQueueDepth = 0;
+    qint64 rxQueuePeak = 0;
+    qint64 txQueueDepth = 0;
+    qint64 txQueuePeak = 0;
+
+    // Per second
+    RateAverages rxByteRate;
+    RateAverages txByteRate;
+    RateAverages rxFrameRate;
+    RateAverages txFrameRate;
+
+    // Filled in by SerialPortUser from its AutoResponder
+    qint64 autoReplies = 0;
+    qint64 autoReplyP50Ns = 0;
+    qint64 autoReplyP99Ns = 0;
+};
+
+/**
+ * @brief Traffic counters of one port
+ *
+ * Written only by the port's SerialPortWorker on its I/O thread and read by
+ * snapshot() from any other thread. Every field is an atomic updated with a
+ * relaxed load and store, which costs the same as a plain increment: with a
+ * single writer there is no read-modify-write to protect, and readers only
+ * need each value to be untorn, not consistent with the others.
+ *
+ * Rates are derived by sample(), which the worker calls on a timer, so the
+ * hot path never does more than an addition.
+ */
+class PortMetrics {
+  public:
+    PortMetrics();
+
+    // Writer side
+    void reset(qint64 nowNs);
+    void countReceived(qint64 bytes) { add(m_rxBytes, bytes); }
+    void countSent(qint64 bytes) { add(m_txBytes, bytes); }
+    void countReceivedFrame() { add(m_rxFrames, 1); }
+    void countSentFrame() { add(m_txFrames, 1); }
+    void setLineErrors(const LineErrorCounts &counts);
+    void recordReceiveQueue(qint64 depth) { raise(m_rxQueuePeak, depth); }
+    void recordTransmitQueue(qint64 depth) { raise(m_txQueuePeak, depth); }
+    void sample(qint64 nowNs);
+
+    // Reader side; fills the counters, peaks and rates and leaves the other fields alone
+    void snapshot(PortMetricsSnapshot *snapshot) const;
+
+  private:
+    std::atomic<qint64> m_rxBytes;
+    std::atomic<qint64> m_txBytes;
+    std::atomic<qint64> m_rxFrames;
+    std::atomic<qint64> m_txFrames;
+    std::atomic<qint64> m_parityErrors;
+    std::atomic<qint64> m_framingErrors;
+    std::atomic<qint64> m_overruns;
+    std::atomic<qint64> m_breaks;
+    std::atomic<qint64> m_rxQueuePeak;
+    std::atomic<qint64> m_txQueuePeak;
+
+    RateMeter m_rxByteRate;
+    RateMeter m_txByteRate;
+    RateMeter m_rxFrameRate;
+    RateMeter m_txFrameRate;
+
+    static qint64 load(const std::atomic<qint64> &value) { return value.load(std::memory_order_relaxed); }
+    static void add(std::atomic<qint64> &counter, qint64 n) {
+        counter.store(load(counter) + n, std::memory_order_relaxed);
+    }
+    static void raise(std::atomic<qint64> &peak, qint64 value) {
+        if (value > load(peak)) {
+            peak.store(value, std::memory_order_relaxed);
+        }
+    }
+};
+
+#endif // PORT_METRICS_H
@@ -0,0 +1,60 @@
+#include "PortTransport.h"
+#include "QSerialPortTransport.h"
+#include "Rfc2217Transport.h"
+#include "TcpTransport.h"
+#include "UdpTransport.h"
+#include "UnixSocketTransport.h"
+
+#ifdef Q_OS_LINUX
+#include "PtyTransport.h"
+#include "TermiosTransport.h"
+#include <linux/serial.h>
+#include <sys/ioctl.h>
+#endif
+
+PortTransport *PortTransport::create(TransportType type, QObject *parent) {
+    switch (type) {
+    case TransportType::QtSerialPort:
+        return new QSerialPortTransport(parent);
+    case TransportType::Termios:
+#ifdef Q_OS_LINUX
+        return new TermiosTransport(parent);
+#else
+        return nullptr;
+#endif
+    case TransportType::Pty:
+#ifdef Q_OS_LINUX
+        return new PtyTransport(parent);
+#else
+        return nullptr;
+#endif
+    case TransportType::Tcp:
+        return new TcpTransport(parent);
+    case TransportType::Rfc2217:
+        return new Rfc2217Transport(parent);
+    case TransportType::Udp:
+        return new UdpTransport(parent);
+    case TransportType::UnixSocket:
+        return new UnixSocketTransport(parent);
+    }
+    return nullptr;
+}
+
+bool PortTransport::readLineErrors(int fd, LineErrorCounts *counts) {
+#ifdef Q_OS_LINUX
+    // Ptys and most USB CDC devices do not keep counters and fail here
+    struct serial_icounter_struct icount = {};
+    if (fd < 0 || ::ioctl(fd, TIOCGICOUNT, &icount) != 0) {
+        return false;
+    }
+    counts->parity = icount.parity;
+    counts->framing = icount.frame;
+    counts->overrun = icount.overrun + icount.buf_overrun;
+    counts->breaks = icount.brk;
+    return true;
+#else
+    Q_UNUSED(fd)
+    Q_UNUSED(counts)
+    return false;
+#endif
+}
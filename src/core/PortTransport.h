@@ -0,0 +1,97 @@
+#ifndef PORT_TRANSPORT_H
+#define PORT_TRANSPORT_H
+
+#include "SerialPortInfo.h"
+#include <QObject>
+#include <QString>
+
+/**
+ * @brief Receive errors counted by the serial driver
+ */
+struct LineErrorCounts {
+    qint64 parity = 0;
+    qint64 framing = 0;
+    qint64 overrun = 0; // UART FIFO and driver buffer overruns
+    qint64 breaks = 0;
+
+    LineErrorCounts operator+(const LineErrorCounts &other) const {
+        return {parity + other.parity, framing + other.framing, overrun + other.overrun, breaks + other.breaks};
+    }
+    LineErrorCounts operator-(const LineErrorCounts &other) const {
+        return {parity - other.parity, framing - other.framing, overrun - other.overrun, breaks - other.breaks};
+    }
+};
+
+/**
+ * @brief Byte stream backend used by SerialPortWorker
+ *
+ * A transport moves raw bytes to and from one device. It lives on the
+ * worker's I/O thread and reports activity through signals, mirroring the
+ * parts of QIODevice the worker relies on:
+ * - readyRead() when new data can be read with read()
+ * - bytesWritten() once written data has been handed to the device; never
+ *   emitted from inside write()
+ * - errorOccurred() for I/O errors; fatal errors mean the device is gone
+ *   and the transport has closed itself
+ *
+ * The worker opens a transport with openAsync(), which reports through
+ * openFinished(). Backends that open at once only implement open(); those
+ * that wait for a remote end override openAsync() so the I/O thread keeps
+ * serving its other ports meanwhile. close() cancels a pending open without
+ * emitting openFinished().
+ *
+ * Use create() to obtain the backend selected by SerialPortInfo::transport().
+ */
+class PortTransport : public QObject {
+    Q_OBJECT
+
+  public:
+    explicit PortTransport(QObject *parent = nullptr) : QObject(parent) {}
+    ~PortTransport() override = default;
+
+    static PortTransport *create(TransportType type, QObject *parent = nullptr);
+
+    virtual TransportType type() const = 0;
+
+    // Opens the device without waiting on it; used by the default openAsync()
+    virtual bool open(const SerialPortInfo &info) {
+        Q_UNUSED(info)
+        return false;
+    }
+    // openFinished() may be emitted before this returns
+    virtual void openAsync(const SerialPortInfo &info) { emit openFinished(open(info)); }
+    virtual void close() = 0;
+    virtual bool isOpen() const = 0;
+    virtual QString errorString() const = 0;
+
+    virtual qint64 bytesAvailable() const = 0;
+    virtual qint64 read(char *data, qint64 maxSize) = 0;
+
+    virtual qint64 write(const char *data, qint64 size) = 0;
+    virtual qint64 bytesToWrite() const = 0;
+
+    // Upper bound for data the backend buffers internally before read()
+    virtual void setReadBufferSize(qint64 size) { Q_UNUSED(size) }
+
+    // Whether every write() goes out as one datagram; the worker then neither
+    // merges nor splits payloads
+    virtual bool isDatagram() const { return false; }
+
+    // Device the other side should open, for loopback backends; empty otherwise
+    virtual QString peerName() const { return QString(); }
+
+    // Receive errors since open(); zero where the backend cannot tell
+    virtual LineErrorCounts lineErrors() const { return LineErrorCounts(); }
+
+  signals:
+    void openFinished(bool ok);
+    void readyRead();
+    void bytesWritten(qint64 bytes);
+    void errorOccurred(const QString &error, bool fatal);
+
+  protected:
+    // Reads the kernel's error counters of a tty (TIOCGICOUNT); Linux only
+    static bool readLineErrors(int fd, LineErrorCounts *counts);
+};
+
+#endif // PORT_TRANSPORT_H
@@ -0,0 +1,65 @@
+#include "ProtocolDecoder.h"
+#include "ModbusRtuDecoder.h"
+#include "NmeaDecoder.h"
+#include "SlipDecoder.h"
+
+ProtocolDecoder::ProtocolDecoder(MessageDirection direction)
+    : m_direction(direction)
+    , m_recordCount(0)
+    , m_errorCount(0)
+{
+}
+
+ProtocolDecoder::~ProtocolDecoder()
+{
+}
+
+ProtocolDecoder* ProtocolDecoder::create(DecoderType type, MessageDirection direction)
+{
+    switch (type) {
+    case DecoderType::None:
+        return nullptr;
+    case DecoderType::ModbusRtu:
+        return new ModbusRtuDecoder(direction);
+    case DecoderType::Nmea0183:
+        return new NmeaDecoder(direction);
+    case DecoderType::Slip:
+        return new SlipDecoder(direction);
+    }
+    return nullptr;
+}
+
+QString ProtocolDecoder::name(DecoderType type)
+{
+    switch (type) {
+    case DecoderType::None:
+        return QStringLiteral("None");
+    case DecoderType::ModbusRtu:
+        return QStringLiteral("Modbus RTU");
+    case DecoderType::Nmea0183:
+        return QStringLiteral("NMEA 0183");
+    case DecoderType::Slip:
+        return QStringLiteral("SLIP");
+    }
+    return QString();
+}
+
+int ProtocolDecoder::feed(const char* data, qint64 length, QVector<DecodedRecord>& records)
+{
+    if (!data || length <= 0) {
+        return 0;
+    }
+
+    int before = records.size();
+    decode(data, length, records);
+    m_recordCount += records.size() - before;
+    return records.size() - before;
+}
+
+int ProtocolDecoder::finish(QVector<DecodedRecord>& records)
+{
+    int before = records.size();
+    decodeFinish(records);
+    m_recordCount += records.size() - before;
+    return records.size() - before;
+}
@@ -0,0 +1,66 @@
+#ifndef PROTOCOL_DECODER_H
+#define PROTOCOL_DECODER_H
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+#include "DecodedRecord.h"
+#include "Message.h"
+
+/**
+ * @brief Incremental decoder that turns a byte stream into DecodedRecords
+ *
+ * Like StreamFramer, a decoder is fed bytes in arbitrary chunks and keeps
+ * its state across calls, so a protocol unit split over several reads is
+ * decoded once its last byte arrives and every record completed by a chunk
+ * is appended to the caller's output vector. Nothing is ever decoded twice.
+ *
+ * finish() tells the decoder that a frame boundary is known (the port's
+ * framing ended a frame): a unit that can be completed is, the rest of the
+ * partial input is discarded.
+ *
+ * Each SerialPortWorker runs one decoder per direction on its I/O thread,
+ * selected by SerialPortInfo::decoder(); direction() tells a decoder whose
+ * traffic it sees, which some protocols need to tell requests from replies.
+ * Use create() to obtain the decoder for a DecoderType.
+ */
+class ProtocolDecoder {
+public:
+    explicit ProtocolDecoder(MessageDirection direction);
+    virtual ~ProtocolDecoder();
+
+    // nullptr for DecoderType::None
+    static ProtocolDecoder* create(DecoderType type, MessageDirection direction);
+    static QString name(DecoderType type);
+
+    virtual DecoderType type() const = 0;
+    MessageDirection direction() const { return m_direction; }
+
+    // Feed bytes; returns the number of records appended to records
+    int feed(const char* data, qint64 length, QVector<DecodedRecord>& records);
+    int feed(const QByteArray& data, QVector<DecodedRecord>& records) { return feed(data.constData(), data.size(), records); }
+
+    // End of a frame; returns the number of records appended to records
+    int finish(QVector<DecodedRecord>& records);
+
+    // Discard partial input
+    virtual void reset() = 0;
+
+    // Statistics
+    qint64 recordCount() const { return m_recordCount; }
+    qint64 errorCount() const { return m_errorCount; }
+
+protected:
+    virtual void decode(const char* data, qint64 length, QVector<DecodedRecord>& records) = 0;
+    virtual void decodeFinish(QVector<DecodedRecord>& records) = 0;
+
+    // Input that could not be decoded (resynchronisation, overlong unit)
+    void countError() { m_errorCount++; }
+
+private:
+    MessageDirection m_direction;
+    qint64 m_recordCount;
+    qint64 m_errorCount;
+};
+
+#endif // PROTOCOL_DECODER_H
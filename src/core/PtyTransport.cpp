@@ -0,0 +1,62 @@
+#include "PtyTransport.h"
+#include <fcntl.h>
+#include <pty.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+// <pty.h> pulls in glibc's <termios.h>, so this file must not include
+// <asm/termbits.h>; all line settings are applied by TermiosTransport.
+
+namespace {
+// Enough for /dev/pts/NNNNN
+const int PTS_NAME_SIZE = 64;
+} // namespace
+
+PtyTransport::PtyTransport(QObject *parent) : TermiosTransport(parent), m_slaveFd(-1) {}
+
+PtyTransport::~PtyTransport() { close(); }
+
+bool PtyTransport::open(const SerialPortInfo &info) {
+    if (isOpen()) {
+        return true;
+    }
+
+    int master = -1;
+    if (::openpty(&master, &m_slaveFd, nullptr, nullptr, nullptr) != 0) {
+        setSystemError(QStringLiteral("Cannot create pseudo terminal"));
+        m_slaveFd = -1;
+        return false;
+    }
+
+    char name[PTS_NAME_SIZE] = {};
+    if (::ptsname_r(master, name, sizeof(name)) != 0 || ::fcntl(master, F_SETFL, O_NONBLOCK) != 0) {
+        setSystemError(QStringLiteral("Cannot set up pseudo terminal"));
+        ::close(master);
+        ::close(m_slaveFd);
+        m_slaveFd = -1;
+        return false;
+    }
+    ::fcntl(master, F_SETFD, FD_CLOEXEC);
+    ::fcntl(m_slaveFd, F_SETFD, FD_CLOEXEC);
+
+    // Line settings of a pty live on the slave; applying them through the
+    // master puts the peer side into raw mode as well
+    if (!attach(master, info)) {
+        ::close(m_slaveFd);
+        m_slaveFd = -1;
+        return false;
+    }
+
+    m_peerName = QString::fromLocal8Bit(name);
+    return true;
+}
+
+void PtyTransport::close() {
+    TermiosTransport::close();
+
+    if (m_slaveFd >= 0) {
+        ::close(m_slaveFd);
+        m_slaveFd = -1;
+    }
+    m_peerName.clear();
+}
@@ -0,0 +1,38 @@
+#ifndef PTY_TRANSPORT_H
+#define PTY_TRANSPORT_H
+
+#include "TermiosTransport.h"
+
+/**
+ * @brief Loopback backend on a freshly created pseudo terminal pair
+ *
+ * open() creates a pty with openpty() and drives the master side with the
+ * same epoll-based I/O as TermiosTransport. The slave device, reported by
+ * peerName() (e.g. /dev/pts/7), plays the part of the serial device: a
+ * test, benchmark or simulator opens it and whatever it writes shows up
+ * as received data on this port.
+ *
+ * The port name in SerialPortInfo is only a label; every open() creates a
+ * new pair. The slave is kept open internally so the master does not see
+ * a hang-up while no peer is attached. Linux only.
+ */
+class PtyTransport : public TermiosTransport {
+    Q_OBJECT
+
+  public:
+    explicit PtyTransport(QObject *parent = nullptr);
+    ~PtyTransport() override;
+
+    TransportType type() const override { return TransportType::Pty; }
+
+    bool open(const SerialPortInfo &info) override;
+    void close() override;
+
+    QString peerName() const override { return m_peerName; }
+
+  private:
+    int m_slaveFd;
+    QString m_peerName;
+};
+
+#endif // PTY_TRANSPORT_H
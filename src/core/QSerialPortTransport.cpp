@@ -0,0 +1,59 @@
+#include "QSerialPortTransport.h"
+
+QSerialPortTransport::QSerialPortTransport(QObject *parent)
+    : PortTransport(parent), m_port(new QSerialPort(this)), m_opening(false) {
+    QObject::connect(m_port, &QSerialPort::readyRead, this, &PortTransport::readyRead);
+    QObject::connect(m_port, &QSerialPort::bytesWritten, this, &PortTransport::bytesWritten);
+    QObject::connect(m_port, &QSerialPort::errorOccurred, this, &QSerialPortTransport::onErrorOccurred);
+}
+
+bool QSerialPortTransport::open(const SerialPortInfo &info) {
+    if (m_port->isOpen()) {
+        return true;
+    }
+
+    info.applyToPort(m_port);
+
+    // Open failures are reported through the return value, not errorOccurred()
+    m_opening = true;
+    bool ok = m_port->open(QIODevice::ReadWrite);
+    m_opening = false;
+
+    m_lineErrorBase = LineErrorCounts();
+#ifdef Q_OS_UNIX
+    if (ok) {
+        readLineErrors(static_cast<int>(m_port->handle()), &m_lineErrorBase);
+    }
+#endif
+    return ok;
+}
+
+void QSerialPortTransport::close() {
+    if (m_port->isOpen()) {
+        m_port->close();
+    }
+}
+
+LineErrorCounts QSerialPortTransport::lineErrors() const {
+    LineErrorCounts counts;
+#ifdef Q_OS_UNIX
+    if (!m_port->isOpen() || !readLineErrors(static_cast<int>(m_port->handle()), &counts)) {
+        return LineErrorCounts();
+    }
+#endif
+    return counts - m_lineErrorBase;
+}
+
+void QSerialPortTransport::onErrorOccurred(QSerialPort::SerialPortError error) {
+    if (error == QSerialPort::NoError || m_opening) {
+        return;
+    }
+
+    // Device was removed
+    bool fatal = error == QSerialPort::ResourceError;
+    if (fatal) {
+        close();
+    }
+
+    emit errorOccurred(m_port->errorString(), fatal);
+}
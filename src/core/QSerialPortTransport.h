@@ -0,0 +1,44 @@
+#ifndef QSERIAL_PORT_TRANSPORT_H
+#define QSERIAL_PORT_TRANSPORT_H
+
+#include "PortTransport.h"
+#include <QSerialPort>
+
+/**
+ * @brief PortTransport backed by QSerialPort; available on every platform
+ */
+class QSerialPortTransport : public PortTransport {
+    Q_OBJECT
+
+  public:
+    explicit QSerialPortTransport(QObject *parent = nullptr);
+
+    TransportType type() const override { return TransportType::QtSerialPort; }
+
+    bool open(const SerialPortInfo &info) override;
+    void close() override;
+    bool isOpen() const override { return m_port->isOpen(); }
+    QString errorString() const override { return m_port->errorString(); }
+
+    qint64 bytesAvailable() const override { return m_port->bytesAvailable(); }
+    qint64 read(char *data, qint64 maxSize) override { return m_port->read(data, maxSize); }
+
+    qint64 write(const char *data, qint64 size) override { return m_port->write(data, size); }
+    qint64 bytesToWrite() const override { return m_port->bytesToWrite(); }
+
+    void setReadBufferSize(qint64 size) override { m_port->setReadBufferSize(size); }
+
+    LineErrorCounts lineErrors() const override;
+
+  private slots:
+    void onErrorOccurred(QSerialPort::SerialPortError error);
+
+  private:
+    QSerialPort *m_port;
+    bool m_opening;
+
+    // Driver counters at open(); the kernel counts from device initialization
+    LineErrorCounts m_lineErrorBase;
+};
+
+#endif // QSERIAL_PORT_TRANSPORT_H
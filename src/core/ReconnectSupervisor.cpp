@@ -0,0 +1,151 @@
+#include "ReconnectSupervisor.h"
+#include "SerialPortUser.h"
+#include <QRandomGenerator>
+
+namespace {
+// First retry; short enough to ride out a USB re-enumeration unnoticed
+const int DEFAULT_INITIAL_DELAY_MS = 250;
+
+// Upper bound for the doubled delay
+const int DEFAULT_MAX_DELAY_MS = 30000;
+
+// Each delay is moved randomly by up to this fraction either way
+const double DEFAULT_JITTER = 0.25;
+} // namespace
+
+ReconnectSupervisor::ReconnectSupervisor(SerialPortUser *user)
+    : QObject(user), m_user(user), m_retryTimer(new QTimer(this)), m_initialDelayMs(DEFAULT_INITIAL_DELAY_MS),
+      m_maxDelayMs(DEFAULT_MAX_DELAY_MS), m_jitter(DEFAULT_JITTER), m_devicePresent(true), m_attempting(false),
+      m_attempts(0), m_backoffStep(0), m_reconnectCount(0), m_totalDowntimeMs(0) {
+    m_retryTimer->setSingleShot(true);
+    QObject::connect(m_retryTimer, &QTimer::timeout, this, &ReconnectSupervisor::attempt);
+    QObject::connect(user, &SerialPortUser::connectionLost, this, &ReconnectSupervisor::onConnectionLost);
+    QObject::connect(user, &SerialPortUser::statusChanged, this, &ReconnectSupervisor::onStatusChanged);
+    QObject::connect(user, &SerialPortUser::connectFinished, this, &ReconnectSupervisor::onConnectFinished);
+}
+
+void ReconnectSupervisor::setBackoff(int initialDelayMs, int maxDelayMs) {
+    m_initialDelayMs = qMax(1, initialDelayMs);
+    m_maxDelayMs = qMax(m_initialDelayMs, maxDelayMs);
+}
+
+void ReconnectSupervisor::setJitter(double fraction) { m_jitter = qBound(0.0, fraction, 1.0); }
+
+int ReconnectSupervisor::backoffDelayMs(int attempt) const {
+    qint64 delay = m_initialDelayMs;
+    for (int i = 1; i < attempt && delay < m_maxDelayMs; ++i) {
+        delay *= 2;
+    }
+    return static_cast<int>(qMin<qint64>(delay, m_maxDelayMs));
+}
+
+void ReconnectSupervisor::deviceAdded() {
+    m_devicePresent = true;
+    if (!isRetrying()) {
+        return;
+    }
+
+    // The device is back: try now and start the backoff over if that fails
+    m_retryTimer->stop();
+    m_backoffStep = 0;
+    if (!m_attempting) {
+        attempt();
+    }
+}
+
+void ReconnectSupervisor::deviceRemoved() {
+    // Nothing to open until deviceAdded()
+    m_devicePresent = false;
+    m_retryTimer->stop();
+}
+
+void ReconnectSupervisor::cancel() {
+    m_retryTimer->stop();
+    if (isRetrying()) {
+        m_totalDowntimeMs += m_outage.elapsed();
+        m_outage.invalidate();
+    }
+}
+
+void ReconnectSupervisor::onConnectionLost() {
+    if (isRetrying()) {
+        return;
+    }
+
+    m_outage.start();
+    m_attempts = 0;
+    m_backoffStep = 0;
+    scheduleRetry();
+}
+
+void ReconnectSupervisor::onStatusChanged() {
+    if (!isRetrying()) {
+        return;
+    }
+
+    PortStatus status = m_user->status();
+    if (status == PortStatus::Online) {
+        // By our attempt or by hand
+        finishOutage();
+    } else if (status != PortStatus::Reconnecting) {
+        // Disconnected by hand
+        cancel();
+    }
+}
+
+void ReconnectSupervisor::attempt() {
+    if (!isRetrying()) {
+        return;
+    }
+
+    // May finish before connectAsync() returns
+    m_attempts++;
+    m_attempting = true;
+    m_user->connectAsync();
+}
+
+void ReconnectSupervisor::onConnectFinished() {
+    // Also reports opens we did not start; those only count through onStatusChanged()
+    if (!m_attempting) {
+        return;
+    }
+    m_attempting = false;
+    if (!isRetrying()) {
+        // Back online or disconnected by hand; onStatusChanged() has handled it
+        return;
+    }
+
+    if (m_user->isOnline()) {
+        finishOutage();
+    } else if (m_user->status() == PortStatus::Reconnecting) {
+        scheduleRetry();
+    } else {
+        cancel();
+    }
+}
+
+void ReconnectSupervisor::scheduleRetry() {
+    if (!m_devicePresent) {
+        return;
+    }
+
+    m_backoffStep++;
+    int delay = backoffDelayMs(m_backoffStep);
+    int spread = static_cast<int>(delay * m_jitter);
+    if (spread > 0) {
+        delay += QRandomGenerator::global()->bounded(-spread, spread + 1);
+    }
+    delay = qMax(1, delay);
+
+    m_retryTimer->start(delay);
+    emit retryScheduled(m_attempts + 1, delay);
+}
+
+void ReconnectSupervisor::finishOutage() {
+    m_retryTimer->stop();
+    qint64 downtime = m_outage.elapsed();
+    m_totalDowntimeMs += downtime;
+    m_outage.invalidate();
+    m_reconnectCount++;
+    emit reconnected(m_attempts, downtime);
+}
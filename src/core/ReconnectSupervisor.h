@@ -0,0 +1,92 @@
+#ifndef RECONNECT_SUPERVISOR_H
+#define RECONNECT_SUPERVISOR_H
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QTimer>
+
+class SerialPortUser;
+
+/**
+ * @brief Reopens a SerialPortUser after its connection was lost
+ *
+ * SerialPortUser announces a lost connection through connectionLost() when
+ * SerialPortInfo::autoReconnect() is set. The supervisor then retries with
+ * exponential backoff: the first attempt follows after a short delay, each
+ * failed attempt doubles it up to a cap, and every delay is spread by a
+ * random jitter so a rack of adapters dropping off the same hub does not
+ * come back in lockstep.
+ *
+ * Device hot-plug events take priority over the timer. While the device is
+ * known to be unplugged (deviceRemoved()) no attempts are made at all; when
+ * it comes back (deviceAdded()) the backoff is reset and the port is opened
+ * right away. Ports without hot-plug events (network, loopback) rely on the
+ * timer alone.
+ *
+ * Attempts open the port with connectAsync() and are judged when
+ * connectFinished() arrives, so an unreachable network endpoint neither
+ * blocks the caller nor the other ports on the I/O thread.
+ *
+ * Retrying stops when the port is back online or the user disconnects it.
+ * The number of successful reconnects and the accumulated downtime are kept
+ * for the life of the supervisor.
+ */
+class ReconnectSupervisor : public QObject {
+    Q_OBJECT
+
+  public:
+    explicit ReconnectSupervisor(SerialPortUser *user);
+
+    // Backoff parameters; the delay before attempt n is initial * 2^(n-1), capped at max
+    void setBackoff(int initialDelayMs, int maxDelayMs);
+    void setJitter(double fraction);
+    int initialDelayMs() const { return m_initialDelayMs; }
+    int maxDelayMs() const { return m_maxDelayMs; }
+
+    // Delay before the given attempt (1-based), without jitter
+    int backoffDelayMs(int attempt) const;
+
+    // Current outage
+    bool isRetrying() const { return m_outage.isValid(); }
+    bool isDevicePresent() const { return m_devicePresent; }
+    int attempts() const { return m_attempts; }
+    qint64 currentDowntimeMs() const { return m_outage.isValid() ? m_outage.elapsed() : 0; }
+
+    // Totals
+    int reconnectCount() const { return m_reconnectCount; }
+    qint64 totalDowntimeMs() const { return m_totalDowntimeMs + currentDowntimeMs(); }
+
+  public slots:
+    void deviceAdded();
+    void deviceRemoved();
+    void cancel();
+
+  signals:
+    void retryScheduled(int attempt, int delayMs);
+    void reconnected(int attempts, qint64 downtimeMs);
+
+  private slots:
+    void onConnectionLost();
+    void onStatusChanged();
+    void onConnectFinished();
+    void attempt();
+
+  private:
+    SerialPortUser *m_user;
+    QTimer *m_retryTimer;
+    QElapsedTimer m_outage;
+    int m_initialDelayMs;
+    int m_maxDelayMs;
+    double m_jitter;
+    bool m_devicePresent;
+    bool m_attempting;
+    int m_attempts;
+    int m_backoffStep;
+    int m_reconnectCount;
+    qint64 m_totalDowntimeMs;
+
+    void scheduleRetry();
+    void finishOutage();
+};
+
+#endif // RECONNECT_SUPERVISOR_H
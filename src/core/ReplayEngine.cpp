@@ -0,0 +1,223 @@
+#include "ReplayEngine.h"
+#include "SerialPortManager.h"
+#include "TimeUtils.h"
+#include <cmath>
+
+namespace {
+const qint64 NS_PER_MS = 1000000;
+
+// Time a single event loop pass may spend sending due writes
+const qint64 MAX_PASS_NS = 5 * NS_PER_MS;
+
+// Wait before trying again when the transmit queue is full
+const int QUEUE_FULL_RETRY_MS = 1;
+
+const int PROGRESS_INTERVAL_MS = 100;
+
+const double MIN_SPEED = 0.01;
+const double MAX_SPEED = 1000.0;
+
+QString formatMs(qint64 ns) { return QString::number(ns / 1e6, 'f', 2); }
+} // namespace
+
+QString ReplayReport::summary() const {
+    QString text = QObject::tr("%1 messages, %2 writes, %3 bytes in %4 ms")
+                       .arg(messageCount)
+                       .arg(writeCount)
+                       .arg(byteCount)
+                       .arg(formatMs(actualDurationNs));
+    if (lateness.count() > 0) {
+        text += QObject::tr(" (target %1 ms, drift %2 ms); lateness p50 %3 ms, p99 %4 ms, max %5 ms")
+                    .arg(formatMs(targetDurationNs))
+                    .arg(formatMs(endDriftNs))
+                    .arg(formatMs(lateness.percentile(50)))
+                    .arg(formatMs(lateness.percentile(99)))
+                    .arg(formatMs(lateness.max()));
+    }
+    if (queueFullCount > 0) {
+        text += QObject::tr("; waited for the transmit queue %1 times").arg(queueFullCount);
+    }
+    if (!error.isEmpty()) {
+        text += QStringLiteral("; ") + error;
+    }
+    return text;
+}
+
+ReplayEngine::ReplayEngine(SerialPortManager *manager, QObject *parent)
+    : QObject(parent), m_manager(manager), m_running(false), m_timer(new QTimer(this)), m_next(0),
+      m_nextTargetNs(0), m_startNs(0), m_sourceStartNs(0), m_lastWriteNs(0) {
+    m_timer->setSingleShot(true);
+    m_timer->setTimerType(Qt::PreciseTimer);
+    QObject::connect(m_timer, &QTimer::timeout, this, &ReplayEngine::onTimeout);
+}
+
+ReplayEngine::~ReplayEngine() = default;
+
+bool ReplayEngine::start(const QString &path, const QString &sourcePort, const QString &targetPort,
+                         const ReplayOptions &options) {
+    if (m_running) {
+        m_errorString = tr("A replay is already running");
+        return false;
+    }
+    if (!m_manager->getUser(targetPort)) {
+        m_errorString = tr("Unknown port %1").arg(targetPort);
+        return false;
+    }
+    if (!m_reader.open(path, sourcePort)) {
+        m_errorString = m_reader.errorString();
+        return false;
+    }
+
+    m_targetPort = targetPort;
+    m_options = options;
+    m_options.speed = qBound(MIN_SPEED, options.speed, MAX_SPEED);
+    m_errorString.clear();
+    m_report = ReplayReport();
+    m_writes.clear();
+    m_next = 0;
+    m_running = true;
+    m_progressTimer.start();
+
+    if (!loadMessage()) {
+        finish(m_reader.errorString());
+        return !m_reader.hasError();
+    }
+
+    // Time zero of the replay is the first write
+    m_startNs = TimeUtils::timestampNs();
+    m_sourceStartNs = m_writes.first().sourceNs;
+    m_lastWriteNs = m_startNs;
+    m_nextTargetNs = m_startNs;
+    m_timer->start(0);
+    return true;
+}
+
+void ReplayEngine::stop() {
+    if (m_running) {
+        finish(tr("Stopped"));
+    }
+}
+
+void ReplayEngine::onTimeout() {
+    const qint64 passStartNs = TimeUtils::timestampNs();
+    while (m_running) {
+        qint64 now = TimeUtils::timestampNs();
+        if (now < m_nextTargetNs) {
+            // Sleep until the last millisecond, then wait out the rest through the event loop
+            m_timer->start(static_cast<int>((m_nextTargetNs - now) / NS_PER_MS));
+            return;
+        }
+        if (now - passStartNs > MAX_PASS_NS) {
+            m_timer->start(0);
+            return;
+        }
+
+        SerialPortUser *user = m_manager->getUser(m_targetPort);
+        if (!user || (!user->isOnline() && !user->isReconnecting())) {
+            finish(tr("Port %1 is not open").arg(m_targetPort));
+            return;
+        }
+        // Check for room first; a rejected sendData() would report an error each time
+        SerialPortInfo info = user->info();
+        if (info.transmitQueueDepth() > 0 && user->pendingTransmitCount() >= info.transmitQueueDepth()) {
+            m_report.queueFullCount++;
+            m_timer->start(QUEUE_FULL_RETRY_MS);
+            return;
+        }
+
+        const Write &write = m_writes.at(m_next);
+        if (!user->sendData(write.data)) {
+            finish(user->errorString());
+            return;
+        }
+        now = TimeUtils::timestampNs();
+        if (m_options.timing != ReplayTiming::Burst) {
+            m_report.lateness.record(now - m_nextTargetNs);
+        }
+        m_report.writeCount++;
+        m_report.byteCount += write.data.size();
+        m_report.targetDurationNs = m_nextTargetNs - m_startNs;
+        m_lastWriteNs = now;
+
+        if (!advance()) {
+            finish(m_reader.errorString());
+            return;
+        }
+    }
+}
+
+bool ReplayEngine::advance() {
+    if (++m_next >= m_writes.size() && !loadMessage()) {
+        return false;
+    }
+
+    // Targets never go backwards, even if the recorded timestamps do
+    qint64 now = TimeUtils::timestampNs();
+    m_nextTargetNs = qMax(m_nextTargetNs, targetFor(m_writes.at(m_next), now));
+
+    if (m_progressTimer.elapsed() >= PROGRESS_INTERVAL_MS) {
+        m_progressTimer.restart();
+        emit progress(m_reader.bytesRead(), m_reader.size());
+    }
+    return true;
+}
+
+bool ReplayEngine::loadMessage() {
+    Message message;
+    while (m_reader.readNext(message)) {
+        bool wanted = m_options.direction == ReplayDirection::Both
+                      || (m_options.direction == ReplayDirection::Received)
+                             == (message.direction() == MessageDirection::Received);
+        const QByteArray data = message.data();
+        if (!wanted || data.isEmpty()) {
+            continue;
+        }
+
+        // One write per recorded read, so coalescing does not change the timing
+        m_writes.clear();
+        m_next = 0;
+        const QVector<MessageChunk> chunks = message.chunks();
+        if (chunks.isEmpty()) {
+            m_writes.append({data, message.timestampNs()});
+        } else {
+            for (int i = 0; i < chunks.size(); ++i) {
+                int begin = chunks.at(i).byteOffset;
+                int end = i + 1 < chunks.size() ? chunks.at(i + 1).byteOffset : data.size();
+                if (end > begin) {
+                    m_writes.append({data.mid(begin, end - begin), message.timestampNs() + chunks.at(i).timeOffsetNs});
+                }
+            }
+        }
+        if (m_writes.isEmpty()) {
+            continue;
+        }
+        m_report.messageCount++;
+        return true;
+    }
+    return false;
+}
+
+qint64 ReplayEngine::targetFor(const Write &write, qint64 nowNs) const {
+    switch (m_options.timing) {
+    case ReplayTiming::Burst:
+        return nowNs;
+    case ReplayTiming::Scaled:
+        return m_startNs + std::llround((write.sourceNs - m_sourceStartNs) / m_options.speed);
+    case ReplayTiming::Original:
+    default:
+        return m_startNs + (write.sourceNs - m_sourceStartNs);
+    }
+}
+
+void ReplayEngine::finish(const QString &error) {
+    m_timer->stop();
+    m_running = false;
+    m_report.error = error;
+    m_report.completed = error.isEmpty();
+    m_report.actualDurationNs = m_report.writeCount > 0 ? m_lastWriteNs - m_startNs : 0;
+    m_report.endDriftNs = m_report.actualDurationNs - m_report.targetDurationNs;
+    m_errorString = error;
+    m_writes.clear();
+    m_reader.close();
+    emit finished(m_report);
+}
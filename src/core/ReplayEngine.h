@@ -0,0 +1,143 @@
+#ifndef REPLAY_ENGINE_H
+#define REPLAY_ENGINE_H
+
+#include "HistoryReader.h"
+#include "LatencyHistogram.h"
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QObject>
+#include <QString>
+#include <QTimer>
+#include <QVector>
+
+class SerialPortManager;
+
+/**
+ * @brief How a replay is paced
+ */
+enum class ReplayTiming {
+    Original, // The gaps recorded in the capture
+    Scaled,   // The recorded gaps divided by ReplayOptions::speed
+    Burst     // As fast as the target port's transmit queue accepts data
+};
+
+/**
+ * @brief Which recorded messages a replay sends
+ */
+enum class ReplayDirection {
+    Received, // What the device sent: replaying it impersonates the device
+    Sent,     // What the host sent: replaying it drives a device
+    Both
+};
+
+struct ReplayOptions {
+    ReplayTiming timing = ReplayTiming::Original;
+    double speed = 1.0; // For ReplayTiming::Scaled, clamped to 0.01 - 1000
+    ReplayDirection direction = ReplayDirection::Received;
+};
+
+/**
+ * @brief Outcome of a replay and how closely it kept to the target timing
+ *
+ * Lateness is the time between a write's target and its hand-over to the
+ * target port's transmit queue. Targets are absolute, so lateness does not
+ * accumulate; endDriftNs compares the whole replay's duration with the
+ * target duration.
+ */
+struct ReplayReport {
+    qint64 messageCount = 0;      // Recorded messages replayed
+    qint64 writeCount = 0;        // Writes, one per recorded read of a coalesced message
+    qint64 byteCount = 0;
+    qint64 queueFullCount = 0;    // Times a write waited for room in the transmit queue
+    qint64 targetDurationNs = 0;  // First to last write, as scheduled
+    qint64 actualDurationNs = 0;  // First to last write, as sent
+    qint64 endDriftNs = 0;        // actualDurationNs - targetDurationNs
+    LatencyHistogram lateness;    // Per write; empty for ReplayTiming::Burst
+    bool completed = false;       // False if stopped or failed before the end
+    QString error;
+
+    QString summary() const;
+};
+
+/**
+ * @brief Replays stored history out of a port with reproducible timing
+ *
+ * Messages are streamed from the history file with HistoryReader, one at
+ * a time, and handed to the target port's SerialPortUser::sendData(). A
+ * coalesced message is sent as the reads it was merged from, at their
+ * recorded arrival times (Message::chunks()).
+ *
+ * Each write has an absolute target time: the replay start plus the
+ * write's recorded offset from the first write, divided by the speed. A
+ * precise QTimer wakes the engine shortly before the target, and the last
+ * fraction of a millisecond is waited out through the event loop, so the
+ * targets are met to well under a millisecond on an idle machine. A late
+ * write does not delay the ones after it. When the transmit queue is full
+ * the write waits for room rather than being dropped, which shows up as
+ * lateness.
+ *
+ * At most a few milliseconds of writes are sent per event loop pass, so a
+ * burst replay does not freeze the thread it runs on.
+ */
+class ReplayEngine : public QObject {
+    Q_OBJECT
+
+  public:
+    explicit ReplayEngine(SerialPortManager *manager, QObject *parent = nullptr);
+    ~ReplayEngine() override;
+
+    // Replays sourcePort's messages from the history file (all ports if empty) out of targetPort
+    bool start(const QString &path, const QString &sourcePort, const QString &targetPort,
+               const ReplayOptions &options = ReplayOptions());
+    void stop();
+
+    bool isRunning() const { return m_running; }
+    QString targetPort() const { return m_targetPort; }
+    QString errorString() const { return m_errorString; }
+
+    // Counters so far, or of the last replay
+    ReplayReport report() const { return m_report; }
+
+  signals:
+    // Emitted at most every 100 ms while running
+    void progress(qint64 bytesRead, qint64 totalBytes);
+    void finished(const ReplayReport &report);
+
+  private slots:
+    void onTimeout();
+
+  private:
+    // A piece of recorded data and when it was originally read or written
+    struct Write {
+        QByteArray data;
+        qint64 sourceNs;
+    };
+
+    SerialPortManager *m_manager;
+    HistoryReader m_reader;
+    QString m_targetPort;
+    ReplayOptions m_options;
+    QString m_errorString;
+    bool m_running;
+    QTimer *m_timer;
+
+    // Writes of the current message; m_next is due at m_nextTargetNs
+    QVector<Write> m_writes;
+    int m_next;
+    qint64 m_nextTargetNs;
+
+    qint64 m_startNs;
+    qint64 m_sourceStartNs;
+    qint64 m_lastWriteNs;
+    QElapsedTimer m_progressTimer;
+    ReplayReport m_report;
+
+    bool advance();
+    bool loadMessage();
+    qint64 targetFor(const Write &write, qint64 nowNs) const;
+    void finish(const QString &error);
+};
+
+Q_DECLARE_METATYPE(ReplayReport)
+
+#endif // REPLAY_ENGINE_H
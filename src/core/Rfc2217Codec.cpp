@@ -0,0 +1,272 @@
+#include "Rfc2217Codec.h"
+#include <cstring>
+
+namespace {
+// Subnegotiations the client cares about are a few bytes; longer ones are truncated
+const int MAX_SUBNEGOTIATION_SIZE = 64;
+
+// COM-PORT-OPTION values (RFC 2217, section 3)
+const quint8 PARITY_NONE = 1;
+const quint8 PARITY_ODD = 2;
+const quint8 PARITY_EVEN = 3;
+const quint8 PARITY_MARK = 4;
+const quint8 PARITY_SPACE = 5;
+
+const quint8 STOPSIZE_ONE = 1;
+const quint8 STOPSIZE_TWO = 2;
+const quint8 STOPSIZE_ONE_AND_HALF = 3;
+
+const quint8 CONTROL_NONE = 1;
+const quint8 CONTROL_XON_XOFF = 2;
+const quint8 CONTROL_HARDWARE = 3;
+
+quint8 parityValue(QSerialPort::Parity parity)
+{
+    switch (parity) {
+    case QSerialPort::OddParity:
+        return PARITY_ODD;
+    case QSerialPort::EvenParity:
+        return PARITY_EVEN;
+    case QSerialPort::MarkParity:
+        return PARITY_MARK;
+    case QSerialPort::SpaceParity:
+        return PARITY_SPACE;
+    default:
+        return PARITY_NONE;
+    }
+}
+
+quint8 stopSizeValue(QSerialPort::StopBits stopBits)
+{
+    switch (stopBits) {
+    case QSerialPort::TwoStop:
+        return STOPSIZE_TWO;
+    case QSerialPort::OneAndHalfStop:
+        return STOPSIZE_ONE_AND_HALF;
+    default:
+        return STOPSIZE_ONE;
+    }
+}
+
+quint8 controlValue(QSerialPort::FlowControl flowControl)
+{
+    switch (flowControl) {
+    case QSerialPort::SoftwareControl:
+        return CONTROL_XON_XOFF;
+    case QSerialPort::HardwareControl:
+        return CONTROL_HARDWARE;
+    default:
+        return CONTROL_NONE;
+    }
+}
+}
+
+Rfc2217Codec::Rfc2217Codec()
+{
+    reset();
+}
+
+void Rfc2217Codec::reset()
+{
+    m_state = State::Data;
+    m_command = 0;
+    m_subNegotiation.clear();
+    m_local.reset();
+    m_remote.reset();
+    m_serverBaudRate = 0;
+}
+
+QByteArray Rfc2217Codec::handshake(const SerialPortInfo& info)
+{
+    reset();
+
+    QByteArray out;
+    appendCommand(out, WILL, OPTION_BINARY);
+    appendCommand(out, DO, OPTION_BINARY);
+    appendCommand(out, WILL, OPTION_SUPPRESS_GO_AHEAD);
+    appendCommand(out, DO, OPTION_SUPPRESS_GO_AHEAD);
+    appendCommand(out, WILL, OPTION_COM_PORT);
+    m_local.set(OPTION_BINARY);
+    m_local.set(OPTION_SUPPRESS_GO_AHEAD);
+    m_local.set(OPTION_COM_PORT);
+    m_remote.set(OPTION_BINARY);
+    m_remote.set(OPTION_SUPPRESS_GO_AHEAD);
+
+    // Baud rate is a 4 byte big-endian value
+    quint32 baudRate = static_cast<quint32>(info.baudRate());
+    QByteArray baud;
+    baud.append(static_cast<char>(baudRate >> 24));
+    baud.append(static_cast<char>(baudRate >> 16));
+    baud.append(static_cast<char>(baudRate >> 8));
+    baud.append(static_cast<char>(baudRate));
+    appendComPort(out, SET_BAUDRATE, baud);
+
+    appendComPort(out, SET_DATASIZE, QByteArray(1, static_cast<char>(info.dataBits())));
+    appendComPort(out, SET_PARITY, QByteArray(1, static_cast<char>(parityValue(info.parity()))));
+    appendComPort(out, SET_STOPSIZE, QByteArray(1, static_cast<char>(stopSizeValue(info.stopBits()))));
+    appendComPort(out, SET_CONTROL, QByteArray(1, static_cast<char>(controlValue(info.flowControl()))));
+    return out;
+}
+
+QByteArray Rfc2217Codec::encode(const char* data, qint64 size)
+{
+    QByteArray out;
+    out.reserve(static_cast<int>(size));
+
+    const char* end = data + size;
+    while (data < end) {
+        const char* iac = static_cast<const char*>(std::memchr(data, IAC, static_cast<size_t>(end - data)));
+        if (!iac) {
+            out.append(data, static_cast<int>(end - data));
+            break;
+        }
+        out.append(data, static_cast<int>(iac - data + 1));
+        out.append(static_cast<char>(IAC));
+        data = iac + 1;
+    }
+    return out;
+}
+
+void Rfc2217Codec::decode(const char* data, qint64 size, QByteArray& payload, QByteArray& reply)
+{
+    const char* end = data + size;
+    while (data < end) {
+        if (m_state == State::Data) {
+            // Copy plain runs in one go
+            const char* iac = static_cast<const char*>(std::memchr(data, IAC, static_cast<size_t>(end - data)));
+            if (!iac) {
+                payload.append(data, static_cast<int>(end - data));
+                return;
+            }
+            payload.append(data, static_cast<int>(iac - data));
+            data = iac + 1;
+            m_state = State::Command;
+            continue;
+        }
+
+        quint8 byte = static_cast<quint8>(*data++);
+        switch (m_state) {
+        case State::Command:
+            if (byte == IAC) {
+                payload.append(static_cast<char>(IAC));
+                m_state = State::Data;
+            } else if (byte >= WILL && byte <= DONT) {
+                m_command = byte;
+                m_state = State::Option;
+            } else if (byte == SB) {
+                m_subNegotiation.clear();
+                m_state = State::SubNegotiation;
+            } else {
+                // NOP, GA and friends carry nothing for a serial link
+                m_state = State::Data;
+            }
+            break;
+        case State::Option:
+            handleOption(m_command, byte, reply);
+            m_state = State::Data;
+            break;
+        case State::SubNegotiation:
+            if (byte == IAC) {
+                m_state = State::SubNegotiationIac;
+            } else if (m_subNegotiation.size() < MAX_SUBNEGOTIATION_SIZE) {
+                m_subNegotiation.append(static_cast<char>(byte));
+            }
+            break;
+        case State::SubNegotiationIac:
+            if (byte == IAC) {
+                if (m_subNegotiation.size() < MAX_SUBNEGOTIATION_SIZE) {
+                    m_subNegotiation.append(static_cast<char>(IAC));
+                }
+                m_state = State::SubNegotiation;
+            } else {
+                if (byte == SE) {
+                    handleSubNegotiation();
+                }
+                m_state = State::Data;
+            }
+            break;
+        case State::Data:
+            break;
+        }
+    }
+}
+
+bool Rfc2217Codec::acceptsLocal(quint8 option)
+{
+    return option == OPTION_BINARY || option == OPTION_SUPPRESS_GO_AHEAD || option == OPTION_COM_PORT;
+}
+
+bool Rfc2217Codec::acceptsRemote(quint8 option)
+{
+    return option == OPTION_BINARY || option == OPTION_SUPPRESS_GO_AHEAD;
+}
+
+void Rfc2217Codec::appendCommand(QByteArray& out, quint8 command, quint8 option)
+{
+    out.append(static_cast<char>(IAC));
+    out.append(static_cast<char>(command));
+    out.append(static_cast<char>(option));
+}
+
+void Rfc2217Codec::appendComPort(QByteArray& out, quint8 command, const QByteArray& value)
+{
+    out.append(static_cast<char>(IAC));
+    out.append(static_cast<char>(SB));
+    out.append(static_cast<char>(OPTION_COM_PORT));
+    out.append(static_cast<char>(command));
+    out.append(encode(value.constData(), value.size()));
+    out.append(static_cast<char>(IAC));
+    out.append(static_cast<char>(SE));
+}
+
+void Rfc2217Codec::handleOption(quint8 command, quint8 option, QByteArray& reply)
+{
+    // Only answer requests that change an option's state, so negotiation cannot loop (RFC 854)
+    switch (command) {
+    case DO:
+        if (!acceptsLocal(option)) {
+            appendCommand(reply, WONT, option);
+        } else if (!m_local.test(option)) {
+            m_local.set(option);
+            appendCommand(reply, WILL, option);
+        }
+        break;
+    case DONT:
+        if (m_local.test(option)) {
+            m_local.reset(option);
+            appendCommand(reply, WONT, option);
+        }
+        break;
+    case WILL:
+        if (!acceptsRemote(option)) {
+            appendCommand(reply, DONT, option);
+        } else if (!m_remote.test(option)) {
+            m_remote.set(option);
+            appendCommand(reply, DO, option);
+        }
+        break;
+    case WONT:
+        if (m_remote.test(option)) {
+            m_remote.reset(option);
+            appendCommand(reply, DONT, option);
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+void Rfc2217Codec::handleSubNegotiation()
+{
+    const QByteArray& sub = m_subNegotiation;
+    if (sub.size() < 6
+        || static_cast<quint8>(sub.at(0)) != OPTION_COM_PORT
+        || static_cast<quint8>(sub.at(1)) != SET_BAUDRATE + SERVER_OFFSET) {
+        return;
+    }
+
+    m_serverBaudRate = (static_cast<quint32>(static_cast<quint8>(sub.at(2))) << 24)
+        | (static_cast<quint32>(static_cast<quint8>(sub.at(3))) << 16)
+        | (static_cast<quint32>(static_cast<quint8>(sub.at(4))) << 8)
+        | static_cast<quint32>(static_cast<quint8>(sub.at(5)));
+}
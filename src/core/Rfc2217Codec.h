@@ -0,0 +1,89 @@
+#ifndef RFC2217_CODEC_H
+#define RFC2217_CODEC_H
+
+#include <QByteArray>
+#include <bitset>
+#include "SerialPortInfo.h"
+
+/**
+ * @brief Telnet framing and COM port control (RFC 2217) for a client port
+ *
+ * Pure byte-level logic, independent of any socket: handshake() produces
+ * the option negotiation and the SET-* commands that configure the remote
+ * serial port, encode() escapes outgoing payload bytes, and decode() strips
+ * Telnet commands from received data and produces the replies the server
+ * expects to its option requests.
+ *
+ * The client offers BINARY, SUPPRESS-GO-AHEAD and COM-PORT-OPTION and
+ * refuses every other option. decode() keeps its parser state between
+ * calls, so commands split across reads are handled.
+ */
+class Rfc2217Codec {
+public:
+    // Telnet commands (RFC 854)
+    static constexpr quint8 SE = 240;
+    static constexpr quint8 SB = 250;
+    static constexpr quint8 WILL = 251;
+    static constexpr quint8 WONT = 252;
+    static constexpr quint8 DO = 253;
+    static constexpr quint8 DONT = 254;
+    static constexpr quint8 IAC = 255;
+
+    // Telnet options
+    static constexpr quint8 OPTION_BINARY = 0;
+    static constexpr quint8 OPTION_SUPPRESS_GO_AHEAD = 3;
+    static constexpr quint8 OPTION_COM_PORT = 44;
+
+    // COM-PORT-OPTION commands sent by the client; the server answers with +100
+    static constexpr quint8 SET_BAUDRATE = 1;
+    static constexpr quint8 SET_DATASIZE = 2;
+    static constexpr quint8 SET_PARITY = 3;
+    static constexpr quint8 SET_STOPSIZE = 4;
+    static constexpr quint8 SET_CONTROL = 5;
+    static constexpr quint8 SERVER_OFFSET = 100;
+
+    Rfc2217Codec();
+
+    // Option offers and line settings to send right after connecting
+    QByteArray handshake(const SerialPortInfo& info);
+
+    // Payload with every 0xFF doubled
+    static QByteArray encode(const char* data, qint64 size);
+
+    // Appends received payload to `payload` and negotiation answers to `reply`
+    void decode(const char* data, qint64 size, QByteArray& payload, QByteArray& reply);
+
+    // Forget negotiated options and any partial command
+    void reset();
+
+    // Baud rate last confirmed by the server, 0 until it answers
+    quint32 serverBaudRate() const { return m_serverBaudRate; }
+
+private:
+    enum class State {
+        Data,
+        Command,            // after IAC
+        Option,             // after IAC WILL/WONT/DO/DONT
+        SubNegotiation,     // inside IAC SB ... IAC SE
+        SubNegotiationIac   // IAC inside a subnegotiation
+    };
+
+    State m_state;
+    quint8 m_command;
+    QByteArray m_subNegotiation;
+
+    // Options currently enabled on our side (WILL) and the server's side (DO)
+    std::bitset<256> m_local;
+    std::bitset<256> m_remote;
+
+    quint32 m_serverBaudRate;
+
+    static bool acceptsLocal(quint8 option);
+    static bool acceptsRemote(quint8 option);
+    static void appendCommand(QByteArray& out, quint8 command, quint8 option);
+    static void appendComPort(QByteArray& out, quint8 command, const QByteArray& value);
+    void handleOption(quint8 command, quint8 option, QByteArray& reply);
+    void handleSubNegotiation();
+};
+
+#endif // RFC2217_CODEC_H
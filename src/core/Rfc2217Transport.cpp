@@ -0,0 +1,116 @@
+#include "Rfc2217Transport.h"
+#include <cstring>
+
+namespace {
+// Decoded bytes held before the socket is left to apply TCP flow control
+const qint64 DEFAULT_READ_LIMIT = 4096;
+} // namespace
+
+Rfc2217Transport::Rfc2217Transport(QObject *parent)
+    : TcpTransport(parent), m_decodedOffset(0), m_readLimit(DEFAULT_READ_LIMIT), m_pendingPayload(0) {
+    // The socket carries Telnet traffic; only decoded payload is announced
+    QObject::disconnect(m_socket, &QTcpSocket::readyRead, this, &PortTransport::readyRead);
+    QObject::disconnect(m_socket, &QTcpSocket::bytesWritten, this, &PortTransport::bytesWritten);
+    QObject::connect(m_socket, &QTcpSocket::readyRead, this, &Rfc2217Transport::onSocketReadyRead);
+    QObject::connect(m_socket, &QTcpSocket::bytesWritten, this, &Rfc2217Transport::onSocketBytesWritten);
+}
+
+void Rfc2217Transport::openAsync(const SerialPortInfo &info) {
+    // The serial settings are sent once the connection is up
+    m_info = info;
+    TcpTransport::openAsync(info);
+}
+
+bool Rfc2217Transport::startSession() { return sendEncoded(m_codec.handshake(m_info), 0) != -1; }
+
+void Rfc2217Transport::close() {
+    TcpTransport::close();
+
+    m_codec.reset();
+    m_decoded.clear();
+    m_decodedOffset = 0;
+    m_pendingWrites.clear();
+    m_pendingPayload = 0;
+}
+
+qint64 Rfc2217Transport::read(char *data, qint64 maxSize) {
+    qint64 count = qMin(maxSize, bytesAvailable());
+    if (count > 0) {
+        std::memcpy(data, m_decoded.constData() + m_decodedOffset, static_cast<size_t>(count));
+        m_decodedOffset += static_cast<int>(count);
+        if (m_decodedOffset == m_decoded.size()) {
+            m_decoded.clear();
+            m_decodedOffset = 0;
+        }
+    }
+
+    // Room was made; pick up what the socket held back meanwhile
+    decodeAvailable();
+    return count;
+}
+
+qint64 Rfc2217Transport::write(const char *data, qint64 size) {
+    if (sendEncoded(Rfc2217Codec::encode(data, size), size) == -1) {
+        return -1;
+    }
+    return size;
+}
+
+void Rfc2217Transport::setReadBufferSize(qint64 size) {
+    m_readLimit = size > 0 ? size : DEFAULT_READ_LIMIT;
+    TcpTransport::setReadBufferSize(size);
+}
+
+void Rfc2217Transport::onSocketReadyRead() {
+    if (decodeAvailable()) {
+        emit readyRead();
+    }
+}
+
+void Rfc2217Transport::onSocketBytesWritten(qint64 bytes) {
+    // A write counts as done once all of its encoded bytes are out
+    qint64 completed = 0;
+    while (bytes > 0 && !m_pendingWrites.isEmpty()) {
+        PendingWrite &pending = m_pendingWrites.first();
+        qint64 written = qMin(bytes, pending.encoded);
+        pending.encoded -= written;
+        bytes -= written;
+        if (pending.encoded > 0) {
+            break;
+        }
+
+        completed += pending.payload;
+        m_pendingPayload -= pending.payload;
+        m_pendingWrites.removeFirst();
+    }
+
+    if (completed > 0) {
+        emit bytesWritten(completed);
+    }
+}
+
+bool Rfc2217Transport::decodeAvailable() {
+    int before = m_decoded.size();
+    QByteArray reply;
+    while (bytesAvailable() < m_readLimit && m_socket->bytesAvailable() > 0) {
+        QByteArray raw = m_socket->read(m_readLimit);
+        m_codec.decode(raw.constData(), raw.size(), m_decoded, reply);
+    }
+
+    // Answers to the server's option requests
+    if (!reply.isEmpty()) {
+        sendEncoded(reply, 0);
+    }
+    return m_decoded.size() > before;
+}
+
+qint64 Rfc2217Transport::sendEncoded(const QByteArray &encoded, qint64 payload) {
+    qint64 written = TcpTransport::write(encoded.constData(), encoded.size());
+    if (written == -1) {
+        return -1;
+    }
+
+    m_pendingWrites.append({written, payload});
+    m_pendingPayload += payload;
+    return written;
+}
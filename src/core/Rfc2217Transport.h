@@ -0,0 +1,67 @@
+#ifndef RFC2217_TRANSPORT_H
+#define RFC2217_TRANSPORT_H
+
+#include "Rfc2217Codec.h"
+#include "TcpTransport.h"
+#include <QList>
+
+/**
+ * @brief Remote serial port behind an RFC 2217 (Telnet COM port control) server
+ *
+ * Same connection handling as TcpTransport, with the Telnet layer handled
+ * by Rfc2217Codec: after connecting, the port's baud rate, data bits,
+ * parity, stop bits and flow control are sent to the server, outgoing
+ * payload is escaped and incoming data is stripped of Telnet commands.
+ *
+ * read() and bytesAvailable() see only payload bytes. bytesWritten()
+ * counts payload bytes too, so the worker's bookkeeping is unaffected by
+ * escaping and by negotiation traffic.
+ */
+class Rfc2217Transport : public TcpTransport {
+    Q_OBJECT
+
+  public:
+    explicit Rfc2217Transport(QObject *parent = nullptr);
+
+    TransportType type() const override { return TransportType::Rfc2217; }
+
+    void openAsync(const SerialPortInfo &info) override;
+    void close() override;
+
+    qint64 bytesAvailable() const override { return m_decoded.size() - m_decodedOffset; }
+    qint64 read(char *data, qint64 maxSize) override;
+
+    qint64 write(const char *data, qint64 size) override;
+    qint64 bytesToWrite() const override { return m_pendingPayload; }
+
+    void setReadBufferSize(qint64 size) override;
+
+  protected:
+    bool startSession() override;
+
+  private slots:
+    void onSocketReadyRead();
+    void onSocketBytesWritten(qint64 bytes);
+
+  private:
+    Rfc2217Codec m_codec;
+    SerialPortInfo m_info;
+
+    // Decoded payload not yet read; refilled from the socket up to m_readLimit
+    QByteArray m_decoded;
+    int m_decodedOffset;
+    qint64 m_readLimit;
+
+    // Encoded size of every socket write and the payload it carries
+    struct PendingWrite {
+        qint64 encoded;
+        qint64 payload;
+    };
+    QList<PendingWrite> m_pendingWrites;
+    qint64 m_pendingPayload;
+
+    bool decodeAvailable();
+    qint64 sendEncoded(const QByteArray &encoded, qint64 payload);
+};
+
+#endif // RFC2217_TRANSPORT_H
@@ -0,0 +1,193 @@
+#include "SendScheduler.h"
+#include "SerialPortManager.h"
+#include "TimeUtils.h"
+#include <algorithm>
+
+namespace {
+const qint64 NS_PER_TICK = 1000000;
+
+const int MIN_INTERVAL_MS = 1;
+const int MAX_INTERVAL_MS = 3600 * 1000;
+} // namespace
+
+SendScheduler::SendScheduler(SerialPortManager *manager)
+    : QObject(manager), m_manager(manager), m_nextId(1), m_epochNs(TimeUtils::timestampNs()),
+      m_timer(new QTimer(this)) {
+    m_timer->setSingleShot(true);
+    m_timer->setTimerType(Qt::PreciseTimer);
+    QObject::connect(m_timer, &QTimer::timeout, this, &SendScheduler::onTimeout);
+}
+
+quint64 SendScheduler::addJob(const QString &portName, const QByteArray &data, int intervalMs, bool start) {
+    JobState state;
+    state.job.id = m_nextId++;
+    state.job.portName = portName;
+    state.job.data = data;
+    state.job.intervalMs = qBound(MIN_INTERVAL_MS, intervalMs, MAX_INTERVAL_MS);
+    state.intervalNs = state.job.intervalMs * NS_PER_TICK;
+    m_jobs.insert(state.job.id, state);
+
+    if (start) {
+        startJob(state.job.id);
+    }
+    return state.job.id;
+}
+
+bool SendScheduler::removeJob(quint64 id) {
+    if (!m_jobs.remove(id)) {
+        return false;
+    }
+    m_wheel.cancel(id);
+    rearm();
+    return true;
+}
+
+void SendScheduler::removeJobs(const QString &portName) {
+    for (auto it = m_jobs.begin(); it != m_jobs.end();) {
+        if (it->job.portName == portName) {
+            m_wheel.cancel(it.key());
+            it = m_jobs.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    rearm();
+}
+
+bool SendScheduler::startJob(quint64 id) {
+    auto it = m_jobs.find(id);
+    if (it == m_jobs.end()) {
+        return false;
+    }
+    if (it->job.active) {
+        return true;
+    }
+
+    // The first send is due now; later ones follow from here
+    it->job.active = true;
+    it->nextDeadlineNs = TimeUtils::timestampNs();
+    schedule(*it);
+    rearm();
+    return true;
+}
+
+bool SendScheduler::stopJob(quint64 id) {
+    auto it = m_jobs.find(id);
+    if (it == m_jobs.end()) {
+        return false;
+    }
+    it->job.active = false;
+    m_wheel.cancel(id);
+    rearm();
+    return true;
+}
+
+bool SendScheduler::setInterval(quint64 id, int intervalMs) {
+    auto it = m_jobs.find(id);
+    if (it == m_jobs.end()) {
+        return false;
+    }
+
+    // Keep the time of the last send; the new interval counts from there
+    qint64 lastSendNs = it->nextDeadlineNs - it->intervalNs;
+    it->job.intervalMs = qBound(MIN_INTERVAL_MS, intervalMs, MAX_INTERVAL_MS);
+    it->intervalNs = it->job.intervalMs * NS_PER_TICK;
+    if (it->job.active) {
+        it->nextDeadlineNs = qMax(lastSendNs + it->intervalNs, TimeUtils::timestampNs());
+        schedule(*it);
+        rearm();
+    }
+    return true;
+}
+
+bool SendScheduler::setData(quint64 id, const QByteArray &data) {
+    auto it = m_jobs.find(id);
+    if (it == m_jobs.end()) {
+        return false;
+    }
+    it->job.data = data;
+    return true;
+}
+
+QList<SendJob> SendScheduler::jobs() const {
+    QList<SendJob> jobs;
+    jobs.reserve(m_jobs.size());
+    for (const JobState &state : m_jobs) {
+        jobs.append(state.job);
+    }
+    std::sort(jobs.begin(), jobs.end(), [](const SendJob &a, const SendJob &b) { return a.id < b.id; });
+    return jobs;
+}
+
+qint64 SendScheduler::totalMissedCount() const {
+    qint64 missed = 0;
+    for (const JobState &state : m_jobs) {
+        missed += state.job.missedCount;
+    }
+    return missed;
+}
+
+void SendScheduler::resetCounters() {
+    for (JobState &state : m_jobs) {
+        state.job.sentCount = 0;
+        state.job.missedCount = 0;
+        state.job.failedCount = 0;
+        state.job.maxLatenessNs = 0;
+    }
+}
+
+qint64 SendScheduler::tickAt(qint64 timestampNs) const {
+    // Round up: a deadline must never be reported due before it has passed
+    return (timestampNs - m_epochNs + NS_PER_TICK - 1) / NS_PER_TICK;
+}
+
+void SendScheduler::schedule(JobState &state) { m_wheel.schedule(state.job.id, tickAt(state.nextDeadlineNs)); }
+
+void SendScheduler::onTimeout() {
+    qint64 now = TimeUtils::timestampNs();
+    QVector<quint64> expired;
+    m_wheel.advance((now - m_epochNs) / NS_PER_TICK, &expired);
+
+    for (quint64 id : qAsConst(expired)) {
+        auto it = m_jobs.find(id);
+        if (it != m_jobs.end() && it->job.active) {
+            fire(it.value(), now);
+        }
+    }
+    rearm();
+}
+
+void SendScheduler::fire(JobState &state, qint64 nowNs) {
+    qint64 lateness = qMax(qint64(0), nowNs - state.nextDeadlineNs);
+    state.job.maxLatenessNs = qMax(state.job.maxLatenessNs, lateness);
+
+    // Skip the periods that are already over instead of sending them in a burst
+    qint64 missed = lateness / state.intervalNs;
+    state.nextDeadlineNs += (missed + 1) * state.intervalNs;
+    state.job.missedCount += missed;
+
+    // A closed port would only report an error for every period
+    SerialPortUser *user = m_manager->getUser(state.job.portName);
+    if (user && (user->isOnline() || user->isReconnecting()) && user->sendData(state.job.data)) {
+        state.job.sentCount++;
+    } else {
+        state.job.failedCount++;
+    }
+    schedule(state);
+
+    // Last, as a handler may change or remove the job
+    if (missed > 0) {
+        emit deadlinesMissed(state.job.id, missed);
+    }
+}
+
+void SendScheduler::rearm() {
+    qint64 wake = m_wheel.nextWakeTick();
+    if (wake < 0) {
+        m_timer->stop();
+        return;
+    }
+
+    qint64 delay = m_epochNs + wake * NS_PER_TICK - TimeUtils::timestampNs();
+    m_timer->start(static_cast<int>(qMax(qint64(0), (delay + NS_PER_TICK - 1) / NS_PER_TICK)));
+}
@@ -0,0 +1,101 @@
+#ifndef SEND_SCHEDULER_H
+#define SEND_SCHEDULER_H
+
+#include "TimerWheel.h"
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QString>
+#include <QTimer>
+
+class SerialPortManager;
+
+/**
+ * @brief A periodic transmission and its counters
+ */
+struct SendJob {
+    quint64 id = 0;
+    QString portName;
+    QByteArray data;
+    int intervalMs = 0;
+    bool active = false;
+
+    qint64 sentCount = 0;
+    qint64 missedCount = 0;   // Periods skipped because the scheduler fell a whole interval behind
+    qint64 failedCount = 0;   // Periods the port was closed or its transmit queue full
+    qint64 maxLatenessNs = 0; // Worst delay between a deadline and the send
+};
+
+/**
+ * @brief Sends data periodically on many ports from one timer
+ *
+ * Every active job's next deadline sits in a TimerWheel with 1 ms ticks,
+ * and a single precise QTimer is armed for the wheel's next wake-up, so a
+ * few hundred heartbeats and status queries cost one timer instead of one
+ * each.
+ *
+ * Deadlines are absolute: the n-th send of a job is due at start + n *
+ * interval, so lateness in one period does not push back the following
+ * ones. If the scheduler falls behind by a whole interval or more, the
+ * periods in between are skipped, not sent in a burst, and counted in
+ * SendJob::missedCount.
+ *
+ * Data goes through SerialPortUser::sendData() of the job's port. A period
+ * in which the port is closed or its transmit queue is full is counted in
+ * SendJob::failedCount. Jobs can be added, stopped, restarted and changed
+ * at any time; a job sends as soon as it is started.
+ */
+class SendScheduler : public QObject {
+    Q_OBJECT
+
+  public:
+    // Owned by the manager, whose users the jobs send on
+    explicit SendScheduler(SerialPortManager *manager);
+
+    // Interval is clamped to 1 ms - 1 h
+    quint64 addJob(const QString &portName, const QByteArray &data, int intervalMs, bool start = true);
+    bool removeJob(quint64 id);
+    void removeJobs(const QString &portName);
+
+    bool startJob(quint64 id);
+    bool stopJob(quint64 id);
+    bool setInterval(quint64 id, int intervalMs);
+    bool setData(quint64 id, const QByteArray &data);
+
+    // Jobs and counters
+    SendJob job(quint64 id) const { return m_jobs.value(id).job; }
+    QList<SendJob> jobs() const;
+    int activeCount() const { return m_wheel.size(); }
+    qint64 totalMissedCount() const;
+    void resetCounters();
+
+  signals:
+    void deadlinesMissed(quint64 id, qint64 periods);
+
+  private slots:
+    void onTimeout();
+
+  private:
+    struct JobState {
+        SendJob job;
+        qint64 intervalNs = 0;
+        qint64 nextDeadlineNs = 0;
+    };
+
+    SerialPortManager *m_manager;
+    QHash<quint64, JobState> m_jobs;
+    quint64 m_nextId;
+
+    // Wheel ticks are milliseconds since m_epochNs
+    TimerWheel m_wheel;
+    qint64 m_epochNs;
+    QTimer *m_timer;
+
+    qint64 tickAt(qint64 timestampNs) const;
+    void schedule(JobState &state);
+    void fire(JobState &state, qint64 nowNs);
+    void rearm();
+};
+
+#endif // SEND_SCHEDULER_H
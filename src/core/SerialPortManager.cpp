@@ -1,9 +1,13 @@
 #include "SerialPortManager.h"
-
-SerialPortManager::SerialPortManager(QObject *parent) : QObject(parent), m_refreshTimer(new QTimer(this)) {
-    QObject::connect(m_refreshTimer, &QTimer::timeout, this, &SerialPortManager::onRefreshTimer);
-
-    updateAvailablePorts();
+#include "ReconnectSupervisor.h"
+#include "SendScheduler.h"
+#include "Trace.h"
+
+SerialPortManager::SerialPortManager(QObject *parent)
+    : QObject(parent), m_ioPool(new IoWorkerPool(this)), m_inventory(new PortInventory(this)),
+      m_sendScheduler(new SendScheduler(this)), m_bulkStarting(false) {
+    QObject::connect(m_inventory, &PortInventory::portAdded, this, &SerialPortManager::onPortAdded);
+    QObject::connect(m_inventory, &PortInventory::portRemoved, this, &SerialPortManager::onPortRemoved);
 }
 
 SerialPortManager::~SerialPortManager() {
@@ -12,23 +16,6 @@ SerialPortManager::~SerialPortManager() {
     m_users.clear();
 }
 
-QStringList SerialPortManager::availablePorts() const { return m_availablePorts; }
-
-void SerialPortManager::refreshAvailablePorts() { updateAvailablePorts(); }
-
-void SerialPortManager::updateAvailablePorts() {
-    QStringList newPorts;
-    const auto ports = QSerialPortInfo::availablePorts();
-    for (const auto &port : ports) {
-        newPorts.append(port.portName());
-    }
-
-    if (newPorts != m_availablePorts) {
-        m_availablePorts = newPorts;
-        emit availablePortsChanged(m_availablePorts);
-    }
-}
-
 SerialPortUser *SerialPortManager::getUser(const QString &portName) { return m_users.value(portName, nullptr); }
 
 SerialPortUser *SerialPortManager::createUser(const QString &portName) {
@@ -36,8 +23,8 @@ SerialPortUser *SerialPortManager::createUser(const QString &portName) {
         return m_users.value(portName);
     }
 
-    SerialPortInfo info(portName);
-    return createUser(info);
+    // Saved settings (transport, framing, ...) apply to ports known from the friend list
+    return createUser(m_friendList.value(portName, SerialPortInfo(portName)));
 }
 
 SerialPortUser *SerialPortManager::createUser(const SerialPortInfo &info) {
@@ -49,12 +36,17 @@ SerialPortUser *SerialPortManager::createUser(const SerialPortInfo &info) {
         return user;
     }
 
-    SerialPortUser *user = new SerialPortUser(info, this);
+    SerialPortUser *user = new SerialPortUser(info, m_ioPool, this);
     m_users.insert(portName, user);
 
     QObject::connect(user, &SerialPortUser::statusChanged, this, &SerialPortManager::onUserStatusChanged);
     QObject::connect(user, &SerialPortUser::messageReceived, this, &SerialPortManager::onUserMessageReceived);
     QObject::connect(user, &SerialPortUser::messageSent, this, &SerialPortManager::onUserMessageSent);
+    QObject::connect(user, &SerialPortUser::connectFinished, this, &SerialPortManager::onUserConnectFinished);
+    QObject::connect(user->reconnectSupervisor(), &ReconnectSupervisor::reconnected, this,
+                     [this, portName](int attempts, qint64 downtimeMs) {
+                         emit userReconnected(portName, attempts, downtimeMs);
+                     });
 
     // Add to friend list
     addToFriendList(info);
@@ -73,10 +65,15 @@ bool SerialPortManager::removeUser(const QString &portName) {
         return false;
     }
 
+    m_sendScheduler->removeJobs(portName);
     SerialPortUser *user = m_users.take(portName);
     user->disconnect();
     delete user;
 
+    if (m_bulkPending.contains(portName)) {
+        completeBulkResult(portName, false, tr("Port was removed"), 0);
+    }
+
     // Also remove from friend list
     if (m_friendList.contains(portName)) {
         m_friendList.remove(portName);
@@ -174,6 +171,24 @@ void SerialPortManager::setPortRemark(const QString &portName, const QString &re
     }
 }
 
+void SerialPortManager::setPortChecksum(const QString &portName, ChecksumType type) {
+    if (m_friendList.contains(portName)) {
+        m_friendList[portName].setChecksum(type);
+        emit friendListChanged();
+    }
+
+    if (m_users.contains(portName)) {
+        m_users[portName]->setChecksum(type);
+    }
+}
+
+ChecksumType SerialPortManager::portChecksum(const QString &portName) const {
+    if (m_users.contains(portName)) {
+        return m_users.value(portName)->info().checksum();
+    }
+    return m_friendList.value(portName).checksum();
+}
+
 void SerialPortManager::updatePortSettings(const SerialPortInfo &info) {
     QString portName = info.portName();
 
@@ -184,6 +199,19 @@ void SerialPortManager::updatePortSettings(const SerialPortInfo &info) {
         existing.setStopBits(info.stopBits());
         existing.setParity(info.parity());
         existing.setFlowControl(info.flowControl());
+        existing.setTransport(info.transport());
+        existing.setReceiveBufferSize(info.receiveBufferSize());
+        existing.setOverflowPolicy(info.overflowPolicy());
+        existing.setFraming(info.framing());
+        existing.setCoalesceWindowMs(info.coalesceWindowMs());
+        existing.setCoalesceMaxBytes(info.coalesceMaxBytes());
+        existing.setTransmitQueueDepth(info.transmitQueueDepth());
+        existing.setTransmitPolicy(info.transmitPolicy());
+        existing.setPacing(info.pacing());
+        existing.setAutoReconnect(info.autoReconnect());
+        existing.setChecksum(info.checksum());
+        existing.setDecoder(info.decoder());
+        existing.setAutoReplies(info.autoReplies());
         if (!info.remark().isEmpty()) {
             existing.setRemark(info.remark());
         }
@@ -217,6 +245,69 @@ void SerialPortManager::disconnectAll() {
     }
 }
 
+bool SerialPortManager::connectPorts(const QStringList &portNames) {
+    if (isBulkConnectPending()) {
+        return false;
+    }
+
+    m_bulkTimer.start();
+    m_bulkResults.clear();
+    m_bulkPending.clear();
+    for (const QString &portName : portNames) {
+        if (m_bulkPending.contains(portName)) {
+            continue;
+        }
+        PortConnectResult result;
+        result.portName = portName;
+        m_bulkPending.insert(portName, m_bulkResults.size());
+        m_bulkResults.append(result);
+    }
+
+    // Ports that are online or open synchronously report right away; the batch completes after the loop
+    m_bulkStarting = true;
+    for (const QString &portName : portNames) {
+        SerialPortUser *user = getUser(portName);
+        if (!user) {
+            user = createUser(portName);
+        }
+        user->connectAsync();
+    }
+    m_bulkStarting = false;
+
+    finishBulkConnect();
+    return true;
+}
+
+void SerialPortManager::disconnectPorts(const QStringList &portNames) {
+    for (const QString &portName : portNames) {
+        if (SerialPortUser *user = getUser(portName)) {
+            user->disconnectAsync();
+        }
+    }
+}
+
+void SerialPortManager::completeBulkResult(const QString &portName, bool ok, const QString &error,
+                                           qint64 openTimeNs) {
+    PortConnectResult &result = m_bulkResults[m_bulkPending.take(portName)];
+    result.ok = ok;
+    result.error = error;
+    result.openTimeNs = openTimeNs;
+    result.completedNs = m_bulkTimer.nsecsElapsed();
+    finishBulkConnect();
+}
+
+void SerialPortManager::finishBulkConnect() {
+    if (m_bulkStarting || !m_bulkPending.isEmpty() || !isBulkConnectPending()) {
+        return;
+    }
+
+    qint64 elapsedNs = m_bulkTimer.nsecsElapsed();
+    m_bulkTimer.invalidate();
+    QList<PortConnectResult> results;
+    results.swap(m_bulkResults);
+    emit portsConnected(results, elapsedNs);
+}
+
 int SerialPortManager::onlineCount() const {
     int count = 0;
     for (auto user : m_users) {
@@ -227,17 +318,16 @@ int SerialPortManager::onlineCount() const {
     return count;
 }
 
-void SerialPortManager::setAutoRefresh(bool enabled) {
-    if (enabled && !m_refreshTimer->isActive()) {
-        m_refreshTimer->start(1000);
-    } else if (!enabled && m_refreshTimer->isActive()) {
-        m_refreshTimer->stop();
+QList<PortMetricsSnapshot> SerialPortManager::metricsSnapshot() const {
+    QList<PortMetricsSnapshot> snapshots;
+    snapshots.reserve(m_users.size());
+    for (auto user : m_users) {
+        snapshots.append(user->metrics());
     }
+    return snapshots;
 }
 
-void SerialPortManager::setRefreshInterval(int msec) { m_refreshTimer->setInterval(msec); }
-
-void SerialPortManager::onRefreshTimer() { updateAvailablePorts(); }
+bool SerialPortManager::setIoThreadCount(int count) { return m_ioPool->setThreadCount(count); }
 
 void SerialPortManager::onUserStatusChanged(PortStatus status) {
     SerialPortUser *user = qobject_cast<SerialPortUser *>(sender());
@@ -247,6 +337,7 @@ void SerialPortManager::onUserStatusChanged(PortStatus status) {
 }
 
 void SerialPortManager::onUserMessageReceived(const Message &message) {
+    TRACE_SCOPE("SerialPortManager::userMessageReceived");
     SerialPortUser *user = qobject_cast<SerialPortUser *>(sender());
     if (user) {
         emit userMessageReceived(user->portName(), message);
@@ -259,3 +350,25 @@ void SerialPortManager::onUserMessageSent(const Message &message) {
         emit userMessageSent(user->portName(), message);
     }
 }
+
+void SerialPortManager::onUserConnectFinished(bool ok, qint64 openTimeNs) {
+    SerialPortUser *user = qobject_cast<SerialPortUser *>(sender());
+    if (user && m_bulkPending.contains(user->portName())) {
+        completeBulkResult(user->portName(), ok, ok ? QString() : user->errorString(), openTimeNs);
+    }
+}
+
+void SerialPortManager::onPortAdded(const PortDescriptor &port) {
+    // Replugged device: reconnect now instead of waiting for the next retry
+    if (SerialPortUser *user = getUser(port.portName)) {
+        user->reconnectSupervisor()->deviceAdded();
+    }
+    emit availablePortAdded(port.portName);
+}
+
+void SerialPortManager::onPortRemoved(const QString &portName) {
+    if (SerialPortUser *user = getUser(portName)) {
+        user->reconnectSupervisor()->deviceRemoved();
+    }
+    emit availablePortRemoved(portName);
+}
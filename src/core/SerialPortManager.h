@@ -1,21 +1,43 @@
 #ifndef SERIAL_PORT_MANAGER_H
 #define SERIAL_PORT_MANAGER_H
 
+#include "IoWorkerPool.h"
+#include "PortInventory.h"
 #include "SerialPortInfo.h"
 #include "SerialPortUser.h"
+#include <QElapsedTimer>
+#include <QHash>
 #include <QMap>
 #include <QObject>
-#include <QSerialPortInfo>
-#include <QTimer>
+
+class SendScheduler;
+
+/**
+ * @brief Outcome of one port in a bulk connect
+ */
+struct PortConnectResult {
+    QString portName;
+    bool ok = false;
+    QString error;
+    qint64 openTimeNs = 0;  // Time the open took, measured on the I/O thread
+    qint64 completedNs = 0; // Time from the start of the batch until this result arrived
+};
 
 /**
  * @brief Manages all serial port users in the application
  *
  * This class is responsible for:
- * - Discovering available serial ports
+ * - Discovering available serial ports (through a hot-plug aware PortInventory)
  * - Managing serial port user instances
  * - Tracking online/offline status
  * - Maintaining the "friend list" of used ports
+ * - Sharding port I/O across a pool of worker threads
+ * - Passing hot-plug events on to each port's ReconnectSupervisor
+ * - Owning the SendScheduler for periodic transmissions
+ *
+ * connectPorts() opens many ports without blocking the caller: every open is
+ * posted to the port's I/O thread, so ports on different threads open in
+ * parallel, and portsConnected() reports all results at once.
  */
 class SerialPortManager : public QObject {
     Q_OBJECT
@@ -24,9 +46,10 @@ class SerialPortManager : public QObject {
     explicit SerialPortManager(QObject *parent = nullptr);
     ~SerialPortManager() override;
 
-    // Port discovery
-    QStringList availablePorts() const;
-    void refreshAvailablePorts();
+    // Port discovery; the inventory is kept current without rescanning
+    PortInventory *inventory() const { return m_inventory; }
+    QStringList availablePorts() const { return m_inventory->portNames(); }
+    void refreshAvailablePorts() { m_inventory->rescan(); }
 
     // Port user management
     SerialPortUser *getUser(const QString &portName);
@@ -44,6 +67,8 @@ class SerialPortManager : public QObject {
 
     // Port settings
     void setPortRemark(const QString &portName, const QString &remark);
+    void setPortChecksum(const QString &portName, ChecksumType type);
+    ChecksumType portChecksum(const QString &portName) const;
     void updatePortSettings(const SerialPortInfo &info);
 
     // Connection management
@@ -51,36 +76,64 @@ class SerialPortManager : public QObject {
     void disconnectPort(const QString &portName);
     void disconnectAll();
 
+    // Bulk connection management; false if a bulk connect is still running
+    bool connectPorts(const QStringList &portNames);
+    void disconnectPorts(const QStringList &portNames);
+    bool isBulkConnectPending() const { return m_bulkTimer.isValid(); }
+
     // Status checking
     int onlineCount() const;
     int totalCount() const { return m_users.size(); }
 
-    // Auto-refresh settings
-    void setAutoRefresh(bool enabled);
-    void setRefreshInterval(int msec);
+    // Traffic metrics of every port user, taken in one pass
+    QList<PortMetricsSnapshot> metricsSnapshot() const;
+
+    // Periodic transmissions; jobs of a removed port are dropped with it
+    SendScheduler *sendScheduler() const { return m_sendScheduler; }
+
+    // I/O threads
+    IoWorkerPool *ioPool() const { return m_ioPool; }
+    bool setIoThreadCount(int count);
+
+    // Auto-refresh: hot-plug events where supported, otherwise polling at the given interval
+    void setAutoRefresh(bool enabled) { m_inventory->setWatching(enabled); }
+    void setRefreshInterval(int msec) { m_inventory->setPollInterval(msec); }
 
   signals:
-    void availablePortsChanged(const QStringList &ports);
+    void availablePortAdded(const QString &portName);
+    void availablePortRemoved(const QString &portName);
     void userCreated(const QString &portName);
     void userRemoved(const QString &portName);
     void userStatusChanged(const QString &portName, PortStatus status);
     void userMessageReceived(const QString &portName, const Message &message);
     void userMessageSent(const QString &portName, const Message &message);
+    void userReconnected(const QString &portName, int attempts, qint64 downtimeMs);
     void friendListChanged();
+    void portsConnected(const QList<PortConnectResult> &results, qint64 elapsedNs);
 
   private slots:
-    void onRefreshTimer();
     void onUserStatusChanged(PortStatus status);
     void onUserMessageReceived(const Message &message);
     void onUserMessageSent(const Message &message);
+    void onUserConnectFinished(bool ok, qint64 openTimeNs);
+    void onPortAdded(const PortDescriptor &port);
+    void onPortRemoved(const QString &portName);
 
   private:
     QMap<QString, SerialPortUser *> m_users;
     QMap<QString, SerialPortInfo> m_friendList;
-    QStringList m_availablePorts;
-    QTimer *m_refreshTimer;
+    IoWorkerPool *m_ioPool;
+    PortInventory *m_inventory;
+    SendScheduler *m_sendScheduler;
+
+    // Bulk connect in progress; m_bulkPending maps a port to its entry in m_bulkResults
+    QElapsedTimer m_bulkTimer;
+    QList<PortConnectResult> m_bulkResults;
+    QHash<QString, int> m_bulkPending;
+    bool m_bulkStarting;
 
-    void updateAvailablePorts();
+    void completeBulkResult(const QString &portName, bool ok, const QString &error, qint64 openTimeNs);
+    void finishBulkConnect();
 };
 
 #endif // SERIAL_PORT_MANAGER_H
@@ -1,40 +1,55 @@
 #include "SerialPortUser.h"
+#include "AutoResponder.h"
+#include "Checksum.h"
 #include "HexUtils.h"
+#include "IoWorkerPool.h"
+#include "ReconnectSupervisor.h"
+#include "SerialPortWorker.h"
+#include "Trace.h"
+#include <QEventLoop>
+#include <QMetaObject>
+#include <QThread>
+
+namespace {
+// Upper bound on messages delivered per wake-up so a flooding port cannot starve the event loop
+const int MAX_MESSAGES_PER_DRAIN = 256;
+
+// How long sendData() waits for room under TransmitPolicy::Block
+const int TRANSMIT_BLOCK_TIMEOUT_MS = 5000;
+}
 
 SerialPortUser::SerialPortUser(QObject* parent)
     : QObject(parent)
-    , m_port(nullptr)
+    , m_pool(nullptr)
+    , m_worker(nullptr)
+    , m_supervisor(new ReconnectSupervisor(this))
+    , m_autoResponder(new AutoResponder(this))
+    , m_connecting(false)
 {
 }
 
 SerialPortUser::SerialPortUser(const SerialPortInfo& info, QObject* parent)
+    : SerialPortUser(info, nullptr, parent)
+{
+}
+
+SerialPortUser::SerialPortUser(const SerialPortInfo& info, IoWorkerPool* pool, QObject* parent)
     : QObject(parent)
-    , m_port(nullptr)
+    , m_pool(pool)
+    , m_worker(nullptr)
+    , m_supervisor(new ReconnectSupervisor(this))
+    , m_autoResponder(new AutoResponder(this))
     , m_info(info)
+    , m_connecting(false)
 {
+    m_info.setStatus(PortStatus::Offline);
+    m_autoResponder->configure(m_info);
 }
 
 SerialPortUser::~SerialPortUser()
 {
     disconnect();
-    if (m_port) {
-        delete m_port;
-        m_port = nullptr;
-    }
-}
-
-PortStatus SerialPortUser::status() const
-{
-    if (!m_port) {
-        return PortStatus::Offline;
-    }
-    if (m_port->isOpen()) {
-        return PortStatus::Online;
-    }
-    if (m_port->error() != QSerialPort::NoError) {
-        return PortStatus::Error;
-    }
-    return PortStatus::Offline;
+    destroyWorker();
 }
 
 void SerialPortUser::setInfo(const SerialPortInfo& info)
@@ -43,9 +58,17 @@ void SerialPortUser::setInfo(const SerialPortInfo& info)
     if (wasOpen) {
         disconnect();
     }
-    
+
+    // Status is owned by this object, not by the caller's copy
+    PortStatus currentStatus = m_info.status();
     m_info = info;
-    
+    m_info.setStatus(currentStatus);
+    m_autoResponder->configure(m_info);
+
+    if (isReconnecting() && !m_info.autoReconnect()) {
+        disconnect();
+    }
+
     if (wasOpen) {
         connect();
     }
@@ -56,27 +79,72 @@ void SerialPortUser::setRemark(const QString& remark)
     m_info.setRemark(remark);
 }
 
+void SerialPortUser::setChecksum(ChecksumType type)
+{
+    // Takes effect with the next payload; no need to reopen the port
+    m_info.setChecksum(type);
+    m_autoResponder->configure(m_info);
+}
+
 bool SerialPortUser::connect()
 {
     if (isOnline()) {
         return true;
     }
-    
-    if (!m_port) {
-        m_port = new QSerialPort(this);
-        setupConnections();
+
+    // Waits here rather than on the I/O thread, which goes on serving the other ports
+    bool ok = false;
+    QEventLoop loop;
+    QMetaObject::Connection finished = QObject::connect(this, &SerialPortUser::connectFinished, &loop,
+                                                        [&](bool result) {
+                                                            ok = result;
+                                                            loop.quit();
+                                                        });
+    connectAsync();
+    if (m_connecting) {
+        loop.exec(QEventLoop::ExcludeUserInputEvents);
     }
-    
-    m_info.applyToPort(m_port);
-    
-    if (!m_port->open(QIODevice::ReadWrite)) {
-        m_errorString = m_port->errorString();
-        updateStatus(PortStatus::Error);
-        emit errorOccurred(m_errorString);
+    QObject::disconnect(finished);
+    return ok;
+}
+
+void SerialPortUser::connectAsync()
+{
+    if (isOnline()) {
+        emit connectFinished(true, 0);
+        return;
+    }
+    if (m_connecting) {
+        // The pending request reports for both
+        return;
+    }
+
+    ensureWorker();
+    m_connecting = true;
+    SerialPortWorker* worker = m_worker;
+    SerialPortInfo info = m_info;
+    runOnWorker([worker, info]() { worker->openAsync(info); }, false);
+}
+
+bool SerialPortUser::finishConnect(bool ok, const QString& error, const QString& peerName)
+{
+    if (!ok) {
+        m_errorString = error;
+        // A failed retry is expected while the device is still away
+        if (!isReconnecting()) {
+            updateStatus(PortStatus::Error);
+            emit errorOccurred(m_errorString);
+        }
         return false;
     }
-    
+
+    if (isOnline()) {
+        // Completed by an earlier request
+        return true;
+    }
+
     m_errorString.clear();
+    m_peerName = peerName;
     m_info.updateLastActiveTime();
     updateStatus(PortStatus::Online);
     emit connected();
@@ -85,34 +153,55 @@ bool SerialPortUser::connect()
 
 void SerialPortUser::disconnect()
 {
-    if (m_port && m_port->isOpen()) {
-        m_port->close();
-        updateStatus(PortStatus::Offline);
+    closePort(true);
+}
+
+void SerialPortUser::disconnectAsync()
+{
+    closePort(false);
+}
+
+void SerialPortUser::closePort(bool wait)
+{
+    if (!m_worker || (!isOnline() && !isReconnecting() && !m_connecting)) {
+        return;
+    }
+
+    // A pending connectAsync() is cancelled; the worker reports it as failed if it is still connecting
+    m_connecting = false;
+    SerialPortWorker* worker = m_worker;
+    runOnWorker([worker]() { worker->close(); }, wait);
+
+    // A reconnecting port has already reported the disconnect; this only ends the retries
+    bool wasOnline = isOnline();
+    m_peerName.clear();
+    updateStatus(PortStatus::Offline);
+    if (wasOnline) {
         emit disconnected();
     }
 }
 
 bool SerialPortUser::sendData(const QByteArray& data)
 {
-    if (!isOnline()) {
+    // While reconnecting, data is queued and sent once the port is back
+    if (!isOnline() && !isReconnecting()) {
         m_errorString = tr("Port is not open");
         emit errorOccurred(m_errorString);
         return false;
     }
-    
-    qint64 bytesWritten = m_port->write(data);
-    if (bytesWritten == -1) {
-        m_errorString = m_port->errorString();
+
+    // Blocking is only possible when the worker runs on another thread
+    int timeoutMs = 0;
+    if (m_info.transmitPolicy() == TransmitPolicy::Block && m_worker->thread() != QThread::currentThread()) {
+        timeoutMs = TRANSMIT_BLOCK_TIMEOUT_MS;
+    }
+
+    // The Sent message comes back through the worker queue once it has been written
+    if (!m_worker->enqueueWrite(Checksum::append(m_info.checksum(), data), timeoutMs)) {
+        m_errorString = tr("Transmit queue is full");
         emit errorOccurred(m_errorString);
         return false;
     }
-    
-    m_port->flush();
-    m_info.updateLastActiveTime();
-    
-    Message msg(m_info.portName(), data, MessageDirection::Sent);
-    emit messageSent(msg);
-    
     return true;
 }
 
@@ -132,53 +221,184 @@ bool SerialPortUser::sendHex(const QString& hexString)
     return sendData(data);
 }
 
-QByteArray SerialPortUser::readAll()
+int SerialPortUser::pendingTransmitCount() const
 {
-    QByteArray data = m_receiveBuffer;
-    m_receiveBuffer.clear();
-    return data;
+    return m_worker ? m_worker->pendingWriteCount() : 0;
 }
 
-void SerialPortUser::setupConnections()
+double SerialPortUser::transmitUtilization() const
 {
-    if (!m_port) return;
-    
-    QObject::connect(m_port, &QSerialPort::readyRead,
-                     this, &SerialPortUser::onReadyRead);
-    QObject::connect(m_port, &QSerialPort::errorOccurred,
-                     this, &SerialPortUser::onErrorOccurred);
+    return m_worker ? m_worker->transmitUtilization() : 0.0;
 }
 
-void SerialPortUser::onReadyRead()
+qint64 SerialPortUser::receiveBufferHighWaterMark() const
 {
-    QByteArray data = m_port->readAll();
-    if (!data.isEmpty()) {
-        m_receiveBuffer.append(data);
-        m_info.updateLastActiveTime();
-        
-        Message msg(m_info.portName(), data, MessageDirection::Received);
-        emit dataReceived(data);
-        emit messageReceived(msg);
+    return m_worker ? m_worker->receiveHighWaterMark() : 0;
+}
+
+qint64 SerialPortUser::receiveBufferDroppedBytes() const
+{
+    return m_worker ? m_worker->receiveDroppedBytes() : 0;
+}
+
+PortMetricsSnapshot SerialPortUser::metrics() const
+{
+    PortMetricsSnapshot snapshot;
+    if (m_worker) {
+        snapshot = m_worker->metrics();
+    }
+    snapshot.portName = portName();
+    snapshot.status = status();
+
+    // The worker stops sampling on close, which would freeze the last rates
+    if (!isOnline() && !isReconnecting()) {
+        snapshot.rxByteRate = RateAverages();
+        snapshot.txByteRate = RateAverages();
+        snapshot.rxFrameRate = RateAverages();
+        snapshot.txFrameRate = RateAverages();
     }
+
+    const LatencyHistogram& replyLatency = m_autoResponder->latency();
+    snapshot.autoReplies = m_autoResponder->replyCount();
+    snapshot.autoReplyP50Ns = replyLatency.percentile(50);
+    snapshot.autoReplyP99Ns = replyLatency.percentile(99);
+    return snapshot;
 }
 
-void SerialPortUser::onErrorOccurred(QSerialPort::SerialPortError error)
+void SerialPortUser::ensureWorker()
 {
-    if (error == QSerialPort::NoError) {
+    if (m_worker) {
         return;
     }
-    
-    m_errorString = m_port->errorString();
-    
-    if (error == QSerialPort::ResourceError) {
-        // Device was removed
-        disconnect();
+
+    m_worker = new SerialPortWorker();
+    if (m_pool) {
+        m_worker->moveToThread(m_pool->acquire(m_info.portName()));
+    }
+
+    QObject::connect(m_worker, &SerialPortWorker::messagesAvailable,
+                     this, &SerialPortUser::onMessagesAvailable);
+    QObject::connect(m_worker, &SerialPortWorker::errorOccurred,
+                     this, &SerialPortUser::onWorkerError);
+    QObject::connect(m_worker, &SerialPortWorker::opened,
+                     this, &SerialPortUser::onWorkerOpened);
+}
+
+void SerialPortUser::destroyWorker()
+{
+    if (!m_worker) {
+        return;
+    }
+
+    QObject::disconnect(m_worker, nullptr, this, nullptr);
+    if (m_worker->thread() == QThread::currentThread()) {
+        delete m_worker;
+    } else {
+        // The transport must be destroyed on the thread it lives on
+        m_worker->deleteLater();
+    }
+    m_worker = nullptr;
+
+    if (m_pool) {
+        m_pool->release(m_info.portName());
+    }
+}
+
+template <typename Func> void SerialPortUser::runOnWorker(Func func, bool blocking)
+{
+    if (m_worker->thread() == QThread::currentThread()) {
+        func();
+    } else {
+        QMetaObject::invokeMethod(m_worker, func, blocking ? Qt::BlockingQueuedConnection : Qt::QueuedConnection);
+    }
+}
+
+void SerialPortUser::onMessagesAvailable()
+{
+    TRACE_SCOPE("SerialPortUser::onMessagesAvailable");
+    if (!m_worker) {
+        return;
+    }
+
+    // Re-arm before draining so data pushed while we drain triggers another wake-up
+    m_worker->rearmNotification();
+
+    ChecksumType checksum = m_info.checksum();
+    bool verify = checksum != ChecksumType::None && m_info.framing().mode() != FramingMode::None;
+
+    Message msg;
+    int delivered = 0;
+    while (delivered < MAX_MESSAGES_PER_DRAIN && m_worker->takeMessage(msg)) {
+        delivered++;
+
+        if (msg.direction() == MessageDirection::Received) {
+            if (verify) {
+                msg.setChecksumStatus(Checksum::verify(checksum, msg.data()) ? ChecksumStatus::Valid
+                                                                            : ChecksumStatus::Invalid);
+            }
+            m_autoResponder->process(msg);
+            TRACE_SCOPE("SerialPortUser::messageReceived");
+            emit dataReceived(msg.data());
+            emit messageReceived(msg);
+        } else {
+            emit messageSent(msg);
+        }
+    }
+
+    // Once per batch; the last message carries the latest timestamp
+    if (delivered > 0) {
+        m_info.updateLastActiveTime(msg.timestampNs());
+    }
+
+    if (delivered == MAX_MESSAGES_PER_DRAIN && m_worker->pendingCount() > 0) {
+        QMetaObject::invokeMethod(this, &SerialPortUser::onMessagesAvailable, Qt::QueuedConnection);
+    }
+}
+
+void SerialPortUser::onWorkerError(const QString& error, bool fatal)
+{
+    m_errorString = error;
+
+    if (fatal && isOnline()) {
+        // Device was removed; the worker has already closed the port
+        m_peerName.clear();
+        if (m_info.autoReconnect()) {
+            // The worker keeps the transmit queue for the reconnect
+            updateStatus(PortStatus::Reconnecting);
+            emit disconnected();
+            emit connectionLost(m_errorString);
+            emit errorOccurred(m_errorString);
+            return;
+        }
+
+        SerialPortWorker* worker = m_worker;
+        runOnWorker([worker]() { worker->close(); }, false);
+        updateStatus(PortStatus::Offline);
+        emit disconnected();
+    }
+
+    // Transient errors (parity, framing, ...) leave an open port usable
+    if (!isOnline()) {
+        updateStatus(PortStatus::Error);
     }
-    
-    updateStatus(PortStatus::Error);
     emit errorOccurred(m_errorString);
 }
 
+void SerialPortUser::onWorkerOpened(bool ok, const QString& error, const QString& peerName, qint64 openTimeNs)
+{
+    if (!m_connecting) {
+        // Disconnected while the open was pending; the worker has closed the port again
+        if (!isOnline()) {
+            m_errorString = tr("Connect was cancelled");
+        }
+        emit connectFinished(isOnline(), openTimeNs);
+        return;
+    }
+
+    m_connecting = false;
+    emit connectFinished(finishConnect(ok, error, peerName), openTimeNs);
+}
+
 void SerialPortUser::updateStatus(PortStatus status)
 {
     m_info.setStatus(status);
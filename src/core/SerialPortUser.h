@@ -2,17 +2,37 @@
 #define SERIAL_PORT_USER_H
 
 #include <QObject>
-#include <QSerialPort>
 #include <QByteArray>
-#include <QTimer>
 #include "SerialPortInfo.h"
 #include "Message.h"
+#include "PortMetrics.h"
+
+class AutoResponder;
+class IoWorkerPool;
+class ReconnectSupervisor;
+class SerialPortWorker;
 
 /**
  * @brief Represents a serial port "user" that can send and receive messages
- * 
- * This class wraps a QSerialPort and provides chat-like functionality,
- * treating the serial port as a user in a messaging system.
+ *
+ * This class provides chat-like functionality on top of a serial port,
+ * treating the serial port as a user in a messaging system. The port itself
+ * is driven by a SerialPortWorker on an I/O thread from the IoWorkerPool;
+ * this object stays on the thread that created it and receives completed
+ * messages through the worker's lock-free queue.
+ *
+ * If the connection is lost and SerialPortInfo::autoReconnect() is set, the
+ * port goes to PortStatus::Reconnecting instead of Error and its
+ * ReconnectSupervisor reopens it. Data sent in the meantime is queued and
+ * goes out once the port is back.
+ *
+ * With SerialPortInfo::checksum() set, sendData() appends the checksum to
+ * every payload and received frames are verified (Message::checksumStatus());
+ * unframed reads are not checked, as they need not end where a frame does.
+ *
+ * Received data passes through the port's AutoResponder first, which answers
+ * the patterns of SerialPortInfo::autoReplies() without a round trip through
+ * the UI.
  */
 class SerialPortUser : public QObject {
     Q_OBJECT
@@ -20,38 +40,60 @@ class SerialPortUser : public QObject {
 public:
     explicit SerialPortUser(QObject* parent = nullptr);
     explicit SerialPortUser(const SerialPortInfo& info, QObject* parent = nullptr);
+    SerialPortUser(const SerialPortInfo& info, IoWorkerPool* pool, QObject* parent = nullptr);
     ~SerialPortUser() override;
-    
+
     // Port information
     SerialPortInfo info() const { return m_info; }
     QString portName() const { return m_info.portName(); }
     QString displayName() const { return m_info.displayName(); }
-    
+
     // Status
-    bool isOnline() const { return m_port && m_port->isOpen(); }
-    PortStatus status() const;
+    bool isOnline() const { return m_info.isOnline(); }
+    bool isReconnecting() const { return m_info.status() == PortStatus::Reconnecting; }
+    PortStatus status() const { return m_info.status(); }
     QString errorString() const { return m_errorString; }
-    
+
+    // Device to open for the other end of a loopback port (e.g. /dev/pts/7), empty otherwise
+    QString peerName() const { return m_peerName; }
+
+    // Reconnect count and downtime live on the supervisor
+    ReconnectSupervisor* reconnectSupervisor() const { return m_supervisor; }
+
+    // Auto-reply rules come from the port settings; counters and latency live on the responder
+    AutoResponder* autoResponder() const { return m_autoResponder; }
+
     // Settings
     void setInfo(const SerialPortInfo& info);
     void setRemark(const QString& remark);
-    
-    // Connection management
+    void setChecksum(ChecksumType type);
+
+    // Connection management; the async variants return at once and leave the work to the I/O thread.
+    // connect() waits for connectAsync() in a local event loop that skips user input
     bool connect();
+    void connectAsync();
     void disconnect();
-    
+    void disconnectAsync();
+
     // Data transmission
     bool sendData(const QByteArray& data);
     bool sendText(const QString& text);
     bool sendHex(const QString& hexString);
-    
-    // Receive buffer
-    QByteArray readAll();
-    bool hasData() const { return !m_receiveBuffer.isEmpty(); }
+    int pendingTransmitCount() const;
+    double transmitUtilization() const;
+
+    // Receive buffer statistics (bytes held by the worker's ring buffer)
+    qint64 receiveBufferHighWaterMark() const;
+    qint64 receiveBufferDroppedBytes() const;
+
+    // Traffic counters and rates; the rates read zero while the port is closed
+    PortMetricsSnapshot metrics() const;
 
 signals:
     void connected();
+    void connectFinished(bool ok, qint64 openTimeNs);
     void disconnected();
+    void connectionLost(const QString& error);
     void dataReceived(const QByteArray& data);
     void messageSent(const Message& message);
     void messageReceived(const Message& message);
@@ -59,16 +101,25 @@ signals:
     void errorOccurred(const QString& error);
 
 private slots:
-    void onReadyRead();
-    void onErrorOccurred(QSerialPort::SerialPortError error);
+    void onMessagesAvailable();
+    void onWorkerError(const QString& error, bool fatal);
+    void onWorkerOpened(bool ok, const QString& error, const QString& peerName, qint64 openTimeNs);
 
 private:
-    QSerialPort* m_port;
+    IoWorkerPool* m_pool;
+    SerialPortWorker* m_worker;
+    ReconnectSupervisor* m_supervisor;
+    AutoResponder* m_autoResponder;
     SerialPortInfo m_info;
-    QByteArray m_receiveBuffer;
     QString m_errorString;
-    
-    void setupConnections();
+    QString m_peerName;
+    bool m_connecting;
+
+    bool finishConnect(bool ok, const QString& error, const QString& peerName);
+    void closePort(bool wait);
+    void ensureWorker();
+    void destroyWorker();
+    template <typename Func> void runOnWorker(Func func, bool blocking);
     void updateStatus(PortStatus status);
 };
 
@@ -0,0 +1,635 @@
+#include "SerialPortWorker.h"
+#include "TimeUtils.h"
+#include "Trace.h"
+#include <QMetaObject>
+#include <QThread>
+
+namespace {
+// Upper bound for SerialPortInfo::transmitQueueDepth()
+const int MAX_TRANSMIT_QUEUE_DEPTH = 4096;
+
+// Small payloads are merged into writes of up to this size
+const int TRANSMIT_COALESCE_LIMIT = 4096;
+
+// Bytes kept inside the transport; the rest waits in the transmit queue
+const qint64 TRANSMIT_IN_FLIGHT_LIMIT = 4096;
+
+// Pacing waits shorter than this are spun out instead of using a timer
+const qint64 PACING_SPIN_THRESHOLD_NS = 1000000;
+
+// Longest a single pacing wake-up may spin before yielding to the event loop
+const qint64 PACING_SPIN_BUDGET_NS = 2000000;
+
+// Interval of the utilization metric
+const int STATISTICS_INTERVAL_MS = 1000;
+
+// Interval at which traffic rates and line errors are sampled
+const int METRICS_INTERVAL_MS = 250;
+} // namespace
+
+SerialPortWorker::SerialPortWorker(QObject *parent)
+    : QObject(parent), m_transport(nullptr), m_rxHighWaterMark(0), m_rxDroppedBytes(0),
+      m_idleGapTimer(new QTimer(this)), m_rxDecoder(nullptr), m_txDecoder(nullptr), m_lastReadNs(0), m_coalesceTimer(new QTimer(this)), m_coalesceMaxBytes(0),
+      m_windowStartNs(0), m_txQueue(MAX_TRANSMIT_QUEUE_DEPTH), m_txSlots(0), m_txDepth(0),
+      m_txWakePending(false), m_opening(false), m_openStartNs(0), m_suspended(false), m_pacingTimer(new QTimer(this)), m_txOffset(0),
+      m_statsTimer(new QTimer(this)), m_txBytesSinceUpdate(0), m_lastUpdateNs(0), m_txUtilization(0.0),
+      m_metricsTimer(new QTimer(this)), m_retryTimer(new QTimer(this)), m_notifyPending(false) {
+    m_clock.start();
+
+    m_idleGapTimer->setSingleShot(true);
+    m_idleGapTimer->setTimerType(Qt::PreciseTimer);
+    QObject::connect(m_idleGapTimer, &QTimer::timeout, this, &SerialPortWorker::onIdleGapTimeout);
+
+    m_coalesceTimer->setSingleShot(true);
+    m_coalesceTimer->setTimerType(Qt::PreciseTimer);
+    m_coalesceTimer->setInterval(0);
+    QObject::connect(m_coalesceTimer, &QTimer::timeout, this, &SerialPortWorker::onCoalesceTimeout);
+
+    m_pacingTimer->setSingleShot(true);
+    m_pacingTimer->setTimerType(Qt::PreciseTimer);
+    QObject::connect(m_pacingTimer, &QTimer::timeout, this, &SerialPortWorker::processTransmitQueue);
+
+    m_statsTimer->setInterval(STATISTICS_INTERVAL_MS);
+    QObject::connect(m_statsTimer, &QTimer::timeout, this, &SerialPortWorker::updateStatistics);
+
+    m_metricsTimer->setInterval(METRICS_INTERVAL_MS);
+    QObject::connect(m_metricsTimer, &QTimer::timeout, this, &SerialPortWorker::sampleMetrics);
+
+    m_retryTimer->setSingleShot(true);
+    m_retryTimer->setInterval(1);
+    QObject::connect(m_retryTimer, &QTimer::timeout, this, &SerialPortWorker::resumeDelivery);
+}
+
+SerialPortWorker::~SerialPortWorker() {
+    close();
+    delete m_rxDecoder;
+    delete m_txDecoder;
+}
+
+void SerialPortWorker::openAsync(const SerialPortInfo &info) {
+    if (m_opening) {
+        // The pending open reports for both
+        return;
+    }
+    m_openStartNs = m_clock.nsecsElapsed();
+    if (isOpen()) {
+        emit opened(true, QString(), peerName(), 0);
+        return;
+    }
+
+    QString framingError = info.framing().validationError();
+    if (!framingError.isEmpty()) {
+        emit opened(false, framingError, QString(), m_clock.nsecsElapsed() - m_openStartNs);
+        return;
+    }
+
+    if (!createTransport(info.transport().type())) {
+        emit opened(false, QStringLiteral("Transport not supported on this platform"), QString(),
+                    m_clock.nsecsElapsed() - m_openStartNs);
+        return;
+    }
+
+    m_portName = info.portName();
+    configureReceiveBuffer(info);
+    m_framer.setConfig(info.framing());
+    configureDecoders(info);
+    m_idleGapTimer->setInterval(qMax(1, info.framing().idleGapMs()));
+    m_coalesceTimer->setInterval(qMax(0, info.coalesceWindowMs()));
+    m_coalesceMaxBytes = qMax(0, info.coalesceMaxBytes());
+    m_rxChunks.clear();
+    configureTransmitQueue(info);
+
+    m_opening = true;
+    m_transport->openAsync(info);
+}
+
+void SerialPortWorker::onTransportOpened(bool ok) {
+    if (!m_opening) {
+        // Cancelled by close()
+        return;
+    }
+    m_opening = false;
+
+    if (!ok) {
+        emit opened(false, m_transport->errorString(), QString(), m_clock.nsecsElapsed() - m_openStartNs);
+        return;
+    }
+
+    m_txBytesSinceUpdate = 0;
+    m_lastUpdateNs = m_clock.nsecsElapsed();
+    m_txUtilization.store(0.0, std::memory_order_relaxed);
+    m_statsTimer->start();
+
+    if (!m_suspended) {
+        m_metrics.reset(m_clock.nsecsElapsed());
+        m_lineErrorsBefore = LineErrorCounts();
+        m_lineErrors = LineErrorCounts();
+    }
+    m_metricsTimer->start();
+
+    // Reopened after a lost connection: send what was kept back
+    if (m_suspended) {
+        m_suspended = false;
+        processTransmitQueue();
+    }
+    emit opened(true, QString(), peerName(), m_clock.nsecsElapsed() - m_openStartNs);
+}
+
+void SerialPortWorker::close() {
+    if (m_transport) {
+        m_transport->close();
+    }
+    if (m_opening) {
+        m_opening = false;
+        emit opened(false, QStringLiteral("Connect was cancelled"), QString(), m_clock.nsecsElapsed() - m_openStartNs);
+    }
+    m_idleGapTimer->stop();
+    m_coalesceTimer->stop();
+    m_statsTimer->stop();
+    m_metricsTimer->stop();
+    m_suspended = false;
+    discardWrites();
+}
+
+void SerialPortWorker::suspend() {
+    m_suspended = true;
+    m_statsTimer->stop();
+
+    // The next connection counts line errors from zero again
+    m_lineErrorsBefore = m_lineErrors;
+
+    // Deliver what has already arrived; a frame cut off by the disconnect can never be completed
+    m_coalesceTimer->stop();
+    drainReceiveBuffer();
+    m_idleGapTimer->stop();
+    if (m_framer.mode() == FramingMode::IdleGap) {
+        onIdleGapTimeout();
+    } else {
+        m_framer.reset();
+    }
+    if (m_rxDecoder) {
+        m_rxDecoder->reset();
+    }
+    if (m_txDecoder) {
+        m_txDecoder->reset();
+    }
+
+    // Nothing is known about how much of the in-flight data arrived; send those payloads again in full
+    QList<QByteArray> held;
+    for (const PendingWrite &pending : qAsConst(m_inFlight)) {
+        held.append(pending.data);
+    }
+    m_txHeld = held + m_txHeld;
+    m_inFlight.clear();
+    m_txCurrent.clear();
+    m_txOffset = 0;
+    m_pacingTimer->stop();
+    m_pacer.reset();
+}
+
+bool SerialPortWorker::createTransport(TransportType type) {
+    if (m_transport && m_transport->type() == type) {
+        return true;
+    }
+
+    delete m_transport;
+    m_transport = PortTransport::create(type, this);
+    if (!m_transport) {
+        return false;
+    }
+
+    QObject::connect(m_transport, &PortTransport::openFinished, this, &SerialPortWorker::onTransportOpened);
+    QObject::connect(m_transport, &PortTransport::readyRead, this, &SerialPortWorker::onReadyRead);
+    QObject::connect(m_transport, &PortTransport::errorOccurred, this, &SerialPortWorker::onTransportError);
+    QObject::connect(m_transport, &PortTransport::bytesWritten, this, &SerialPortWorker::onBytesWritten);
+    return true;
+}
+
+bool SerialPortWorker::enqueueWrite(const QByteArray &data, int timeoutMs) {
+    if (!m_txSlots.tryAcquire(1, timeoutMs)) {
+        return false;
+    }
+
+    // Holding a slot guarantees room: the queue is at least as large as the depth limit
+    m_txQueue.tryPush(data);
+    if (!m_txWakePending.exchange(true, std::memory_order_seq_cst)) {
+        QMetaObject::invokeMethod(this, &SerialPortWorker::processTransmitQueue, Qt::QueuedConnection);
+    }
+    return true;
+}
+
+void SerialPortWorker::configureTransmitQueue(const SerialPortInfo &info) {
+    // Resuming with an unchanged depth keeps the queued payloads; anything else starts empty
+    int depth = qBound(1, info.transmitQueueDepth(), MAX_TRANSMIT_QUEUE_DEPTH);
+    if (m_suspended && depth == m_txDepth) {
+        m_pacer.configure(info.pacing(), info.characterTimeNs());
+        return;
+    }
+    m_suspended = false;
+    discardWrites();
+
+    // Every slot is free now, so the limit can be changed by adding or taking the difference
+    if (depth > m_txDepth) {
+        m_txSlots.release(depth - m_txDepth);
+    } else if (depth < m_txDepth) {
+        m_txSlots.acquire(m_txDepth - depth);
+    }
+    m_txDepth = depth;
+
+    m_pacer.configure(info.pacing(), info.characterTimeNs());
+}
+
+void SerialPortWorker::processTransmitQueue() {
+    m_txWakePending.store(false, std::memory_order_seq_cst);
+
+    if (!isOpen()) {
+        // Payloads queued while the connection is down wait for the reopen
+        if (!m_suspended) {
+            discardWrites();
+        }
+        return;
+    }
+    fillWriteBuffer();
+}
+
+bool SerialPortWorker::takePayload(QByteArray &payload) {
+    m_metrics.recordTransmitQueue(pendingWriteCount());
+    if (!m_txHeld.isEmpty()) {
+        payload = m_txHeld.takeFirst();
+        return true;
+    }
+    return m_txQueue.tryPop(payload);
+}
+
+void SerialPortWorker::fillWriteBuffer() {
+    if (m_pacer.isEnabled()) {
+        fillPacedWriteBuffer();
+        return;
+    }
+
+    while (isOpen() && m_transport->bytesToWrite() < TRANSMIT_IN_FLIGHT_LIMIT) {
+        // Merge queued payloads into one write; a single payload is shared, not copied.
+        // Datagram transports send each payload on its own to keep message boundaries.
+        int limit = m_transport->isDatagram() ? 1 : TRANSMIT_COALESCE_LIMIT;
+        QByteArray chunk;
+        QByteArray payload;
+        bool popped = false;
+        while (chunk.size() < limit && takePayload(payload)) {
+            chunk.append(payload);
+            m_inFlight.append({payload, payload.size()});
+            popped = true;
+        }
+
+        if (chunk.isEmpty()) {
+            if (popped) {
+                // Only empty payloads; nothing will be written for them
+                completeWrites(0);
+            }
+            return;
+        }
+
+        if (m_transport->write(chunk.constData(), chunk.size()) == -1) {
+            writeFailed();
+            return;
+        }
+    }
+}
+
+void SerialPortWorker::fillPacedWriteBuffer() {
+    qint64 spinDeadline = m_clock.nsecsElapsed() + PACING_SPIN_BUDGET_NS;
+
+    while (isOpen() && m_transport->bytesToWrite() < TRANSMIT_IN_FLIGHT_LIMIT) {
+        if (m_txOffset >= m_txCurrent.size()) {
+            QByteArray payload;
+            if (!takePayload(payload)) {
+                return;
+            }
+            m_inFlight.append({payload, payload.size()});
+            m_txCurrent = payload;
+            m_txOffset = 0;
+            if (payload.isEmpty()) {
+                completeWrites(0);
+                continue;
+            }
+        }
+
+        qint64 now = m_clock.nsecsElapsed();
+        qint64 delay = m_pacer.delayNs(now);
+        if (delay > 0) {
+            if (delay >= PACING_SPIN_THRESHOLD_NS || now + delay > spinDeadline) {
+                // Wake up slightly early and spin the sub-millisecond remainder
+                m_pacingTimer->start(static_cast<int>(delay / 1000000));
+                return;
+            }
+            while (m_clock.nsecsElapsed() < now + delay) {
+                QThread::yieldCurrentThread();
+            }
+            now = m_clock.nsecsElapsed();
+        }
+
+        qint64 remaining = m_txCurrent.size() - m_txOffset;
+        qint64 length = m_transport->isDatagram() ? remaining : m_pacer.releasable(now, remaining);
+        if (m_transport->write(m_txCurrent.constData() + m_txOffset, length) == -1) {
+            writeFailed();
+            return;
+        }
+        m_txOffset += static_cast<int>(length);
+        m_pacer.commit(now, length, m_txOffset >= m_txCurrent.size());
+    }
+}
+
+void SerialPortWorker::writeFailed() {
+    // A fatal error raised by the write has already suspended the worker and kept the payloads
+    if (m_suspended) {
+        return;
+    }
+    emit errorOccurred(m_transport->errorString(), false);
+    discardWrites();
+}
+
+void SerialPortWorker::onBytesWritten(qint64 bytes) {
+    m_txBytesSinceUpdate += bytes;
+    m_metrics.countSent(bytes);
+    completeWrites(bytes);
+    fillWriteBuffer();
+}
+
+void SerialPortWorker::updateStatistics() {
+    qint64 now = m_clock.nsecsElapsed();
+    qint64 elapsed = now - m_lastUpdateNs;
+    if (elapsed <= 0) {
+        return;
+    }
+
+    double utilization = static_cast<double>(m_pacer.wireTimeNs(m_txBytesSinceUpdate)) / elapsed;
+    m_txUtilization.store(qMin(1.0, utilization), std::memory_order_relaxed);
+    m_txBytesSinceUpdate = 0;
+    m_lastUpdateNs = now;
+}
+
+void SerialPortWorker::sampleMetrics() {
+    // Keeps sampling while suspended so the rates fall to zero during an outage
+    if (isOpen()) {
+        m_lineErrors = m_lineErrorsBefore + m_transport->lineErrors();
+        m_metrics.setLineErrors(m_lineErrors);
+    }
+    m_metrics.sample(m_clock.nsecsElapsed());
+}
+
+PortMetricsSnapshot SerialPortWorker::metrics() const {
+    PortMetricsSnapshot snapshot;
+    m_metrics.snapshot(&snapshot);
+    snapshot.rxQueueDepth = static_cast<qint64>(m_queue.size());
+    snapshot.txQueueDepth = pendingWriteCount();
+    snapshot.rxDroppedBytes = receiveDroppedBytes();
+    return snapshot;
+}
+
+void SerialPortWorker::completeWrites(qint64 bytes) {
+    qint64 now = 0;
+    while (!m_inFlight.isEmpty()) {
+        PendingWrite &pending = m_inFlight.first();
+        qint64 written = qMin(bytes, pending.remaining);
+        pending.remaining -= written;
+        bytes -= written;
+        if (pending.remaining > 0) {
+            break;
+        }
+
+        if (now == 0) {
+            now = TimeUtils::timestampNs();
+        }
+        publish(Message(m_portName, pending.data, MessageDirection::Sent, now));
+        m_inFlight.removeFirst();
+        m_txSlots.release();
+    }
+}
+
+void SerialPortWorker::discardWrites() {
+    QByteArray payload;
+    while (m_txQueue.tryPop(payload)) {
+        m_txSlots.release();
+    }
+
+    m_txSlots.release(m_inFlight.size() + m_txHeld.size());
+    m_inFlight.clear();
+    m_txHeld.clear();
+
+    m_txCurrent.clear();
+    m_txOffset = 0;
+    m_pacingTimer->stop();
+    m_pacer.reset();
+}
+
+void SerialPortWorker::configureReceiveBuffer(const SerialPortInfo &info) {
+    int slabSize = SlabRingBuffer::DEFAULT_SLAB_SIZE;
+    int slabCount = qMax(1, info.receiveBufferSize() / slabSize);
+
+    if (m_rxRing.slabSize() != slabSize || m_rxRing.slabCount() != slabCount) {
+        m_rxRing = SlabRingBuffer(slabSize, slabCount, info.overflowPolicy());
+    } else {
+        m_rxRing.clear();
+        m_rxRing.setPolicy(info.overflowPolicy());
+    }
+    m_rxRing.resetHighWaterMark();
+
+    // Keep the transport's own buffer small so unread data stays in the driver, not on the heap
+    m_transport->setReadBufferSize(slabSize);
+}
+
+void SerialPortWorker::configureDecoders(const SerialPortInfo &info) {
+    delete m_rxDecoder;
+    delete m_txDecoder;
+    m_rxDecoder = ProtocolDecoder::create(info.decoder(), MessageDirection::Received);
+    m_txDecoder = ProtocolDecoder::create(info.decoder(), MessageDirection::Sent);
+}
+
+void SerialPortWorker::decode(Message &message) {
+    bool received = message.direction() == MessageDirection::Received;
+    ProtocolDecoder *decoder = received ? m_rxDecoder : m_txDecoder;
+    if (!decoder) {
+        return;
+    }
+
+    decoder->feed(message.data(), m_records);
+    // A received frame ends where the framer says it does
+    if (received && m_framer.mode() != FramingMode::None) {
+        decoder->finish(m_records);
+    }
+    if (!m_records.isEmpty()) {
+        message.setRecords(m_records);
+        m_records.clear();
+    }
+}
+
+void SerialPortWorker::onReadyRead() {
+    TRACE_SCOPE("SerialPortWorker::onReadyRead");
+    readIntoRing();
+    drainReceiveBuffer();
+}
+
+void SerialPortWorker::readIntoRing() {
+    qint64 offset = m_rxRing.size();
+    qint64 droppedBefore = m_rxRing.droppedBytes();
+    qint64 readNs = 0;
+
+    while (isOpen() && m_transport->bytesAvailable() > 0) {
+        qint64 contiguous = 0;
+        char *dest = m_rxRing.writePointer(&contiguous);
+        if (!dest) {
+            // Backpressure: leave the rest in the driver until the consumer catches up
+            scheduleRetry();
+            break;
+        }
+
+        qint64 bytesRead = m_transport->read(dest, contiguous);
+        if (bytesRead <= 0) {
+            break;
+        }
+        if (readNs == 0) {
+            readNs = TimeUtils::timestampNs();
+        }
+        m_rxRing.commit(bytesRead);
+        m_metrics.countReceived(bytesRead);
+    }
+
+    if (readNs != 0) {
+        m_lastReadNs = readNs;
+    }
+    if (isCoalescing() && m_rxRing.size() > offset) {
+        recordChunk(offset, m_rxRing.droppedBytes() - droppedBefore, m_lastReadNs);
+    }
+
+    m_rxHighWaterMark.store(m_rxRing.highWaterMark(), std::memory_order_relaxed);
+    m_rxDroppedBytes.store(m_rxRing.droppedBytes(), std::memory_order_relaxed);
+}
+
+void SerialPortWorker::drainReceiveBuffer() {
+    TRACE_SCOPE("SerialPortWorker::drainReceiveBuffer");
+    bool fed = false;
+    while (!m_rxRing.isEmpty()) {
+        if (!m_backlog.isEmpty() || m_queue.isFull()) {
+            // Leave the bytes in the ring until the consumer has made room
+            scheduleRetry();
+            break;
+        }
+
+        if (m_framer.mode() == FramingMode::None) {
+            if (!isCoalescing()) {
+                publish(Message(m_portName, m_rxRing.readAll(), MessageDirection::Received, m_lastReadNs));
+                continue;
+            }
+
+            // Keep the window open until it times out, the byte limit is hit or the ring is full
+            bool limitReached = m_coalesceMaxBytes > 0 && m_rxRing.size() >= m_coalesceMaxBytes;
+            if (m_coalesceTimer->isActive() && !limitReached && !m_rxRing.isFull()) {
+                break;
+            }
+
+            Message message(m_portName, m_rxRing.readAll(), MessageDirection::Received, m_windowStartNs);
+            message.setChunks(m_rxChunks);
+            m_rxChunks.clear();
+            m_coalesceTimer->stop();
+            publish(std::move(message));
+            continue;
+        }
+
+        // Frame straight out of the ring, one contiguous span at a time
+        qint64 contiguous = 0;
+        const char *data = m_rxRing.readPointer(&contiguous);
+        m_framer.feed(data, contiguous, m_frames);
+        m_rxRing.consume(contiguous);
+        fed = true;
+        publishFrames();
+    }
+
+    // Every new byte restarts the idle gap
+    if (fed && m_framer.mode() == FramingMode::IdleGap && m_framer.hasPartialFrame()) {
+        m_idleGapTimer->start();
+    }
+}
+
+void SerialPortWorker::publishFrames() {
+    for (const QByteArray &frame : qAsConst(m_frames)) {
+        publish(Message(m_portName, frame, MessageDirection::Received, m_lastReadNs));
+    }
+    m_frames.clear();
+}
+
+void SerialPortWorker::recordChunk(qint64 offset, qint64 droppedBytes, qint64 readNs) {
+    if (m_rxChunks.isEmpty()) {
+        m_windowStartNs = readNs;
+        m_coalesceTimer->start();
+    }
+
+    // With the Overwrite policy older bytes may have been dropped to make room;
+    // chunks that lost their beginning now start at offset 0
+    for (MessageChunk &chunk : m_rxChunks) {
+        chunk.byteOffset = static_cast<int>(qMax(qint64(0), chunk.byteOffset - droppedBytes));
+    }
+    m_rxChunks.append({static_cast<int>(qMax(qint64(0), offset - droppedBytes)), readNs - m_windowStartNs});
+
+    // Keep only the most recent of the chunks that collapsed onto offset 0
+    while (m_rxChunks.size() > 1 && m_rxChunks.at(1).byteOffset == 0) {
+        m_rxChunks.removeFirst();
+    }
+}
+
+void SerialPortWorker::onCoalesceTimeout() { drainReceiveBuffer(); }
+
+void SerialPortWorker::onIdleGapTimeout() {
+    m_framer.flush(m_frames);
+    publishFrames();
+}
+
+void SerialPortWorker::onTransportError(const QString &error, bool fatal) {
+    // The transport has already closed itself; keep the transmit state for a reconnect
+    if (fatal) {
+        suspend();
+    }
+
+    emit errorOccurred(error, fatal);
+}
+
+void SerialPortWorker::publish(Message &&message) {
+    decode(message);
+
+    if (message.direction() == MessageDirection::Received) {
+        m_metrics.countReceivedFrame();
+    } else {
+        m_metrics.countSentFrame();
+    }
+
+    // Keep ordering: anything already waiting in the backlog goes first
+    if (!m_backlog.isEmpty() || !m_queue.tryPush(std::move(message))) {
+        m_backlog.append(message);
+        scheduleRetry();
+    } else {
+        notify();
+    }
+    m_metrics.recordReceiveQueue(static_cast<qint64>(m_queue.size()) + m_backlog.size());
+}
+
+void SerialPortWorker::resumeDelivery() {
+    while (!m_backlog.isEmpty() && m_queue.tryPush(m_backlog.first())) {
+        m_backlog.removeFirst();
+    }
+    notify();
+
+    drainReceiveBuffer();
+    readIntoRing();
+    drainReceiveBuffer();
+}
+
+void SerialPortWorker::scheduleRetry() {
+    // The consumer frees space asynchronously, so poll until it has caught up
+    if (!m_retryTimer->isActive()) {
+        m_retryTimer->start();
+    }
+}
+
+void SerialPortWorker::notify() {
+    if (!m_notifyPending.exchange(true, std::memory_order_seq_cst)) {
+        emit messagesAvailable();
+    }
+}
@@ -0,0 +1,227 @@
+#ifndef SERIAL_PORT_WORKER_H
+#define SERIAL_PORT_WORKER_H
+
+#include "Message.h"
+#include "PortMetrics.h"
+#include "PortTransport.h"
+#include "ProtocolDecoder.h"
+#include "SerialPortInfo.h"
+#include "SlabRingBuffer.h"
+#include "SpscQueue.h"
+#include "StreamFramer.h"
+#include "TransmitPacer.h"
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QList>
+#include <QObject>
+#include <QSemaphore>
+#include <QTimer>
+#include <QVector>
+#include <atomic>
+
+/**
+ * @brief Performs the actual serial I/O for a SerialPortUser on an I/O thread
+ *
+ * The worker owns the PortTransport selected by SerialPortInfo::transport()
+ * and lives on one of the IoWorkerPool threads. Received and sent data is
+ * turned into Message objects here and handed to the owning thread through a
+ * lock-free queue; the owner is only woken once per batch via
+ * messagesAvailable().
+ *
+ * Incoming bytes are read straight into a fixed-size SlabRingBuffer, so the
+ * memory used per port stays constant no matter how long a capture runs.
+ * If the consumer falls behind, the ring's overflow policy either stops
+ * reading from the port (backpressure) or discards the oldest data.
+ *
+ * A StreamFramer then splits the buffered bytes into protocol frames as
+ * configured by SerialPortInfo::framing(), so each Message holds exactly one
+ * frame instead of whatever a single read happened to return.
+ *
+ * The clock is read once per read, right after the data arrives, and that
+ * timestamp goes into every Message the read completes. Sent messages are
+ * stamped when the transport reports the data as written.
+ *
+ * If SerialPortInfo::decoder() selects a protocol, every Message is run
+ * through a ProtocolDecoder (one per direction) before it is handed over, and
+ * the records it completes are attached to it. Decoding happens once, here,
+ * so the consumer never parses the data again.
+ *
+ * Without framing, reads can instead be coalesced: everything received
+ * within SerialPortInfo::coalesceWindowMs() of the first read (or until
+ * coalesceMaxBytes() is reached) becomes one Message, which records the
+ * byte offset and arrival time of every read in Message::chunks().
+ *
+ * Outgoing data travels the other way through a second lock-free queue.
+ * The worker coalesces queued payloads into larger writes, keeps only a
+ * small amount of data inside the transport and tops it up from
+ * bytesWritten(), and publishes the Sent message once a payload has actually been written.
+ * Datagram transports are the exception: each payload is written, and
+ * therefore sent, on its own.
+ * The number of payloads queued or in flight is limited by
+ * SerialPortInfo::transmitQueueDepth().
+ *
+ * If SerialPortInfo::pacing() is enabled, a TransmitPacer decides when
+ * bytes may go out. Waits of a millisecond or more use a precise timer;
+ * shorter ones are spun out on the I/O thread, within a small budget per
+ * wake-up so other ports on the same thread are not starved.
+ *
+ * When the transport reports a fatal error (device unplugged, connection
+ * dropped) the worker suspends instead of closing: queued payloads keep
+ * their slots, and payloads that were only partly written are held and sent
+ * again in full first once the port is open again. A partial frame cut off by the
+ * disconnect is discarded (or delivered, for idle gap framing), so framing
+ * restarts cleanly on the new connection. close() discards everything.
+ *
+ * Traffic is counted in a PortMetrics as it passes through; a timer samples
+ * the rates and the driver's line error counters. The counters start over
+ * on every open but not when resuming after a lost connection.
+ *
+ * openAsync() and close() must be called on the worker's thread. openAsync()
+ * never waits for the device: the transport reports when it is open, and
+ * the worker then emits opened() with the time the open took. Network
+ * transports keep connecting while the thread serves its other ports. A
+ * close() during a pending open cancels it and reports it as failed.
+ * enqueueWrite(), takeMessage() and rearmNotification() must be called on
+ * the consumer thread.
+ */
+class SerialPortWorker : public QObject {
+    Q_OBJECT
+
+  public:
+    explicit SerialPortWorker(QObject *parent = nullptr);
+    ~SerialPortWorker() override;
+
+    // Worker thread side
+    void openAsync(const SerialPortInfo &info);
+    void close();
+    bool isOpen() const { return m_transport && m_transport->isOpen(); }
+    bool isSuspended() const { return m_suspended; }
+    QString peerName() const { return m_transport ? m_transport->peerName() : QString(); }
+
+    // Consumer side
+    bool enqueueWrite(const QByteArray &data, int timeoutMs);
+    int pendingWriteCount() const { return m_txDepth - m_txSlots.available(); }
+    bool takeMessage(Message &message) { return m_queue.tryPop(message); }
+    void rearmNotification() { m_notifyPending.store(false, std::memory_order_seq_cst); }
+    int pendingCount() const { return static_cast<int>(m_queue.size()); }
+
+    // Receive buffer statistics, readable from any thread
+    qint64 receiveHighWaterMark() const { return m_rxHighWaterMark.load(std::memory_order_relaxed); }
+    qint64 receiveDroppedBytes() const { return m_rxDroppedBytes.load(std::memory_order_relaxed); }
+
+    // Share of the line rate used by transmitted data over the last second (0.0 - 1.0)
+    double transmitUtilization() const { return m_txUtilization.load(std::memory_order_relaxed); }
+
+    // Traffic counters and rates, readable from any thread; the port name and status are left empty
+    PortMetricsSnapshot metrics() const;
+
+  signals:
+    void messagesAvailable();
+    void opened(bool ok, const QString &error, const QString &peerName, qint64 openTimeNs);
+    void errorOccurred(const QString &error, bool fatal);
+
+  private slots:
+    void onTransportOpened(bool ok);
+    void onReadyRead();
+    void onTransportError(const QString &error, bool fatal);
+    void resumeDelivery();
+    void onIdleGapTimeout();
+    void onCoalesceTimeout();
+    void processTransmitQueue();
+    void onBytesWritten(qint64 bytes);
+    void updateStatistics();
+    void sampleMetrics();
+
+  private:
+    PortTransport *m_transport;
+    QString m_portName;
+
+    // Receive path
+    SlabRingBuffer m_rxRing;
+    std::atomic<qint64> m_rxHighWaterMark;
+    std::atomic<qint64> m_rxDroppedBytes;
+    StreamFramer m_framer;
+    QVector<QByteArray> m_frames;
+    QTimer *m_idleGapTimer;
+
+    // Protocol decoders per direction; nullptr without SerialPortInfo::decoder()
+    ProtocolDecoder *m_rxDecoder;
+    ProtocolDecoder *m_txDecoder;
+    QVector<DecodedRecord> m_records;
+
+    // TimeUtils::timestampNs() of the latest read; stamps the messages it completes
+    qint64 m_lastReadNs;
+
+    // Coalescing window; open while m_rxChunks is not empty
+    QTimer *m_coalesceTimer;
+    qint64 m_coalesceMaxBytes;
+    QVector<MessageChunk> m_rxChunks;
+    qint64 m_windowStartNs;
+
+    // Transmit path; a payload holds its slot until it has been written
+    struct PendingWrite {
+        QByteArray data;
+        qint64 remaining;
+    };
+    SpscQueue<QByteArray> m_txQueue;
+    QSemaphore m_txSlots;
+    int m_txDepth;
+    std::atomic_bool m_txWakePending;
+    QList<PendingWrite> m_inFlight;
+
+    // Open in progress and when it was started
+    bool m_opening;
+    qint64 m_openStartNs;
+
+    // Set after a lost connection; m_txHeld is sent before the queue once reopened
+    bool m_suspended;
+    QList<QByteArray> m_txHeld;
+
+    // Pacing; m_txCurrent is the payload being released piecewise
+    TransmitPacer m_pacer;
+    QElapsedTimer m_clock;
+    QTimer *m_pacingTimer;
+    QByteArray m_txCurrent;
+    int m_txOffset;
+
+    // Utilization metric
+    QTimer *m_statsTimer;
+    qint64 m_txBytesSinceUpdate;
+    qint64 m_lastUpdateNs;
+    std::atomic<double> m_txUtilization;
+
+    // Traffic metrics; line errors of earlier connections are kept across a reconnect
+    PortMetrics m_metrics;
+    QTimer *m_metricsTimer;
+    LineErrorCounts m_lineErrorsBefore;
+    LineErrorCounts m_lineErrors;
+
+    // Handoff to the consumer thread
+    SpscQueue<Message> m_queue;
+    QList<Message> m_backlog;
+    QTimer *m_retryTimer;
+    std::atomic_bool m_notifyPending;
+
+    bool createTransport(TransportType type);
+    void configureReceiveBuffer(const SerialPortInfo &info);
+    void configureDecoders(const SerialPortInfo &info);
+    void decode(Message &message);
+    void readIntoRing();
+    void drainReceiveBuffer();
+    void publishFrames();
+    bool isCoalescing() const { return m_coalesceTimer->interval() > 0 && m_framer.mode() == FramingMode::None; }
+    void recordChunk(qint64 offset, qint64 droppedBytes, qint64 readNs);
+    void configureTransmitQueue(const SerialPortInfo &info);
+    bool takePayload(QByteArray &payload);
+    void fillWriteBuffer();
+    void fillPacedWriteBuffer();
+    void completeWrites(qint64 bytes);
+    void writeFailed();
+    void discardWrites();
+    void suspend();
+    void publish(Message &&message);
+    void scheduleRetry();
+    void notify();
+};
+
+#endif // SERIAL_PORT_WORKER_H
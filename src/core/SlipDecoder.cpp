@@ -0,0 +1,155 @@
+#include "SlipDecoder.h"
+
+namespace {
+// SLIP special characters (RFC 1055)
+const unsigned char SLIP_END = 0xC0;
+const unsigned char SLIP_ESC = 0xDB;
+const unsigned char SLIP_ESC_END = 0xDC;
+const unsigned char SLIP_ESC_ESC = 0xDD;
+
+// Frames longer than this are dropped
+const int MAX_FRAME_SIZE = 65536;
+
+// Payload bytes shown in the record
+const int PREVIEW_SIZE = 32;
+
+const int IPV4_HEADER_SIZE = 20;
+
+QString ipv4Address(const unsigned char* address)
+{
+    return QStringLiteral("%1.%2.%3.%4").arg(address[0]).arg(address[1]).arg(address[2]).arg(address[3]);
+}
+
+QString ipProtocolName(int protocol)
+{
+    switch (protocol) {
+    case 1:
+        return QStringLiteral("ICMP");
+    case 6:
+        return QStringLiteral("TCP");
+    case 17:
+        return QStringLiteral("UDP");
+    default:
+        return QString::number(protocol);
+    }
+}
+}
+
+SlipDecoder::SlipDecoder(MessageDirection direction)
+    : ProtocolDecoder(direction)
+    , m_escaped(false)
+    , m_discarding(false)
+{
+    m_frame.reserve(4096);
+}
+
+void SlipDecoder::reset()
+{
+    m_frame.clear();
+    m_escaped = false;
+    m_discarding = false;
+}
+
+void SlipDecoder::decode(const char* data, qint64 length, QVector<DecodedRecord>& records)
+{
+    qint64 pos = 0;
+    while (pos < length) {
+        // Copy runs of ordinary bytes in one go
+        if (!m_escaped && !m_discarding) {
+            qint64 run = pos;
+            while (run < length && static_cast<unsigned char>(data[run]) != SLIP_END
+                   && static_cast<unsigned char>(data[run]) != SLIP_ESC) {
+                run++;
+            }
+            if (run > pos) {
+                if (m_frame.size() + (run - pos) > MAX_FRAME_SIZE) {
+                    countError();
+                    m_frame.clear();
+                    m_discarding = true;
+                } else {
+                    m_frame.append(data + pos, static_cast<int>(run - pos));
+                }
+                pos = run;
+                continue;
+            }
+        }
+
+        unsigned char c = static_cast<unsigned char>(data[pos++]);
+        if (c == SLIP_END) {
+            if (m_escaped) {
+                countError();
+                m_frame.clear();
+            } else if (!m_discarding) {
+                complete(records);
+            }
+            reset();
+            continue;
+        }
+
+        if (m_discarding) {
+            continue;
+        }
+
+        if (m_escaped) {
+            m_escaped = false;
+            if (c == SLIP_ESC_END) {
+                m_frame.append(static_cast<char>(SLIP_END));
+            } else if (c == SLIP_ESC_ESC) {
+                m_frame.append(static_cast<char>(SLIP_ESC));
+            } else {
+                // Invalid escape: drop the frame up to the next END
+                countError();
+                m_frame.clear();
+                m_discarding = true;
+            }
+        } else {
+            m_escaped = true;
+        }
+    }
+}
+
+void SlipDecoder::decodeFinish(QVector<DecodedRecord>& records)
+{
+    if (!m_escaped && !m_discarding) {
+        complete(records);
+    }
+    reset();
+}
+
+void SlipDecoder::complete(QVector<DecodedRecord>& records)
+{
+    if (!m_frame.isEmpty()) {
+        records.append(makeRecord(m_frame));
+        m_frame.clear();
+    }
+}
+
+DecodedRecord SlipDecoder::makeRecord(const QByteArray& payload) const
+{
+    DecodedRecord record(QStringLiteral("SLIP"), QStringLiteral("%1 bytes").arg(payload.size()));
+    record.addField(QStringLiteral("Length"), QString::number(payload.size()));
+
+    QString preview = QString::fromLatin1(payload.left(PREVIEW_SIZE).toHex(' ').toUpper());
+    if (payload.size() > PREVIEW_SIZE) {
+        preview += QStringLiteral(" ...");
+    }
+    record.addField(QStringLiteral("Payload"), preview);
+
+    // IPv4: version 4 and a header length that fits the payload
+    const unsigned char* ip = reinterpret_cast<const unsigned char*>(payload.constData());
+    int headerSize = (ip[0] & 0x0F) * 4;
+    if (payload.size() >= IPV4_HEADER_SIZE && (ip[0] >> 4) == 4 && headerSize >= IPV4_HEADER_SIZE
+        && headerSize <= payload.size()) {
+        QString protocol = ipProtocolName(ip[9]);
+        QString source = ipv4Address(ip + 12);
+        QString destination = ipv4Address(ip + 16);
+        record.setSummary(QStringLiteral("%1 bytes, IPv4 %2 %3 > %4")
+                              .arg(payload.size()).arg(protocol, source, destination));
+        record.addField(QStringLiteral("Protocol"), protocol);
+        record.addField(QStringLiteral("Source"), source);
+        record.addField(QStringLiteral("Destination"), destination);
+        record.addField(QStringLiteral("TTL"), QString::number(ip[8]));
+        record.addField(QStringLiteral("Total length"), QString::number((ip[2] << 8) | ip[3]));
+    }
+    return record;
+}
@@ -0,0 +1,38 @@
+#ifndef SLIP_DECODER_H
+#define SLIP_DECODER_H
+
+#include "ProtocolDecoder.h"
+
+/**
+ * @brief Decodes RFC 1055 SLIP frames
+ *
+ * Frames end with END (0xC0); ESC sequences are undone and empty frames
+ * (the END that many senders put in front of each frame) are skipped. A
+ * record lists the payload size and its first bytes; if the payload is an
+ * IPv4 packet, the header fields are decoded as well.
+ *
+ * The decoder expects the escaped stream, so use it on ports without SLIP
+ * framing; there the framer has already removed the escapes. On other
+ * framed ports finish() completes a frame whose END was not seen.
+ */
+class SlipDecoder : public ProtocolDecoder {
+public:
+    explicit SlipDecoder(MessageDirection direction = MessageDirection::Received);
+
+    DecoderType type() const override { return DecoderType::Slip; }
+    void reset() override;
+
+protected:
+    void decode(const char* data, qint64 length, QVector<DecodedRecord>& records) override;
+    void decodeFinish(QVector<DecodedRecord>& records) override;
+
+private:
+    QByteArray m_frame;
+    bool m_escaped;
+    bool m_discarding;
+
+    void complete(QVector<DecodedRecord>& records);
+    DecodedRecord makeRecord(const QByteArray& payload) const;
+};
+
+#endif // SLIP_DECODER_H
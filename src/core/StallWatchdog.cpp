@@ -0,0 +1,136 @@
+#include "StallWatchdog.h"
+#include <QMetaObject>
+#include <QThread>
+#include <QTimer>
+
+QString StallReport::summary() const {
+    QString text = QObject::tr("Event loop stalled for %1 ms").arg(durationNs / 1000000);
+    if (!operation.isEmpty()) {
+        return text + QObject::tr(" in %1 (running for %2 ms)").arg(operation).arg(operationNs / 1000000);
+    }
+    if (!lastOperation.isEmpty()) {
+        return text + QObject::tr(" outside traced code; last traced operation: %1").arg(lastOperation);
+    }
+    return text;
+}
+
+StallWatchdog::StallWatchdog(QObject *parent)
+    : QObject(parent), m_thresholdMs(DEFAULT_THRESHOLD_MS), m_thread(new QThread(this)), m_timer(nullptr),
+      m_pingSentNs(0), m_samplePingNs(0), m_stallCount(0), m_maxStallNs(0) {
+    qRegisterMetaType<StallReport>();
+    m_thread->setObjectName(QStringLiteral("SerialChat-Watchdog"));
+}
+
+StallWatchdog::~StallWatchdog() { stop(); }
+
+void StallWatchdog::start() {
+    if (isRunning()) {
+        return;
+    }
+
+    Trace::watchCurrentThread();
+    m_pingSentNs.store(0, std::memory_order_relaxed);
+
+    // Lives on the monitor thread; deleted by stop() once that thread has finished
+    m_timer = new QTimer();
+    m_timer->setInterval(CHECK_INTERVAL_MS);
+    m_timer->moveToThread(m_thread);
+    connect(m_timer, &QTimer::timeout, m_timer, [this]() { check(); });
+    connect(m_thread, &QThread::started, m_timer, QOverload<>::of(&QTimer::start));
+    m_thread->start();
+}
+
+void StallWatchdog::stop() {
+    if (!m_timer) {
+        return;
+    }
+
+    m_thread->quit();
+    m_thread->wait();
+    delete m_timer;
+    m_timer = nullptr;
+    m_pingSentNs.store(0, std::memory_order_release);
+}
+
+bool StallWatchdog::isRunning() const { return m_timer != nullptr; }
+
+void StallWatchdog::setThresholdMs(int thresholdMs) {
+    m_thresholdMs.store(qMax(MIN_THRESHOLD_MS, thresholdMs), std::memory_order_relaxed);
+}
+
+void StallWatchdog::reset() {
+    m_stallCount = 0;
+    m_maxStallNs = 0;
+    m_histogram.clear();
+    m_recentStalls.clear();
+}
+
+void StallWatchdog::check() {
+    qint64 nowNs = TimeUtils::timestampNs();
+    qint64 sentNs = m_pingSentNs.load(std::memory_order_acquire);
+    if (sentNs == 0) {
+        m_pingSentNs.store(nowNs, std::memory_order_release);
+        QMetaObject::invokeMethod(this, [this, nowNs]() { onPong(nowNs); }, Qt::QueuedConnection);
+        return;
+    }
+
+    // The loop is busy; remember the operation that has been running longest
+    TraceOperation operation = Trace::watchedOperation();
+    if (!operation.isValid() || !operation.isRunning()) {
+        return;
+    }
+    QMutexLocker lock(&m_sampleMutex);
+    if (m_samplePingNs != sentNs || !m_sample.isValid() || operation.startNs < m_sample.startNs) {
+        m_samplePingNs = sentNs;
+        m_sample = operation;
+        m_sample.durationNs = nowNs - operation.startNs;
+    } else if (operation.startNs == m_sample.startNs) {
+        m_sample.durationNs = nowNs - operation.startNs;
+    }
+}
+
+void StallWatchdog::onPong(qint64 sentNs) {
+    // Sent before the watchdog was stopped
+    if (m_pingSentNs.load(std::memory_order_acquire) != sentNs) {
+        return;
+    }
+    qint64 stallNs = TimeUtils::timestampNs() - sentNs;
+
+    TraceOperation culprit;
+    {
+        QMutexLocker lock(&m_sampleMutex);
+        if (m_samplePingNs == sentNs) {
+            culprit = m_sample;
+        }
+        m_sample = TraceOperation();
+        m_samplePingNs = 0;
+    }
+    m_pingSentNs.store(0, std::memory_order_release);
+
+    if (stallNs < thresholdMs() * 1000000LL) {
+        return;
+    }
+
+    StallReport report;
+    report.timestampNs = sentNs;
+    report.durationNs = stallNs;
+    if (culprit.isValid()) {
+        report.operation = culprit.describe();
+        report.operationNs = culprit.durationNs;
+    } else {
+        // The blocking code had no span; the last finished one is the best hint
+        TraceOperation last = Trace::watchedOperation();
+        if (last.isValid() && !last.isRunning()) {
+            report.lastOperation = last.describe();
+        }
+    }
+
+    m_stallCount++;
+    m_maxStallNs = qMax(m_maxStallNs, stallNs);
+    m_histogram.record(stallNs);
+    m_recentStalls.append(report);
+    while (m_recentStalls.size() > MAX_RECENT_STALLS) {
+        m_recentStalls.removeFirst();
+    }
+    emit stallDetected(report);
+}
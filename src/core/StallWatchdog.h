@@ -0,0 +1,106 @@
+#ifndef STALL_WATCHDOG_H
+#define STALL_WATCHDOG_H
+
+#include "LatencyHistogram.h"
+#include "Trace.h"
+#include <QList>
+#include <QMetaType>
+#include <QMutex>
+#include <QObject>
+#include <QString>
+#include <atomic>
+
+class QThread;
+class QTimer;
+
+/**
+ * @brief One time the watched event loop did not respond within the threshold
+ */
+struct StallReport {
+    qint64 timestampNs = 0; // When the unanswered ping was sent
+    qint64 durationNs = 0;
+
+    // Outermost traced span that was running during the stall, if any
+    QString operation;
+    qint64 operationNs = 0; // How long it had been running when last seen
+
+    // Otherwise the last traced span that finished before it
+    QString lastOperation;
+
+    QString summary() const;
+};
+
+Q_DECLARE_METATYPE(StallReport)
+
+/**
+ * @brief Detects and attributes stalls of the event loop it is created in
+ *
+ * A monitor thread posts a ping to the watched thread every
+ * CHECK_INTERVAL_MS and measures how long it takes to be delivered. A ping
+ * delivered later than the threshold is a stall: stallDetected() is emitted
+ * on the watched thread once the loop is running again, and the stall is
+ * counted in stallCount(), maxStallNs() and histogram().
+ *
+ * While a ping is outstanding the monitor samples Trace::watchedOperation(),
+ * the outermost TRACE_SCOPE open on the watched thread, so the report names
+ * the operation that blocked the loop ("ChatWidget::loadMessages, 8000
+ * bubbles"). A stall can start up to one check interval before the ping
+ * that catches it, so durations err on the short side by at most that much.
+ */
+class StallWatchdog : public QObject {
+    Q_OBJECT
+
+  public:
+    static constexpr int DEFAULT_THRESHOLD_MS = 250;
+    static constexpr int MIN_THRESHOLD_MS = 50;
+    static constexpr int CHECK_INTERVAL_MS = 25;
+    static constexpr int MAX_RECENT_STALLS = 100;
+
+    explicit StallWatchdog(QObject *parent = nullptr);
+    ~StallWatchdog() override;
+
+    // Watches the thread this object lives in, which must be the calling thread
+    void start();
+    void stop();
+    bool isRunning() const;
+
+    int thresholdMs() const { return m_thresholdMs.load(std::memory_order_relaxed); }
+    void setThresholdMs(int thresholdMs);
+
+    // Statistics since construction or reset()
+    qint64 stallCount() const { return m_stallCount; }
+    qint64 maxStallNs() const { return m_maxStallNs; }
+    const LatencyHistogram &histogram() const { return m_histogram; }
+    QList<StallReport> recentStalls() const { return m_recentStalls; }
+    void reset();
+
+  signals:
+    void stallDetected(const StallReport &report);
+
+  private:
+    std::atomic<int> m_thresholdMs;
+    QThread *m_thread;
+    QTimer *m_timer;
+
+    // Send time of the unanswered ping; 0 when none is outstanding
+    std::atomic<qint64> m_pingSentNs;
+
+    // Longest-running operation seen while the current ping was outstanding
+    QMutex m_sampleMutex;
+    qint64 m_samplePingNs;
+    TraceOperation m_sample;
+
+    // Owned by the watched thread
+    qint64 m_stallCount;
+    qint64 m_maxStallNs;
+    LatencyHistogram m_histogram;
+    QList<StallReport> m_recentStalls;
+
+    // Monitor thread
+    void check();
+
+    // Watched thread
+    void onPong(qint64 sentNs);
+};
+
+#endif // STALL_WATCHDOG_H
@@ -0,0 +1,355 @@
+#include "StreamFramer.h"
+#include <cstring>
+
+namespace {
+// SLIP special characters (RFC 1055)
+const unsigned char SLIP_END = 0xC0;
+const unsigned char SLIP_ESC = 0xDB;
+const unsigned char SLIP_ESC_END = 0xDC;
+const unsigned char SLIP_ESC_ESC = 0xDD;
+
+// Initial capacity of the frame buffer; it grows up to maxFrameSize if needed
+const int INITIAL_FRAME_CAPACITY = 4096;
+}
+
+StreamFramer::StreamFramer(const FramingConfig& config)
+    : m_expectedSize(-1)
+    , m_discarding(false)
+    , m_escaped(false)
+    , m_cobsStarted(false)
+    , m_cobsCode(0)
+    , m_cobsRemaining(0)
+    , m_frameCount(0)
+    , m_errorCount(0)
+    , m_oversizedCount(0)
+    , m_emptyFrameCount(0)
+{
+    setConfig(config);
+}
+
+void StreamFramer::setConfig(const FramingConfig& config)
+{
+    m_config = config;
+    m_config.setFrameLength(qMax(1, config.frameLength()));
+    m_config.setLengthOffset(qMax(0, config.lengthOffset()));
+    m_config.setLengthSize(qBound(1, config.lengthSize(), 4));
+    m_config.setMaxFrameSize(qMax(1, config.maxFrameSize()));
+    if (m_config.mode() == FramingMode::LengthPrefix) {
+        // Invalid per FramingConfig::validationError(); a header must at least fit in a frame
+        m_config.setMaxFrameSize(qMax(m_config.maxFrameSize(), m_config.headerSize()));
+    }
+
+    // reserve() marks the capacity as reserved, so clearing the frame keeps the allocation
+    m_frame.reserve(qMin(m_config.maxFrameSize(), INITIAL_FRAME_CAPACITY));
+    reset();
+}
+
+int StreamFramer::feed(const char* data, qint64 length, QVector<QByteArray>& frames)
+{
+    if (!data || length <= 0) {
+        return 0;
+    }
+
+    int before = frames.size();
+    switch (m_config.mode()) {
+    case FramingMode::None:
+        appendChecked(data, length, frames);
+        emitFrame(frames);
+        break;
+    case FramingMode::Delimiter:
+        feedDelimiter(data, length, frames);
+        break;
+    case FramingMode::FixedLength:
+        feedFixedLength(data, length, frames);
+        break;
+    case FramingMode::LengthPrefix:
+        feedLengthPrefix(data, length, frames);
+        break;
+    case FramingMode::IdleGap:
+        appendChecked(data, length, frames);
+        break;
+    case FramingMode::Slip:
+        feedSlip(data, length, frames);
+        break;
+    case FramingMode::Cobs:
+        feedCobs(data, length, frames);
+        break;
+    }
+    return frames.size() - before;
+}
+
+int StreamFramer::flush(QVector<QByteArray>& frames)
+{
+    int before = frames.size();
+    emitFrame(frames);
+    discardFrame();
+    return frames.size() - before;
+}
+
+void StreamFramer::reset()
+{
+    discardFrame();
+    m_discarding = false;
+}
+
+void StreamFramer::feedDelimiter(const char* data, qint64 length, QVector<QByteArray>& frames)
+{
+    const QByteArray& delimiter = m_config.delimiter();
+    if (delimiter.isEmpty()) {
+        appendChecked(data, length, frames);
+        return;
+    }
+
+    // Search for the delimiter's last byte, then confirm the whole sequence at the end of the frame
+    const char last = delimiter.at(delimiter.size() - 1);
+    qint64 pos = 0;
+    while (pos < length) {
+        const void* hit = std::memchr(data + pos, last, static_cast<size_t>(length - pos));
+        qint64 end = hit ? static_cast<const char*>(hit) - data + 1 : length;
+        appendChecked(data + pos, end - pos, frames);
+        pos = end;
+
+        if (hit && m_frame.endsWith(delimiter)) {
+            if (!m_config.keepDelimiter()) {
+                m_frame.chop(delimiter.size());
+            }
+            emitFrame(frames);
+        }
+    }
+}
+
+void StreamFramer::feedFixedLength(const char* data, qint64 length, QVector<QByteArray>& frames)
+{
+    const int frameLength = m_config.frameLength();
+    qint64 pos = 0;
+    while (pos < length) {
+        qint64 chunk = qMin(qint64(frameLength - m_frame.size()), length - pos);
+        m_frame.append(data + pos, static_cast<int>(chunk));
+        pos += chunk;
+
+        if (m_frame.size() >= frameLength) {
+            emitFrame(frames);
+        }
+    }
+}
+
+void StreamFramer::feedLengthPrefix(const char* data, qint64 length, QVector<QByteArray>& frames)
+{
+    const int headerSize = m_config.headerSize();
+    qint64 pos = 0;
+    while (pos < length) {
+        if (m_expectedSize < 0) {
+            qint64 chunk = qMin(qint64(headerSize - m_frame.size()), length - pos);
+            m_frame.append(data + pos, static_cast<int>(chunk));
+            pos += chunk;
+            if (m_frame.size() < headerSize) {
+                break;
+            }
+
+            qint64 total = headerSize + decodeLength() + m_config.lengthAdjustment();
+            if (total < headerSize || total > m_config.maxFrameSize()) {
+                // Not a plausible header; slide forward one byte and try again
+                m_errorCount++;
+                m_frame.remove(0, 1);
+                continue;
+            }
+            m_expectedSize = total;
+        }
+
+        qint64 chunk = qMin(m_expectedSize - m_frame.size(), length - pos);
+        m_frame.append(data + pos, static_cast<int>(chunk));
+        pos += chunk;
+
+        if (m_frame.size() >= m_expectedSize) {
+            emitFrame(frames);
+            m_expectedSize = -1;
+        }
+    }
+}
+
+void StreamFramer::feedSlip(const char* data, qint64 length, QVector<QByteArray>& frames)
+{
+    const int maxFrameSize = m_config.maxFrameSize();
+    qint64 pos = 0;
+    while (pos < length) {
+        // Copy runs of ordinary bytes in one go
+        if (!m_escaped && !m_discarding) {
+            qint64 run = pos;
+            while (run < length && static_cast<unsigned char>(data[run]) != SLIP_END
+                   && static_cast<unsigned char>(data[run]) != SLIP_ESC) {
+                run++;
+            }
+            if (run > pos) {
+                if (m_frame.size() + (run - pos) > maxFrameSize) {
+                    m_oversizedCount++;
+                    discardFrame();
+                    m_discarding = true;
+                } else {
+                    m_frame.append(data + pos, static_cast<int>(run - pos));
+                }
+                pos = run;
+                continue;
+            }
+        }
+
+        unsigned char c = static_cast<unsigned char>(data[pos++]);
+        if (c == SLIP_END) {
+            if (m_escaped) {
+                m_errorCount++;
+                discardFrame();
+            } else if (!m_discarding) {
+                emitFrame(frames);
+            }
+            m_discarding = false;
+            m_escaped = false;
+            continue;
+        }
+
+        if (m_discarding) {
+            continue;
+        }
+
+        if (m_escaped) {
+            m_escaped = false;
+            if (c == SLIP_ESC_END) {
+                c = SLIP_END;
+            } else if (c == SLIP_ESC_ESC) {
+                c = SLIP_ESC;
+            } else {
+                // Protocol violation; RFC 1055 keeps the byte as-is
+                m_errorCount++;
+            }
+        } else if (c == SLIP_ESC) {
+            m_escaped = true;
+            continue;
+        }
+
+        if (m_frame.size() >= maxFrameSize) {
+            m_oversizedCount++;
+            discardFrame();
+            m_discarding = true;
+            continue;
+        }
+        m_frame.append(static_cast<char>(c));
+    }
+}
+
+void StreamFramer::feedCobs(const char* data, qint64 length, QVector<QByteArray>& frames)
+{
+    const int maxFrameSize = m_config.maxFrameSize();
+    qint64 pos = 0;
+    while (pos < length) {
+        unsigned char c = static_cast<unsigned char>(data[pos]);
+
+        if (c == 0) {
+            pos++;
+            if (m_discarding) {
+                m_discarding = false;
+            } else if (m_cobsStarted && m_cobsRemaining != 0) {
+                // Frame ended in the middle of a block
+                m_errorCount++;
+            } else if (m_frame.isEmpty()) {
+                // Nothing to deliver; counted so idle or resync zeros stay visible
+                m_emptyFrameCount++;
+            } else {
+                emitFrame(frames);
+            }
+            discardFrame();
+            continue;
+        }
+
+        if (m_discarding) {
+            pos++;
+            continue;
+        }
+
+        if (m_cobsRemaining == 0) {
+            // Code byte: every block except one of 254 data bytes implies a trailing zero,
+            // which is only written once the next block shows it was not the last one
+            if (m_cobsStarted && m_cobsCode < 0xFF) {
+                m_frame.append('\0');
+            }
+            m_cobsCode = c;
+            m_cobsRemaining = c - 1;
+            m_cobsStarted = true;
+            pos++;
+            continue;
+        }
+
+        // Copy the block's data bytes, stopping early at an unexpected zero
+        qint64 chunk = qMin(qint64(m_cobsRemaining), length - pos);
+        const void* zero = std::memchr(data + pos, 0, static_cast<size_t>(chunk));
+        if (zero) {
+            chunk = static_cast<const char*>(zero) - (data + pos);
+        }
+
+        if (m_frame.size() + chunk > maxFrameSize) {
+            m_oversizedCount++;
+            discardFrame();
+            m_discarding = true;
+            continue;
+        }
+
+        m_frame.append(data + pos, static_cast<int>(chunk));
+        m_cobsRemaining -= static_cast<int>(chunk);
+        pos += chunk;
+    }
+}
+
+void StreamFramer::appendChecked(const char* data, qint64 length, QVector<QByteArray>& frames)
+{
+    const int maxFrameSize = m_config.maxFrameSize();
+    while (length > 0) {
+        qint64 room = maxFrameSize - m_frame.size();
+        if (room <= 0) {
+            // Never let a missing terminator grow the buffer without bound
+            m_oversizedCount++;
+            emitFrame(frames);
+            room = maxFrameSize;
+        }
+
+        qint64 chunk = qMin(room, length);
+        m_frame.append(data, static_cast<int>(chunk));
+        data += chunk;
+        length -= chunk;
+    }
+}
+
+qint64 StreamFramer::decodeLength() const
+{
+    const unsigned char* field = reinterpret_cast<const unsigned char*>(m_frame.constData()) + m_config.lengthOffset();
+    const int size = m_config.lengthSize();
+
+    quint32 value = 0;
+    for (int i = 0; i < size; ++i) {
+        int index = m_config.lengthBigEndian() ? i : size - 1 - i;
+        value = (value << 8) | field[index];
+    }
+    return value;
+}
+
+void StreamFramer::emitFrame(QVector<QByteArray>& frames)
+{
+    if (m_frame.isEmpty()) {
+        return;
+    }
+
+    frames.append(QByteArray(m_frame.constData(), m_frame.size()));
+    m_frameCount++;
+    clearFrame();
+}
+
+void StreamFramer::clearFrame()
+{
+    m_frame.resize(0);
+}
+
+void StreamFramer::discardFrame()
+{
+    clearFrame();
+    m_expectedSize = -1;
+    m_escaped = false;
+    m_cobsStarted = false;
+    m_cobsCode = 0;
+    m_cobsRemaining = 0;
+}
@@ -0,0 +1,88 @@
+#ifndef STREAM_FRAMER_H
+#define STREAM_FRAMER_H
+
+#include <QByteArray>
+#include <QVector>
+#include "FramingConfig.h"
+
+/**
+ * @brief Incremental splitter that turns a byte stream into protocol frames
+ *
+ * Bytes are fed in arbitrary chunks with feed(); every frame completed by
+ * the chunk is appended to the caller's output vector. Partial frames are
+ * carried over to the next call, so a frame split across several reads is
+ * reassembled and a read holding many frames yields many messages.
+ *
+ * The frame being assembled lives in a single preallocated buffer; the only
+ * allocation per frame is the QByteArray handed to the caller.
+ *
+ * In IdleGap mode the framer cannot see time, so the owner must call
+ * flush() once the line has been idle for FramingConfig::idleGapMs().
+ */
+class StreamFramer {
+public:
+    explicit StreamFramer(const FramingConfig& config = FramingConfig());
+
+    // Configuration; changing it discards any partial frame
+    FramingConfig config() const { return m_config; }
+    void setConfig(const FramingConfig& config);
+    FramingMode mode() const { return m_config.mode(); }
+
+    // Feed received bytes; returns the number of frames appended to frames
+    int feed(const char* data, qint64 length, QVector<QByteArray>& frames);
+    int feed(const QByteArray& data, QVector<QByteArray>& frames) { return feed(data.constData(), data.size(), frames); }
+
+    // Emit the partial frame, if any (end of an idle gap)
+    int flush(QVector<QByteArray>& frames);
+
+    // Discard the partial frame and decoder state
+    void reset();
+
+    // State
+    bool hasPartialFrame() const { return !m_frame.isEmpty() || m_escaped || m_cobsStarted; }
+    int partialSize() const { return m_frame.size(); }
+
+    // Statistics
+    qint64 frameCount() const { return m_frameCount; }
+    qint64 errorCount() const { return m_errorCount; }
+    qint64 oversizedCount() const { return m_oversizedCount; }
+    // Cobs: delimiters that closed no data (a lone 0x00, or 0x01 0x00); no frame is emitted for them
+    qint64 emptyFrameCount() const { return m_emptyFrameCount; }
+
+private:
+    FramingConfig m_config;
+    QByteArray m_frame;
+
+    // LengthPrefix: total frame size once the header is complete, else -1
+    qint64 m_expectedSize;
+
+    // Slip / Cobs: skipping bytes until the next frame boundary
+    bool m_discarding;
+
+    // Slip
+    bool m_escaped;
+
+    // Cobs
+    bool m_cobsStarted;
+    int m_cobsCode;
+    int m_cobsRemaining;
+
+    qint64 m_frameCount;
+    qint64 m_errorCount;
+    qint64 m_oversizedCount;
+    qint64 m_emptyFrameCount;
+
+    void feedDelimiter(const char* data, qint64 length, QVector<QByteArray>& frames);
+    void feedFixedLength(const char* data, qint64 length, QVector<QByteArray>& frames);
+    void feedLengthPrefix(const char* data, qint64 length, QVector<QByteArray>& frames);
+    void feedSlip(const char* data, qint64 length, QVector<QByteArray>& frames);
+    void feedCobs(const char* data, qint64 length, QVector<QByteArray>& frames);
+
+    void appendChecked(const char* data, qint64 length, QVector<QByteArray>& frames);
+    qint64 decodeLength() const;
+    void emitFrame(QVector<QByteArray>& frames);
+    void clearFrame();
+    void discardFrame();
+};
+
+#endif // STREAM_FRAMER_H
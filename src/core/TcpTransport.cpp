@@ -0,0 +1,110 @@
+#include "TcpTransport.h"
+#include <QTimer>
+
+namespace {
+// Longest openAsync() waits for the remote end to accept
+const int CONNECT_TIMEOUT_MS = 3000;
+} // namespace
+
+TcpTransport::TcpTransport(QObject *parent)
+    : PortTransport(parent), m_socket(new QTcpSocket(this)), m_connectTimer(new QTimer(this)), m_connecting(false),
+      m_closing(false) {
+    m_connectTimer->setSingleShot(true);
+    m_connectTimer->setInterval(CONNECT_TIMEOUT_MS);
+    QObject::connect(m_connectTimer, &QTimer::timeout, this, &TcpTransport::onConnectTimeout);
+
+    QObject::connect(m_socket, &QTcpSocket::connected, this, &TcpTransport::onConnected);
+#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
+    QObject::connect(m_socket, &QTcpSocket::errorOccurred, this, &TcpTransport::onSocketError);
+#else
+    QObject::connect(m_socket, QOverload<QAbstractSocket::SocketError>::of(&QTcpSocket::error), this,
+                     &TcpTransport::onSocketError);
+#endif
+    QObject::connect(m_socket, &QTcpSocket::readyRead, this, &PortTransport::readyRead);
+    QObject::connect(m_socket, &QTcpSocket::bytesWritten, this, &PortTransport::bytesWritten);
+    QObject::connect(m_socket, &QTcpSocket::disconnected, this, &TcpTransport::onDisconnected);
+}
+
+void TcpTransport::openAsync(const SerialPortInfo &info) {
+    if (isOpen()) {
+        emit openFinished(true);
+        return;
+    }
+
+    TransportConfig config = info.transport();
+    if (config.address().isEmpty() || config.port() <= 0 || config.port() > 65535) {
+        m_errorString = QStringLiteral("No remote address configured");
+        emit openFinished(false);
+        return;
+    }
+
+    close();
+    m_connecting = true;
+    m_connectTimer->start();
+    m_socket->connectToHost(config.address(), static_cast<quint16>(config.port()));
+}
+
+void TcpTransport::close() {
+    m_connecting = false;
+    m_connectTimer->stop();
+    m_closing = true;
+    m_socket->abort();
+    m_closing = false;
+}
+
+qint64 TcpTransport::write(const char *data, qint64 size) {
+    qint64 written = m_socket->write(data, size);
+    if (written == -1) {
+        m_errorString = m_socket->errorString();
+    }
+    return written;
+}
+
+void TcpTransport::onConnected() {
+    if (!m_connecting) {
+        return;
+    }
+
+    // Serial traffic is mostly small frames; do not hold them back for Nagle
+    m_socket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+    if (!startSession()) {
+        finishOpen(false, m_socket->errorString());
+        return;
+    }
+    finishOpen(true, QString());
+}
+
+void TcpTransport::onSocketError() {
+    // Errors of an established connection end in disconnected()
+    if (m_connecting) {
+        finishOpen(false, m_socket->errorString());
+    }
+}
+
+void TcpTransport::onConnectTimeout() {
+    if (m_connecting) {
+        finishOpen(false, QStringLiteral("Connection timed out"));
+    }
+}
+
+void TcpTransport::finishOpen(bool ok, const QString &error) {
+    m_connecting = false;
+    m_connectTimer->stop();
+    if (ok) {
+        m_errorString.clear();
+    } else {
+        m_errorString = error;
+        close();
+    }
+    emit openFinished(ok);
+}
+
+void TcpTransport::onDisconnected() {
+    if (m_closing) {
+        return;
+    }
+
+    m_errorString = QStringLiteral("Connection closed by remote host");
+    close();
+    emit errorOccurred(m_errorString, true);
+}
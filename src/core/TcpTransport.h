@@ -0,0 +1,60 @@
+#ifndef TCP_TRANSPORT_H
+#define TCP_TRANSPORT_H
+
+#include "PortTransport.h"
+#include <QTcpSocket>
+
+class QTimer;
+
+/**
+ * @brief Raw TCP client backend, e.g. for a terminal server or ser2net port
+ *
+ * Connects to TransportConfig::address():port() and passes bytes through
+ * unchanged. openAsync() returns at once and reports through openFinished()
+ * when the connection is established, refused or has timed out. A
+ * connection closed by the remote end is reported as a fatal error, like an
+ * unplugged serial adapter.
+ */
+class TcpTransport : public PortTransport {
+    Q_OBJECT
+
+  public:
+    explicit TcpTransport(QObject *parent = nullptr);
+
+    TransportType type() const override { return TransportType::Tcp; }
+
+    void openAsync(const SerialPortInfo &info) override;
+    void close() override;
+    bool isOpen() const override { return m_socket->state() == QAbstractSocket::ConnectedState; }
+    QString errorString() const override { return m_errorString; }
+
+    qint64 bytesAvailable() const override { return m_socket->bytesAvailable(); }
+    qint64 read(char *data, qint64 maxSize) override { return m_socket->read(data, maxSize); }
+
+    qint64 write(const char *data, qint64 size) override;
+    qint64 bytesToWrite() const override { return m_socket->bytesToWrite(); }
+
+    void setReadBufferSize(qint64 size) override { m_socket->setReadBufferSize(size); }
+
+  protected:
+    QTcpSocket *m_socket;
+
+    // Called once connected, before openFinished(); false fails the open
+    virtual bool startSession() { return true; }
+
+  private slots:
+    void onConnected();
+    void onSocketError();
+    void onConnectTimeout();
+    void onDisconnected();
+
+  private:
+    QString m_errorString;
+    QTimer *m_connectTimer;
+    bool m_connecting;
+    bool m_closing;
+
+    void finishOpen(bool ok, const QString &error);
+};
+
+#endif // TCP_TRANSPORT_H
@@ -0,0 +1,343 @@
+#include "TermiosTransport.h"
+#include "EpollReactor.h"
+#include <QMetaObject>
+#include <asm/termbits.h>
+#include <cerrno>
+#include <fcntl.h>
+#include <linux/serial.h>
+#include <sys/epoll.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+// <asm/termbits.h> provides termios2 and BOTHER, but clashes with <termios.h>,
+// so nothing in this file may include the glibc termios header.
+
+namespace {
+const quint32 READ_EVENTS = EPOLLIN | EPOLLRDHUP | EPOLLET;
+} // namespace
+
+TermiosTransport::TermiosTransport(QObject *parent)
+    : PortTransport(parent), m_fd(-1), m_writeOffset(0), m_writeArmed(false), m_pendingWritten(0),
+      m_writtenPosted(false) {}
+
+TermiosTransport::~TermiosTransport() { close(); }
+
+bool TermiosTransport::open(const SerialPortInfo &info) {
+    if (isOpen()) {
+        return true;
+    }
+    m_errorString.clear();
+
+    QString path = info.portName();
+    if (!path.startsWith(QLatin1Char('/'))) {
+        path.prepend(QStringLiteral("/dev/"));
+    }
+
+    int fd = ::open(path.toLocal8Bit().constData(), O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0) {
+        setSystemError(QStringLiteral("Cannot open ") + path);
+        return false;
+    }
+
+    // Same exclusive access QSerialPort asks for
+    if (::ioctl(fd, TIOCEXCL) != 0) {
+        setSystemError(QStringLiteral("Cannot lock ") + path);
+        ::close(fd);
+        return false;
+    }
+
+    return attach(fd, info);
+}
+
+bool TermiosTransport::attach(int fd, const SerialPortInfo &info) {
+    m_fd = fd;
+    if (!configure(info)) {
+        ::close(m_fd);
+        m_fd = -1;
+        return false;
+    }
+
+    EpollReactor *reactor = EpollReactor::forCurrentThread();
+    if (!reactor->isValid() || !reactor->add(m_fd, READ_EVENTS, [this](quint32 events) { onEvents(events); })) {
+        setSystemError(QStringLiteral("Cannot watch port"));
+        ::close(m_fd);
+        m_fd = -1;
+        return false;
+    }
+
+    m_lineErrorBase = LineErrorCounts();
+    readLineErrors(m_fd, &m_lineErrorBase);
+    m_errorString.clear();
+    return true;
+}
+
+LineErrorCounts TermiosTransport::lineErrors() const {
+    LineErrorCounts counts;
+    if (!readLineErrors(m_fd, &counts)) {
+        return LineErrorCounts();
+    }
+    return counts - m_lineErrorBase;
+}
+
+bool TermiosTransport::configure(const SerialPortInfo &info) {
+    struct termios2 tio = {};
+    if (::ioctl(m_fd, TCGETS2, &tio) != 0) {
+        setSystemError(QStringLiteral("Cannot read port settings"));
+        return false;
+    }
+
+    // Raw mode, as cfmakeraw() would set it
+    tio.c_iflag &= ~(IGNBRK | BRKINT | PARMRK | ISTRIP | INLCR | IGNCR | ICRNL | IXON | IXOFF | IXANY | INPCK);
+    tio.c_oflag &= ~OPOST;
+    tio.c_lflag &= ~(ECHO | ECHONL | ICANON | ISIG | IEXTEN);
+    tio.c_cflag &= ~(CSIZE | PARENB | PARODD | CMSPAR | CSTOPB | CRTSCTS);
+    tio.c_cflag |= CREAD | CLOCAL;
+
+    // Any integer rate, no rounding to the standard Bxxx table
+    tio.c_cflag &= ~(CBAUD | (CBAUD << IBSHIFT));
+    tio.c_cflag |= BOTHER | (BOTHER << IBSHIFT);
+    tio.c_ispeed = static_cast<speed_t>(info.baudRate());
+    tio.c_ospeed = static_cast<speed_t>(info.baudRate());
+
+    switch (info.dataBits()) {
+    case QSerialPort::Data5:
+        tio.c_cflag |= CS5;
+        break;
+    case QSerialPort::Data6:
+        tio.c_cflag |= CS6;
+        break;
+    case QSerialPort::Data7:
+        tio.c_cflag |= CS7;
+        break;
+    default:
+        tio.c_cflag |= CS8;
+        break;
+    }
+
+    switch (info.parity()) {
+    case QSerialPort::EvenParity:
+        tio.c_cflag |= PARENB;
+        break;
+    case QSerialPort::OddParity:
+        tio.c_cflag |= PARENB | PARODD;
+        break;
+    case QSerialPort::MarkParity:
+        tio.c_cflag |= PARENB | CMSPAR | PARODD;
+        break;
+    case QSerialPort::SpaceParity:
+        tio.c_cflag |= PARENB | CMSPAR;
+        break;
+    default:
+        break;
+    }
+    if (tio.c_cflag & PARENB) {
+        tio.c_iflag |= INPCK;
+    }
+
+    switch (info.stopBits()) {
+    case QSerialPort::TwoStop:
+        tio.c_cflag |= CSTOPB;
+        break;
+    case QSerialPort::OneAndHalfStop:
+        m_errorString = QStringLiteral("1.5 stop bits are not supported by the native backend");
+        return false;
+    default:
+        break;
+    }
+
+    switch (info.flowControl()) {
+    case QSerialPort::HardwareControl:
+        tio.c_cflag |= CRTSCTS;
+        break;
+    case QSerialPort::SoftwareControl:
+        tio.c_iflag |= IXON | IXOFF;
+        break;
+    default:
+        break;
+    }
+
+    // The descriptor is non-blocking, so VMIN/VTIME only decide when the
+    // driver reports the port readable, which is what wakes the reactor
+    TransportConfig transport = info.transport();
+    tio.c_cc[VMIN] = static_cast<cc_t>(qBound(0, transport.vmin(), 255));
+    tio.c_cc[VTIME] = static_cast<cc_t>(qBound(0, transport.vtime(), 255));
+
+    if (::ioctl(m_fd, TCSETS2, &tio) != 0) {
+        setSystemError(QStringLiteral("Cannot apply port settings"));
+        return false;
+    }
+
+    // Best effort: pseudo terminals and USB adapters may not support it
+    struct serial_struct serial = {};
+    if (::ioctl(m_fd, TIOCGSERIAL, &serial) == 0) {
+        if (transport.lowLatency()) {
+            serial.flags |= ASYNC_LOW_LATENCY;
+        } else {
+            serial.flags &= ~ASYNC_LOW_LATENCY;
+        }
+        ::ioctl(m_fd, TIOCSSERIAL, &serial);
+    }
+
+    ::ioctl(m_fd, TCFLSH, TCIOFLUSH);
+    return true;
+}
+
+void TermiosTransport::close() {
+    if (!isOpen()) {
+        return;
+    }
+
+    EpollReactor::forCurrentThread()->remove(m_fd);
+    ::close(m_fd);
+    m_fd = -1;
+
+    m_writeBuffer.clear();
+    m_writeOffset = 0;
+    m_writeArmed = false;
+    m_pendingWritten = 0;
+}
+
+qint64 TermiosTransport::bytesAvailable() const {
+    int available = 0;
+    if (!isOpen() || ::ioctl(m_fd, FIONREAD, &available) != 0) {
+        return 0;
+    }
+    return available;
+}
+
+qint64 TermiosTransport::read(char *data, qint64 maxSize) {
+    if (!isOpen()) {
+        return -1;
+    }
+
+    ssize_t bytesRead = ::read(m_fd, data, static_cast<size_t>(maxSize));
+    if (bytesRead >= 0) {
+        return bytesRead;
+    }
+    if (errno == EAGAIN || errno == EINTR) {
+        return 0;
+    }
+
+    // EIO and friends: the device is gone
+    setSystemError(QStringLiteral("Read failed"));
+    fail(m_errorString);
+    return -1;
+}
+
+qint64 TermiosTransport::write(const char *data, qint64 size) {
+    if (!isOpen()) {
+        m_errorString = QStringLiteral("Port is not open");
+        return -1;
+    }
+
+    qint64 written = 0;
+    if (bytesToWrite() == 0) {
+        // Nothing queued, so the kernel can take the data straight away
+        ssize_t result = ::write(m_fd, data, static_cast<size_t>(size));
+        if (result < 0 && errno != EAGAIN && errno != EINTR) {
+            setSystemError(QStringLiteral("Write failed"));
+            return -1;
+        }
+        written = qMax<qint64>(0, result);
+    }
+
+    if (written < size) {
+        if (m_writeOffset > 0) {
+            m_writeBuffer.remove(0, static_cast<int>(m_writeOffset));
+            m_writeOffset = 0;
+        }
+        m_writeBuffer.append(data + written, static_cast<int>(size - written));
+        setWriteArmed(true);
+    }
+
+    reportWritten(written);
+    return size;
+}
+
+void TermiosTransport::onEvents(quint32 events) {
+    if (events & EPOLLIN) {
+        emit readyRead();
+    }
+
+    // readyRead() handlers may have closed the port
+    if (!isOpen()) {
+        return;
+    }
+
+    if (events & (EPOLLHUP | EPOLLRDHUP | EPOLLERR)) {
+        fail(QStringLiteral("Device disconnected"));
+        return;
+    }
+
+    if (events & EPOLLOUT) {
+        flushWriteBuffer();
+    }
+}
+
+void TermiosTransport::flushWriteBuffer() {
+    qint64 written = 0;
+    while (bytesToWrite() > 0) {
+        ssize_t result = ::write(m_fd, m_writeBuffer.constData() + m_writeOffset, static_cast<size_t>(bytesToWrite()));
+        if (result < 0) {
+            if (errno == EAGAIN || errno == EINTR) {
+                break;
+            }
+            setSystemError(QStringLiteral("Write failed"));
+            fail(m_errorString);
+            return;
+        }
+        m_writeOffset += result;
+        written += result;
+    }
+
+    if (bytesToWrite() == 0) {
+        m_writeBuffer.clear();
+        m_writeOffset = 0;
+        setWriteArmed(false);
+    }
+    reportWritten(written);
+}
+
+void TermiosTransport::setWriteArmed(bool armed) {
+    if (m_writeArmed == armed) {
+        return;
+    }
+    m_writeArmed = armed;
+    EpollReactor::forCurrentThread()->modify(m_fd, armed ? READ_EVENTS | EPOLLOUT : READ_EVENTS);
+}
+
+void TermiosTransport::reportWritten(qint64 bytes) {
+    if (bytes <= 0) {
+        return;
+    }
+
+    // bytesWritten() must not fire from inside write(); report once per event loop pass
+    m_pendingWritten += bytes;
+    if (!m_writtenPosted) {
+        m_writtenPosted = true;
+        QMetaObject::invokeMethod(this, &TermiosTransport::emitBytesWritten, Qt::QueuedConnection);
+    }
+}
+
+void TermiosTransport::emitBytesWritten() {
+    m_writtenPosted = false;
+    qint64 bytes = m_pendingWritten;
+    m_pendingWritten = 0;
+    if (bytes > 0) {
+        emit bytesWritten(bytes);
+    }
+}
+
+void TermiosTransport::fail(const QString &error) {
+    close();
+    m_errorString = error;
+
+    // Called from inside read() or event dispatch; let the caller unwind first
+    QMetaObject::invokeMethod(
+        this, [this, error]() { emit errorOccurred(error, true); }, Qt::QueuedConnection);
+}
+
+void TermiosTransport::setSystemError(const QString &context) {
+    int error = errno;
+    m_errorString = context + QStringLiteral(": ") + qt_error_string(error);
+}
@@ -0,0 +1,73 @@
+#ifndef TERMIOS_TRANSPORT_H
+#define TERMIOS_TRANSPORT_H
+
+#include "PortTransport.h"
+#include <QByteArray>
+
+/**
+ * @brief Native Linux serial backend built on termios2
+ *
+ * Talks to the tty directly instead of going through QSerialPort:
+ * - arbitrary baud rates through BOTHER, no rounding to standard values
+ * - VMIN/VTIME and ASYNC_LOW_LATENCY taken from TransportConfig
+ * - the descriptor is registered with the thread's EpollReactor, so
+ *   many ports on one I/O thread share a single epoll_wait()
+ * - read() goes straight to the kernel; there is no intermediate buffer
+ *
+ * Linux only; see TransportConfig::isSupported().
+ */
+class TermiosTransport : public PortTransport {
+    Q_OBJECT
+
+  public:
+    explicit TermiosTransport(QObject *parent = nullptr);
+    ~TermiosTransport() override;
+
+    TransportType type() const override { return TransportType::Termios; }
+
+    bool open(const SerialPortInfo &info) override;
+    void close() override;
+    bool isOpen() const override { return m_fd >= 0; }
+    QString errorString() const override { return m_errorString; }
+
+    qint64 bytesAvailable() const override;
+    qint64 read(char *data, qint64 maxSize) override;
+
+    qint64 write(const char *data, qint64 size) override;
+    qint64 bytesToWrite() const override { return m_writeBuffer.size() - m_writeOffset; }
+
+    LineErrorCounts lineErrors() const override;
+
+  protected:
+    // Takes ownership of an open descriptor, applies the line settings and starts watching it
+    bool attach(int fd, const SerialPortInfo &info);
+    void setSystemError(const QString &context);
+
+  private slots:
+    void emitBytesWritten();
+
+  private:
+    int m_fd;
+    QString m_errorString;
+
+    // Driver counters at open(); the kernel counts from device initialization
+    LineErrorCounts m_lineErrorBase;
+
+    // Data the kernel did not accept yet, flushed on EPOLLOUT
+    QByteArray m_writeBuffer;
+    qint64 m_writeOffset;
+    bool m_writeArmed;
+
+    // Accepted bytes not yet reported through bytesWritten()
+    qint64 m_pendingWritten;
+    bool m_writtenPosted;
+
+    bool configure(const SerialPortInfo &info);
+    void onEvents(quint32 events);
+    void flushWriteBuffer();
+    void setWriteArmed(bool armed);
+    void reportWritten(qint64 bytes);
+    void fail(const QString &error);
+};
+
+#endif // TERMIOS_TRANSPORT_H
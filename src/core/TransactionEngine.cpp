@@ -0,0 +1,254 @@
+#include "TransactionEngine.h"
+#include "Checksum.h"
+#include "SerialPortUser.h"
+#include "TimeUtils.h"
+
+namespace {
+const qint64 NS_PER_MS = 1000000;
+
+// Requests in flight at once; 1 is plain stop-and-wait polling
+const int DEFAULT_WINDOW = 1;
+
+const int DEFAULT_TIMEOUT_MS = 1000;
+} // namespace
+
+namespace ResponseMatchers {
+ResponseMatcher any() {
+    return [](const QByteArray &, const QByteArray &) { return true; };
+}
+
+ResponseMatcher sameField(int offset, int length) {
+    return [offset, length](const QByteArray &request, const QByteArray &response) {
+        if (request.size() < offset + length || response.size() < offset + length) {
+            return false;
+        }
+        return request.mid(offset, length) == response.mid(offset, length);
+    };
+}
+} // namespace ResponseMatchers
+
+TransactionEngine::TransactionEngine(SerialPortUser *user)
+    : QObject(user), m_user(user), m_matcher(ResponseMatchers::any()), m_window(DEFAULT_WINDOW),
+      m_defaultTimeoutMs(DEFAULT_TIMEOUT_MS), m_nextId(1), m_timeoutTimer(new QTimer(this)), m_cycleIndex(0),
+      m_running(false), m_pumping(false), m_completed(0), m_timeouts(0), m_failed(0), m_unmatched(0) {
+    m_timeoutTimer->setSingleShot(true);
+    m_timeoutTimer->setTimerType(Qt::PreciseTimer);
+    QObject::connect(m_timeoutTimer, &QTimer::timeout, this, &TransactionEngine::onTimeout);
+    QObject::connect(user, &SerialPortUser::messageReceived, this, &TransactionEngine::onMessageReceived);
+    QObject::connect(user, &SerialPortUser::messageSent, this, &TransactionEngine::onMessageSent);
+    QObject::connect(user, &SerialPortUser::statusChanged, this, &TransactionEngine::onStatusChanged);
+
+    // Requests rejected by a full transmit queue, and a cycle paused by a closed port, go on from here
+    QObject::connect(user, &SerialPortUser::connected, this, &TransactionEngine::pump);
+}
+
+void TransactionEngine::setWindow(int requests) {
+    m_window = qMax(1, requests);
+    pump();
+}
+
+quint64 TransactionEngine::submit(const QByteArray &request, int timeoutMs) {
+    Transaction transaction = createTransaction(request, timeoutMs);
+    m_queued.enqueue(transaction);
+    pump();
+    return transaction.id;
+}
+
+void TransactionEngine::setCycle(const QList<QByteArray> &requests) {
+    m_cycle = requests;
+    m_cycleIndex = 0;
+    pump();
+}
+
+void TransactionEngine::resetStatistics() {
+    m_latency.clear();
+    m_completed = 0;
+    m_timeouts = 0;
+    m_failed = 0;
+    m_unmatched = 0;
+}
+
+void TransactionEngine::start() {
+    m_running = true;
+    pump();
+}
+
+void TransactionEngine::stop() { m_running = false; }
+
+void TransactionEngine::cancelAll() {
+    m_running = false;
+    m_timeoutTimer->stop();
+
+    QList<Transaction> cancelled = m_inFlight;
+    cancelled.append(m_queued);
+    m_inFlight.clear();
+    m_queued.clear();
+    for (const Transaction &transaction : qAsConst(cancelled)) {
+        finish(transaction, TransactionStatus::Failed, QByteArray(), 0, tr("Cancelled"));
+    }
+}
+
+TransactionEngine::Transaction TransactionEngine::createTransaction(const QByteArray &request, int timeoutMs) {
+    return {m_nextId++, request, timeoutMs < 0 ? m_defaultTimeoutMs : qMax(1, timeoutMs), QByteArray(), 0, 0};
+}
+
+void TransactionEngine::pump() {
+    // Result handlers may submit more requests; the outer call picks them up
+    if (m_pumping) {
+        return;
+    }
+    m_pumping = true;
+
+    // While the port is closed the queued requests fail, and the cycle waits for the reconnect
+    bool portClosed = false;
+    while (m_inFlight.size() < m_window) {
+        Transaction transaction;
+        bool fromCycle = false;
+        if (!m_queued.isEmpty()) {
+            transaction = m_queued.dequeue();
+        } else if (m_running && !m_cycle.isEmpty() && !portClosed) {
+            transaction = createTransaction(m_cycle.at(m_cycleIndex), -1);
+            m_cycleIndex = (m_cycleIndex + 1) % m_cycle.size();
+            fromCycle = true;
+        } else {
+            break;
+        }
+
+        // In flight before sending, so the Sent message finds it however soon it comes back
+        transaction.payload = Checksum::append(m_user->info().checksum(), transaction.request);
+        m_inFlight.append(transaction);
+        if (!m_user->sendData(transaction.request)) {
+            m_inFlight.removeLast();
+            if (m_user->isOnline() || m_user->isReconnecting()) {
+                // Transmit queue is full; try again once something has been written
+                if (fromCycle) {
+                    m_cycleIndex = (m_cycleIndex + m_cycle.size() - 1) % m_cycle.size();
+                } else {
+                    m_queued.prepend(transaction);
+                }
+                break;
+            }
+            portClosed = true;
+            finish(transaction, TransactionStatus::Failed, QByteArray(), 0, m_user->errorString());
+        }
+    }
+
+    armTimeout();
+    m_pumping = false;
+}
+
+void TransactionEngine::onMessageReceived(const Message &message) {
+    const QByteArray response = message.data();
+    for (int i = 0; i < m_inFlight.size(); ++i) {
+        if (!m_matcher || m_matcher(m_inFlight.at(i).request, response)) {
+            Transaction transaction = m_inFlight.takeAt(i);
+            qint64 latency = transaction.isWritten() ? qMax(qint64(0), message.timestampNs() - transaction.sentNs) : 0;
+            finish(transaction, TransactionStatus::Completed, response, latency);
+            pump();
+            return;
+        }
+    }
+
+    m_unmatched++;
+    emit unmatchedResponse(response);
+}
+
+void TransactionEngine::onMessageSent(const Message &message) {
+    // Writes complete in queue order; anything else the user sent in between does not match
+    for (Transaction &transaction : m_inFlight) {
+        if (!transaction.isWritten()) {
+            if (message.data() == transaction.payload) {
+                transaction.sentNs = message.timestampNs();
+                transaction.deadlineNs = transaction.sentNs + transaction.timeoutMs * NS_PER_MS;
+                armTimeout();
+            }
+            break;
+        }
+    }
+
+    // A slot in the transmit queue has been freed
+    if (!m_queued.isEmpty() || m_running) {
+        pump();
+    }
+}
+
+void TransactionEngine::onStatusChanged(PortStatus status) {
+    if (status == PortStatus::Online || status == PortStatus::Reconnecting) {
+        return;
+    }
+
+    // Closing the port discarded the writes that were still queued
+    QList<Transaction> discarded;
+    for (int i = 0; i < m_inFlight.size();) {
+        if (!m_inFlight.at(i).isWritten()) {
+            discarded.append(m_inFlight.takeAt(i));
+        } else {
+            ++i;
+        }
+    }
+    for (const Transaction &transaction : qAsConst(discarded)) {
+        finish(transaction, TransactionStatus::Failed, QByteArray(), 0, tr("Port closed before the request was sent"));
+    }
+    armTimeout();
+}
+
+void TransactionEngine::onTimeout() {
+    qint64 now = TimeUtils::timestampNs();
+    QList<Transaction> expired;
+    for (int i = 0; i < m_inFlight.size();) {
+        if (m_inFlight.at(i).isWritten() && m_inFlight.at(i).deadlineNs <= now) {
+            expired.append(m_inFlight.takeAt(i));
+        } else {
+            ++i;
+        }
+    }
+
+    for (const Transaction &transaction : qAsConst(expired)) {
+        finish(transaction, TransactionStatus::TimedOut, QByteArray(), now - transaction.sentNs,
+               tr("No response within %1 ms").arg(transaction.timeoutMs));
+    }
+    pump();
+}
+
+void TransactionEngine::finish(const Transaction &transaction, TransactionStatus status, const QByteArray &response,
+                               qint64 latencyNs, const QString &error) {
+    switch (status) {
+    case TransactionStatus::Completed:
+        m_completed++;
+        m_latency.record(latencyNs);
+        break;
+    case TransactionStatus::TimedOut:
+        m_timeouts++;
+        break;
+    case TransactionStatus::Failed:
+        m_failed++;
+        break;
+    }
+
+    TransactionResult result;
+    result.id = transaction.id;
+    result.status = status;
+    result.request = transaction.request;
+    result.response = response;
+    result.latencyNs = latencyNs;
+    result.error = error;
+    emit transactionFinished(result);
+}
+
+void TransactionEngine::armTimeout() {
+    // Deadlines start when a request has been written
+    qint64 earliest = -1;
+    for (const Transaction &transaction : qAsConst(m_inFlight)) {
+        if (transaction.isWritten() && (earliest < 0 || transaction.deadlineNs < earliest)) {
+            earliest = transaction.deadlineNs;
+        }
+    }
+    if (earliest < 0) {
+        m_timeoutTimer->stop();
+        return;
+    }
+
+    // Round up so the timer never fires before the deadline has passed
+    qint64 remaining = qMax(qint64(0), earliest - TimeUtils::timestampNs());
+    m_timeoutTimer->start(static_cast<int>((remaining + NS_PER_MS - 1) / NS_PER_MS));
+}
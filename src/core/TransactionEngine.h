@@ -0,0 +1,173 @@
+#ifndef TRANSACTION_ENGINE_H
+#define TRANSACTION_ENGINE_H
+
+#include "LatencyHistogram.h"
+#include "Message.h"
+#include "SerialPortInfo.h"
+#include <QByteArray>
+#include <QList>
+#include <QObject>
+#include <QQueue>
+#include <QString>
+#include <QTimer>
+#include <functional>
+
+class SerialPortUser;
+
+/**
+ * @brief Decides whether a received frame is the reply to a request
+ */
+using ResponseMatcher = std::function<bool(const QByteArray &request, const QByteArray &response)>;
+
+namespace ResponseMatchers {
+// Any frame answers the oldest request in flight; for devices that reply in order
+ResponseMatcher any();
+
+// The reply repeats `length` bytes of the request starting at `offset`,
+// e.g. the Modbus RTU slave address and function code (0, 2)
+ResponseMatcher sameField(int offset, int length);
+} // namespace ResponseMatchers
+
+enum class TransactionStatus {
+    Completed,
+    TimedOut,
+    Failed // Could not be sent
+};
+
+/**
+ * @brief Outcome of one request
+ */
+struct TransactionResult {
+    quint64 id = 0;
+    TransactionStatus status = TransactionStatus::Failed;
+    QByteArray request;
+    QByteArray response;
+    qint64 latencyNs = 0; // From writing the request until the read that completed the reply
+    QString error;
+};
+
+/**
+ * @brief Request/response polling master on top of a SerialPortUser
+ *
+ * Requests are queued with submit() and sent as soon as fewer than
+ * window() of them are waiting for a reply, so several can be in flight at
+ * once on links and devices that allow it. Each received frame is offered
+ * to the in-flight requests from oldest to newest; the first one the
+ * matcher accepts completes with that frame. Frames that match nothing
+ * (late replies, unsolicited data) are counted as unmatched.
+ *
+ * sendData() only queues a request for the I/O thread, so a request counts
+ * as sent once its Sent message comes back (SerialPortUser::messageSent()):
+ * its round-trip time and its timeout both start at that write, not at the
+ * time it was queued behind other data or held back by pacing.
+ *
+ * A request that gets no reply within its timeout is finished as TimedOut
+ * and its slot in the window is freed. Deadlines are kept by one precise
+ * timer armed for the earliest of them.
+ *
+ * A request that cannot be sent while the port is closed finishes as Failed
+ * at once; it is not kept for later. One rejected by a full transmit queue
+ * stays queued and is tried again after the next write, reply, timeout or
+ * reconnect. Requests still waiting to be written when the port is closed
+ * are finished as Failed.
+ *
+ * setCycle() installs a list of requests that is polled round-robin for as
+ * long as the engine is started, which is the usual way to poll a bus of
+ * devices. After a failed send the cycle pauses until the next reply,
+ * timeout or reconnect. Round-trip times of completed requests are
+ * collected in a LatencyHistogram.
+ *
+ * The engine works on the messages SerialPortUser already delivers, so
+ * framing must be configured on the port to split replies into frames.
+ * It lives on the user's thread and needs no widgets.
+ */
+class TransactionEngine : public QObject {
+    Q_OBJECT
+
+  public:
+    // Owned by the user
+    explicit TransactionEngine(SerialPortUser *user);
+
+    // Configuration
+    void setWindow(int requests);
+    int window() const { return m_window; }
+    void setDefaultTimeout(int timeoutMs) { m_defaultTimeoutMs = qMax(1, timeoutMs); }
+    int defaultTimeout() const { return m_defaultTimeoutMs; }
+    void setMatcher(const ResponseMatcher &matcher) { m_matcher = matcher; }
+
+    // One-off requests; a negative timeout uses defaultTimeout()
+    quint64 submit(const QByteArray &request, int timeoutMs = -1);
+    int queuedCount() const { return m_queued.size(); }
+    int inFlightCount() const { return m_inFlight.size(); }
+
+    // Continuous polling
+    void setCycle(const QList<QByteArray> &requests);
+    QList<QByteArray> cycle() const { return m_cycle; }
+    bool isRunning() const { return m_running; }
+
+    // Statistics
+    const LatencyHistogram &latency() const { return m_latency; }
+    qint64 completedCount() const { return m_completed; }
+    qint64 timeoutCount() const { return m_timeouts; }
+    qint64 failedCount() const { return m_failed; }
+    qint64 unmatchedCount() const { return m_unmatched; }
+    void resetStatistics();
+
+  public slots:
+    void start();
+    void stop();
+
+    // Stops the cycle and finishes everything queued or in flight as Failed
+    void cancelAll();
+
+  signals:
+    void transactionFinished(const TransactionResult &result);
+    void unmatchedResponse(const QByteArray &response);
+
+  private slots:
+    void onMessageReceived(const Message &message);
+    void onMessageSent(const Message &message);
+    void onStatusChanged(PortStatus status);
+    void onTimeout();
+    void pump();
+
+  private:
+    struct Transaction {
+        quint64 id;
+        QByteArray request;
+        int timeoutMs;
+        QByteArray payload; // As written, with the port's checksum
+        qint64 sentNs;      // Write time from the Sent message; 0 until then
+        qint64 deadlineNs;
+
+        bool isWritten() const { return sentNs != 0; }
+    };
+
+    SerialPortUser *m_user;
+    ResponseMatcher m_matcher;
+    int m_window;
+    int m_defaultTimeoutMs;
+    quint64 m_nextId;
+
+    QQueue<Transaction> m_queued;
+    QList<Transaction> m_inFlight;
+    QTimer *m_timeoutTimer;
+
+    QList<QByteArray> m_cycle;
+    int m_cycleIndex;
+    bool m_running;
+    bool m_pumping;
+
+    LatencyHistogram m_latency;
+    qint64 m_completed;
+    qint64 m_timeouts;
+    qint64 m_failed;
+    qint64 m_unmatched;
+
+    Transaction createTransaction(const QByteArray &request, int timeoutMs);
+    void finish(const Transaction &transaction, TransactionStatus status, const QByteArray &response,
+                qint64 latencyNs, const QString &error = QString());
+    void armTimeout();
+};
+
+#endif // TRANSACTION_ENGINE_H
@@ -0,0 +1,85 @@
+#include "TransmitPacer.h"
+
+namespace {
+// How far the utilization clock may run ahead of real time; keeps the driver
+// fed between timer wake-ups without exceeding the average rate
+const qint64 RATE_LOOKAHEAD_NS = 1000000;
+}
+
+TransmitPacer::TransmitPacer()
+    : m_enabled(false)
+    , m_characterTimeNs(1)
+    , m_interByteDelayNs(0)
+    , m_interFrameGapNs(0)
+    , m_rateCostNs(0)
+    , m_lineFreeNs(0)
+    , m_gapUntilNs(0)
+    , m_rateClockNs(0)
+{
+}
+
+void TransmitPacer::configure(const PacingConfig& config, qint64 characterTimeNs)
+{
+    m_enabled = config.isEnabled();
+    m_characterTimeNs = qMax(qint64(1), characterTimeNs);
+    m_interByteDelayNs = qMax(0, config.interByteDelayUs()) * qint64(1000);
+    m_interFrameGapNs = qMax(0, config.interFrameGapUs()) * qint64(1000);
+
+    int utilization = qBound(1, config.maxUtilization(), 100);
+    m_rateCostNs = utilization < 100 ? m_characterTimeNs * 100 / utilization : 0;
+
+    reset();
+}
+
+qint64 TransmitPacer::delayNs(qint64 nowNs) const
+{
+    qint64 releaseAt = m_gapUntilNs;
+    if (m_rateCostNs > 0) {
+        // Wait until at least one more byte fits into the lookahead window
+        releaseAt = qMax(releaseAt, m_rateClockNs + m_rateCostNs - RATE_LOOKAHEAD_NS);
+    }
+    return qMax(qint64(0), releaseAt - nowNs);
+}
+
+qint64 TransmitPacer::releasable(qint64 nowNs, qint64 available) const
+{
+    if (available <= 0) {
+        return 0;
+    }
+
+    // Every byte needs its own idle time, so release them one at a time
+    if (m_interByteDelayNs > 0) {
+        return 1;
+    }
+
+    qint64 bytes = available;
+    if (m_rateCostNs > 0) {
+        qint64 budget = nowNs + RATE_LOOKAHEAD_NS - qMax(nowNs, m_rateClockNs);
+        bytes = qMin(bytes, qMax(qint64(1), budget / m_rateCostNs));
+    }
+    return bytes;
+}
+
+void TransmitPacer::commit(qint64 nowNs, qint64 bytes, bool endOfFrame)
+{
+    bytes = qMax(qint64(0), bytes);
+    m_lineFreeNs = qMax(nowNs, m_lineFreeNs) + wireTimeNs(bytes);
+
+    if (m_rateCostNs > 0) {
+        m_rateClockNs = qMax(nowNs, m_rateClockNs) + bytes * m_rateCostNs;
+    }
+
+    // Gaps are measured from the moment the last released byte leaves the wire
+    qint64 gap = m_interByteDelayNs;
+    if (endOfFrame) {
+        gap = qMax(gap, m_interFrameGapNs);
+    }
+    m_gapUntilNs = gap > 0 ? m_lineFreeNs + gap : 0;
+}
+
+void TransmitPacer::reset()
+{
+    m_lineFreeNs = 0;
+    m_gapUntilNs = 0;
+    m_rateClockNs = 0;
+}
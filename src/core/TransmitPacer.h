@@ -0,0 +1,54 @@
+#ifndef TRANSMIT_PACER_H
+#define TRANSMIT_PACER_H
+
+#include <QtGlobal>
+#include "PacingConfig.h"
+
+/**
+ * @brief Decides when queued bytes may be handed to the serial driver
+ *
+ * The pacer keeps a model of the line: every released byte occupies the
+ * wire for one character time (start bit, data bits, parity, stop bits at
+ * the configured baud rate). From that it derives the earliest moment the
+ * next byte may be released so that
+ * - the line is idle for interByteDelayUs after every byte,
+ * - the line is idle for interFrameGapUs after every frame (one payload),
+ * - on average no more than maxUtilization percent of the line is used.
+ *
+ * All times are in nanoseconds on a monotonic clock supplied by the caller,
+ * which keeps the class free of timers and easy to test.
+ */
+class TransmitPacer {
+public:
+    TransmitPacer();
+
+    // Configuration
+    void configure(const PacingConfig& config, qint64 characterTimeNs);
+    bool isEnabled() const { return m_enabled; }
+    qint64 characterTimeNs() const { return m_characterTimeNs; }
+    qint64 wireTimeNs(qint64 bytes) const { return bytes * m_characterTimeNs; }
+
+    // Scheduling
+    qint64 delayNs(qint64 nowNs) const;
+    qint64 releasable(qint64 nowNs, qint64 available) const;
+    void commit(qint64 nowNs, qint64 bytes, bool endOfFrame);
+    void reset();
+
+private:
+    bool m_enabled;
+    qint64 m_characterTimeNs;
+    qint64 m_interByteDelayNs;
+    qint64 m_interFrameGapNs;
+
+    // Time one released byte is charged against the utilization limit
+    qint64 m_rateCostNs;
+
+    // Estimated time the wire finishes sending everything released so far
+    qint64 m_lineFreeNs;
+    // Earliest release time imposed by the inter-byte delay or frame gap
+    qint64 m_gapUntilNs;
+    // Utilization clock; runs ahead of real time while the rate limit is in use
+    qint64 m_rateClockNs;
+};
+
+#endif // TRANSMIT_PACER_H
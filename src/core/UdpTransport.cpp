@@ -0,0 +1,106 @@
+#include "UdpTransport.h"
+#include <QHostInfo>
+#include <QMetaObject>
+#include <QNetworkDatagram>
+#include <cstring>
+
+UdpTransport::UdpTransport(QObject *parent)
+    : PortTransport(parent), m_socket(new QUdpSocket(this)), m_remotePort(0), m_datagramOffset(0),
+      m_unreportedBytes(0) {
+    QObject::connect(m_socket, &QUdpSocket::readyRead, this, &UdpTransport::onSocketReadyRead);
+}
+
+bool UdpTransport::open(const SerialPortInfo &info) {
+    if (isOpen()) {
+        return true;
+    }
+
+    TransportConfig config = info.transport();
+    if (config.address().isEmpty() || config.port() <= 0 || config.port() > 65535) {
+        m_errorString = QStringLiteral("No remote address configured");
+        return false;
+    }
+
+    // Host names are resolved once, on the I/O thread
+    if (!m_remoteAddress.setAddress(config.address())) {
+        QHostInfo host = QHostInfo::fromName(config.address());
+        if (host.addresses().isEmpty()) {
+            m_errorString = host.errorString();
+            return false;
+        }
+        m_remoteAddress = host.addresses().first();
+    }
+    m_remotePort = static_cast<quint16>(config.port());
+
+    QHostAddress local = m_remoteAddress.protocol() == QAbstractSocket::IPv4Protocol ? QHostAddress(QHostAddress::AnyIPv4)
+                                                                                     : QHostAddress(QHostAddress::Any);
+    if (!m_socket->bind(local, static_cast<quint16>(qBound(0, config.localPort(), 65535)))) {
+        m_errorString = m_socket->errorString();
+        return false;
+    }
+
+    m_errorString.clear();
+    return true;
+}
+
+void UdpTransport::close() {
+    m_socket->abort();
+    m_datagram.clear();
+    m_datagramOffset = 0;
+    m_unreportedBytes = 0;
+}
+
+qint64 UdpTransport::read(char *data, qint64 maxSize) {
+    qint64 count = qMin(maxSize, bytesAvailable());
+    if (count > 0) {
+        std::memcpy(data, m_datagram.constData() + m_datagramOffset, static_cast<size_t>(count));
+        m_datagramOffset += static_cast<int>(count);
+    }
+
+    takeDatagram();
+    return count;
+}
+
+qint64 UdpTransport::write(const char *data, qint64 size) {
+    qint64 written = m_socket->writeDatagram(data, size, m_remoteAddress, m_remotePort);
+    if (written == -1) {
+        m_errorString = m_socket->errorString();
+        return -1;
+    }
+
+    // QUdpSocket reports bytesWritten() from inside writeDatagram(); post it instead
+    if (m_unreportedBytes == 0) {
+        QMetaObject::invokeMethod(this, &UdpTransport::reportWritten, Qt::QueuedConnection);
+    }
+    m_unreportedBytes += written;
+    return written;
+}
+
+void UdpTransport::onSocketReadyRead() {
+    takeDatagram();
+    if (bytesAvailable() > 0) {
+        emit readyRead();
+    }
+}
+
+void UdpTransport::reportWritten() {
+    qint64 bytes = m_unreportedBytes;
+    m_unreportedBytes = 0;
+    if (bytes > 0) {
+        emit bytesWritten(bytes);
+    }
+}
+
+void UdpTransport::takeDatagram() {
+    if (bytesAvailable() > 0) {
+        return;
+    }
+
+    m_datagram.clear();
+    m_datagramOffset = 0;
+
+    // Empty datagrams carry nothing; skip them so they do not stall the socket
+    while (m_datagram.isEmpty() && m_socket->hasPendingDatagrams()) {
+        m_datagram = m_socket->receiveDatagram().data();
+    }
+}
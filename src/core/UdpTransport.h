@@ -0,0 +1,57 @@
+#ifndef UDP_TRANSPORT_H
+#define UDP_TRANSPORT_H
+
+#include "PortTransport.h"
+#include <QHostAddress>
+#include <QUdpSocket>
+
+/**
+ * @brief Datagram backend for devices that speak UDP (serial-to-Ethernet bridges, sensors)
+ *
+ * Binds TransportConfig::localPort() (0 picks a free port) and sends every
+ * write() as one datagram to address():port(). Datagrams from any sender
+ * are accepted. Received datagrams are handed out as a byte stream, so the
+ * port's framing settings apply as usual; a datagram larger than one read
+ * is split across reads rather than truncated.
+ */
+class UdpTransport : public PortTransport {
+    Q_OBJECT
+
+  public:
+    explicit UdpTransport(QObject *parent = nullptr);
+
+    TransportType type() const override { return TransportType::Udp; }
+    bool isDatagram() const override { return true; }
+
+    bool open(const SerialPortInfo &info) override;
+    void close() override;
+    bool isOpen() const override { return m_socket->state() == QAbstractSocket::BoundState; }
+    QString errorString() const override { return m_errorString; }
+
+    qint64 bytesAvailable() const override { return m_datagram.size() - m_datagramOffset; }
+    qint64 read(char *data, qint64 maxSize) override;
+
+    qint64 write(const char *data, qint64 size) override;
+    qint64 bytesToWrite() const override { return m_unreportedBytes; }
+
+  private slots:
+    void onSocketReadyRead();
+    void reportWritten();
+
+  private:
+    QUdpSocket *m_socket;
+    QString m_errorString;
+    QHostAddress m_remoteAddress;
+    quint16 m_remotePort;
+
+    // Datagram being handed out piecewise; the next one is fetched once it is used up
+    QByteArray m_datagram;
+    int m_datagramOffset;
+
+    // Bytes sent since the last bytesWritten()
+    qint64 m_unreportedBytes;
+
+    void takeDatagram();
+};
+
+#endif // UDP_TRANSPORT_H
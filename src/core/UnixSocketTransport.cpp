@@ -0,0 +1,102 @@
+#include "UnixSocketTransport.h"
+#include <QTimer>
+
+namespace {
+// Longest openAsync() waits for the server to accept
+const int CONNECT_TIMEOUT_MS = 3000;
+} // namespace
+
+UnixSocketTransport::UnixSocketTransport(QObject *parent)
+    : PortTransport(parent), m_socket(new QLocalSocket(this)), m_connectTimer(new QTimer(this)), m_connecting(false),
+      m_closing(false) {
+    m_connectTimer->setSingleShot(true);
+    m_connectTimer->setInterval(CONNECT_TIMEOUT_MS);
+    QObject::connect(m_connectTimer, &QTimer::timeout, this, &UnixSocketTransport::onConnectTimeout);
+
+    QObject::connect(m_socket, &QLocalSocket::connected, this, &UnixSocketTransport::onConnected);
+#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
+    QObject::connect(m_socket, &QLocalSocket::errorOccurred, this, &UnixSocketTransport::onSocketError);
+#else
+    QObject::connect(m_socket, QOverload<QLocalSocket::LocalSocketError>::of(&QLocalSocket::error), this,
+                     &UnixSocketTransport::onSocketError);
+#endif
+    QObject::connect(m_socket, &QLocalSocket::readyRead, this, &PortTransport::readyRead);
+    QObject::connect(m_socket, &QLocalSocket::bytesWritten, this, &PortTransport::bytesWritten);
+    QObject::connect(m_socket, &QLocalSocket::disconnected, this, &UnixSocketTransport::onDisconnected);
+}
+
+void UnixSocketTransport::openAsync(const SerialPortInfo &info) {
+    if (isOpen()) {
+        emit openFinished(true);
+        return;
+    }
+
+    QString path = info.transport().address();
+    if (path.isEmpty()) {
+        m_errorString = QStringLiteral("No socket path configured");
+        emit openFinished(false);
+        return;
+    }
+
+    close();
+    m_connecting = true;
+    m_connectTimer->start();
+    m_socket->connectToServer(path);
+}
+
+void UnixSocketTransport::close() {
+    m_connecting = false;
+    m_connectTimer->stop();
+    m_closing = true;
+    m_socket->abort();
+    m_closing = false;
+}
+
+qint64 UnixSocketTransport::write(const char *data, qint64 size) {
+    qint64 written = m_socket->write(data, size);
+    if (written == -1) {
+        m_errorString = m_socket->errorString();
+    }
+    return written;
+}
+
+void UnixSocketTransport::onConnected() {
+    if (m_connecting) {
+        finishOpen(true, QString());
+    }
+}
+
+void UnixSocketTransport::onSocketError() {
+    // Errors of an established connection end in disconnected()
+    if (m_connecting) {
+        finishOpen(false, m_socket->errorString());
+    }
+}
+
+void UnixSocketTransport::onConnectTimeout() {
+    if (m_connecting) {
+        finishOpen(false, QStringLiteral("Connection timed out"));
+    }
+}
+
+void UnixSocketTransport::finishOpen(bool ok, const QString &error) {
+    m_connecting = false;
+    m_connectTimer->stop();
+    if (ok) {
+        m_errorString.clear();
+    } else {
+        m_errorString = error;
+        close();
+    }
+    emit openFinished(ok);
+}
+
+void UnixSocketTransport::onDisconnected() {
+    if (m_closing) {
+        return;
+    }
+
+    m_errorString = QStringLiteral("Connection closed by server");
+    close();
+    emit errorOccurred(m_errorString, true);
+}
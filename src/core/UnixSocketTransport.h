@@ -0,0 +1,55 @@
+#ifndef UNIX_SOCKET_TRANSPORT_H
+#define UNIX_SOCKET_TRANSPORT_H
+
+#include "PortTransport.h"
+#include <QLocalSocket>
+
+class QTimer;
+
+/**
+ * @brief Local stream socket backend (Unix domain socket, named pipe on Windows)
+ *
+ * Connects to the server named by TransportConfig::address(), typically a
+ * socket path exposed by a simulator or a serial multiplexer. Behaves like
+ * TcpTransport otherwise: openAsync() reports through openFinished() without
+ * waiting for the server, and a connection closed by the server is a fatal
+ * error.
+ */
+class UnixSocketTransport : public PortTransport {
+    Q_OBJECT
+
+  public:
+    explicit UnixSocketTransport(QObject *parent = nullptr);
+
+    TransportType type() const override { return TransportType::UnixSocket; }
+
+    void openAsync(const SerialPortInfo &info) override;
+    void close() override;
+    bool isOpen() const override { return m_socket->state() == QLocalSocket::ConnectedState; }
+    QString errorString() const override { return m_errorString; }
+
+    qint64 bytesAvailable() const override { return m_socket->bytesAvailable(); }
+    qint64 read(char *data, qint64 maxSize) override { return m_socket->read(data, maxSize); }
+
+    qint64 write(const char *data, qint64 size) override;
+    qint64 bytesToWrite() const override { return m_socket->bytesToWrite(); }
+
+    void setReadBufferSize(qint64 size) override { m_socket->setReadBufferSize(size); }
+
+  private slots:
+    void onConnected();
+    void onSocketError();
+    void onConnectTimeout();
+    void onDisconnected();
+
+  private:
+    QLocalSocket *m_socket;
+    QString m_errorString;
+    QTimer *m_connectTimer;
+    bool m_connecting;
+    bool m_closing;
+
+    void finishOpen(bool ok, const QString &error);
+};
+
+#endif // UNIX_SOCKET_TRANSPORT_H
@@ -0,0 +1,165 @@
+#include "SerialChatDaemon.h"
+#include "HexUtils.h"
+#include <QDateTime>
+#include <QTextStream>
+
+namespace {
+// Longest payload printed with --log-messages
+const int LOG_PREVIEW_BYTES = 32;
+} // namespace
+
+SerialChatDaemon::SerialChatDaemon(const DaemonOptions &options, QObject *parent)
+    : QObject(parent), m_options(options), m_portManager(new SerialPortManager(this)),
+      m_messageManager(new MessageManager(this)), m_dataPersistence(new DataPersistence(this)),
+      m_saveTimer(new QTimer(this)) {
+    if (!m_options.dataDirectory.isEmpty()) {
+        m_dataPersistence->setDataDirectory(m_options.dataDirectory);
+    }
+
+    connect(m_portManager, &SerialPortManager::userStatusChanged, this, &SerialChatDaemon::onUserStatusChanged);
+    connect(m_portManager, &SerialPortManager::userMessageReceived, this, &SerialChatDaemon::onUserMessageReceived);
+    connect(m_portManager, &SerialPortManager::userMessageSent, this, &SerialChatDaemon::onUserMessageSent);
+    connect(m_portManager, &SerialPortManager::portsConnected, this, &SerialChatDaemon::onPortsConnected);
+    connect(m_portManager, &SerialPortManager::userReconnected, this,
+            [this](const QString &portName, int attempts, qint64 downtimeMs) {
+                log(tr("Reconnected to %1 after %2 attempts (%3 s down)")
+                        .arg(portName)
+                        .arg(attempts)
+                        .arg(downtimeMs / 1000.0, 0, 'f', 1));
+            });
+    connect(m_dataPersistence, &DataPersistence::error, this, [this](const QString &error) { log(error); });
+    connect(m_saveTimer, &QTimer::timeout, this, &SerialChatDaemon::saveMessages);
+}
+
+SerialChatDaemon::~SerialChatDaemon() { qDeleteAll(m_chatGroups); }
+
+bool SerialChatDaemon::start() {
+    log(tr("Data directory: %1").arg(m_dataPersistence->dataDirectory()));
+
+    const QList<SerialPortInfo> friends = m_dataPersistence->loadFriendList();
+    for (const SerialPortInfo &info : friends) {
+        m_portManager->addToFriendList(info);
+    }
+    const QList<ChatGroupInfo> groups = m_dataPersistence->loadChatGroups();
+    for (const ChatGroupInfo &info : groups) {
+        createChatGroup(info);
+    }
+
+    QStringList ports = m_options.ports;
+    if (ports.isEmpty()) {
+        for (const SerialPortInfo &info : friends) {
+            ports.append(info.portName());
+        }
+    }
+    for (const QString &portName : qAsConst(ports)) {
+        if (!m_portManager->hasFriend(portName)) {
+            log(tr("%1 is not in the friend list; opening it with default settings").arg(portName));
+            m_portManager->addToFriendList(portName);
+        }
+    }
+    if (ports.isEmpty()) {
+        log(tr("No ports configured; add ports in Serial Chat or pass --port"));
+        return false;
+    }
+
+    log(tr("Opening %1 ports, %2 groups").arg(ports.size()).arg(m_chatGroups.size()));
+    m_portManager->setAutoRefresh(true);
+    m_portManager->connectPorts(ports);
+
+    if (m_options.saveIntervalSec > 0) {
+        m_saveTimer->start(m_options.saveIntervalSec * 1000);
+    }
+    return true;
+}
+
+void SerialChatDaemon::shutdown() {
+    m_saveTimer->stop();
+    m_portManager->disconnectAll();
+    saveMessages();
+    log(tr("Stopped"));
+}
+
+void SerialChatDaemon::onUserStatusChanged(const QString &portName, PortStatus status) {
+    SerialPortUser *user = m_portManager->getUser(portName);
+    if (status == PortStatus::Online && user && !user->peerName().isEmpty()) {
+        log(tr("Loopback %1: attach the other end to %2").arg(portName, user->peerName()));
+    }
+    if (status == PortStatus::Reconnecting && user) {
+        log(tr("Lost connection to %1 (%2), reconnecting").arg(portName, user->errorString()));
+    }
+}
+
+void SerialChatDaemon::onUserMessageReceived(const QString &portName, const Message &message) {
+    m_messageManager->addMessage(message);
+    m_unsavedMessages[portName].append(message);
+    if (m_options.logMessages) {
+        log(tr("%1 RX %2 bytes: %3")
+                .arg(portName)
+                .arg(message.data().size())
+                .arg(HexUtils::byteArrayToHexString(message.data().left(LOG_PREVIEW_BYTES))));
+    }
+}
+
+void SerialChatDaemon::onUserMessageSent(const QString &portName, const Message &message) {
+    m_messageManager->addMessage(message);
+    m_unsavedMessages[portName].append(message);
+    if (m_options.logMessages) {
+        log(tr("%1 TX %2 bytes: %3")
+                .arg(portName)
+                .arg(message.data().size())
+                .arg(HexUtils::byteArrayToHexString(message.data().left(LOG_PREVIEW_BYTES))));
+    }
+}
+
+void SerialChatDaemon::onPortsConnected(const QList<PortConnectResult> &results, qint64 elapsedNs) {
+    int connected = 0;
+    int failed = 0;
+    for (const PortConnectResult &result : results) {
+        if (result.ok) {
+            connected++;
+            log(tr("Connected to %1 (%2 ms)").arg(result.portName).arg(result.openTimeNs / 1e6, 0, 'f', 1));
+        } else {
+            failed++;
+            log(tr("Failed to connect to %1: %2").arg(result.portName, result.error));
+        }
+    }
+    log(tr("%1 connected, %2 failed in %3 ms").arg(connected).arg(failed).arg(elapsedNs / 1e6, 0, 'f', 1));
+}
+
+void SerialChatDaemon::saveMessages() {
+    // Appended rather than rewritten: the files keep earlier runs, and MessageManager only holds the newest messages.
+    // Messages that could not be written stay queued for the next attempt.
+    for (auto it = m_unsavedMessages.begin(); it != m_unsavedMessages.end();) {
+        if (m_dataPersistence->appendMessages(it.key(), it.value())) {
+            it = m_unsavedMessages.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    for (auto it = m_unsavedGroupMessages.begin(); it != m_unsavedGroupMessages.end();) {
+        if (m_dataPersistence->appendGroupMessages(it.key(), it.value())) {
+            it = m_unsavedGroupMessages.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void SerialChatDaemon::createChatGroup(const ChatGroupInfo &info) {
+    if (m_chatGroups.contains(info.id())) {
+        return;
+    }
+
+    // Forwarding between members happens inside ChatGroup; only the history is kept here
+    ChatGroup *group = new ChatGroup(info, m_portManager);
+    m_chatGroups.insert(info.id(), group);
+    connect(group, &ChatGroup::messageReceived, this, [this, group](const Message &message) {
+        m_messageManager->addGroupMessage(group->id(), message);
+        m_unsavedGroupMessages[group->id()].append(message);
+    });
+}
+
+void SerialChatDaemon::log(const QString &message) const {
+    QTextStream err(stderr);
+    err << QDateTime::currentDateTime().toString("hh:mm:ss.zzz") << ' ' << message << '\n';
+}
@@ -0,0 +1,78 @@
+#ifndef SERIAL_CHAT_DAEMON_H
+#define SERIAL_CHAT_DAEMON_H
+
+#include "ChatGroup.h"
+#include "DataPersistence.h"
+#include "MessageManager.h"
+#include "SerialPortManager.h"
+#include <QMap>
+#include <QObject>
+#include <QStringList>
+#include <QTimer>
+
+/**
+ * @brief Settings of a headless run, from the serialchatd command line
+ */
+struct DaemonOptions {
+    QString dataDirectory;    // Empty for the GUI's data directory
+    QStringList ports;        // Ports to open; empty for every port in the friend list
+    int saveIntervalSec = 60; // How often new message history is written; 0 only saves on exit
+    bool logMessages = false; // Print every message, not only status changes
+};
+
+/**
+ * @brief The capture, forwarding and persistence pipeline without a GUI
+ *
+ * Runs the same SerialPortManager, MessageManager and ChatGroup objects as
+ * MainWindow, configured from the GUI's friends.json and groups.json, under
+ * QCoreApplication. Received and sent messages are stored per port and per
+ * group exactly as in the GUI and appended to the data directory's message
+ * history periodically and on shutdown, so earlier captures survive a
+ * restart and are not cut to MessageManager's in-memory limit. The
+ * configuration files are only read, so the daemon and the GUI can share a
+ * data directory.
+ *
+ * Lost ports reconnect on their own (ReconnectSupervisor); status changes
+ * and connect results are logged to stderr.
+ */
+class SerialChatDaemon : public QObject {
+    Q_OBJECT
+
+  public:
+    explicit SerialChatDaemon(const DaemonOptions &options, QObject *parent = nullptr);
+    ~SerialChatDaemon() override;
+
+    // Loads the configuration and starts opening the ports; false if there is nothing to run
+    bool start();
+
+    // Closes the ports and writes the message history
+    void shutdown();
+
+    SerialPortManager *portManager() const { return m_portManager; }
+    MessageManager *messageManager() const { return m_messageManager; }
+    int groupCount() const { return m_chatGroups.size(); }
+
+  private slots:
+    void onUserStatusChanged(const QString &portName, PortStatus status);
+    void onUserMessageReceived(const QString &portName, const Message &message);
+    void onUserMessageSent(const QString &portName, const Message &message);
+    void onPortsConnected(const QList<PortConnectResult> &results, qint64 elapsedNs);
+    void saveMessages();
+
+  private:
+    DaemonOptions m_options;
+    SerialPortManager *m_portManager;
+    MessageManager *m_messageManager;
+    DataPersistence *m_dataPersistence;
+    QMap<QString, ChatGroup *> m_chatGroups;
+    QTimer *m_saveTimer;
+
+    // Messages not yet appended to the history files, per port and per group
+    QMap<QString, QList<Message>> m_unsavedMessages;
+    QMap<QString, QList<Message>> m_unsavedGroupMessages;
+
+    void createChatGroup(const ChatGroupInfo &info);
+    void log(const QString &message) const;
+};
+
+#endif // SERIAL_CHAT_DAEMON_H
@@ -0,0 +1,104 @@
+#include "SerialChatDaemon.h"
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QTextStream>
+
+#ifdef Q_OS_UNIX
+#include <QSocketNotifier>
+#include <csignal>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace {
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+const auto SKIP_EMPTY_PARTS = Qt::SkipEmptyParts;
+#else
+const auto SKIP_EMPTY_PARTS = QString::SkipEmptyParts;
+#endif
+
+#ifdef Q_OS_UNIX
+// Self-pipe: the signal handler only writes a byte, the event loop does the shutdown
+int signalFds[2] = {-1, -1};
+
+void onSignal(int) {
+    char byte = 1;
+    ssize_t ignored = ::write(signalFds[0], &byte, sizeof(byte));
+    Q_UNUSED(ignored)
+}
+
+bool installSignalHandlers(QCoreApplication &app, SerialChatDaemon &daemon) {
+    if (::socketpair(AF_UNIX, SOCK_STREAM, 0, signalFds) != 0) {
+        return false;
+    }
+    QSocketNotifier *notifier = new QSocketNotifier(signalFds[1], QSocketNotifier::Read, &app);
+    QObject::connect(notifier, &QSocketNotifier::activated, &app, [&app, &daemon, notifier]() {
+        notifier->setEnabled(false);
+        char byte;
+        ssize_t ignored = ::read(signalFds[1], &byte, sizeof(byte));
+        Q_UNUSED(ignored)
+        daemon.shutdown();
+        app.quit();
+    });
+
+    struct sigaction action = {};
+    action.sa_handler = onSignal;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = SA_RESTART;
+    return ::sigaction(SIGINT, &action, nullptr) == 0 && ::sigaction(SIGTERM, &action, nullptr) == 0;
+}
+#endif
+} // namespace
+
+int main(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+
+    // Same identity as the GUI, so both use one data directory
+    app.setApplicationName("Serial Chat");
+    app.setApplicationVersion(APP_VERSION);
+    app.setOrganizationName("SerialChat");
+    app.setOrganizationDomain("serialchat.app");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Headless Serial Chat: opens the configured ports, forwards chat groups and "
+                                     "records message history without a GUI.");
+    parser.addHelpOption();
+    parser.addVersionOption();
+    QCommandLineOption dataDirOption("data-dir", "Directory holding friends.json and groups.json.", "path");
+    QCommandLineOption portOption("port", "Port to open; repeat or separate with commas. Default: every friend.",
+                                  "name");
+    QCommandLineOption saveIntervalOption("save-interval", "Seconds between history saves; 0 saves only on exit.",
+                                          "seconds", "60");
+    QCommandLineOption logMessagesOption("log-messages", "Print every received and sent message.");
+    parser.addOption(dataDirOption);
+    parser.addOption(portOption);
+    parser.addOption(saveIntervalOption);
+    parser.addOption(logMessagesOption);
+    parser.process(app);
+
+    DaemonOptions options;
+    options.dataDirectory = parser.value(dataDirOption);
+    for (const QString &value : parser.values(portOption)) {
+        for (const QString &port : value.split(',', SKIP_EMPTY_PARTS)) {
+            options.ports.append(port.trimmed());
+        }
+    }
+    bool ok = false;
+    options.saveIntervalSec = parser.value(saveIntervalOption).toInt(&ok);
+    if (!ok || options.saveIntervalSec < 0) {
+        QTextStream(stderr) << "Invalid --save-interval: " << parser.value(saveIntervalOption) << '\n';
+        return 1;
+    }
+    options.logMessages = parser.isSet(logMessagesOption);
+
+    SerialChatDaemon daemon(options);
+#ifdef Q_OS_UNIX
+    if (!installSignalHandlers(app, daemon)) {
+        QTextStream(stderr) << "Could not install signal handlers; history is only saved periodically\n";
+    }
+#endif
+    if (!daemon.start()) {
+        return 1;
+    }
+    return app.exec();
+}
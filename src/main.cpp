@@ -1,10 +1,38 @@
 #include <QApplication>
+#include <QCommandLineParser>
 #include <QIcon>
 #include "MainWindow.h"
+#include "Trace.h"
+
+#ifdef SERIALCHAT_TRACING
+// Layout and painting run in event handlers Qt calls later, outside any span in our code
+class TracingApplication : public QApplication {
+public:
+    using QApplication::QApplication;
+
+    bool notify(QObject *receiver, QEvent *event) override
+    {
+        switch (event->type()) {
+        case QEvent::LayoutRequest: {
+            TRACE_SCOPE("QEvent::LayoutRequest");
+            return QApplication::notify(receiver, event);
+        }
+        case QEvent::Paint: {
+            TRACE_SCOPE("QEvent::Paint");
+            return QApplication::notify(receiver, event);
+        }
+        default:
+            return QApplication::notify(receiver, event);
+        }
+    }
+};
+#else
+using TracingApplication = QApplication;
+#endif
 
 int main(int argc, char *argv[])
 {
-    QApplication app(argc, argv);
+    TracingApplication app(argc, argv);
     
     // Set application info
     app.setApplicationName("Serial Chat");
@@ -12,6 +40,28 @@ int main(int argc, char *argv[])
     app.setOrganizationName("SerialChat");
     app.setOrganizationDomain("serialchat.app");
     
+    // Command line
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    parser.addVersionOption();
+    QCommandLineOption traceOption("trace", "Record trace spans from start-up and write them to <file> "
+                                            "as Chrome trace JSON on exit.", "file");
+    parser.addOption(traceOption);
+    QCommandLineOption stallOption("stall-threshold", "Log event loop stalls longer than <ms> to the console "
+                                                      "(default 250, 0 disables the watchdog).", "ms");
+    parser.addOption(stallOption);
+    parser.process(app);
+
+    QString tracePath = parser.value(traceOption);
+    if (!tracePath.isEmpty()) {
+        if (Trace::isAvailable()) {
+            Trace::start();
+        } else {
+            qWarning("--trace needs a build with ENABLE_TRACING=ON");
+            tracePath.clear();
+        }
+    }
+    
     // Set application icon
     app.setWindowIcon(QIcon(":/icons/app.svg"));
     
@@ -20,7 +70,25 @@ int main(int argc, char *argv[])
     
     // Create and show main window
     MainWindow mainWindow;
+    if (parser.isSet(stallOption)) {
+        int thresholdMs = parser.value(stallOption).toInt();
+        if (thresholdMs > 0) {
+            mainWindow.stallWatchdog()->setThresholdMs(thresholdMs);
+        } else {
+            mainWindow.stallWatchdog()->stop();
+        }
+    }
     mainWindow.show();
     
-    return app.exec();
+    int result = app.exec();
+
+    // Unless the recording was already saved from the View menu
+    if (!tracePath.isEmpty() && Trace::isRecording()) {
+        Trace::stop();
+        QString error;
+        if (!Trace::writeChromeJson(tracePath, &error)) {
+            qWarning("Failed to write trace: %s", qPrintable(error));
+        }
+    }
+    return result;
 }
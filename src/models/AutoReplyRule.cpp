@@ -0,0 +1,38 @@
+#include "AutoReplyRule.h"
+
+AutoReplyRule::AutoReplyRule()
+    : m_enabled(true)
+{
+}
+
+AutoReplyRule::AutoReplyRule(const QByteArray& pattern, const QByteArray& response)
+    : m_pattern(pattern)
+    , m_response(response)
+    , m_enabled(true)
+{
+}
+
+QJsonObject AutoReplyRule::toJson() const
+{
+    QJsonObject json;
+    json["pattern"] = QString::fromLatin1(m_pattern.toHex());
+    json["response"] = QString::fromLatin1(m_response.toHex());
+    json["enabled"] = m_enabled;
+    return json;
+}
+
+AutoReplyRule AutoReplyRule::fromJson(const QJsonObject& json)
+{
+    AutoReplyRule rule;
+    rule.m_pattern = QByteArray::fromHex(json["pattern"].toString().toLatin1());
+    rule.m_response = QByteArray::fromHex(json["response"].toString().toLatin1());
+    rule.m_enabled = json["enabled"].toBool(true);
+    return rule;
+}
+
+bool AutoReplyRule::operator==(const AutoReplyRule& other) const
+{
+    return m_pattern == other.m_pattern
+        && m_response == other.m_response
+        && m_enabled == other.m_enabled;
+}
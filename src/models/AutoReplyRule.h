@@ -0,0 +1,41 @@
+#ifndef AUTO_REPLY_RULE_H
+#define AUTO_REPLY_RULE_H
+
+#include <QByteArray>
+#include <QJsonObject>
+
+/**
+ * @brief "When these bytes arrive, send those back" for one port
+ *
+ * Used by AutoResponder for device emulation and keepalive handling.
+ */
+class AutoReplyRule {
+public:
+    AutoReplyRule();
+    AutoReplyRule(const QByteArray& pattern, const QByteArray& response);
+
+    // Getters
+    QByteArray pattern() const { return m_pattern; }
+    QByteArray response() const { return m_response; }
+    bool isEnabled() const { return m_enabled; }
+
+    // Setters
+    void setPattern(const QByteArray& pattern) { m_pattern = pattern; }
+    void setResponse(const QByteArray& response) { m_response = response; }
+    void setEnabled(bool enabled) { m_enabled = enabled; }
+
+    // Serialization
+    QJsonObject toJson() const;
+    static AutoReplyRule fromJson(const QJsonObject& json);
+
+    // Operators
+    bool operator==(const AutoReplyRule& other) const;
+    bool operator!=(const AutoReplyRule& other) const { return !(*this == other); }
+
+private:
+    QByteArray m_pattern;
+    QByteArray m_response;
+    bool m_enabled;
+};
+
+#endif // AUTO_REPLY_RULE_H
@@ -0,0 +1,72 @@
+#include "DecodedRecord.h"
+#include <QJsonArray>
+
+DecodedRecord::DecodedRecord()
+    : m_valid(true)
+{
+}
+
+DecodedRecord::DecodedRecord(const QString& protocol, const QString& summary)
+    : m_protocol(protocol)
+    , m_summary(summary)
+    , m_valid(true)
+{
+}
+
+QString DecodedRecord::field(const QString& name) const
+{
+    for (const DecodedField& field : m_fields) {
+        if (field.name == name) {
+            return field.value;
+        }
+    }
+    return QString();
+}
+
+QString DecodedRecord::toText() const
+{
+    QString text = m_protocol + QStringLiteral(": ") + m_summary;
+    if (!m_valid) {
+        text += QStringLiteral(" (bad checksum)");
+    }
+    for (const DecodedField& field : m_fields) {
+        text += QStringLiteral("\n  ") + field.name + QStringLiteral(": ") + field.value;
+    }
+    return text;
+}
+
+QJsonObject DecodedRecord::toJson() const
+{
+    QJsonObject json;
+    json["protocol"] = m_protocol;
+    json["summary"] = m_summary;
+    QJsonArray fields;
+    for (const DecodedField& field : m_fields) {
+        fields.append(QJsonArray{field.name, field.value});
+    }
+    json["fields"] = fields;
+    if (!m_valid) {
+        json["valid"] = false;
+    }
+    return json;
+}
+
+DecodedRecord DecodedRecord::fromJson(const QJsonObject& json)
+{
+    DecodedRecord record(json["protocol"].toString(), json["summary"].toString());
+    const QJsonArray fields = json["fields"].toArray();
+    for (const QJsonValue& value : fields) {
+        QJsonArray field = value.toArray();
+        record.addField(field.at(0).toString(), field.at(1).toString());
+    }
+    record.m_valid = json["valid"].toBool(true);
+    return record;
+}
+
+bool DecodedRecord::operator==(const DecodedRecord& other) const
+{
+    return m_protocol == other.m_protocol
+        && m_summary == other.m_summary
+        && m_fields == other.m_fields
+        && m_valid == other.m_valid;
+}
@@ -0,0 +1,73 @@
+#ifndef DECODED_RECORD_H
+#define DECODED_RECORD_H
+
+#include <QJsonObject>
+#include <QString>
+#include <QVector>
+
+/**
+ * @brief Protocol decoder run on a port's traffic
+ */
+enum class DecoderType {
+    None,
+    ModbusRtu,      // Modbus RTU requests, responses and exceptions
+    Nmea0183,       // NMEA 0183 sentences (GPS and marine instruments)
+    Slip            // RFC 1055 SLIP frames, IPv4 headers shown if present
+};
+
+/**
+ * @brief One named value of a decoded record
+ */
+struct DecodedField {
+    QString name;
+    QString value;
+
+    bool operator==(const DecodedField& other) const { return name == other.name && value == other.value; }
+    bool operator!=(const DecodedField& other) const { return !(*this == other); }
+};
+
+/**
+ * @brief A protocol unit found in a port's traffic by a ProtocolDecoder
+ *
+ * Records are attached to the Message whose data completed them, so they
+ * are decoded once on the I/O thread and kept with the history.
+ */
+class DecodedRecord {
+public:
+    DecodedRecord();
+    DecodedRecord(const QString& protocol, const QString& summary);
+
+    // Getters
+    QString protocol() const { return m_protocol; }
+    QString summary() const { return m_summary; }
+    QVector<DecodedField> fields() const { return m_fields; }
+    QString field(const QString& name) const;
+
+    // False if the unit was found but failed its checksum
+    bool isValid() const { return m_valid; }
+
+    // Setters
+    void setProtocol(const QString& protocol) { m_protocol = protocol; }
+    void setSummary(const QString& summary) { m_summary = summary; }
+    void addField(const QString& name, const QString& value) { m_fields.append({name, value}); }
+    void setValid(bool valid) { m_valid = valid; }
+
+    // Summary followed by one "name: value" line per field
+    QString toText() const;
+
+    // Serialization
+    QJsonObject toJson() const;
+    static DecodedRecord fromJson(const QJsonObject& json);
+
+    // Operators
+    bool operator==(const DecodedRecord& other) const;
+    bool operator!=(const DecodedRecord& other) const { return !(*this == other); }
+
+private:
+    QString m_protocol;
+    QString m_summary;
+    QVector<DecodedField> m_fields;
+    bool m_valid;
+};
+
+#endif // DECODED_RECORD_H
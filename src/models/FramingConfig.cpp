@@ -0,0 +1,79 @@
+#include "FramingConfig.h"
+
+FramingConfig::FramingConfig()
+    : FramingConfig(FramingMode::None)
+{
+}
+
+FramingConfig::FramingConfig(FramingMode mode)
+    : m_mode(mode)
+    , m_delimiter("\n")
+    , m_keepDelimiter(false)
+    , m_frameLength(8)
+    , m_lengthOffset(0)
+    , m_lengthSize(1)
+    , m_lengthBigEndian(true)
+    , m_lengthAdjustment(0)
+    , m_idleGapMs(5)
+    , m_maxFrameSize(65536)
+{
+}
+
+QString FramingConfig::validationError() const
+{
+    // Every header would be rejected as implausible and the framer would never resynchronize
+    if (m_mode == FramingMode::LengthPrefix && headerSize() > m_maxFrameSize) {
+        return QStringLiteral("Length prefix header (%1 bytes) is larger than the maximum frame size (%2 bytes)")
+            .arg(headerSize())
+            .arg(m_maxFrameSize);
+    }
+    return QString();
+}
+
+QJsonObject FramingConfig::toJson() const
+{
+    QJsonObject json;
+    json["mode"] = static_cast<int>(m_mode);
+    json["delimiter"] = QString::fromLatin1(m_delimiter.toHex());
+    json["keepDelimiter"] = m_keepDelimiter;
+    json["frameLength"] = m_frameLength;
+    json["lengthOffset"] = m_lengthOffset;
+    json["lengthSize"] = m_lengthSize;
+    json["lengthBigEndian"] = m_lengthBigEndian;
+    json["lengthAdjustment"] = m_lengthAdjustment;
+    json["idleGapMs"] = m_idleGapMs;
+    json["maxFrameSize"] = m_maxFrameSize;
+    return json;
+}
+
+FramingConfig FramingConfig::fromJson(const QJsonObject& json)
+{
+    FramingConfig config;
+    config.m_mode = static_cast<FramingMode>(json["mode"].toInt(0));
+    if (json.contains("delimiter")) {
+        config.m_delimiter = QByteArray::fromHex(json["delimiter"].toString().toLatin1());
+    }
+    config.m_keepDelimiter = json["keepDelimiter"].toBool(config.m_keepDelimiter);
+    config.m_frameLength = json["frameLength"].toInt(config.m_frameLength);
+    config.m_lengthOffset = json["lengthOffset"].toInt(config.m_lengthOffset);
+    config.m_lengthSize = json["lengthSize"].toInt(config.m_lengthSize);
+    config.m_lengthBigEndian = json["lengthBigEndian"].toBool(config.m_lengthBigEndian);
+    config.m_lengthAdjustment = json["lengthAdjustment"].toInt(config.m_lengthAdjustment);
+    config.m_idleGapMs = json["idleGapMs"].toInt(config.m_idleGapMs);
+    config.m_maxFrameSize = json["maxFrameSize"].toInt(config.m_maxFrameSize);
+    return config;
+}
+
+bool FramingConfig::operator==(const FramingConfig& other) const
+{
+    return m_mode == other.m_mode
+        && m_delimiter == other.m_delimiter
+        && m_keepDelimiter == other.m_keepDelimiter
+        && m_frameLength == other.m_frameLength
+        && m_lengthOffset == other.m_lengthOffset
+        && m_lengthSize == other.m_lengthSize
+        && m_lengthBigEndian == other.m_lengthBigEndian
+        && m_lengthAdjustment == other.m_lengthAdjustment
+        && m_idleGapMs == other.m_idleGapMs
+        && m_maxFrameSize == other.m_maxFrameSize;
+}
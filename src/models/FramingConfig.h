@@ -0,0 +1,94 @@
+#ifndef FRAMING_CONFIG_H
+#define FRAMING_CONFIG_H
+
+#include <QByteArray>
+#include <QJsonObject>
+#include <QString>
+
+/**
+ * @brief How a port's byte stream is split into messages
+ */
+enum class FramingMode {
+    None,           // One message per read (no framing)
+    Delimiter,      // Frames end with a delimiter sequence
+    FixedLength,    // Every frame has the same length
+    LengthPrefix,   // Frame length is read from a header field
+    IdleGap,        // A frame ends when the line is idle for a while
+    Slip,           // RFC 1055 SLIP
+    Cobs            // Consistent Overhead Byte Stuffing, 0x00 terminated
+};
+
+/**
+ * @brief Per-port framing settings used by StreamFramer
+ *
+ * Only the parameters of the selected mode are used; the others keep their
+ * values so switching modes back and forth does not lose them.
+ */
+class FramingConfig {
+public:
+    FramingConfig();
+    explicit FramingConfig(FramingMode mode);
+
+    // Getters
+    FramingMode mode() const { return m_mode; }
+    QByteArray delimiter() const { return m_delimiter; }
+    bool keepDelimiter() const { return m_keepDelimiter; }
+    int frameLength() const { return m_frameLength; }
+    int lengthOffset() const { return m_lengthOffset; }
+    int lengthSize() const { return m_lengthSize; }
+    bool lengthBigEndian() const { return m_lengthBigEndian; }
+    int lengthAdjustment() const { return m_lengthAdjustment; }
+    int idleGapMs() const { return m_idleGapMs; }
+    int maxFrameSize() const { return m_maxFrameSize; }
+
+    // Setters
+    void setMode(FramingMode mode) { m_mode = mode; }
+    void setDelimiter(const QByteArray& delimiter) { m_delimiter = delimiter; }
+    void setKeepDelimiter(bool keep) { m_keepDelimiter = keep; }
+    void setFrameLength(int length) { m_frameLength = length; }
+    void setLengthOffset(int offset) { m_lengthOffset = offset; }
+    void setLengthSize(int size) { m_lengthSize = size; }
+    void setLengthBigEndian(bool bigEndian) { m_lengthBigEndian = bigEndian; }
+    void setLengthAdjustment(int adjustment) { m_lengthAdjustment = adjustment; }
+    void setIdleGapMs(int ms) { m_idleGapMs = ms; }
+    void setMaxFrameSize(int size) { m_maxFrameSize = size; }
+
+    // Length of the header that precedes the payload in LengthPrefix mode
+    int headerSize() const { return m_lengthOffset + m_lengthSize; }
+
+    // Why the selected mode cannot work with these settings; empty if it can
+    QString validationError() const;
+    bool isValid() const { return validationError().isEmpty(); }
+
+    // Serialization
+    QJsonObject toJson() const;
+    static FramingConfig fromJson(const QJsonObject& json);
+
+    // Operators
+    bool operator==(const FramingConfig& other) const;
+    bool operator!=(const FramingConfig& other) const { return !(*this == other); }
+
+private:
+    FramingMode m_mode;
+
+    // Delimiter
+    QByteArray m_delimiter;
+    bool m_keepDelimiter;
+
+    // FixedLength
+    int m_frameLength;
+
+    // LengthPrefix: frame = header (offset + size bytes) + value + adjustment
+    int m_lengthOffset;
+    int m_lengthSize;
+    bool m_lengthBigEndian;
+    int m_lengthAdjustment;
+
+    // IdleGap
+    int m_idleGapMs;
+
+    // Frames that grow past this are emitted as-is
+    int m_maxFrameSize;
+};
+
+#endif // FRAMING_CONFIG_H
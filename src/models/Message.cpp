@@ -1,26 +1,53 @@
 #include "Message.h"
+#include "TimeUtils.h"
+#include "Trace.h"
 #include <QUuid>
 #include <QJsonArray>
+#include <QStringList>
 
 Message::Message()
     : m_id(generateId())
     , m_direction(MessageDirection::Received)
-    , m_timestamp(QDateTime::currentDateTime())
+    , m_timestampNs(TimeUtils::timestampNs())
+    , m_checksumStatus(ChecksumStatus::Unchecked)
+{
+}
+
+Message::Message(const QString& portName, const QByteArray& data, MessageDirection direction)
+    : Message(portName, data, direction, TimeUtils::timestampNs())
 {
 }
 
 Message::Message(const QString& portName, const QByteArray& data, 
-                 MessageDirection direction, const QDateTime& timestamp)
+                 MessageDirection direction, qint64 timestampNs)
     : m_id(generateId())
     , m_portName(portName)
     , m_data(data)
     , m_direction(direction)
-    , m_timestamp(timestamp)
+    , m_timestampNs(timestampNs)
+    , m_checksumStatus(ChecksumStatus::Unchecked)
 {
 }
 
+Message::Message(const QString& portName, const QByteArray& data, 
+                 MessageDirection direction, const QDateTime& timestamp)
+    : Message(portName, data, direction, TimeUtils::fromDateTime(timestamp))
+{
+}
+
+QDateTime Message::timestamp() const
+{
+    return TimeUtils::toDateTime(m_timestampNs);
+}
+
+void Message::setTimestamp(const QDateTime& timestamp)
+{
+    m_timestampNs = TimeUtils::fromDateTime(timestamp);
+}
+
 QString Message::generateId()
 {
+    TRACE_SCOPE("Message::generateId");
     return QUuid::createUuid().toString(QUuid::WithoutBraces);
 }
 
@@ -39,6 +66,16 @@ QString Message::displayText(MessageFormat format) const
     switch (format) {
         case MessageFormat::Hex:
             return toHex();
+        case MessageFormat::Decoded: {
+            if (m_records.isEmpty()) {
+                return toHex();
+            }
+            QStringList lines;
+            for (const DecodedRecord& record : m_records) {
+                lines.append(record.toText());
+            }
+            return lines.join('\n');
+        }
         case MessageFormat::Text:
         default:
             return toText();
@@ -47,7 +84,7 @@ QString Message::displayText(MessageFormat format) const
 
 QString Message::formattedTime() const
 {
-    return m_timestamp.toString("hh:mm:ss");
+    return timestamp().toString("hh:mm:ss");
 }
 
 QJsonObject Message::toJson() const
@@ -57,7 +94,27 @@ QJsonObject Message::toJson() const
     json["portName"] = m_portName;
     json["data"] = QString(m_data.toBase64());
     json["direction"] = static_cast<int>(m_direction);
-    json["timestamp"] = m_timestamp.toString(Qt::ISODate);
+    json["timestamp"] = timestamp().toString(Qt::ISODateWithMs);
+    // A string, since a JSON number (double) cannot hold nanoseconds since 1970 exactly
+    json["timestampNs"] = QString::number(m_timestampNs);
+    
+    if (!m_chunks.isEmpty()) {
+        QJsonArray chunks;
+        for (const MessageChunk& chunk : m_chunks) {
+            chunks.append(QJsonArray{chunk.byteOffset, static_cast<double>(chunk.timeOffsetNs)});
+        }
+        json["chunks"] = chunks;
+    }
+    if (!m_records.isEmpty()) {
+        QJsonArray records;
+        for (const DecodedRecord& record : m_records) {
+            records.append(record.toJson());
+        }
+        json["records"] = records;
+    }
+    if (m_checksumStatus != ChecksumStatus::Unchecked) {
+        json["checksum"] = static_cast<int>(m_checksumStatus);
+    }
     return json;
 }
 
@@ -68,7 +125,24 @@ Message Message::fromJson(const QJsonObject& json)
     msg.m_portName = json["portName"].toString();
     msg.m_data = QByteArray::fromBase64(json["data"].toString().toUtf8());
     msg.m_direction = static_cast<MessageDirection>(json["direction"].toInt());
-    msg.m_timestamp = QDateTime::fromString(json["timestamp"].toString(), Qt::ISODate);
+    bool ok = false;
+    msg.m_timestampNs = json["timestampNs"].toString().toLongLong(&ok);
+    if (!ok) {
+        // Saved before nanosecond timestamps
+        msg.m_timestampNs = TimeUtils::fromDateTime(QDateTime::fromString(json["timestamp"].toString(), Qt::ISODate));
+    }
+    
+    const QJsonArray chunks = json["chunks"].toArray();
+    msg.m_chunks.reserve(chunks.size());
+    for (const QJsonValue& value : chunks) {
+        QJsonArray chunk = value.toArray();
+        msg.m_chunks.append({chunk.at(0).toInt(), static_cast<qint64>(chunk.at(1).toDouble())});
+    }
+    const QJsonArray records = json["records"].toArray();
+    for (const QJsonValue& value : records) {
+        msg.m_records.append(DecodedRecord::fromJson(value.toObject()));
+    }
+    msg.m_checksumStatus = static_cast<ChecksumStatus>(json["checksum"].toInt(0));
     return msg;
 }
 
@@ -5,6 +5,8 @@
 #include <QDateTime>
 #include <QByteArray>
 #include <QJsonObject>
+#include <QVector>
+#include "DecodedRecord.h"
 
 /**
  * @brief Message direction enum
@@ -19,24 +21,63 @@ enum class MessageDirection {
  */
 enum class MessageFormat {
     Text,   // Display as text
-    Hex     // Display as hexadecimal
+    Hex,    // Display as hexadecimal
+    Decoded // Display the decoded records (hexadecimal if there are none)
+};
+
+/**
+ * @brief Result of checking a received frame's checksum
+ */
+enum class ChecksumStatus {
+    Unchecked,  // Sent, unframed, or the port has no checksum configured
+    Valid,
+    Invalid
+};
+
+/**
+ * @brief Position and arrival time of one read inside a coalesced message
+ */
+struct MessageChunk {
+    int byteOffset;         // Offset of the chunk's first byte in data()
+    qint64 timeOffsetNs;    // Arrival time relative to timestampNs()
 };
 
 /**
  * @brief Represents a single message in the chat
+ *
+ * The timestamp is kept as nanoseconds since the Unix epoch from
+ * TimeUtils::timestampNs(). Received messages carry the time of the read
+ * that completed them, sent messages the time the data was written, so the
+ * difference between two timestamps is the real gap between the frames.
+ * timestamp() converts to wall time for display.
  */
 class Message {
 public:
     Message();
+    Message(const QString& portName, const QByteArray& data, MessageDirection direction);
+    Message(const QString& portName, const QByteArray& data, 
+            MessageDirection direction, qint64 timestampNs);
     Message(const QString& portName, const QByteArray& data, 
-            MessageDirection direction, const QDateTime& timestamp = QDateTime::currentDateTime());
+            MessageDirection direction, const QDateTime& timestamp);
     
     // Getters
     QString id() const { return m_id; }
     QString portName() const { return m_portName; }
     QByteArray data() const { return m_data; }
     MessageDirection direction() const { return m_direction; }
-    QDateTime timestamp() const { return m_timestamp; }
+    qint64 timestampNs() const { return m_timestampNs; }
+    QDateTime timestamp() const;
+    
+    // Arrival timing of the reads merged into this message (empty if not coalesced)
+    QVector<MessageChunk> chunks() const { return m_chunks; }
+    int chunkCount() const { return m_chunks.size(); }
+    
+    // Protocol units completed by this message's data, see ProtocolDecoder
+    QVector<DecodedRecord> records() const { return m_records; }
+    int recordCount() const { return m_records.size(); }
+    
+    // Set on received frames when the port verifies checksums
+    ChecksumStatus checksumStatus() const { return m_checksumStatus; }
     
     // Display methods
     QString toText() const;
@@ -48,7 +89,11 @@ public:
     void setPortName(const QString& portName) { m_portName = portName; }
     void setData(const QByteArray& data) { m_data = data; }
     void setDirection(MessageDirection direction) { m_direction = direction; }
-    void setTimestamp(const QDateTime& timestamp) { m_timestamp = timestamp; }
+    void setTimestampNs(qint64 timestampNs) { m_timestampNs = timestampNs; }
+    void setTimestamp(const QDateTime& timestamp);
+    void setChunks(const QVector<MessageChunk>& chunks) { m_chunks = chunks; }
+    void setChecksumStatus(ChecksumStatus status) { m_checksumStatus = status; }
+    void setRecords(const QVector<DecodedRecord>& records) { m_records = records; }
     
     // Serialization
     QJsonObject toJson() const;
@@ -63,7 +108,10 @@ private:
     QString m_portName;
     QByteArray m_data;
     MessageDirection m_direction;
-    QDateTime m_timestamp;
+    qint64 m_timestampNs;
+    QVector<MessageChunk> m_chunks;
+    ChecksumStatus m_checksumStatus;
+    QVector<DecodedRecord> m_records;
     
     static QString generateId();
 };
@@ -0,0 +1,38 @@
+#include "PacingConfig.h"
+
+PacingConfig::PacingConfig()
+    : m_interByteDelayUs(0)
+    , m_interFrameGapUs(0)
+    , m_maxUtilization(100)
+{
+}
+
+bool PacingConfig::isEnabled() const
+{
+    return m_interByteDelayUs > 0 || m_interFrameGapUs > 0 || m_maxUtilization < 100;
+}
+
+QJsonObject PacingConfig::toJson() const
+{
+    QJsonObject json;
+    json["interByteDelayUs"] = m_interByteDelayUs;
+    json["interFrameGapUs"] = m_interFrameGapUs;
+    json["maxUtilization"] = m_maxUtilization;
+    return json;
+}
+
+PacingConfig PacingConfig::fromJson(const QJsonObject& json)
+{
+    PacingConfig config;
+    config.m_interByteDelayUs = json["interByteDelayUs"].toInt(0);
+    config.m_interFrameGapUs = json["interFrameGapUs"].toInt(0);
+    config.m_maxUtilization = json["maxUtilization"].toInt(100);
+    return config;
+}
+
+bool PacingConfig::operator==(const PacingConfig& other) const
+{
+    return m_interByteDelayUs == other.m_interByteDelayUs
+        && m_interFrameGapUs == other.m_interFrameGapUs
+        && m_maxUtilization == other.m_maxUtilization;
+}
@@ -0,0 +1,41 @@
+#ifndef PACING_CONFIG_H
+#define PACING_CONFIG_H
+
+#include <QJsonObject>
+
+/**
+ * @brief Per-port transmit pacing settings used by TransmitPacer
+ *
+ * Pacing is off by default; any non-zero delay or a utilization below
+ * 100% enables it.
+ */
+class PacingConfig {
+public:
+    PacingConfig();
+
+    // Getters
+    int interByteDelayUs() const { return m_interByteDelayUs; }
+    int interFrameGapUs() const { return m_interFrameGapUs; }
+    int maxUtilization() const { return m_maxUtilization; }
+    bool isEnabled() const;
+
+    // Setters
+    void setInterByteDelayUs(int us) { m_interByteDelayUs = us; }
+    void setInterFrameGapUs(int us) { m_interFrameGapUs = us; }
+    void setMaxUtilization(int percent) { m_maxUtilization = percent; }
+
+    // Serialization
+    QJsonObject toJson() const;
+    static PacingConfig fromJson(const QJsonObject& json);
+
+    // Operators
+    bool operator==(const PacingConfig& other) const;
+    bool operator!=(const PacingConfig& other) const { return !(*this == other); }
+
+private:
+    int m_interByteDelayUs;     // Idle time after every byte
+    int m_interFrameGapUs;      // Idle time after every sendData() payload
+    int m_maxUtilization;       // Percentage of the line rate, 1-100
+};
+
+#endif // PACING_CONFIG_H
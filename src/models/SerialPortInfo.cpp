@@ -1,4 +1,11 @@
 #include "SerialPortInfo.h"
+#include "TimeUtils.h"
+#include <QJsonArray>
+
+namespace {
+const int DEFAULT_RECEIVE_BUFFER_SIZE = SlabRingBuffer::DEFAULT_SLAB_SIZE * SlabRingBuffer::DEFAULT_SLAB_COUNT;
+const int DEFAULT_TRANSMIT_QUEUE_DEPTH = 256;
+}
 
 SerialPortInfo::SerialPortInfo()
     : m_baudRate(115200)
@@ -6,7 +13,17 @@ SerialPortInfo::SerialPortInfo()
     , m_stopBits(QSerialPort::OneStop)
     , m_parity(QSerialPort::NoParity)
     , m_flowControl(QSerialPort::NoFlowControl)
+    , m_receiveBufferSize(DEFAULT_RECEIVE_BUFFER_SIZE)
+    , m_overflowPolicy(SlabRingBuffer::OverflowPolicy::Backpressure)
+    , m_coalesceWindowMs(0)
+    , m_coalesceMaxBytes(0)
+    , m_transmitQueueDepth(DEFAULT_TRANSMIT_QUEUE_DEPTH)
+    , m_transmitPolicy(TransmitPolicy::Reject)
+    , m_autoReconnect(true)
+    , m_checksum(ChecksumType::None)
+    , m_decoder(DecoderType::None)
     , m_status(PortStatus::Offline)
+    , m_lastActiveNs(0)
 {
 }
 
@@ -17,8 +34,28 @@ SerialPortInfo::SerialPortInfo(const QString& portName)
     , m_stopBits(QSerialPort::OneStop)
     , m_parity(QSerialPort::NoParity)
     , m_flowControl(QSerialPort::NoFlowControl)
+    , m_receiveBufferSize(DEFAULT_RECEIVE_BUFFER_SIZE)
+    , m_overflowPolicy(SlabRingBuffer::OverflowPolicy::Backpressure)
+    , m_coalesceWindowMs(0)
+    , m_coalesceMaxBytes(0)
+    , m_transmitQueueDepth(DEFAULT_TRANSMIT_QUEUE_DEPTH)
+    , m_transmitPolicy(TransmitPolicy::Reject)
+    , m_autoReconnect(true)
+    , m_checksum(ChecksumType::None)
+    , m_decoder(DecoderType::None)
     , m_status(PortStatus::Offline)
+    , m_lastActiveNs(0)
+{
+}
+
+QDateTime SerialPortInfo::lastActiveTime() const
 {
+    return m_lastActiveNs != 0 ? TimeUtils::toDateTime(m_lastActiveNs) : QDateTime();
+}
+
+void SerialPortInfo::updateLastActiveTime()
+{
+    m_lastActiveNs = TimeUtils::timestampNs();
 }
 
 QString SerialPortInfo::displayName() const
@@ -29,6 +66,35 @@ QString SerialPortInfo::displayName() const
     return QString("%1 (%2)").arg(m_remark, m_portName);
 }
 
+double SerialPortInfo::bitsPerCharacter() const
+{
+    // Start bit + data bits + optional parity bit + stop bits
+    double bits = 1.0 + static_cast<int>(m_dataBits);
+    if (m_parity != QSerialPort::NoParity) {
+        bits += 1.0;
+    }
+    switch (m_stopBits) {
+    case QSerialPort::OneAndHalfStop:
+        bits += 1.5;
+        break;
+    case QSerialPort::TwoStop:
+        bits += 2.0;
+        break;
+    default:
+        bits += 1.0;
+        break;
+    }
+    return bits;
+}
+
+qint64 SerialPortInfo::characterTimeNs() const
+{
+    if (m_baudRate <= 0) {
+        return 0;
+    }
+    return static_cast<qint64>(bitsPerCharacter() * 1e9 / m_baudRate + 0.5);
+}
+
 void SerialPortInfo::applyToPort(QSerialPort* port) const
 {
     if (!port) return;
@@ -51,7 +117,24 @@ QJsonObject SerialPortInfo::toJson() const
     json["stopBits"] = static_cast<int>(m_stopBits);
     json["parity"] = static_cast<int>(m_parity);
     json["flowControl"] = static_cast<int>(m_flowControl);
-    json["lastActiveTime"] = m_lastActiveTime.toString(Qt::ISODate);
+    json["transport"] = m_transport.toJson();
+    json["receiveBufferSize"] = m_receiveBufferSize;
+    json["overflowPolicy"] = static_cast<int>(m_overflowPolicy);
+    json["framing"] = m_framing.toJson();
+    json["coalesceWindowMs"] = m_coalesceWindowMs;
+    json["coalesceMaxBytes"] = m_coalesceMaxBytes;
+    json["transmitQueueDepth"] = m_transmitQueueDepth;
+    json["transmitPolicy"] = static_cast<int>(m_transmitPolicy);
+    json["pacing"] = m_pacing.toJson();
+    json["autoReconnect"] = m_autoReconnect;
+    json["checksum"] = static_cast<int>(m_checksum);
+    json["decoder"] = static_cast<int>(m_decoder);
+    QJsonArray autoReplies;
+    for (const AutoReplyRule& rule : m_autoReplies) {
+        autoReplies.append(rule.toJson());
+    }
+    json["autoReplies"] = autoReplies;
+    json["lastActiveTime"] = lastActiveTime().toString(Qt::ISODate);
     return json;
 }
 
@@ -65,7 +148,24 @@ SerialPortInfo SerialPortInfo::fromJson(const QJsonObject& json)
     info.m_stopBits = static_cast<QSerialPort::StopBits>(json["stopBits"].toInt(1));
     info.m_parity = static_cast<QSerialPort::Parity>(json["parity"].toInt(0));
     info.m_flowControl = static_cast<QSerialPort::FlowControl>(json["flowControl"].toInt(0));
-    info.m_lastActiveTime = QDateTime::fromString(json["lastActiveTime"].toString(), Qt::ISODate);
+    info.m_transport = TransportConfig::fromJson(json["transport"].toObject());
+    info.m_receiveBufferSize = json["receiveBufferSize"].toInt(DEFAULT_RECEIVE_BUFFER_SIZE);
+    info.m_overflowPolicy = static_cast<SlabRingBuffer::OverflowPolicy>(json["overflowPolicy"].toInt(0));
+    info.m_framing = FramingConfig::fromJson(json["framing"].toObject());
+    info.m_coalesceWindowMs = json["coalesceWindowMs"].toInt(0);
+    info.m_coalesceMaxBytes = json["coalesceMaxBytes"].toInt(0);
+    info.m_transmitQueueDepth = json["transmitQueueDepth"].toInt(DEFAULT_TRANSMIT_QUEUE_DEPTH);
+    info.m_transmitPolicy = static_cast<TransmitPolicy>(json["transmitPolicy"].toInt(0));
+    info.m_pacing = PacingConfig::fromJson(json["pacing"].toObject());
+    info.m_autoReconnect = json["autoReconnect"].toBool(true);
+    info.m_checksum = static_cast<ChecksumType>(json["checksum"].toInt(0));
+    info.m_decoder = static_cast<DecoderType>(json["decoder"].toInt(0));
+    const QJsonArray autoReplies = json["autoReplies"].toArray();
+    for (const QJsonValue& value : autoReplies) {
+        info.m_autoReplies.append(AutoReplyRule::fromJson(value.toObject()));
+    }
+    QDateTime lastActive = QDateTime::fromString(json["lastActiveTime"].toString(), Qt::ISODate);
+    info.m_lastActiveNs = lastActive.isValid() ? TimeUtils::fromDateTime(lastActive) : 0;
     info.m_status = PortStatus::Offline;
     return info;
 }
@@ -5,6 +5,14 @@
 #include <QJsonObject>
 #include <QSerialPort>
 #include <QDateTime>
+#include <QList>
+#include "SlabRingBuffer.h"
+#include "AutoReplyRule.h"
+#include "Checksum.h"
+#include "DecodedRecord.h"
+#include "FramingConfig.h"
+#include "PacingConfig.h"
+#include "TransportConfig.h"
 
 /**
  * @brief Serial port connection status
@@ -12,7 +20,16 @@
 enum class PortStatus {
     Offline,    // Port is not connected
     Online,     // Port is connected and ready
-    Error       // Port has an error
+    Error,      // Port has an error
+    Reconnecting // Connection was lost; retrying until the device is back
+};
+
+/**
+ * @brief What sendData() does when the transmit queue is full
+ */
+enum class TransmitPolicy {
+    Reject,     // Fail the send immediately
+    Block       // Wait for room, up to a timeout
 };
 
 /**
@@ -34,11 +51,40 @@ public:
     QSerialPort::StopBits stopBits() const { return m_stopBits; }
     QSerialPort::Parity parity() const { return m_parity; }
     QSerialPort::FlowControl flowControl() const { return m_flowControl; }
+    TransportConfig transport() const { return m_transport; }
+    
+    // Receive buffer
+    int receiveBufferSize() const { return m_receiveBufferSize; }
+    SlabRingBuffer::OverflowPolicy overflowPolicy() const { return m_overflowPolicy; }
+    FramingConfig framing() const { return m_framing; }
+    int coalesceWindowMs() const { return m_coalesceWindowMs; }
+    int coalesceMaxBytes() const { return m_coalesceMaxBytes; }
+    
+    // Transmit queue
+    int transmitQueueDepth() const { return m_transmitQueueDepth; }
+    TransmitPolicy transmitPolicy() const { return m_transmitPolicy; }
+    PacingConfig pacing() const { return m_pacing; }
+    
+    // Reopen the port automatically when the connection is lost
+    bool autoReconnect() const { return m_autoReconnect; }
+    
+    // Appended to every payload sent and verified on every received frame
+    ChecksumType checksum() const { return m_checksum; }
+    
+    // Protocol decoded on the I/O thread; the records are attached to each Message
+    DecoderType decoder() const { return m_decoder; }
+    
+    // Replies sent automatically when a pattern is received
+    QList<AutoReplyRule> autoReplies() const { return m_autoReplies; }
+    
+    // Wire timing derived from the line settings
+    double bitsPerCharacter() const;
+    qint64 characterTimeNs() const;
     
     // Status
     PortStatus status() const { return m_status; }
     bool isOnline() const { return m_status == PortStatus::Online; }
-    QDateTime lastActiveTime() const { return m_lastActiveTime; }
+    QDateTime lastActiveTime() const;
     
     // Setters
     void setPortName(const QString& name) { m_portName = name; }
@@ -48,8 +94,22 @@ public:
     void setStopBits(QSerialPort::StopBits stopBits) { m_stopBits = stopBits; }
     void setParity(QSerialPort::Parity parity) { m_parity = parity; }
     void setFlowControl(QSerialPort::FlowControl flowControl) { m_flowControl = flowControl; }
+    void setTransport(const TransportConfig& transport) { m_transport = transport; }
+    void setReceiveBufferSize(int bytes) { m_receiveBufferSize = bytes; }
+    void setOverflowPolicy(SlabRingBuffer::OverflowPolicy policy) { m_overflowPolicy = policy; }
+    void setFraming(const FramingConfig& framing) { m_framing = framing; }
+    void setCoalesceWindowMs(int ms) { m_coalesceWindowMs = ms; }
+    void setCoalesceMaxBytes(int bytes) { m_coalesceMaxBytes = bytes; }
+    void setTransmitQueueDepth(int depth) { m_transmitQueueDepth = depth; }
+    void setTransmitPolicy(TransmitPolicy policy) { m_transmitPolicy = policy; }
+    void setPacing(const PacingConfig& pacing) { m_pacing = pacing; }
+    void setAutoReconnect(bool enabled) { m_autoReconnect = enabled; }
+    void setChecksum(ChecksumType type) { m_checksum = type; }
+    void setDecoder(DecoderType type) { m_decoder = type; }
+    void setAutoReplies(const QList<AutoReplyRule>& rules) { m_autoReplies = rules; }
     void setStatus(PortStatus status) { m_status = status; }
-    void updateLastActiveTime() { m_lastActiveTime = QDateTime::currentDateTime(); }
+    void updateLastActiveTime();
+    void updateLastActiveTime(qint64 timestampNs) { m_lastActiveNs = timestampNs; }
     
     // Serialization
     QJsonObject toJson() const;
@@ -70,8 +130,21 @@ private:
     QSerialPort::StopBits m_stopBits;
     QSerialPort::Parity m_parity;
     QSerialPort::FlowControl m_flowControl;
+    TransportConfig m_transport;
+    int m_receiveBufferSize;
+    SlabRingBuffer::OverflowPolicy m_overflowPolicy;
+    FramingConfig m_framing;
+    int m_coalesceWindowMs;     // 0 disables coalescing
+    int m_coalesceMaxBytes;     // 0 means no byte limit
+    int m_transmitQueueDepth;
+    TransmitPolicy m_transmitPolicy;
+    PacingConfig m_pacing;
+    bool m_autoReconnect;
+    ChecksumType m_checksum;
+    DecoderType m_decoder;
+    QList<AutoReplyRule> m_autoReplies;
     PortStatus m_status;
-    QDateTime m_lastActiveTime;
+    qint64 m_lastActiveNs;  // TimeUtils::timestampNs(), 0 if never active
 };
 
 #endif // SERIAL_PORT_INFO_H
@@ -0,0 +1,102 @@
+#include "TransportConfig.h"
+
+TransportConfig::TransportConfig()
+    : TransportConfig(TransportType::QtSerialPort)
+{
+}
+
+TransportConfig::TransportConfig(TransportType type)
+    : m_type(type)
+    , m_vmin(1)
+    , m_vtime(0)
+    , m_lowLatency(true)
+    , m_port(0)
+    , m_localPort(0)
+{
+}
+
+bool TransportConfig::isSupported(TransportType type)
+{
+    switch (type) {
+    case TransportType::QtSerialPort:
+    case TransportType::Tcp:
+    case TransportType::Rfc2217:
+    case TransportType::Udp:
+    case TransportType::UnixSocket:
+        return true;
+    case TransportType::Termios:
+    case TransportType::Pty:
+#ifdef Q_OS_LINUX
+        return true;
+#else
+        return false;
+#endif
+    }
+    return false;
+}
+
+bool TransportConfig::isNetwork() const
+{
+    switch (m_type) {
+    case TransportType::Tcp:
+    case TransportType::Rfc2217:
+    case TransportType::Udp:
+    case TransportType::UnixSocket:
+        return true;
+    default:
+        return false;
+    }
+}
+
+QString TransportConfig::endpoint() const
+{
+    switch (m_type) {
+    case TransportType::Tcp:
+        return QString("tcp://%1:%2").arg(m_address).arg(m_port);
+    case TransportType::Rfc2217:
+        return QString("rfc2217://%1:%2").arg(m_address).arg(m_port);
+    case TransportType::Udp:
+        return QString("udp://%1:%2").arg(m_address).arg(m_port);
+    case TransportType::UnixSocket:
+        return QString("unix:%1").arg(m_address);
+    default:
+        return QString();
+    }
+}
+
+QJsonObject TransportConfig::toJson() const
+{
+    QJsonObject json;
+    json["type"] = static_cast<int>(m_type);
+    json["vmin"] = m_vmin;
+    json["vtime"] = m_vtime;
+    json["lowLatency"] = m_lowLatency;
+    json["address"] = m_address;
+    json["port"] = m_port;
+    json["localPort"] = m_localPort;
+    return json;
+}
+
+TransportConfig TransportConfig::fromJson(const QJsonObject& json)
+{
+    TransportConfig config;
+    config.m_type = static_cast<TransportType>(json["type"].toInt(0));
+    config.m_vmin = json["vmin"].toInt(config.m_vmin);
+    config.m_vtime = json["vtime"].toInt(config.m_vtime);
+    config.m_lowLatency = json["lowLatency"].toBool(config.m_lowLatency);
+    config.m_address = json["address"].toString();
+    config.m_port = json["port"].toInt(0);
+    config.m_localPort = json["localPort"].toInt(0);
+    return config;
+}
+
+bool TransportConfig::operator==(const TransportConfig& other) const
+{
+    return m_type == other.m_type
+        && m_vmin == other.m_vmin
+        && m_vtime == other.m_vtime
+        && m_lowLatency == other.m_lowLatency
+        && m_address == other.m_address
+        && m_port == other.m_port
+        && m_localPort == other.m_localPort;
+}
@@ -0,0 +1,82 @@
+#ifndef TRANSPORT_CONFIG_H
+#define TRANSPORT_CONFIG_H
+
+#include <QJsonObject>
+#include <QString>
+
+/**
+ * @brief Backend used to talk to a port
+ */
+enum class TransportType {
+    QtSerialPort,   // QSerialPort (all platforms)
+    Termios,        // Native Linux termios2 backend
+    Pty,            // Pseudo terminal loopback (Linux), for testing without hardware
+    Tcp,            // Raw TCP client, e.g. a terminal server port
+    Rfc2217,        // Telnet COM port control (RFC 2217) over TCP
+    Udp,            // UDP datagrams to and from a remote endpoint
+    UnixSocket      // Unix domain stream socket (QLocalSocket)
+};
+
+/**
+ * @brief Per-port transport selection and backend specific options
+ *
+ * Serial backends open SerialPortInfo::portName(). Network backends connect
+ * to address()/port() instead and use the port name only as a label.
+ */
+class TransportConfig {
+public:
+    TransportConfig();
+    explicit TransportConfig(TransportType type);
+
+    // Getters
+    TransportType type() const { return m_type; }
+    int vmin() const { return m_vmin; }
+    int vtime() const { return m_vtime; }
+    bool lowLatency() const { return m_lowLatency; }
+    QString address() const { return m_address; }
+    int port() const { return m_port; }
+    int localPort() const { return m_localPort; }
+
+    // Setters
+    void setType(TransportType type) { m_type = type; }
+    void setVmin(int vmin) { m_vmin = vmin; }
+    void setVtime(int deciseconds) { m_vtime = deciseconds; }
+    void setLowLatency(bool enabled) { m_lowLatency = enabled; }
+    void setAddress(const QString& address) { m_address = address; }
+    void setPort(int port) { m_port = port; }
+    void setLocalPort(int port) { m_localPort = port; }
+
+    // Backend category
+    bool isNetwork() const;
+
+    // Remote endpoint as a URL-like string, e.g. "tcp://10.0.0.5:4001"; empty for serial backends
+    QString endpoint() const;
+
+    // Whether the backend is available in this build
+    static bool isSupported(TransportType type);
+
+    // Serialization
+    QJsonObject toJson() const;
+    static TransportConfig fromJson(const QJsonObject& json);
+
+    // Operators
+    bool operator==(const TransportConfig& other) const;
+    bool operator!=(const TransportConfig& other) const { return !(*this == other); }
+
+private:
+    TransportType m_type;
+
+    // Termios: wake-up threshold in bytes and inter-byte timer in 1/10 s
+    int m_vmin;
+    int m_vtime;
+    // Termios: request ASYNC_LOW_LATENCY from the driver
+    bool m_lowLatency;
+
+    // Network: host name or IP (socket path for UnixSocket), remote port,
+    // and for UDP the local port to receive on (0 = any free port)
+    QString m_address;
+    int m_port;
+    int m_localPort;
+};
+
+#endif // TRANSPORT_CONFIG_H
@@ -1,4 +1,5 @@
 #include "ChatBubble.h"
+#include "Trace.h"
 #include <QMenu>
 #include <QAction>
 #include <QClipboard>
@@ -12,6 +13,7 @@ ChatBubble::ChatBubble(const Message& message, MessageFormat format, QWidget* pa
     , m_message(message)
     , m_format(format)
 {
+    TRACE_SCOPE("ChatBubble::ChatBubble");
     setupUi();
     updateDisplay();
 }
@@ -43,7 +45,13 @@ void ChatBubble::updateDisplay()
 {
     m_portLabel->setText(m_message.portName());
     m_contentLabel->setText(m_message.displayText(m_format));
-    m_timeLabel->setText(m_message.formattedTime());
+    QString time = m_message.formattedTime();
+    if (m_message.checksumStatus() == ChecksumStatus::Valid) {
+        time += QString::fromUtf8("  \u2713");
+    } else if (m_message.checksumStatus() == ChecksumStatus::Invalid) {
+        time += QStringLiteral("  ") + tr("Bad checksum");
+    }
+    m_timeLabel->setText(time);
     applyStyle();
 }
 
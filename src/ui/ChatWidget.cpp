@@ -3,6 +3,7 @@
 #include "SerialPortManager.h"
 #include "MessageManager.h"
 #include "ChatGroup.h"
+#include "Trace.h"
 #include <QScrollBar>
 #include <QTimer>
 #include <QMessageBox>
@@ -95,9 +96,13 @@ void ChatWidget::setDisplayFormat(MessageFormat format)
 
 void ChatWidget::addMessage(const Message& message)
 {
+    TRACE_SCOPE("ChatWidget::addMessage");
     ChatBubble* bubble = new ChatBubble(message, m_displayFormat, m_chatContainer);
     m_bubbles.append(bubble);
-    m_chatLayout->insertWidget(m_chatLayout->count() - 1, bubble);
+    {
+        TRACE_SCOPE("ChatWidget::insertWidget");
+        m_chatLayout->insertWidget(m_chatLayout->count() - 1, bubble);
+    }
     
     // Scroll to bottom after adding
     QTimer::singleShot(50, this, &ChatWidget::scrollToBottom);
@@ -114,6 +119,7 @@ void ChatWidget::clearMessages()
 
 void ChatWidget::loadMessages(const QList<Message>& messages)
 {
+    TRACE_SCOPE_COUNT("ChatWidget::loadMessages", messages.size(), "bubbles");
     clearMessages();
     for (const Message& msg : messages) {
         addMessage(msg);
@@ -163,7 +169,8 @@ void ChatWidget::onClearClicked()
 
 void ChatWidget::onFormatChanged(int index)
 {
-    m_displayFormat = (index == 0) ? MessageFormat::Text : MessageFormat::Hex;
+    static const MessageFormat formats[] = {MessageFormat::Text, MessageFormat::Hex, MessageFormat::Decoded};
+    m_displayFormat = formats[qBound(0, index, 2)];
     setDisplayFormat(m_displayFormat);
 }
 
@@ -177,6 +184,15 @@ void ChatWidget::onHexModeChanged(bool checked)
     }
 }
 
+void ChatWidget::onChecksumChanged(int index)
+{
+    if (m_isGroupMode || m_currentPort.isEmpty()) {
+        return;
+    }
+    ChecksumType type = static_cast<ChecksumType>(m_checksumCombo->itemData(index).toInt());
+    emit checksumChangeRequested(m_currentPort, type);
+}
+
 void ChatWidget::setupUi()
 {
     m_mainLayout = new QVBoxLayout(this);
@@ -220,7 +236,8 @@ void ChatWidget::setupHeader()
     m_formatCombo = new QComboBox(m_headerWidget);
     m_formatCombo->addItem(tr("Text"));
     m_formatCombo->addItem(tr("Hex"));
-    m_formatCombo->setFixedWidth(80);
+    m_formatCombo->addItem(tr("Decoded"));
+    m_formatCombo->setFixedWidth(90);
     connect(m_formatCombo, QOverload<int>::of(&QComboBox::currentIndexChanged),
             this, &ChatWidget::onFormatChanged);
     
@@ -269,8 +286,23 @@ void ChatWidget::setupInputArea()
     m_hexCheckBox = new QCheckBox(tr("Hex Mode"), m_inputWidget);
     connect(m_hexCheckBox, &QCheckBox::toggled, this, &ChatWidget::onHexModeChanged);
     
+    // Appended to every payload sent to this port and checked on received frames
+    m_checksumLabel = new QLabel(tr("Checksum:"), m_inputWidget);
+    m_checksumCombo = new QComboBox(m_inputWidget);
+    const ChecksumType checksumTypes[] = {ChecksumType::None, ChecksumType::Xor8, ChecksumType::Lrc8,
+                                          ChecksumType::Crc8, ChecksumType::Crc16Modbus, ChecksumType::Crc32};
+    for (ChecksumType type : checksumTypes) {
+        m_checksumCombo->addItem(Checksum::name(type), static_cast<int>(type));
+    }
+    connect(m_checksumCombo, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, &ChatWidget::onChecksumChanged);
+    m_checksumLabel->hide();
+    m_checksumCombo->hide();
+    
     m_inputTopLayout->addWidget(m_hexCheckBox);
     m_inputTopLayout->addStretch();
+    m_inputTopLayout->addWidget(m_checksumLabel);
+    m_inputTopLayout->addWidget(m_checksumCombo);
     
     m_inputEdit = new QTextEdit(m_inputWidget);
     m_inputEdit->setPlaceholderText(tr("Enter message..."));
@@ -336,6 +368,7 @@ void ChatWidget::setupTargetSelection()
 
 void ChatWidget::scrollToBottom()
 {
+    TRACE_SCOPE("ChatWidget::scrollToBottom");
     QScrollBar* scrollBar = m_scrollArea->verticalScrollBar();
     scrollBar->setValue(scrollBar->maximum());
 }
@@ -374,6 +407,10 @@ void ChatWidget::updateHeader()
                 m_statusButton->setText(tr("Online - Click to Disconnect"));
                 m_statusButton->setStyleSheet("QPushButton { border: 1px solid #07C160; border-radius: 12px; padding: 4px 12px; font-size: 11px; color: #07C160; background-color: #E8F5E9; } QPushButton:hover { background-color: #FFEBEE; border-color: #F44336; color: #F44336; }");
                 m_statusButton->show();
+            } else if (user && user->isReconnecting()) {
+                m_statusButton->setText(tr("Reconnecting - Click to Disconnect"));
+                m_statusButton->setStyleSheet("QPushButton { border: 1px solid #FA9D3B; border-radius: 12px; padding: 4px 12px; font-size: 11px; color: #FA9D3B; background-color: #FFF3E0; } QPushButton:hover { background-color: #FFEBEE; border-color: #F44336; color: #F44336; }");
+                m_statusButton->show();
             } else {
                 m_statusButton->setText(tr("Offline - Click to Connect"));
                 m_statusButton->setStyleSheet("QPushButton { border: 1px solid #757575; border-radius: 12px; padding: 4px 12px; font-size: 11px; color: #757575; } QPushButton:hover { background-color: #E8F5E9; border-color: #07C160; color: #07C160; }");
@@ -381,6 +418,17 @@ void ChatWidget::updateHeader()
             }
         }
     }
+    
+    // The checksum is a per-port setting
+    bool portMode = !m_isGroupMode && !m_currentPort.isEmpty();
+    m_checksumLabel->setVisible(portMode);
+    m_checksumCombo->setVisible(portMode);
+    if (portMode && m_portManager) {
+        int index = m_checksumCombo->findData(static_cast<int>(m_portManager->portChecksum(m_currentPort)));
+        m_checksumCombo->blockSignals(true);
+        m_checksumCombo->setCurrentIndex(qMax(index, 0));
+        m_checksumCombo->blockSignals(false);
+    }
 }
 
 void ChatWidget::updateTargetList()
@@ -453,7 +501,7 @@ void ChatWidget::onStatusClicked()
         // Toggle port connection
         if (m_portManager) {
             SerialPortUser* user = m_portManager->getUser(m_currentPort);
-            if (user && user->isOnline()) {
+            if (user && (user->isOnline() || user->isReconnecting())) {
                 emit disconnectPortRequested(m_currentPort);
             } else {
                 emit connectPortRequested(m_currentPort);
@@ -2,6 +2,7 @@
 #define CHAT_WIDGET_H
 
 #include "ChatBubble.h"
+#include "Checksum.h"
 #include "Message.h"
 #include <QCheckBox>
 #include <QComboBox>
@@ -68,6 +69,7 @@ class ChatWidget : public QWidget {
     void connectPortRequested(const QString &portName);
     void disconnectPortRequested(const QString &portName);
     void groupForwardingToggled(const QString &groupId, bool enabled);
+    void checksumChangeRequested(const QString &portName, ChecksumType type);
 
   public slots:
     void onMessageReceived(const Message &message);
@@ -77,6 +79,7 @@ class ChatWidget : public QWidget {
     void onClearClicked();
     void onFormatChanged(int index);
     void onHexModeChanged(bool checked);
+    void onChecksumChanged(int index);
     void onTitleClicked();
     void onStatusClicked();
     void onMembersButtonClicked();
@@ -118,6 +121,8 @@ class ChatWidget : public QWidget {
     QTextEdit *m_inputEdit;
     QHBoxLayout *m_buttonLayout;
     QCheckBox *m_hexCheckBox;
+    QLabel *m_checksumLabel;
+    QComboBox *m_checksumCombo;
     QPushButton *m_clearButton;
     QPushButton *m_sendButton;
 
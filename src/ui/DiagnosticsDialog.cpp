@@ -0,0 +1,155 @@
+#include "DiagnosticsDialog.h"
+#include "TimeUtils.h"
+#include <QHeaderView>
+
+namespace {
+const int REFRESH_INTERVAL_MS = 1000;
+
+// Rows of the stall histogram, aggregated from the finer LatencyHistogram buckets
+struct StallRange {
+    qint64 fromMs;
+    const char* label;
+};
+
+const StallRange STALL_RANGES[] = {
+    {0, QT_TRANSLATE_NOOP("DiagnosticsDialog", "< 250 ms")},
+    {250, QT_TRANSLATE_NOOP("DiagnosticsDialog", "250 - 500 ms")},
+    {500, QT_TRANSLATE_NOOP("DiagnosticsDialog", "0.5 - 1 s")},
+    {1000, QT_TRANSLATE_NOOP("DiagnosticsDialog", "1 - 2 s")},
+    {2000, QT_TRANSLATE_NOOP("DiagnosticsDialog", "2 - 5 s")},
+    {5000, QT_TRANSLATE_NOOP("DiagnosticsDialog", "> 5 s")},
+};
+const int STALL_RANGE_COUNT = sizeof(STALL_RANGES) / sizeof(STALL_RANGES[0]);
+}
+
+DiagnosticsDialog::DiagnosticsDialog(StallWatchdog* watchdog, QWidget* parent)
+    : QDialog(parent)
+    , m_watchdog(watchdog)
+    , m_refreshTimer(new QTimer(this))
+{
+    setupUi();
+    refresh();
+
+    connect(m_refreshTimer, &QTimer::timeout, this, &DiagnosticsDialog::refresh);
+    m_refreshTimer->start(REFRESH_INTERVAL_MS);
+}
+
+DiagnosticsDialog::~DiagnosticsDialog()
+{
+}
+
+void DiagnosticsDialog::refresh()
+{
+    m_stallCountLabel->setText(QString::number(m_watchdog->stallCount()));
+    m_maxStallLabel->setText(m_watchdog->stallCount() > 0
+                                 ? tr("%1 ms").arg(m_watchdog->maxStallNs() / 1000000)
+                                 : tr("-"));
+
+    const LatencyHistogram& histogram = m_watchdog->histogram();
+    qint64 counts[STALL_RANGE_COUNT] = {};
+    for (int i = 0; i < histogram.bucketCount(); ++i) {
+        qint64 value = histogram.bucketValue(i);
+        if (value == 0) {
+            continue;
+        }
+        qint64 lowerMs = LatencyHistogram::bucketLowerBound(i) / 1000000;
+        int range = STALL_RANGE_COUNT - 1;
+        while (range > 0 && lowerMs < STALL_RANGES[range].fromMs) {
+            --range;
+        }
+        counts[range] += value;
+    }
+    for (int row = 0; row < STALL_RANGE_COUNT; ++row) {
+        m_histogramTable->item(row, 1)->setText(QString::number(counts[row]));
+    }
+
+    // Newest first
+    const QList<StallReport> stalls = m_watchdog->recentStalls();
+    m_recentList->clear();
+    for (int i = stalls.size() - 1; i >= 0; --i) {
+        const StallReport& report = stalls.at(i);
+        m_recentList->addItem(QString("[%1] %2")
+                                  .arg(TimeUtils::toDateTime(report.timestampNs).toString("HH:mm:ss.zzz"))
+                                  .arg(report.summary()));
+    }
+}
+
+void DiagnosticsDialog::onThresholdChanged(int thresholdMs)
+{
+    m_watchdog->setThresholdMs(thresholdMs);
+}
+
+void DiagnosticsDialog::onResetClicked()
+{
+    m_watchdog->reset();
+    refresh();
+}
+
+void DiagnosticsDialog::setupUi()
+{
+    setWindowTitle(tr("Diagnostics"));
+    setMinimumSize(520, 480);
+
+    m_mainLayout = new QVBoxLayout(this);
+    m_mainLayout->setSpacing(15);
+    m_mainLayout->setContentsMargins(20, 20, 20, 20);
+
+    m_formLayout = new QFormLayout();
+    m_formLayout->setSpacing(10);
+
+    m_thresholdSpin = new QSpinBox(this);
+    m_thresholdSpin->setRange(StallWatchdog::MIN_THRESHOLD_MS, 60000);
+    m_thresholdSpin->setSingleStep(50);
+    m_thresholdSpin->setSuffix(tr(" ms"));
+    m_thresholdSpin->setValue(m_watchdog->thresholdMs());
+    m_thresholdSpin->setEnabled(m_watchdog->isRunning());
+    m_thresholdSpin->setToolTip(tr("Event loop delays at least this long are logged as stalls"));
+    connect(m_thresholdSpin, QOverload<int>::of(&QSpinBox::valueChanged), this,
+            &DiagnosticsDialog::onThresholdChanged);
+
+    m_stallCountLabel = new QLabel(this);
+    m_maxStallLabel = new QLabel(this);
+
+    m_formLayout->addRow(tr("Stall threshold:"), m_thresholdSpin);
+    m_formLayout->addRow(tr("Stalls:"), m_stallCountLabel);
+    m_formLayout->addRow(tr("Longest stall:"), m_maxStallLabel);
+
+    m_histogramTable = new QTableWidget(STALL_RANGE_COUNT, 2, this);
+    m_histogramTable->setHorizontalHeaderLabels({tr("Duration"), tr("Stalls")});
+    m_histogramTable->verticalHeader()->setVisible(false);
+    m_histogramTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    m_histogramTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_histogramTable->setSelectionMode(QAbstractItemView::NoSelection);
+    for (int row = 0; row < STALL_RANGE_COUNT; ++row) {
+        m_histogramTable->setItem(row, 0, new QTableWidgetItem(tr(STALL_RANGES[row].label)));
+        QTableWidgetItem* countItem = new QTableWidgetItem();
+        countItem->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+        m_histogramTable->setItem(row, 1, countItem);
+    }
+
+    m_recentList = new QListWidget(this);
+    m_recentList->setToolTip(tr("Most recent stalls, newest first"));
+
+    m_buttonLayout = new QHBoxLayout();
+    m_buttonLayout->setSpacing(10);
+
+    m_resetButton = new QPushButton(tr("Reset"), this);
+    m_resetButton->setStyleSheet("QPushButton { padding: 8px 20px; }");
+    connect(m_resetButton, &QPushButton::clicked, this, &DiagnosticsDialog::onResetClicked);
+
+    m_closeButton = new QPushButton(tr("Close"), this);
+    m_closeButton->setDefault(true);
+    m_closeButton->setStyleSheet("QPushButton { padding: 8px 30px; }");
+    connect(m_closeButton, &QPushButton::clicked, this, &DiagnosticsDialog::accept);
+
+    m_buttonLayout->addWidget(m_resetButton);
+    m_buttonLayout->addStretch();
+    m_buttonLayout->addWidget(m_closeButton);
+
+    m_mainLayout->addLayout(m_formLayout);
+    m_mainLayout->addWidget(new QLabel(tr("Stall durations:"), this));
+    m_mainLayout->addWidget(m_histogramTable);
+    m_mainLayout->addWidget(new QLabel(tr("Recent stalls:"), this));
+    m_mainLayout->addWidget(m_recentList, 1);
+    m_mainLayout->addLayout(m_buttonLayout);
+}
@@ -0,0 +1,50 @@
+#ifndef DIAGNOSTICS_DIALOG_H
+#define DIAGNOSTICS_DIALOG_H
+
+#include <QDialog>
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QFormLayout>
+#include <QSpinBox>
+#include <QTableWidget>
+#include <QListWidget>
+#include <QPushButton>
+#include <QLabel>
+#include <QTimer>
+#include "StallWatchdog.h"
+
+/**
+ * @brief Event-loop stall statistics collected by a StallWatchdog
+ */
+class DiagnosticsDialog : public QDialog {
+    Q_OBJECT
+
+public:
+    explicit DiagnosticsDialog(StallWatchdog* watchdog, QWidget* parent = nullptr);
+    ~DiagnosticsDialog() override;
+
+private slots:
+    void refresh();
+    void onThresholdChanged(int thresholdMs);
+    void onResetClicked();
+
+private:
+    StallWatchdog* m_watchdog;
+    QTimer* m_refreshTimer;
+
+    // UI Components
+    QVBoxLayout* m_mainLayout;
+    QFormLayout* m_formLayout;
+    QSpinBox* m_thresholdSpin;
+    QLabel* m_stallCountLabel;
+    QLabel* m_maxStallLabel;
+    QTableWidget* m_histogramTable;
+    QListWidget* m_recentList;
+    QHBoxLayout* m_buttonLayout;
+    QPushButton* m_resetButton;
+    QPushButton* m_closeButton;
+
+    void setupUi();
+};
+
+#endif // DIAGNOSTICS_DIALOG_H
@@ -1,10 +1,17 @@
 #include "FriendListItem.h"
 #include "TimeUtils.h"
 #include <QContextMenuEvent>
+#include <QLocale>
 #include <QMouseEvent>
 #include <QPainter>
 #include <QResizeEvent>
 
+namespace {
+QString formatRate(double bytesPerSecond) {
+    return QLocale().formattedDataSize(qRound64(bytesPerSecond)) + QStringLiteral("/s");
+}
+} // namespace
+
 FriendListItem::FriendListItem(const SerialPortInfo &info, QWidget *parent)
     : QWidget(parent), m_info(info), m_selected(false), m_hovered(false), m_unreadCount(0), m_slideOffset(0),
       m_swiping(false), m_slideAnimation(nullptr) {
@@ -58,6 +65,41 @@ void FriendListItem::incrementUnreadCount() { setUnreadCount(m_unreadCount + 1);
 
 void FriendListItem::clearUnread() { setUnreadCount(0); }
 
+void FriendListItem::setTraffic(const PortMetricsSnapshot &metrics) {
+    if (metrics.status != PortStatus::Online && metrics.status != PortStatus::Reconnecting) {
+        m_trafficLabel->hide();
+        m_trafficLabel->setToolTip(QString());
+        return;
+    }
+
+    QString rx = formatRate(metrics.rxByteRate.oneSecond);
+    QString tx = formatRate(metrics.txByteRate.oneSecond);
+    m_trafficLabel->setText(QStringLiteral("\u2193%1 \u2191%2").arg(rx, tx));
+    m_trafficLabel->show();
+
+    QLocale locale;
+    QStringList lines;
+    lines << tr("RX: %1 bytes, %2 frames").arg(metrics.rxBytes).arg(metrics.rxFrames);
+    lines << tr("TX: %1 bytes, %2 frames").arg(metrics.txBytes).arg(metrics.txFrames);
+    lines << tr("RX 10 s / 60 s: %1 / %2")
+                 .arg(formatRate(metrics.rxByteRate.tenSeconds), formatRate(metrics.rxByteRate.oneMinute));
+    lines << tr("TX 10 s / 60 s: %1 / %2")
+                 .arg(formatRate(metrics.txByteRate.tenSeconds), formatRate(metrics.txByteRate.oneMinute));
+    lines << tr("Parity errors: %1, framing errors: %2, overruns: %3")
+                 .arg(metrics.lineErrors.parity)
+                 .arg(metrics.lineErrors.framing)
+                 .arg(metrics.lineErrors.overrun);
+    lines << tr("Dropped: %1").arg(locale.formattedDataSize(metrics.rxDroppedBytes));
+    lines << tr("Queue peak: RX %1, TX %2").arg(metrics.rxQueuePeak).arg(metrics.txQueuePeak);
+    if (metrics.autoReplies > 0) {
+        lines << tr("Auto replies: %1, latency p50 %2 ms, p99 %3 ms")
+                     .arg(metrics.autoReplies)
+                     .arg(metrics.autoReplyP50Ns / 1e6, 0, 'f', 2)
+                     .arg(metrics.autoReplyP99Ns / 1e6, 0, 'f', 2);
+    }
+    m_trafficLabel->setToolTip(lines.join(QLatin1Char('\n')));
+}
+
 void FriendListItem::setSlideOffset(int offset) {
     m_slideOffset = offset;
     m_contentWidget->move(offset, 0);
@@ -144,7 +186,13 @@ void FriendListItem::setupUi() {
         "background-color: #FA5151; color: white; border-radius: 10px; font-size: 10px; font-weight: bold;");
     m_unreadBadge->hide();
 
+    m_trafficLabel = new QLabel(m_contentWidget);
+    m_trafficLabel->setStyleSheet("color: #999999;");
+    m_trafficLabel->setFont(timeFont);
+    m_trafficLabel->hide();
+
     bottomRow->addWidget(m_lastMessageLabel, 1);
+    bottomRow->addWidget(m_trafficLabel);
     bottomRow->addWidget(m_unreadBadge);
 
     m_infoLayout->addLayout(topRow);
@@ -173,6 +221,9 @@ void FriendListItem::updateDisplay() {
     case PortStatus::Online:
         m_statusIndicator->setStyleSheet("background-color: #07C160; border-radius: 7px; border: 2px solid white;");
         break;
+    case PortStatus::Reconnecting:
+        m_statusIndicator->setStyleSheet("background-color: #FA9D3B; border-radius: 7px; border: 2px solid white;");
+        break;
     case PortStatus::Error:
         m_statusIndicator->setStyleSheet("background-color: #FA5151; border-radius: 7px; border: 2px solid white;");
         break;
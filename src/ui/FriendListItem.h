@@ -1,6 +1,7 @@
 #ifndef FRIEND_LIST_ITEM_H
 #define FRIEND_LIST_ITEM_H
 
+#include "PortMetrics.h"
 #include "SerialPortInfo.h"
 #include <QHBoxLayout>
 #include <QLabel>
@@ -37,6 +38,9 @@ class FriendListItem : public QWidget {
     void clearUnread();
     int unreadCount() const { return m_unreadCount; }
 
+    // Live receive/transmit rates, shown while the port is connected
+    void setTraffic(const PortMetricsSnapshot &metrics);
+
     // Slide offset for swipe gesture
     int slideOffset() const { return m_slideOffset; }
     void setSlideOffset(int offset);
@@ -86,6 +90,7 @@ class FriendListItem : public QWidget {
     QLabel *m_lastMessageLabel;
     QLabel *m_timeLabel;
     QLabel *m_unreadBadge;
+    QLabel *m_trafficLabel;
 
     // Delete button (hidden by default)
     QPushButton *m_deleteButton;
@@ -384,6 +384,9 @@ void FriendListWidget::showPortContextMenu(const QString &portName, const QPoint
     QAction *remarkAction = menu.addAction(tr("Set Remark..."));
     connect(remarkAction, &QAction::triggered, this, [this, portName]() { emit portRemarkRequested(portName); });
 
+    QAction *replayAction = menu.addAction(tr("Replay History..."));
+    connect(replayAction, &QAction::triggered, this, [this, portName]() { emit replayRequested(portName); });
+
     menu.addSeparator();
 
     QAction *deleteAction = menu.addAction(QIcon(":/icons/delete.png"), tr("Delete"));
@@ -428,6 +431,12 @@ void FriendListWidget::clearUnread(const QString &portName) {
     }
 }
 
+void FriendListWidget::updateTraffic(const PortMetricsSnapshot &metrics) {
+    if (m_friendItems.contains(metrics.portName)) {
+        m_friendItems[metrics.portName]->setTraffic(metrics);
+    }
+}
+
 QWidget *FriendListWidget::createGroupItem(const ChatGroupInfo &group) {
     QWidget *item = new QWidget(this);
     item->setFixedHeight(60);
@@ -58,6 +58,7 @@ class FriendListWidget : public QWidget {
     void createGroupRequested();
     void portSettingsRequested(const QString &portName);
     void portRemarkRequested(const QString &portName);
+    void replayRequested(const QString &portName);
     void connectRequested(const QString &portName);
     void disconnectRequested(const QString &portName);
     void deletePortRequested(const QString &portName);
@@ -68,6 +69,7 @@ class FriendListWidget : public QWidget {
     void updateLastMessage(const QString &portName, const QString &message);
     void incrementUnread(const QString &portName);
     void clearUnread(const QString &portName);
+    void updateTraffic(const PortMetricsSnapshot &metrics);
 
   protected:
     bool eventFilter(QObject *watched, QEvent *event) override;
@@ -1,18 +1,28 @@
 #include "MainWindow.h"
 #include "ChatGroupDialog.h"
+#include "DiagnosticsDialog.h"
+#include "ReplayDialog.h"
 #include "SerialPortRemarkDialog.h"
 #include "SerialPortSettingsDialog.h"
+#include "Trace.h"
 #include <QApplication>
 #include <QCloseEvent>
 #include <QDateTime>
 #include <QFileDialog>
 #include <QJsonArray>
 #include <QJsonDocument>
+#include <QLocale>
 #include <QMessageBox>
 
+namespace {
+// Status changes arriving within this time cause a single friend list refresh
+const int LIST_REFRESH_DELAY_MS = 20;
+} // namespace
+
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent), m_portManager(new SerialPortManager(this)), m_messageManager(new MessageManager(this)),
-      m_dataPersistence(new DataPersistence(this)) {
+      m_dataPersistence(new DataPersistence(this)), m_replayEngine(new ReplayEngine(m_portManager, this)),
+      m_stallWatchdog(new StallWatchdog(this)) {
     setupUi();
     setupMenuBar();
     setupStatusBar();
@@ -23,6 +33,7 @@ MainWindow::MainWindow(QWidget *parent)
     // Start auto-refresh
     m_portManager->setAutoRefresh(true);
     m_statusTimer->start(1000);
+    m_stallWatchdog->start();
 
     logMessage(tr("Serial Chat started"));
 }
@@ -39,7 +50,7 @@ void MainWindow::closeEvent(QCloseEvent *event) {
 }
 
 void MainWindow::onAddPortRequested() {
-    SerialPortSettingsDialog dialog(this);
+    SerialPortSettingsDialog dialog(m_portManager->inventory(), this);
     if (dialog.exec() == QDialog::Accepted) {
         SerialPortInfo info = dialog.portInfo();
         if (!info.portName().isEmpty()) {
@@ -91,7 +102,7 @@ void MainWindow::onPortSettingsRequested(const QString &portName) {
         return;
     }
 
-    SerialPortSettingsDialog dialog(user->info(), this);
+    SerialPortSettingsDialog dialog(m_portManager->inventory(), user->info(), this);
     if (dialog.exec() == QDialog::Accepted) {
         m_portManager->updatePortSettings(dialog.portInfo());
         m_friendListWidget->refreshList();
@@ -109,6 +120,50 @@ void MainWindow::onPortRemarkRequested(const QString &portName) {
     }
 }
 
+void MainWindow::onReplayRequested(const QString &portName) {
+    if (m_replayEngine->isRunning()) {
+        QMessageBox::StandardButton reply = QMessageBox::question(
+            this, tr("Replay History"),
+            tr("A replay to %1 is running. Stop it?").arg(m_replayEngine->targetPort()),
+            QMessageBox::Yes | QMessageBox::No);
+        if (reply == QMessageBox::Yes) {
+            m_replayEngine->stop();
+        }
+        return;
+    }
+
+    QStringList sourcePorts;
+    for (const SerialPortInfo &info : m_portManager->friendList()) {
+        if (info.portName() != portName) {
+            sourcePorts.append(info.portName());
+        }
+    }
+    ReplayDialog dialog(portName, sourcePorts, m_dataPersistence->dataDirectory() + "/messages/", this);
+    if (dialog.exec() != QDialog::Accepted) {
+        return;
+    }
+
+    if (!m_replayEngine->start(dialog.path(), dialog.sourcePort(), portName, dialog.options())) {
+        logError(tr("Failed to replay %1: %2").arg(dialog.path(), m_replayEngine->errorString()));
+        QMessageBox::warning(this, tr("Error"), tr("Failed to replay history: %1").arg(m_replayEngine->errorString()));
+        return;
+    }
+    if (m_replayEngine->isRunning()) {
+        logMessage(tr("Replaying %1 to %2").arg(dialog.path(), portName));
+        m_statusLabel->setText(tr("Replaying to %1").arg(portName));
+    }
+}
+
+void MainWindow::onReplayFinished(const ReplayReport &report) {
+    QString text = tr("Replay to %1: %2").arg(m_replayEngine->targetPort(), report.summary());
+    if (report.completed) {
+        logMessage(text);
+    } else {
+        logWarning(text);
+    }
+    m_statusLabel->setText(tr("Ready"));
+}
+
 void MainWindow::onCreateGroupRequested() {
     ChatGroupDialog dialog(m_portManager, this);
     if (dialog.exec() == QDialog::Accepted) {
@@ -125,7 +180,8 @@ void MainWindow::onSendDataRequested(const QString &portName, const QByteArray &
         user = m_portManager->createUser(portName);
     }
 
-    if (!user->isOnline()) {
+    // A reconnecting port queues the data until it is back
+    if (!user->isOnline() && !user->isReconnecting()) {
         if (!user->connect()) {
             QMessageBox::warning(this, tr("Error"),
                                  tr("Failed to connect to %1: %2").arg(portName, user->errorString()));
@@ -144,8 +200,16 @@ void MainWindow::onSendDataRequested(const QString &portName, const QByteArray &
 void MainWindow::onClearHistoryRequested(const QString &portName) { m_messageManager->clearMessages(portName); }
 
 void MainWindow::onUserStatusChanged(const QString &portName, PortStatus status) {
-    Q_UNUSED(status)
-    m_friendListWidget->refreshList();
+    m_listRefreshTimer->start();
+
+    // Loopback ports get a new device on every connect; say where to attach
+    SerialPortUser *user = m_portManager->getUser(portName);
+    if (status == PortStatus::Online && user && !user->peerName().isEmpty()) {
+        logMessage(tr("Loopback %1: attach the other end to %2").arg(portName, user->peerName()));
+    }
+    if (status == PortStatus::Reconnecting && user) {
+        logWarning(tr("Lost connection to %1 (%2), reconnecting").arg(portName, user->errorString()));
+    }
 
     // Update chat widget if this is the current port
     if (m_chatWidget->currentPort() == portName) {
@@ -156,6 +220,7 @@ void MainWindow::onUserStatusChanged(const QString &portName, PortStatus status)
 }
 
 void MainWindow::onUserMessageReceived(const QString &portName, const Message &message) {
+    TRACE_SCOPE("MainWindow::onUserMessageReceived");
     // Add to message manager
     m_messageManager->addMessage(message);
 
@@ -240,8 +305,12 @@ void MainWindow::onDeletePortRequested(const QString &portName) {
 void MainWindow::onRefreshPorts() { m_portManager->refreshAvailablePorts(); }
 
 void MainWindow::onDisconnectAll() {
-    m_portManager->disconnectAll();
-    m_friendListWidget->refreshList();
+    // Ports close on their I/O threads; the status changes refresh the list
+    QStringList ports;
+    for (const SerialPortInfo &info : m_portManager->friendList()) {
+        ports.append(info.portName());
+    }
+    m_portManager->disconnectPorts(ports);
 }
 
 void MainWindow::onClearAllHistory() {
@@ -328,6 +397,19 @@ void MainWindow::updateStatusBar() {
     int online = m_portManager->onlineCount();
     int total = m_portManager->totalCount();
     m_connectionLabel->setText(tr("Online: %1/%2").arg(online).arg(total));
+
+    // Live rates for the status bar total and each friend list entry
+    double rxRate = 0.0;
+    double txRate = 0.0;
+    for (const PortMetricsSnapshot &metrics : m_portManager->metricsSnapshot()) {
+        rxRate += metrics.rxByteRate.oneSecond;
+        txRate += metrics.txByteRate.oneSecond;
+        m_friendListWidget->updateTraffic(metrics);
+    }
+    QLocale locale;
+    QString rx = locale.formattedDataSize(qRound64(rxRate));
+    QString tx = locale.formattedDataSize(qRound64(txRate));
+    m_trafficLabel->setText(tr("RX: %1/s  TX: %2/s").arg(rx, tx));
 }
 
 void MainWindow::setupUi() {
@@ -411,6 +493,18 @@ void MainWindow::setupMenuBar() {
     m_toggleConsoleAction->setShortcut(QKeySequence(Qt::CTRL | Qt::Key_QuoteLeft));
     connect(m_toggleConsoleAction, &QAction::triggered, this, &MainWindow::onToggleConsole);
 
+    // Only in builds with ENABLE_TRACING; may already be recording from --trace
+    m_traceAction = nullptr;
+    if (Trace::isAvailable()) {
+        m_traceAction = m_viewMenu->addAction(tr("Record &Trace"));
+        m_traceAction->setCheckable(true);
+        m_traceAction->setChecked(Trace::isRecording());
+        connect(m_traceAction, &QAction::toggled, this, &MainWindow::onToggleTrace);
+    }
+
+    m_diagnosticsAction = m_viewMenu->addAction(tr("&Diagnostics..."));
+    connect(m_diagnosticsAction, &QAction::triggered, this, &MainWindow::onShowDiagnostics);
+
     // Help menu
     m_helpMenu = menuBar()->addMenu(tr("&Help"));
 
@@ -425,8 +519,15 @@ void MainWindow::setupStatusBar() {
     m_connectionLabel = new QLabel(tr("Online: 0/0"));
     statusBar()->addPermanentWidget(m_connectionLabel);
 
+    m_trafficLabel = new QLabel(tr("RX: 0 bytes/s  TX: 0 bytes/s"));
+    statusBar()->addPermanentWidget(m_trafficLabel);
+
     m_statusTimer = new QTimer(this);
     connect(m_statusTimer, &QTimer::timeout, this, &MainWindow::updateStatusBar);
+
+    m_listRefreshTimer = new QTimer(this);
+    m_listRefreshTimer->setSingleShot(true);
+    m_listRefreshTimer->setInterval(LIST_REFRESH_DELAY_MS);
 }
 
 void MainWindow::setupConnections() {
@@ -439,6 +540,7 @@ void MainWindow::setupConnections() {
     connect(m_friendListWidget, &FriendListWidget::disconnectRequested, this, &MainWindow::onDisconnectRequested);
     connect(m_friendListWidget, &FriendListWidget::portSettingsRequested, this, &MainWindow::onPortSettingsRequested);
     connect(m_friendListWidget, &FriendListWidget::portRemarkRequested, this, &MainWindow::onPortRemarkRequested);
+    connect(m_friendListWidget, &FriendListWidget::replayRequested, this, &MainWindow::onReplayRequested);
 
     // Chat widget connections
     connect(m_chatWidget, &ChatWidget::sendDataRequested, this, &MainWindow::onSendDataRequested);
@@ -449,11 +551,31 @@ void MainWindow::setupConnections() {
     connect(m_chatWidget, &ChatWidget::connectPortRequested, this, &MainWindow::onConnectRequested);
     connect(m_chatWidget, &ChatWidget::disconnectPortRequested, this, &MainWindow::onDisconnectRequested);
     connect(m_chatWidget, &ChatWidget::groupForwardingToggled, this, &MainWindow::onGroupForwardingToggled);
+    connect(m_chatWidget, &ChatWidget::checksumChangeRequested, m_portManager, &SerialPortManager::setPortChecksum);
+
+    // Replay progress and drift report
+    connect(m_replayEngine, &ReplayEngine::progress, this, [this](qint64 bytesRead, qint64 totalBytes) {
+        int percent = totalBytes > 0 ? static_cast<int>(bytesRead * 100 / totalBytes) : 0;
+        m_statusLabel->setText(tr("Replaying to %1: %2%").arg(m_replayEngine->targetPort()).arg(percent));
+    });
+    connect(m_replayEngine, &ReplayEngine::finished, this, &MainWindow::onReplayFinished);
+
+    // Event loop stalls
+    connect(m_stallWatchdog, &StallWatchdog::stallDetected, this, &MainWindow::onStallDetected);
 
     // Port manager connections
     connect(m_portManager, &SerialPortManager::userStatusChanged, this, &MainWindow::onUserStatusChanged);
+    connect(m_portManager, &SerialPortManager::portsConnected, this, &MainWindow::onPortsConnected);
+    connect(m_listRefreshTimer, &QTimer::timeout, m_friendListWidget, &FriendListWidget::refreshList);
     connect(m_portManager, &SerialPortManager::userMessageReceived, this, &MainWindow::onUserMessageReceived);
     connect(m_portManager, &SerialPortManager::userMessageSent, this, &MainWindow::onUserMessageSent);
+    connect(m_portManager, &SerialPortManager::userReconnected, this,
+            [this](const QString &portName, int attempts, qint64 downtimeMs) {
+                logMessage(tr("Reconnected to %1 after %2 attempt(s), %3 s offline")
+                               .arg(portName)
+                               .arg(attempts)
+                               .arg(downtimeMs / 1000.0, 0, 'f', 1));
+            });
 
     // Delete port handling
     connect(m_friendListWidget, &FriendListWidget::deletePortRequested, this, &MainWindow::onDeletePortRequested);
@@ -527,24 +649,40 @@ void MainWindow::setupConsoleDock() {
 }
 
 void MainWindow::onConnectAll() {
+    // Opens run on the I/O threads; onPortsConnected() reports once all are done
+    QStringList ports;
+    for (const SerialPortInfo &info : m_portManager->friendList()) {
+        if (!info.isOnline()) {
+            ports.append(info.portName());
+        }
+    }
+
+    // Disabled first: if nothing is left to open, portsConnected() arrives before connectPorts() returns
+    m_connectAllAction->setEnabled(false);
+    if (!m_portManager->connectPorts(ports)) {
+        m_connectAllAction->setEnabled(true);
+    }
+}
+
+void MainWindow::onPortsConnected(const QList<PortConnectResult> &results, qint64 elapsedNs) {
     int connected = 0;
     int failed = 0;
-
-    QList<SerialPortInfo> friends = m_portManager->friendList();
-    for (const SerialPortInfo &info : friends) {
-        if (!info.isOnline()) {
-            if (m_portManager->connectPort(info.portName())) {
-                connected++;
-                logMessage(tr("Connected to %1").arg(info.portName()));
-            } else {
-                failed++;
-                logWarning(tr("Failed to connect to %1").arg(info.portName()));
-            }
+    for (const PortConnectResult &result : results) {
+        if (result.ok) {
+            connected++;
+            logMessage(tr("Connected to %1 (%2 ms)").arg(result.portName).arg(result.openTimeNs / 1e6, 0, 'f', 1));
+        } else {
+            failed++;
+            logWarning(tr("Failed to connect to %1: %2").arg(result.portName, result.error));
         }
     }
 
+    m_connectAllAction->setEnabled(true);
     m_friendListWidget->refreshList();
-    logMessage(tr("Connect All completed: %1 connected, %2 failed").arg(connected).arg(failed));
+    logMessage(tr("Connect All completed: %1 connected, %2 failed in %3 ms")
+                   .arg(connected)
+                   .arg(failed)
+                   .arg(elapsedNs / 1e6, 0, 'f', 1));
 }
 
 void MainWindow::onToggleConsole() {
@@ -552,6 +690,45 @@ void MainWindow::onToggleConsole() {
     m_toggleConsoleAction->setChecked(m_consoleDock->isVisible());
 }
 
+void MainWindow::onToggleTrace(bool checked) {
+    if (checked) {
+        Trace::start();
+        logMessage(tr("Trace recording started"));
+        return;
+    }
+
+    Trace::stop();
+    QString fileName = QFileDialog::getSaveFileName(this, tr("Save Trace"), "serialchat-trace.json",
+                                                    tr("JSON Files (*.json);;All Files (*)"));
+    if (fileName.isEmpty()) {
+        logWarning(tr("Trace discarded"));
+        return;
+    }
+
+    QString error;
+    if (Trace::writeChromeJson(fileName, &error)) {
+        logMessage(tr("Trace with %1 spans (%2 dropped) saved to %3; open it in ui.perfetto.dev or chrome://tracing")
+                       .arg(Trace::eventCount())
+                       .arg(Trace::droppedCount())
+                       .arg(fileName));
+    } else {
+        logError(tr("Failed to save trace: %1").arg(error));
+    }
+}
+
+void MainWindow::onShowDiagnostics() {
+    DiagnosticsDialog dialog(m_stallWatchdog, this);
+    dialog.exec();
+}
+
+void MainWindow::onStallDetected(const StallReport &report) {
+    QString text = report.summary();
+    if (!Trace::isAvailable()) {
+        text += tr(" (build with ENABLE_TRACING to name the operation)");
+    }
+    logWarning(text);
+}
+
 void MainWindow::logMessage(const QString &message) {
     QString timestamp = QDateTime::currentDateTime().toString("hh:mm:ss");
     m_consoleOutput->append(QString("<span style='color: #6A9955;'>[%1]</span> %2").arg(timestamp, message));
@@ -641,7 +818,7 @@ void MainWindow::onSendGroupDataRequested(const QString &groupId, const QByteArr
             user = m_portManager->createUser(portName);
         }
 
-        if (!user->isOnline()) {
+        if (!user->isOnline() && !user->isReconnecting()) {
             if (!user->connect()) {
                 logWarning(tr("Failed to connect to %1: %2").arg(portName, user->errorString()));
                 continue;
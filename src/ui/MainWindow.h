@@ -19,7 +19,9 @@
 #include "DataPersistence.h"
 #include "FriendListWidget.h"
 #include "MessageManager.h"
+#include "ReplayEngine.h"
 #include "SerialPortManager.h"
+#include "StallWatchdog.h"
 
 // Version info
 #define APP_VERSION "1.0.0"
@@ -42,6 +44,9 @@ class MainWindow : public QMainWindow {
     void logError(const QString &message);
     void logWarning(const QString &message);
 
+    // Started with the window; main() applies --stall-threshold
+    StallWatchdog *stallWatchdog() const { return m_stallWatchdog; }
+
   protected:
     void closeEvent(QCloseEvent *event) override;
 
@@ -54,6 +59,8 @@ class MainWindow : public QMainWindow {
     void onDisconnectRequested(const QString &portName);
     void onPortSettingsRequested(const QString &portName);
     void onPortRemarkRequested(const QString &portName);
+    void onReplayRequested(const QString &portName);
+    void onReplayFinished(const ReplayReport &report);
 
     // Group actions
     void onCreateGroupRequested();
@@ -77,10 +84,14 @@ class MainWindow : public QMainWindow {
     // Menu actions
     void onRefreshPorts();
     void onConnectAll();
+    void onPortsConnected(const QList<PortConnectResult> &results, qint64 elapsedNs);
     void onDisconnectAll();
     void onClearAllHistory();
     void onExportHistory();
     void onToggleConsole();
+    void onToggleTrace(bool checked);
+    void onShowDiagnostics();
+    void onStallDetected(const StallReport &report);
     void onAbout();
 
     // Status bar update
@@ -91,6 +102,8 @@ class MainWindow : public QMainWindow {
     SerialPortManager *m_portManager;
     MessageManager *m_messageManager;
     DataPersistence *m_dataPersistence;
+    ReplayEngine *m_replayEngine;
+    StallWatchdog *m_stallWatchdog;
     QMap<QString, ChatGroup *> m_chatGroups;
 
     // UI Components
@@ -119,13 +132,19 @@ class MainWindow : public QMainWindow {
     QAction *m_clearHistoryAction;
     QAction *m_exportHistoryAction;
     QAction *m_toggleConsoleAction;
+    QAction *m_traceAction;
+    QAction *m_diagnosticsAction;
     QAction *m_aboutAction;
 
     // Status bar
     QLabel *m_statusLabel;
     QLabel *m_connectionLabel;
+    QLabel *m_trafficLabel;
     QTimer *m_statusTimer;
 
+    // Merges friend list refreshes when many ports change status at once
+    QTimer *m_listRefreshTimer;
+
     void setupUi();
     void setupMenuBar();
     void setupStatusBar();
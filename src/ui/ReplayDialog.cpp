@@ -0,0 +1,136 @@
+#include "ReplayDialog.h"
+#include <QFileDialog>
+#include <QFileInfo>
+#include <QMessageBox>
+
+ReplayDialog::ReplayDialog(const QString& targetPort, const QStringList& sourcePorts, const QString& defaultPath,
+                           QWidget* parent)
+    : QDialog(parent)
+    , m_targetPort(targetPort)
+{
+    setupUi(sourcePorts, defaultPath);
+}
+
+ReplayDialog::~ReplayDialog()
+{
+}
+
+QString ReplayDialog::path() const
+{
+    return m_pathEdit->text().trimmed();
+}
+
+QString ReplayDialog::sourcePort() const
+{
+    // The first item stands for every port in the file
+    return m_sourceCombo->currentIndex() == 0 ? QString() : m_sourceCombo->currentText().trimmed();
+}
+
+ReplayOptions ReplayDialog::options() const
+{
+    ReplayOptions options;
+    options.direction = static_cast<ReplayDirection>(m_directionCombo->currentData().toInt());
+    options.timing = static_cast<ReplayTiming>(m_timingCombo->currentData().toInt());
+    options.speed = m_speedSpin->value();
+    return options;
+}
+
+void ReplayDialog::onBrowseClicked()
+{
+    QString fileName = QFileDialog::getOpenFileName(this, tr("Open History"), path(), tr("JSON Files (*.json)"));
+    if (!fileName.isEmpty()) {
+        m_pathEdit->setText(fileName);
+    }
+}
+
+void ReplayDialog::onTimingChanged(int index)
+{
+    Q_UNUSED(index);
+    m_speedSpin->setEnabled(options().timing == ReplayTiming::Scaled);
+}
+
+void ReplayDialog::onOkClicked()
+{
+    if (!QFileInfo(path()).isFile()) {
+        QMessageBox::warning(this, tr("Warning"), tr("Please choose a history file"));
+        m_pathEdit->setFocus();
+        return;
+    }
+    accept();
+}
+
+void ReplayDialog::setupUi(const QStringList& sourcePorts, const QString& defaultPath)
+{
+    setWindowTitle(tr("Replay History"));
+    setMinimumWidth(420);
+
+    m_mainLayout = new QVBoxLayout(this);
+    m_mainLayout->setSpacing(15);
+    m_mainLayout->setContentsMargins(20, 20, 20, 20);
+
+    m_formLayout = new QFormLayout();
+    m_formLayout->setSpacing(10);
+
+    m_targetLabel = new QLabel(m_targetPort, this);
+    m_targetLabel->setStyleSheet("font-weight: bold;");
+
+    m_pathEdit = new QLineEdit(defaultPath, this);
+    m_pathEdit->setPlaceholderText(tr("Saved or exported history (*.json)"));
+    m_browseButton = new QPushButton(tr("Browse..."), this);
+    connect(m_browseButton, &QPushButton::clicked, this, &ReplayDialog::onBrowseClicked);
+    QHBoxLayout* pathLayout = new QHBoxLayout();
+    pathLayout->addWidget(m_pathEdit, 1);
+    pathLayout->addWidget(m_browseButton);
+
+    // Editable, as the file may hold ports that are no longer in the friend list
+    m_sourceCombo = new QComboBox(this);
+    m_sourceCombo->setEditable(true);
+    m_sourceCombo->addItem(tr("(all ports in the file)"));
+    m_sourceCombo->addItems(sourcePorts);
+    m_sourceCombo->setToolTip(tr("Port whose recorded messages are replayed"));
+
+    m_directionCombo = new QComboBox(this);
+    m_directionCombo->addItem(tr("Received (act as the device)"), static_cast<int>(ReplayDirection::Received));
+    m_directionCombo->addItem(tr("Sent (act as the host)"), static_cast<int>(ReplayDirection::Sent));
+    m_directionCombo->addItem(tr("Both"), static_cast<int>(ReplayDirection::Both));
+
+    m_timingCombo = new QComboBox(this);
+    m_timingCombo->addItem(tr("Original timing"), static_cast<int>(ReplayTiming::Original));
+    m_timingCombo->addItem(tr("Scaled"), static_cast<int>(ReplayTiming::Scaled));
+    m_timingCombo->addItem(tr("As fast as possible"), static_cast<int>(ReplayTiming::Burst));
+    connect(m_timingCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &ReplayDialog::onTimingChanged);
+
+    m_speedSpin = new QDoubleSpinBox(this);
+    m_speedSpin->setRange(0.01, 1000.0);
+    m_speedSpin->setDecimals(2);
+    m_speedSpin->setValue(10.0);
+    m_speedSpin->setSuffix(tr(" x"));
+    m_speedSpin->setToolTip(tr("Recorded gaps are divided by this factor"));
+    m_speedSpin->setEnabled(false);
+
+    m_formLayout->addRow(tr("Replay to:"), m_targetLabel);
+    m_formLayout->addRow(tr("History file:"), pathLayout);
+    m_formLayout->addRow(tr("Recorded port:"), m_sourceCombo);
+    m_formLayout->addRow(tr("Messages:"), m_directionCombo);
+    m_formLayout->addRow(tr("Timing:"), m_timingCombo);
+    m_formLayout->addRow(tr("Speed:"), m_speedSpin);
+
+    m_buttonLayout = new QHBoxLayout();
+    m_buttonLayout->setSpacing(10);
+
+    m_cancelButton = new QPushButton(tr("Cancel"), this);
+    m_cancelButton->setStyleSheet("QPushButton { padding: 8px 20px; }");
+    connect(m_cancelButton, &QPushButton::clicked, this, &ReplayDialog::reject);
+
+    m_okButton = new QPushButton(tr("Replay"), this);
+    m_okButton->setDefault(true);
+    m_okButton->setStyleSheet("QPushButton { padding: 8px 30px; background-color: #07C160; color: white; border: none; border-radius: 5px; } QPushButton:hover { background-color: #06AD56; }");
+    connect(m_okButton, &QPushButton::clicked, this, &ReplayDialog::onOkClicked);
+
+    m_buttonLayout->addStretch();
+    m_buttonLayout->addWidget(m_cancelButton);
+    m_buttonLayout->addWidget(m_okButton);
+
+    m_mainLayout->addLayout(m_formLayout);
+    m_mainLayout->addLayout(m_buttonLayout);
+}
@@ -0,0 +1,57 @@
+#ifndef REPLAY_DIALOG_H
+#define REPLAY_DIALOG_H
+
+#include <QDialog>
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QFormLayout>
+#include <QLineEdit>
+#include <QComboBox>
+#include <QDoubleSpinBox>
+#include <QPushButton>
+#include <QLabel>
+#include <QStringList>
+#include "ReplayEngine.h"
+
+/**
+ * @brief Dialog for replaying a history file out of a port
+ */
+class ReplayDialog : public QDialog {
+    Q_OBJECT
+
+public:
+    ReplayDialog(const QString& targetPort, const QStringList& sourcePorts, const QString& defaultPath,
+                 QWidget* parent = nullptr);
+    ~ReplayDialog() override;
+
+    // Chosen replay
+    QString path() const;
+    QString sourcePort() const;
+    ReplayOptions options() const;
+
+private slots:
+    void onBrowseClicked();
+    void onTimingChanged(int index);
+    void onOkClicked();
+
+private:
+    QString m_targetPort;
+
+    // UI Components
+    QVBoxLayout* m_mainLayout;
+    QFormLayout* m_formLayout;
+    QLabel* m_targetLabel;
+    QLineEdit* m_pathEdit;
+    QPushButton* m_browseButton;
+    QComboBox* m_sourceCombo;
+    QComboBox* m_directionCombo;
+    QComboBox* m_timingCombo;
+    QDoubleSpinBox* m_speedSpin;
+    QHBoxLayout* m_buttonLayout;
+    QPushButton* m_cancelButton;
+    QPushButton* m_okButton;
+
+    void setupUi(const QStringList& sourcePorts, const QString& defaultPath);
+};
+
+#endif // REPLAY_DIALOG_H
@@ -1,8 +1,66 @@
 #include "SerialPortSettingsDialog.h"
-#include <QSerialPortInfo>
+#include <QIntValidator>
+#include "HexUtils.h"
+#include "PortInventory.h"
 
-SerialPortSettingsDialog::SerialPortSettingsDialog(QWidget* parent)
+namespace {
+// Length field layouts offered for LengthPrefix framing: size in bytes and byte order
+struct LengthFieldOption {
+    int size;
+    bool bigEndian;
+};
+
+const LengthFieldOption LENGTH_FIELD_OPTIONS[] = {
+    {1, true},
+    {2, true},
+    {2, false},
+    {4, true},
+    {4, false},
+};
+
+// Separates pattern and response of an auto-reply rule; a leading '#' disables the rule
+const QString AUTO_REPLY_ARROW = QStringLiteral("=>");
+const QChar AUTO_REPLY_DISABLED = QLatin1Char('#');
+
+QString formatAutoReplies(const QList<AutoReplyRule>& rules)
+{
+    QStringList lines;
+    for (const AutoReplyRule& rule : rules) {
+        QString line = HexUtils::byteArrayToHexString(rule.pattern()) + " " + AUTO_REPLY_ARROW + " "
+            + HexUtils::byteArrayToHexString(rule.response());
+        lines << (rule.isEnabled() ? line : AUTO_REPLY_DISABLED + line);
+    }
+    return lines.join(QLatin1Char('\n'));
+}
+
+QList<AutoReplyRule> parseAutoReplies(const QString& text)
+{
+    QList<AutoReplyRule> rules;
+    for (QString line : text.split(QLatin1Char('\n'))) {
+        line = line.trimmed();
+        bool enabled = !line.startsWith(AUTO_REPLY_DISABLED);
+        if (!enabled) {
+            line.remove(0, 1);
+        }
+
+        int arrow = line.indexOf(AUTO_REPLY_ARROW);
+        if (arrow < 0) {
+            continue;
+        }
+        AutoReplyRule rule(HexUtils::hexStringToByteArray(line.left(arrow)),
+                           HexUtils::hexStringToByteArray(line.mid(arrow + AUTO_REPLY_ARROW.size())));
+        rule.setEnabled(enabled);
+        if (!rule.pattern().isEmpty()) {
+            rules.append(rule);
+        }
+    }
+    return rules;
+}
+}
+
+SerialPortSettingsDialog::SerialPortSettingsDialog(PortInventory* inventory, QWidget* parent)
     : QDialog(parent)
+    , m_inventory(inventory)
     , m_editMode(false)
 {
     setupUi();
@@ -10,8 +68,9 @@ SerialPortSettingsDialog::SerialPortSettingsDialog(QWidget* parent)
     refreshPorts();
 }
 
-SerialPortSettingsDialog::SerialPortSettingsDialog(const SerialPortInfo& info, QWidget* parent)
+SerialPortSettingsDialog::SerialPortSettingsDialog(PortInventory* inventory, const SerialPortInfo& info, QWidget* parent)
     : QDialog(parent)
+    , m_inventory(inventory)
     , m_info(info)
     , m_editMode(true)
 {
@@ -39,16 +98,23 @@ void SerialPortSettingsDialog::setPortInfo(const SerialPortInfo& info)
 
 void SerialPortSettingsDialog::refreshPorts()
 {
-    QString currentPort = m_portCombo->currentText();
+    // Typed-in names (loopback, network) survive a refresh
+    QString typedName = m_portCombo->isEditable() ? m_portCombo->currentText() : QString();
+    QString currentPort = m_portCombo->currentData().toString();
     m_portCombo->clear();
     
-    const auto ports = QSerialPortInfo::availablePorts();
+    const auto ports = m_inventory->ports();
     for (const auto& port : ports) {
-        QString displayText = port.portName();
-        if (!port.description().isEmpty()) {
-            displayText += " - " + port.description();
+        QString displayText = port.portName;
+        if (!port.description.isEmpty()) {
+            displayText += " - " + port.description;
         }
-        m_portCombo->addItem(displayText, port.portName());
+        m_portCombo->addItem(displayText, port.portName);
+    }
+    
+    if (m_portCombo->isEditable()) {
+        m_portCombo->setEditText(typedName);
+        return;
     }
     
     // Restore selection if possible
@@ -65,7 +131,8 @@ void SerialPortSettingsDialog::refreshPorts()
 
 void SerialPortSettingsDialog::onRefreshClicked()
 {
-    refreshPorts();
+    // Explicit full scan; changes arrive through the inventory's signals
+    m_inventory->rescan();
 }
 
 void SerialPortSettingsDialog::onOkClicked()
@@ -79,6 +146,37 @@ void SerialPortSettingsDialog::onCancelClicked()
     reject();
 }
 
+void SerialPortSettingsDialog::onFramingModeChanged()
+{
+    FramingMode mode = static_cast<FramingMode>(m_framingCombo->currentData().toInt());
+    m_delimiterEdit->setEnabled(mode == FramingMode::Delimiter);
+    m_frameLengthSpin->setEnabled(mode == FramingMode::FixedLength);
+    m_lengthFieldCombo->setEnabled(mode == FramingMode::LengthPrefix);
+    m_idleGapSpin->setEnabled(mode == FramingMode::IdleGap);
+    m_coalesceWindowSpin->setEnabled(mode == FramingMode::None);
+    m_coalesceBytesSpin->setEnabled(mode == FramingMode::None);
+}
+
+void SerialPortSettingsDialog::onTransportChanged()
+{
+    TransportType type = static_cast<TransportType>(m_transportCombo->currentData().toInt());
+    bool native = type == TransportType::Termios || type == TransportType::Pty;
+    m_vminSpin->setEnabled(native);
+    m_vtimeSpin->setEnabled(native);
+    m_lowLatencyCheck->setEnabled(type == TransportType::Termios);
+    
+    bool network = TransportConfig(type).isNetwork();
+    m_addressEdit->setEnabled(network);
+    m_remotePortSpin->setEnabled(network && type != TransportType::UnixSocket);
+    m_localPortSpin->setEnabled(type == TransportType::Udp);
+    m_addressEdit->setPlaceholderText(type == TransportType::UnixSocket ? tr("Socket path") : tr("Host or IP address"));
+    
+    // Loopback and network ports have no device to pick, so any name can be typed in
+    bool named = type == TransportType::Pty || network;
+    m_portCombo->setEditable(named);
+    m_refreshButton->setEnabled(!named);
+}
+
 void SerialPortSettingsDialog::setupUi()
 {
     setWindowTitle(m_editMode ? tr("Edit Port Settings") : tr("Add Serial Port"));
@@ -106,21 +204,127 @@ void SerialPortSettingsDialog::setupUi()
     m_refreshButton->setToolTip(tr("Refresh port list"));
     connect(m_refreshButton, &QPushButton::clicked, this, &SerialPortSettingsDialog::onRefreshClicked);
     
+    // Follow devices being plugged in or removed while the dialog is open
+    connect(m_inventory, &PortInventory::portAdded, this, &SerialPortSettingsDialog::refreshPorts);
+    connect(m_inventory, &PortInventory::portRemoved, this, &SerialPortSettingsDialog::refreshPorts);
+    
     portLayout->addWidget(m_portCombo, 1);
     portLayout->addWidget(m_refreshButton);
     
     m_baudRateCombo = new QComboBox(this);
+    // Any rate can be typed in; the native backend applies it exactly
+    m_baudRateCombo->setEditable(true);
+    m_baudRateCombo->setValidator(new QIntValidator(1, 100000000, m_baudRateCombo));
     m_dataBitsCombo = new QComboBox(this);
     m_stopBitsCombo = new QComboBox(this);
     m_parityCombo = new QComboBox(this);
     m_flowControlCombo = new QComboBox(this);
     
+    m_transportCombo = new QComboBox(this);
+    connect(m_transportCombo, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, &SerialPortSettingsDialog::onTransportChanged);
+    
+    m_vminSpin = new QSpinBox(this);
+    m_vminSpin->setRange(0, 255);
+    m_vminSpin->setSuffix(tr(" bytes"));
+    m_vminSpin->setToolTip(tr("Wake up once this many bytes have arrived (VMIN)"));
+    
+    m_vtimeSpin = new QSpinBox(this);
+    m_vtimeSpin->setRange(0, 255);
+    m_vtimeSpin->setSuffix(tr(" x 0.1 s"));
+    m_vtimeSpin->setSpecialValueText(tr("Off"));
+    m_vtimeSpin->setToolTip(tr("Inter-byte timeout (VTIME)"));
+    
+    m_lowLatencyCheck = new QCheckBox(tr("Low latency driver mode"), this);
+    
+    m_addressEdit = new QLineEdit(this);
+    
+    m_remotePortSpin = new QSpinBox(this);
+    m_remotePortSpin->setRange(0, 65535);
+    m_remotePortSpin->setSpecialValueText(tr("None"));
+    
+    m_localPortSpin = new QSpinBox(this);
+    m_localPortSpin->setRange(0, 65535);
+    m_localPortSpin->setSpecialValueText(tr("Any"));
+    m_localPortSpin->setToolTip(tr("UDP port to receive on"));
+    
+    m_framingCombo = new QComboBox(this);
+    connect(m_framingCombo, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, &SerialPortSettingsDialog::onFramingModeChanged);
+    
+    m_delimiterEdit = new QLineEdit(this);
+    m_delimiterEdit->setPlaceholderText(tr("Hex, e.g. 0D 0A"));
+    
+    m_frameLengthSpin = new QSpinBox(this);
+    m_frameLengthSpin->setRange(1, 65536);
+    m_frameLengthSpin->setSuffix(tr(" bytes"));
+    
+    m_lengthFieldCombo = new QComboBox(this);
+    
+    m_idleGapSpin = new QSpinBox(this);
+    m_idleGapSpin->setRange(1, 10000);
+    m_idleGapSpin->setSuffix(tr(" ms"));
+    
+    m_coalesceWindowSpin = new QSpinBox(this);
+    m_coalesceWindowSpin->setRange(0, 1000);
+    m_coalesceWindowSpin->setSuffix(tr(" ms"));
+    m_coalesceWindowSpin->setSpecialValueText(tr("Off"));
+    
+    m_coalesceBytesSpin = new QSpinBox(this);
+    m_coalesceBytesSpin->setRange(0, 1048576);
+    m_coalesceBytesSpin->setSuffix(tr(" bytes"));
+    m_coalesceBytesSpin->setSpecialValueText(tr("No limit"));
+    
+    m_decoderCombo = new QComboBox(this);
+    m_decoderCombo->setToolTip(tr("Protocol shown in the Decoded view"));
+    
+    m_interByteDelaySpin = new QSpinBox(this);
+    m_interByteDelaySpin->setRange(0, 1000000);
+    m_interByteDelaySpin->setSuffix(tr(" us"));
+    
+    m_interFrameGapSpin = new QSpinBox(this);
+    m_interFrameGapSpin->setRange(0, 10000000);
+    m_interFrameGapSpin->setSuffix(tr(" us"));
+    
+    m_maxUtilizationSpin = new QSpinBox(this);
+    m_maxUtilizationSpin->setRange(1, 100);
+    m_maxUtilizationSpin->setSuffix(tr(" %"));
+    
+    m_autoReconnectCheck = new QCheckBox(tr("Reconnect automatically"), this);
+    m_autoReconnectCheck->setToolTip(tr("Reopen the port with increasing delays after it was unplugged or dropped"));
+    
+    m_autoRepliesEdit = new QPlainTextEdit(this);
+    m_autoRepliesEdit->setPlaceholderText(tr("One rule per line in hex, e.g. 41 54 0D => 4F 4B 0D"));
+    m_autoRepliesEdit->setToolTip(tr("Sends the response whenever the pattern is received; start a line with # to disable it"));
+    m_autoRepliesEdit->setLineWrapMode(QPlainTextEdit::NoWrap);
+    m_autoRepliesEdit->setFixedHeight(80);
+    
     m_formLayout->addRow(tr("Port:"), portWidget);
     m_formLayout->addRow(tr("Baud Rate:"), m_baudRateCombo);
     m_formLayout->addRow(tr("Data Bits:"), m_dataBitsCombo);
     m_formLayout->addRow(tr("Stop Bits:"), m_stopBitsCombo);
     m_formLayout->addRow(tr("Parity:"), m_parityCombo);
     m_formLayout->addRow(tr("Flow Control:"), m_flowControlCombo);
+    m_formLayout->addRow(tr("Backend:"), m_transportCombo);
+    m_formLayout->addRow(tr("Wake Threshold:"), m_vminSpin);
+    m_formLayout->addRow(tr("Byte Timeout:"), m_vtimeSpin);
+    m_formLayout->addRow(QString(), m_lowLatencyCheck);
+    m_formLayout->addRow(tr("Address:"), m_addressEdit);
+    m_formLayout->addRow(tr("Remote Port:"), m_remotePortSpin);
+    m_formLayout->addRow(tr("Local Port:"), m_localPortSpin);
+    m_formLayout->addRow(tr("Framing:"), m_framingCombo);
+    m_formLayout->addRow(tr("Delimiter:"), m_delimiterEdit);
+    m_formLayout->addRow(tr("Frame Length:"), m_frameLengthSpin);
+    m_formLayout->addRow(tr("Length Field:"), m_lengthFieldCombo);
+    m_formLayout->addRow(tr("Idle Gap:"), m_idleGapSpin);
+    m_formLayout->addRow(tr("Merge Window:"), m_coalesceWindowSpin);
+    m_formLayout->addRow(tr("Merge Limit:"), m_coalesceBytesSpin);
+    m_formLayout->addRow(tr("Decoder:"), m_decoderCombo);
+    m_formLayout->addRow(tr("Byte Delay:"), m_interByteDelaySpin);
+    m_formLayout->addRow(tr("Frame Gap:"), m_interFrameGapSpin);
+    m_formLayout->addRow(tr("Max Line Usage:"), m_maxUtilizationSpin);
+    m_formLayout->addRow(QString(), m_autoReconnectCheck);
+    m_formLayout->addRow(tr("Auto Replies:"), m_autoRepliesEdit);
     
     m_buttonLayout = new QHBoxLayout();
     m_buttonLayout->setSpacing(10);
@@ -178,6 +382,67 @@ void SerialPortSettingsDialog::populateCombos()
     m_flowControlCombo->addItem(tr("Hardware (RTS/CTS)"), QSerialPort::HardwareControl);
     m_flowControlCombo->addItem(tr("Software (XON/XOFF)"), QSerialPort::SoftwareControl);
     m_flowControlCombo->setCurrentIndex(0);
+    
+    // Transport backends available in this build
+    m_transportCombo->addItem(tr("Qt Serial Port"), static_cast<int>(TransportType::QtSerialPort));
+    if (TransportConfig::isSupported(TransportType::Termios)) {
+        m_transportCombo->addItem(tr("Native (termios2)"), static_cast<int>(TransportType::Termios));
+    }
+    if (TransportConfig::isSupported(TransportType::Pty)) {
+        m_transportCombo->addItem(tr("Pseudo Terminal (Loopback)"), static_cast<int>(TransportType::Pty));
+    }
+    m_transportCombo->addItem(tr("TCP"), static_cast<int>(TransportType::Tcp));
+    m_transportCombo->addItem(tr("RFC 2217 (Telnet)"), static_cast<int>(TransportType::Rfc2217));
+    m_transportCombo->addItem(tr("UDP"), static_cast<int>(TransportType::Udp));
+    m_transportCombo->addItem(tr("Unix Socket"), static_cast<int>(TransportType::UnixSocket));
+    TransportConfig transport;
+    m_transportCombo->setCurrentIndex(0);
+    m_vminSpin->setValue(transport.vmin());
+    m_vtimeSpin->setValue(transport.vtime());
+    m_lowLatencyCheck->setChecked(transport.lowLatency());
+    m_remotePortSpin->setValue(transport.port());
+    m_localPortSpin->setValue(transport.localPort());
+    onTransportChanged();
+    
+    // Framing
+    m_framingCombo->addItem(tr("None"), static_cast<int>(FramingMode::None));
+    m_framingCombo->addItem(tr("Delimiter"), static_cast<int>(FramingMode::Delimiter));
+    m_framingCombo->addItem(tr("Fixed Length"), static_cast<int>(FramingMode::FixedLength));
+    m_framingCombo->addItem(tr("Length Prefix"), static_cast<int>(FramingMode::LengthPrefix));
+    m_framingCombo->addItem(tr("Idle Gap"), static_cast<int>(FramingMode::IdleGap));
+    m_framingCombo->addItem(tr("SLIP"), static_cast<int>(FramingMode::Slip));
+    m_framingCombo->addItem(tr("COBS"), static_cast<int>(FramingMode::Cobs));
+    
+    m_lengthFieldCombo->addItem(tr("1 byte"));
+    m_lengthFieldCombo->addItem(tr("2 bytes, big-endian"));
+    m_lengthFieldCombo->addItem(tr("2 bytes, little-endian"));
+    m_lengthFieldCombo->addItem(tr("4 bytes, big-endian"));
+    m_lengthFieldCombo->addItem(tr("4 bytes, little-endian"));
+    
+    FramingConfig defaults;
+    m_framingCombo->setCurrentIndex(0);
+    m_delimiterEdit->setText(HexUtils::byteArrayToHexString(defaults.delimiter()));
+    m_frameLengthSpin->setValue(defaults.frameLength());
+    m_lengthFieldCombo->setCurrentIndex(0);
+    m_idleGapSpin->setValue(defaults.idleGapMs());
+    m_coalesceWindowSpin->setValue(0);
+    m_coalesceBytesSpin->setValue(0);
+    onFramingModeChanged();
+    
+    // Protocol decoder
+    m_decoderCombo->addItem(tr("None"), static_cast<int>(DecoderType::None));
+    m_decoderCombo->addItem(tr("Modbus RTU"), static_cast<int>(DecoderType::ModbusRtu));
+    m_decoderCombo->addItem(tr("NMEA 0183"), static_cast<int>(DecoderType::Nmea0183));
+    m_decoderCombo->addItem(tr("SLIP"), static_cast<int>(DecoderType::Slip));
+    m_decoderCombo->setCurrentIndex(0);
+    
+    // Transmit pacing
+    PacingConfig pacing;
+    m_interByteDelaySpin->setValue(pacing.interByteDelayUs());
+    m_interFrameGapSpin->setValue(pacing.interFrameGapUs());
+    m_maxUtilizationSpin->setValue(pacing.maxUtilization());
+    
+    m_autoReconnectCheck->setChecked(true);
 }
 
 void SerialPortSettingsDialog::loadSettings()
@@ -192,6 +457,8 @@ void SerialPortSettingsDialog::loadSettings()
     int baudIndex = m_baudRateCombo->findData(m_info.baudRate());
     if (baudIndex >= 0) {
         m_baudRateCombo->setCurrentIndex(baudIndex);
+    } else {
+        m_baudRateCombo->setEditText(QString::number(m_info.baudRate()));
     }
     
     // Data bits
@@ -217,14 +484,108 @@ void SerialPortSettingsDialog::loadSettings()
     if (flowIndex >= 0) {
         m_flowControlCombo->setCurrentIndex(flowIndex);
     }
+    
+    // Transport
+    TransportConfig transport = m_info.transport();
+    int transportIndex = m_transportCombo->findData(static_cast<int>(transport.type()));
+    if (transportIndex >= 0) {
+        m_transportCombo->setCurrentIndex(transportIndex);
+    }
+    m_vminSpin->setValue(transport.vmin());
+    m_vtimeSpin->setValue(transport.vtime());
+    m_lowLatencyCheck->setChecked(transport.lowLatency());
+    m_addressEdit->setText(transport.address());
+    m_remotePortSpin->setValue(transport.port());
+    m_localPortSpin->setValue(transport.localPort());
+    onTransportChanged();
+    if (m_portCombo->isEditable()) {
+        m_portCombo->setEditText(m_info.portName());
+    }
+    
+    // Framing
+    FramingConfig framing = m_info.framing();
+    int framingIndex = m_framingCombo->findData(static_cast<int>(framing.mode()));
+    if (framingIndex >= 0) {
+        m_framingCombo->setCurrentIndex(framingIndex);
+    }
+    m_delimiterEdit->setText(HexUtils::byteArrayToHexString(framing.delimiter()));
+    m_frameLengthSpin->setValue(framing.frameLength());
+    for (int i = 0; i < m_lengthFieldCombo->count(); ++i) {
+        if (LENGTH_FIELD_OPTIONS[i].size == framing.lengthSize()
+            && LENGTH_FIELD_OPTIONS[i].bigEndian == framing.lengthBigEndian()) {
+            m_lengthFieldCombo->setCurrentIndex(i);
+            break;
+        }
+    }
+    m_idleGapSpin->setValue(framing.idleGapMs());
+    m_coalesceWindowSpin->setValue(m_info.coalesceWindowMs());
+    m_coalesceBytesSpin->setValue(m_info.coalesceMaxBytes());
+    onFramingModeChanged();
+    
+    int decoderIndex = m_decoderCombo->findData(static_cast<int>(m_info.decoder()));
+    if (decoderIndex >= 0) {
+        m_decoderCombo->setCurrentIndex(decoderIndex);
+    }
+    
+    // Transmit pacing
+    PacingConfig pacing = m_info.pacing();
+    m_interByteDelaySpin->setValue(pacing.interByteDelayUs());
+    m_interFrameGapSpin->setValue(pacing.interFrameGapUs());
+    m_maxUtilizationSpin->setValue(pacing.maxUtilization());
+    
+    m_autoReconnectCheck->setChecked(m_info.autoReconnect());
+    m_autoRepliesEdit->setPlainText(formatAutoReplies(m_info.autoReplies()));
 }
 
 void SerialPortSettingsDialog::saveSettings()
 {
-    m_info.setPortName(m_portCombo->currentData().toString());
-    m_info.setBaudRate(m_baudRateCombo->currentData().toInt());
+    TransportConfig transport(static_cast<TransportType>(m_transportCombo->currentData().toInt()));
+    transport.setVmin(m_vminSpin->value());
+    transport.setVtime(m_vtimeSpin->value());
+    transport.setLowLatency(m_lowLatencyCheck->isChecked());
+    transport.setAddress(m_addressEdit->text().trimmed());
+    transport.setPort(m_remotePortSpin->value());
+    transport.setLocalPort(m_localPortSpin->value());
+    m_info.setTransport(transport);
+    
+    // Loopback and network names are typed in; real ports come from the list
+    if (m_portCombo->isEditable()) {
+        m_info.setPortName(m_portCombo->currentText().trimmed());
+        if (m_info.portName().isEmpty() && transport.isNetwork()) {
+            m_info.setPortName(transport.endpoint());
+        }
+    } else {
+        m_info.setPortName(m_portCombo->currentData().toString());
+    }
+    m_info.setBaudRate(m_baudRateCombo->currentText().toInt());
     m_info.setDataBits(static_cast<QSerialPort::DataBits>(m_dataBitsCombo->currentData().toInt()));
     m_info.setStopBits(static_cast<QSerialPort::StopBits>(m_stopBitsCombo->currentData().toInt()));
     m_info.setParity(static_cast<QSerialPort::Parity>(m_parityCombo->currentData().toInt()));
     m_info.setFlowControl(static_cast<QSerialPort::FlowControl>(m_flowControlCombo->currentData().toInt()));
+    
+    // Framing; parameters of other modes are kept as they were
+    FramingConfig framing = m_info.framing();
+    framing.setMode(static_cast<FramingMode>(m_framingCombo->currentData().toInt()));
+    QByteArray delimiter = HexUtils::hexStringToByteArray(m_delimiterEdit->text());
+    if (!delimiter.isEmpty()) {
+        framing.setDelimiter(delimiter);
+    }
+    framing.setFrameLength(m_frameLengthSpin->value());
+    const LengthFieldOption& lengthField = LENGTH_FIELD_OPTIONS[m_lengthFieldCombo->currentIndex()];
+    framing.setLengthSize(lengthField.size);
+    framing.setLengthBigEndian(lengthField.bigEndian);
+    framing.setIdleGapMs(m_idleGapSpin->value());
+    m_info.setFraming(framing);
+    m_info.setCoalesceWindowMs(m_coalesceWindowSpin->value());
+    m_info.setCoalesceMaxBytes(m_coalesceBytesSpin->value());
+    m_info.setDecoder(static_cast<DecoderType>(m_decoderCombo->currentData().toInt()));
+    
+    PacingConfig pacing;
+    pacing.setInterByteDelayUs(m_interByteDelaySpin->value());
+    pacing.setInterFrameGapUs(m_interFrameGapSpin->value());
+    pacing.setMaxUtilization(m_maxUtilizationSpin->value());
+    m_info.setPacing(pacing);
+    
+    m_info.setAutoReconnect(m_autoReconnectCheck->isChecked());
+    m_info.setAutoReplies(parseAutoReplies(m_autoRepliesEdit->toPlainText()));
 }
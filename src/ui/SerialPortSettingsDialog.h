@@ -8,17 +8,26 @@
 #include <QComboBox>
 #include <QPushButton>
 #include <QLabel>
+#include <QLineEdit>
+#include <QSpinBox>
+#include <QCheckBox>
+#include <QPlainTextEdit>
 #include "SerialPortInfo.h"
 
+class PortInventory;
+
 /**
  * @brief Dialog for configuring serial port settings
+ *
+ * The port list comes from the application's PortInventory and follows
+ * hot-plug changes while the dialog is open; opening it does not scan.
  */
 class SerialPortSettingsDialog : public QDialog {
     Q_OBJECT
 
 public:
-    explicit SerialPortSettingsDialog(QWidget* parent = nullptr);
-    explicit SerialPortSettingsDialog(const SerialPortInfo& info, QWidget* parent = nullptr);
+    explicit SerialPortSettingsDialog(PortInventory* inventory, QWidget* parent = nullptr);
+    SerialPortSettingsDialog(PortInventory* inventory, const SerialPortInfo& info, QWidget* parent = nullptr);
     ~SerialPortSettingsDialog() override;
     
     // Get the configured settings
@@ -27,15 +36,18 @@ public:
     // Set initial values
     void setPortInfo(const SerialPortInfo& info);
     
-    // Refresh available ports
+    // Refill the port list from the inventory
     void refreshPorts();
 
 private slots:
     void onRefreshClicked();
     void onOkClicked();
     void onCancelClicked();
+    void onFramingModeChanged();
+    void onTransportChanged();
 
 private:
+    PortInventory* m_inventory;
     SerialPortInfo m_info;
     bool m_editMode;
     
@@ -51,6 +63,37 @@ private:
     QComboBox* m_parityCombo;
     QComboBox* m_flowControlCombo;
     
+    // Transport backend
+    QComboBox* m_transportCombo;
+    QSpinBox* m_vminSpin;
+    QSpinBox* m_vtimeSpin;
+    QCheckBox* m_lowLatencyCheck;
+    QLineEdit* m_addressEdit;
+    QSpinBox* m_remotePortSpin;
+    QSpinBox* m_localPortSpin;
+    
+    // Framing
+    QComboBox* m_framingCombo;
+    QLineEdit* m_delimiterEdit;
+    QSpinBox* m_frameLengthSpin;
+    QComboBox* m_lengthFieldCombo;
+    QSpinBox* m_idleGapSpin;
+    QSpinBox* m_coalesceWindowSpin;
+    QSpinBox* m_coalesceBytesSpin;
+    
+    // Protocol decoder
+    QComboBox* m_decoderCombo;
+    
+    // Transmit pacing
+    QSpinBox* m_interByteDelaySpin;
+    QSpinBox* m_interFrameGapSpin;
+    QSpinBox* m_maxUtilizationSpin;
+    
+    QCheckBox* m_autoReconnectCheck;
+    
+    // Auto replies, one "pattern => response" rule per line
+    QPlainTextEdit* m_autoRepliesEdit;
+    
     QHBoxLayout* m_buttonLayout;
     QPushButton* m_okButton;
     QPushButton* m_cancelButton;
@@ -0,0 +1,86 @@
+#include "AhoCorasick.h"
+
+namespace {
+const int ALPHABET = 256;
+}
+
+AhoCorasick::AhoCorasick()
+    : m_built(false)
+{
+    build();
+}
+
+int AhoCorasick::addPattern(const QByteArray& pattern)
+{
+    if (pattern.isEmpty()) {
+        return -1;
+    }
+    m_patterns.append(pattern);
+    m_built = false;
+    return m_patterns.size() - 1;
+}
+
+void AhoCorasick::clear()
+{
+    m_patterns.clear();
+    build();
+}
+
+void AhoCorasick::build()
+{
+    m_next.assign(ALPHABET, -1);
+    m_terminal.assign(1, -1);
+    m_output.assign(1, ROOT);
+    m_samePattern.assign(static_cast<size_t>(m_patterns.size()), -1);
+
+    // Trie of all patterns; -1 marks a missing edge until the BFS below fills it in
+    for (int p = 0; p < m_patterns.size(); ++p) {
+        int state = ROOT;
+        for (char c : m_patterns.at(p)) {
+            size_t edge = static_cast<size_t>(state) * ALPHABET + static_cast<uchar>(c);
+            if (m_next[edge] < 0) {
+                m_next[edge] = static_cast<int>(m_terminal.size());
+                m_next.resize(m_next.size() + ALPHABET, -1);
+                m_terminal.push_back(-1);
+                m_output.push_back(ROOT);
+            }
+            state = m_next[edge];
+        }
+
+        // Keep equal patterns in a list, in the order they were added
+        int* last = &m_terminal[static_cast<size_t>(state)];
+        while (*last >= 0) {
+            last = &m_samePattern[static_cast<size_t>(*last)];
+        }
+        *last = p;
+    }
+
+    // Breadth first, so the failure state of a node is complete before the node itself
+    std::vector<int> failure(m_terminal.size(), ROOT);
+    std::vector<int> queue;
+    queue.reserve(m_terminal.size());
+    queue.push_back(ROOT);
+    for (size_t head = 0; head < queue.size(); ++head) {
+        int state = queue[head];
+        size_t row = static_cast<size_t>(state) * ALPHABET;
+        size_t failureRow = static_cast<size_t>(failure[static_cast<size_t>(state)]) * ALPHABET;
+
+        for (int c = 0; c < ALPHABET; ++c) {
+            int child = m_next[row + c];
+            if (child < 0) {
+                // Missing edges continue where the longest matching suffix would
+                m_next[row + c] = state == ROOT ? ROOT : m_next[failureRow + c];
+                continue;
+            }
+
+            int childFailure = state == ROOT ? ROOT : m_next[failureRow + c];
+            failure[static_cast<size_t>(child)] = childFailure;
+            m_output[static_cast<size_t>(child)] = m_terminal[static_cast<size_t>(childFailure)] >= 0
+                ? childFailure
+                : m_output[static_cast<size_t>(childFailure)];
+            queue.push_back(child);
+        }
+    }
+
+    m_built = true;
+}
@@ -0,0 +1,68 @@
+#ifndef AHO_CORASICK_H
+#define AHO_CORASICK_H
+
+#include <QByteArray>
+#include <QList>
+#include <vector>
+
+/**
+ * @brief Finds many byte patterns in a stream in a single pass
+ *
+ * The patterns are compiled by build() into an Aho-Corasick automaton
+ * with a full 256-entry transition table per state, so scanning costs one
+ * table lookup per byte however many patterns there are. All occurrences
+ * are reported, including overlapping ones and patterns that end inside
+ * other patterns.
+ *
+ * The automaton itself is immutable after build(); the position in the
+ * stream is a plain state number owned by the caller. Passing the state
+ * returned by one scan() to the next lets a match span any number of
+ * chunks.
+ *
+ * Not thread-safe while building; scan() may run on several threads.
+ */
+class AhoCorasick {
+public:
+    static constexpr int ROOT = 0;
+
+    AhoCorasick();
+
+    // Empty patterns are ignored and get -1; the index counts the accepted patterns
+    int addPattern(const QByteArray& pattern);
+    void clear();
+    void build();
+
+    bool isBuilt() const { return m_built; }
+    int patternCount() const { return m_patterns.size(); }
+    QByteArray pattern(int index) const { return m_patterns.at(index); }
+    int stateCount() const { return static_cast<int>(m_terminal.size()); }
+
+    // Feeds bytes from `state` and returns the state after them; calls
+    // onMatch(patternIndex, endOffset) for each pattern ending at data[endOffset - 1]
+    template <typename Callback>
+    int scan(int state, const char* data, int size, Callback onMatch) const
+    {
+        for (int i = 0; i < size; ++i) {
+            state = m_next[static_cast<size_t>(state) * 256 + static_cast<uchar>(data[i])];
+
+            // The root is never terminal, so 0 ends the chain of output links
+            for (int s = m_terminal[state] >= 0 ? state : m_output[state]; s != ROOT; s = m_output[s]) {
+                for (int p = m_terminal[s]; p >= 0; p = m_samePattern[p]) {
+                    onMatch(p, i + 1);
+                }
+            }
+        }
+        return state;
+    }
+
+private:
+    QList<QByteArray> m_patterns;
+    bool m_built;
+
+    std::vector<int> m_next;        // state * 256 + byte -> state
+    std::vector<int> m_terminal;    // First pattern ending at a state, -1 if none
+    std::vector<int> m_output;      // Nearest proper suffix state that is terminal, ROOT if none
+    std::vector<int> m_samePattern; // Next pattern equal to this one, -1 if none
+};
+
+#endif // AHO_CORASICK_H
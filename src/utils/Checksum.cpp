@@ -0,0 +1,344 @@
+#include "Checksum.h"
+#include <QtEndian>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define CHECKSUM_HAVE_PCLMUL
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+namespace {
+const int SLICES = 8;
+
+// Bit-reflected polynomials
+const quint16 CRC16_MODBUS_POLY = 0xA001;
+const quint32 CRC32_POLY = 0xEDB88320;
+
+const quint8 CRC8_POLY = 0x07;
+
+// Below this the folding setup costs more than it saves
+const qint64 PCLMUL_MIN_SIZE = 64;
+
+// tables[k][v]: CRC register after byte v followed by k zero bytes
+template <typename T>
+struct CrcTables {
+    T tables[SLICES][256];
+};
+
+template <typename T>
+CrcTables<T> makeReflectedTables(T poly)
+{
+    CrcTables<T> t;
+    for (int v = 0; v < 256; ++v) {
+        T crc = static_cast<T>(v);
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc & 1) ? static_cast<T>((crc >> 1) ^ poly) : static_cast<T>(crc >> 1);
+        }
+        t.tables[0][v] = crc;
+    }
+    for (int k = 1; k < SLICES; ++k) {
+        for (int v = 0; v < 256; ++v) {
+            T previous = t.tables[k - 1][v];
+            t.tables[k][v] = static_cast<T>((previous >> 8) ^ t.tables[0][previous & 0xFF]);
+        }
+    }
+    return t;
+}
+
+CrcTables<quint8> makeCrc8Tables()
+{
+    CrcTables<quint8> t;
+    for (int v = 0; v < 256; ++v) {
+        quint8 crc = static_cast<quint8>(v);
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc & 0x80) ? static_cast<quint8>((crc << 1) ^ CRC8_POLY) : static_cast<quint8>(crc << 1);
+        }
+        t.tables[0][v] = crc;
+    }
+    for (int k = 1; k < SLICES; ++k) {
+        for (int v = 0; v < 256; ++v) {
+            t.tables[k][v] = t.tables[0][t.tables[k - 1][v]];
+        }
+    }
+    return t;
+}
+
+const CrcTables<quint8>& crc8Tables()
+{
+    static const CrcTables<quint8> tables = makeCrc8Tables();
+    return tables;
+}
+
+const CrcTables<quint16>& crc16ModbusTables()
+{
+    static const CrcTables<quint16> tables = makeReflectedTables<quint16>(CRC16_MODBUS_POLY);
+    return tables;
+}
+
+const CrcTables<quint32>& crc32Tables()
+{
+    static const CrcTables<quint32> tables = makeReflectedTables<quint32>(CRC32_POLY);
+    return tables;
+}
+
+// Slicing-by-8 for reflected CRCs of up to 32 bits
+template <typename T>
+T reflectedCrc(const CrcTables<T>& tables, const uchar* p, qint64 size, T crc)
+{
+    const auto& t = tables.tables;
+    while (size >= SLICES) {
+        quint32 one = qFromLittleEndian<quint32>(p) ^ crc;
+        quint32 two = qFromLittleEndian<quint32>(p + 4);
+        crc = static_cast<T>(t[7][one & 0xFF] ^ t[6][(one >> 8) & 0xFF] ^ t[5][(one >> 16) & 0xFF] ^ t[4][one >> 24]
+                             ^ t[3][two & 0xFF] ^ t[2][(two >> 8) & 0xFF] ^ t[1][(two >> 16) & 0xFF]
+                             ^ t[0][two >> 24]);
+        p += SLICES;
+        size -= SLICES;
+    }
+    while (size-- > 0) {
+        crc = static_cast<T>((crc >> 8) ^ t[0][(crc ^ *p++) & 0xFF]);
+    }
+    return crc;
+}
+
+#ifdef CHECKSUM_HAVE_PCLMUL
+// Folds 64-byte blocks into four 128-bit lanes, then reduces to 32 bits (Barrett).
+// Takes and returns the CRC register (inverted form); size must be >= 64 and a multiple of 16.
+__attribute__((target("pclmul,sse4.1"))) quint32 crc32Pclmul(const uchar* p, qint64 size, quint32 crc)
+{
+    // x^(4*128+64) mod P, x^(4*128) mod P, x^(128+64) mod P, x^128 mod P, x^64 mod P, bit-reflected and shifted
+    alignas(16) static const quint64 k1k2[] = {0x0154442bd4ULL, 0x01c6e41596ULL};
+    alignas(16) static const quint64 k3k4[] = {0x01751997d0ULL, 0x00ccaa009eULL};
+    alignas(16) static const quint64 k5k0[] = {0x0163cd6124ULL, 0x0000000000ULL};
+    // P(x) and the Barrett constant mu = x^64 / P(x), bit-reflected
+    alignas(16) static const quint64 poly[] = {0x01db710641ULL, 0x01f7011641ULL};
+
+    __m128i x1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    __m128i x2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16));
+    __m128i x3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 32));
+    __m128i x4 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 48));
+    x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128(static_cast<int>(crc)));
+    p += 64;
+    size -= 64;
+
+    __m128i k = _mm_load_si128(reinterpret_cast<const __m128i*>(k1k2));
+    while (size >= 64) {
+        __m128i x5 = _mm_clmulepi64_si128(x1, k, 0x00);
+        __m128i x6 = _mm_clmulepi64_si128(x2, k, 0x00);
+        __m128i x7 = _mm_clmulepi64_si128(x3, k, 0x00);
+        __m128i x8 = _mm_clmulepi64_si128(x4, k, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, k, 0x11);
+        x2 = _mm_clmulepi64_si128(x2, k, 0x11);
+        x3 = _mm_clmulepi64_si128(x3, k, 0x11);
+        x4 = _mm_clmulepi64_si128(x4, k, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+        x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16)));
+        x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 32)));
+        x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 48)));
+        p += 64;
+        size -= 64;
+    }
+
+    // Four lanes into one
+    k = _mm_load_si128(reinterpret_cast<const __m128i*>(k3k4));
+    const __m128i lanes[] = {x2, x3, x4};
+    for (const __m128i& lane : lanes) {
+        __m128i x5 = _mm_clmulepi64_si128(x1, k, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, k, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, lane), x5);
+    }
+
+    // Remaining 16-byte blocks
+    while (size >= 16) {
+        __m128i x5 = _mm_clmulepi64_si128(x1, k, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, k, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, _mm_loadu_si128(reinterpret_cast<const __m128i*>(p))), x5);
+        p += 16;
+        size -= 16;
+    }
+
+    // 128 bits to 64
+    __m128i mask = _mm_setr_epi32(~0, 0, ~0, 0);
+    __m128i x5 = _mm_clmulepi64_si128(x1, k, 0x10);
+    x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x5);
+    k = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(k5k0));
+    x5 = _mm_srli_si128(x1, 4);
+    x1 = _mm_and_si128(x1, mask);
+    x1 = _mm_xor_si128(_mm_clmulepi64_si128(x1, k, 0x00), x5);
+
+    // Barrett reduction to 32 bits
+    k = _mm_load_si128(reinterpret_cast<const __m128i*>(poly));
+    x5 = _mm_and_si128(x1, mask);
+    x5 = _mm_clmulepi64_si128(x5, k, 0x10);
+    x5 = _mm_and_si128(x5, mask);
+    x5 = _mm_clmulepi64_si128(x5, k, 0x00);
+    x1 = _mm_xor_si128(x1, x5);
+    return static_cast<quint32>(_mm_extract_epi32(x1, 1));
+}
+
+bool detectPclmul()
+{
+    unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+        return false;
+    }
+    return (ecx & bit_PCLMUL) && (ecx & bit_SSE4_1);
+}
+#endif
+}
+
+quint8 Checksum::xor8(const char* data, qint64 size, quint8 value)
+{
+    // Eight bytes per step; the compiler vectorizes this further
+    const uchar* p = reinterpret_cast<const uchar*>(data);
+    quint64 wide = 0;
+    for (; size >= 8; p += 8, size -= 8) {
+        wide ^= qFromUnaligned<quint64>(p);
+    }
+    for (int shift = 0; shift < 64; shift += 8) {
+        value ^= static_cast<quint8>(wide >> shift);
+    }
+    while (size-- > 0) {
+        value ^= *p++;
+    }
+    return value;
+}
+
+quint8 Checksum::lrc8(const char* data, qint64 size, quint8 value)
+{
+    const uchar* p = reinterpret_cast<const uchar*>(data);
+    quint32 sum = 0;
+    while (size-- > 0) {
+        sum += *p++;
+    }
+    return static_cast<quint8>(value - sum);
+}
+
+quint8 Checksum::crc8(const char* data, qint64 size, quint8 crc)
+{
+    const auto& t = crc8Tables().tables;
+    const uchar* p = reinterpret_cast<const uchar*>(data);
+    while (size >= SLICES) {
+        crc = t[7][p[0] ^ crc] ^ t[6][p[1]] ^ t[5][p[2]] ^ t[4][p[3]]
+            ^ t[3][p[4]] ^ t[2][p[5]] ^ t[1][p[6]] ^ t[0][p[7]];
+        p += SLICES;
+        size -= SLICES;
+    }
+    while (size-- > 0) {
+        crc = t[0][crc ^ *p++];
+    }
+    return crc;
+}
+
+quint16 Checksum::crc16Modbus(const char* data, qint64 size, quint16 crc)
+{
+    return reflectedCrc(crc16ModbusTables(), reinterpret_cast<const uchar*>(data), size, crc);
+}
+
+quint32 Checksum::crc32(const char* data, qint64 size, quint32 crc)
+{
+#ifdef CHECKSUM_HAVE_PCLMUL
+    if (size >= PCLMUL_MIN_SIZE && hasAcceleratedCrc32()) {
+        const uchar* p = reinterpret_cast<const uchar*>(data);
+        qint64 folded = size & ~qint64(15);
+        quint32 state = crc32Pclmul(p, folded, ~crc);
+        return ~reflectedCrc(crc32Tables(), p + folded, size - folded, state);
+    }
+#endif
+    return crc32Portable(data, size, crc);
+}
+
+quint32 Checksum::crc32Portable(const char* data, qint64 size, quint32 crc)
+{
+    return ~reflectedCrc(crc32Tables(), reinterpret_cast<const uchar*>(data), size, ~crc);
+}
+
+bool Checksum::hasAcceleratedCrc32()
+{
+#ifdef CHECKSUM_HAVE_PCLMUL
+    static const bool supported = detectPclmul();
+    return supported;
+#else
+    return false;
+#endif
+}
+
+int Checksum::size(ChecksumType type)
+{
+    switch (type) {
+    case ChecksumType::None:
+        return 0;
+    case ChecksumType::Xor8:
+    case ChecksumType::Lrc8:
+    case ChecksumType::Crc8:
+        return 1;
+    case ChecksumType::Crc16Modbus:
+        return 2;
+    case ChecksumType::Crc32:
+        return 4;
+    }
+    return 0;
+}
+
+QByteArray Checksum::compute(ChecksumType type, const QByteArray& data)
+{
+    QByteArray result(size(type), Qt::Uninitialized);
+    uchar* out = reinterpret_cast<uchar*>(result.data());
+    switch (type) {
+    case ChecksumType::None:
+        break;
+    case ChecksumType::Xor8:
+        out[0] = xor8(data.constData(), data.size());
+        break;
+    case ChecksumType::Lrc8:
+        out[0] = lrc8(data.constData(), data.size());
+        break;
+    case ChecksumType::Crc8:
+        out[0] = crc8(data.constData(), data.size());
+        break;
+    case ChecksumType::Crc16Modbus:
+        qToLittleEndian(crc16Modbus(data.constData(), data.size()), out);
+        break;
+    case ChecksumType::Crc32:
+        qToLittleEndian(crc32(data.constData(), data.size()), out);
+        break;
+    }
+    return result;
+}
+
+QByteArray Checksum::append(ChecksumType type, const QByteArray& data)
+{
+    if (type == ChecksumType::None) {
+        return data;
+    }
+    return data + compute(type, data);
+}
+
+bool Checksum::verify(ChecksumType type, const QByteArray& frame)
+{
+    int length = size(type);
+    if (frame.size() < length) {
+        return false;
+    }
+    QByteArray payload = QByteArray::fromRawData(frame.constData(), frame.size() - length);
+    return frame.endsWith(compute(type, payload));
+}
+
+QString Checksum::name(ChecksumType type)
+{
+    switch (type) {
+    case ChecksumType::None:
+        return QStringLiteral("None");
+    case ChecksumType::Xor8:
+        return QStringLiteral("XOR");
+    case ChecksumType::Lrc8:
+        return QStringLiteral("LRC");
+    case ChecksumType::Crc8:
+        return QStringLiteral("CRC-8");
+    case ChecksumType::Crc16Modbus:
+        return QStringLiteral("CRC-16/Modbus");
+    case ChecksumType::Crc32:
+        return QStringLiteral("CRC-32");
+    }
+    return QString();
+}
@@ -0,0 +1,55 @@
+#ifndef CHECKSUM_H
+#define CHECKSUM_H
+
+#include <QByteArray>
+#include <QString>
+
+/**
+ * @brief Checksums appended to frames by common serial protocols
+ */
+enum class ChecksumType {
+    None,
+    Xor8,           // XOR of all bytes (NMEA and many simple protocols)
+    Lrc8,           // Two's complement of the byte sum (Modbus ASCII LRC)
+    Crc8,           // CRC-8/SMBUS: poly 0x07, init 0x00
+    Crc16Modbus,    // CRC-16/MODBUS: poly 0x8005 reflected, init 0xFFFF, sent low byte first
+    Crc32           // CRC-32 (zlib, Ethernet): poly 0x04C11DB7 reflected, sent low byte first
+};
+
+/**
+ * @brief Table-driven checksum and CRC functions
+ *
+ * The CRCs use slicing-by-8: eight 256-entry tables let the loop consume
+ * eight bytes per iteration with independent lookups instead of one byte at
+ * a time. On x86 CPUs with PCLMULQDQ, CRC-32 of longer buffers is computed
+ * by carry-less multiplication folding (Intel, "Fast CRC Computation for
+ * Generic Polynomials Using PCLMULQDQ"), selected at runtime.
+ *
+ * Every function takes the value of a previous call as its last argument,
+ * so a checksum can be computed over several pieces:
+ * crc32(b, n, crc32(a, m)) equals crc32 of a followed by b.
+ */
+class Checksum {
+public:
+    static quint8 xor8(const char* data, qint64 size, quint8 value = 0);
+    static quint8 lrc8(const char* data, qint64 size, quint8 value = 0);
+    static quint8 crc8(const char* data, qint64 size, quint8 crc = 0);
+    static quint16 crc16Modbus(const char* data, qint64 size, quint16 crc = 0xFFFF);
+    static quint32 crc32(const char* data, qint64 size, quint32 crc = 0);
+
+    // CRC-32 without the PCLMULQDQ path, for comparison
+    static quint32 crc32Portable(const char* data, qint64 size, quint32 crc = 0);
+    static bool hasAcceleratedCrc32();
+
+    // Checksum bytes in the order they go on the wire; empty for None
+    static int size(ChecksumType type);
+    static QByteArray compute(ChecksumType type, const QByteArray& data);
+    static QByteArray append(ChecksumType type, const QByteArray& data);
+
+    // True if the frame ends with the checksum of the bytes before it
+    static bool verify(ChecksumType type, const QByteArray& frame);
+
+    static QString name(ChecksumType type);
+};
+
+#endif // CHECKSUM_H
@@ -0,0 +1,94 @@
+#include "LatencyHistogram.h"
+#include <QtAlgorithms>
+#include <algorithm>
+#include <limits>
+
+namespace {
+// 2^3 buckets per power of two
+const int SUB_BUCKET_BITS = 3;
+const int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+
+// Values below SUB_BUCKETS get a bucket each; each further power of two up to 2^62 gets SUB_BUCKETS
+const int BUCKET_COUNT = (63 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+}
+
+LatencyHistogram::LatencyHistogram()
+    : m_buckets(BUCKET_COUNT, 0)
+    , m_count(0)
+    , m_sum(0)
+    , m_min(std::numeric_limits<qint64>::max())
+    , m_max(0)
+{
+}
+
+int LatencyHistogram::bucketIndex(qint64 valueNs)
+{
+    quint64 value = static_cast<quint64>(qMax(qint64(0), valueNs));
+    if (value < static_cast<quint64>(SUB_BUCKETS)) {
+        return static_cast<int>(value);
+    }
+
+    // The leading bit selects the power of two, the next SUB_BUCKET_BITS bits the bucket within it
+    int exponent = 63 - static_cast<int>(qCountLeadingZeroBits(value));
+    int sub = static_cast<int>((value >> (exponent - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1));
+    return (exponent - SUB_BUCKET_BITS + 1) * SUB_BUCKETS + sub;
+}
+
+qint64 LatencyHistogram::bucketLowerBound(int index)
+{
+    if (index < SUB_BUCKETS) {
+        return index;
+    }
+    int exponent = index / SUB_BUCKETS + SUB_BUCKET_BITS - 1;
+    int sub = index % SUB_BUCKETS;
+    return static_cast<qint64>(SUB_BUCKETS + sub) << (exponent - SUB_BUCKET_BITS);
+}
+
+void LatencyHistogram::record(qint64 valueNs)
+{
+    valueNs = qMax(qint64(0), valueNs);
+    m_buckets[static_cast<size_t>(bucketIndex(valueNs))]++;
+    m_count++;
+    m_sum += valueNs;
+    m_min = qMin(m_min, valueNs);
+    m_max = qMax(m_max, valueNs);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other)
+{
+    for (size_t i = 0; i < m_buckets.size(); ++i) {
+        m_buckets[i] += other.m_buckets[i];
+    }
+    m_count += other.m_count;
+    m_sum += other.m_sum;
+    m_min = qMin(m_min, other.m_min);
+    m_max = qMax(m_max, other.m_max);
+}
+
+void LatencyHistogram::clear()
+{
+    std::fill(m_buckets.begin(), m_buckets.end(), 0);
+    m_count = 0;
+    m_sum = 0;
+    m_min = std::numeric_limits<qint64>::max();
+    m_max = 0;
+}
+
+qint64 LatencyHistogram::percentile(double percent) const
+{
+    if (m_count == 0) {
+        return 0;
+    }
+
+    // Smallest bucket at which the cumulative count reaches the rank
+    qint64 rank = qMax(qint64(1), static_cast<qint64>(qBound(0.0, percent, 100.0) / 100.0 * m_count + 0.5));
+    qint64 seen = 0;
+    for (int i = 0; i < bucketCount(); ++i) {
+        seen += m_buckets[static_cast<size_t>(i)];
+        if (seen >= rank) {
+            qint64 upper = i + 1 < bucketCount() ? bucketLowerBound(i + 1) - 1 : m_max;
+            return qMin(upper, m_max);
+        }
+    }
+    return m_max;
+}
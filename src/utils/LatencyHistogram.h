@@ -0,0 +1,47 @@
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <QtGlobal>
+#include <vector>
+
+/**
+ * @brief Log-linear histogram of durations in nanoseconds
+ *
+ * Every power of two is split into 8 equal buckets, so a recorded value is
+ * known to within 12.5% across the whole range from 1 ns to centuries, in
+ * under 4 KiB and without allocating after construction. record() is a few
+ * integer instructions; percentiles are computed on demand.
+ *
+ * Not thread-safe; merge() combines histograms kept on different threads.
+ */
+class LatencyHistogram {
+public:
+    LatencyHistogram();
+
+    void record(qint64 valueNs);
+    void merge(const LatencyHistogram& other);
+    void clear();
+
+    qint64 count() const { return m_count; }
+    qint64 min() const { return m_count > 0 ? m_min : 0; }
+    qint64 max() const { return m_max; }
+    double mean() const { return m_count > 0 ? static_cast<double>(m_sum) / m_count : 0.0; }
+
+    // Upper bound of the bucket holding the given percentile (0 - 100), capped at max()
+    qint64 percentile(double percent) const;
+
+    // Raw buckets, for export
+    int bucketCount() const { return static_cast<int>(m_buckets.size()); }
+    qint64 bucketValue(int index) const { return m_buckets[static_cast<size_t>(index)]; }
+    static qint64 bucketLowerBound(int index);
+    static int bucketIndex(qint64 valueNs);
+
+private:
+    std::vector<qint64> m_buckets;
+    qint64 m_count;
+    qint64 m_sum;
+    qint64 m_min;
+    qint64 m_max;
+};
+
+#endif // LATENCY_HISTOGRAM_H
@@ -0,0 +1,112 @@
+#include "SlabRingBuffer.h"
+#include <algorithm>
+#include <cstring>
+
+SlabRingBuffer::SlabRingBuffer(int slabSize, int slabCount, OverflowPolicy policy)
+    : m_storage(static_cast<size_t>(qMax(1, slabSize)) * static_cast<size_t>(qMax(1, slabCount)))
+    , m_slabSize(qMax(1, slabSize))
+    , m_slabCount(qMax(1, slabCount))
+    , m_policy(policy)
+    , m_head(0)
+    , m_tail(0)
+    , m_highWaterMark(0)
+    , m_droppedBytes(0)
+{
+}
+
+char* SlabRingBuffer::writePointer(qint64* contiguous)
+{
+    if (isFull()) {
+        if (m_policy == OverflowPolicy::Backpressure) {
+            *contiguous = 0;
+            return nullptr;
+        }
+        dropOldestSlab();
+    }
+
+    // Never hand out more than the rest of the current slab
+    qint64 offsetInSlab = m_tail % m_slabSize;
+    *contiguous = qMin(freeSpace(), m_slabSize - offsetInSlab);
+    return m_storage.data() + (m_tail % capacity());
+}
+
+void SlabRingBuffer::commit(qint64 bytes)
+{
+    if (bytes <= 0) {
+        return;
+    }
+
+    m_tail += qMin(bytes, freeSpace());
+    m_highWaterMark = qMax(m_highWaterMark, size());
+}
+
+qint64 SlabRingBuffer::write(const char* data, qint64 length)
+{
+    qint64 written = 0;
+    while (written < length) {
+        qint64 contiguous = 0;
+        char* dest = writePointer(&contiguous);
+        if (!dest) {
+            break;
+        }
+
+        qint64 chunk = qMin(contiguous, length - written);
+        std::memcpy(dest, data + written, static_cast<size_t>(chunk));
+        commit(chunk);
+        written += chunk;
+    }
+    return written;
+}
+
+const char* SlabRingBuffer::readPointer(qint64* contiguous) const
+{
+    qint64 index = m_head % capacity();
+    *contiguous = qMin(size(), capacity() - index);
+    return m_storage.data() + index;
+}
+
+void SlabRingBuffer::consume(qint64 bytes)
+{
+    m_head += qBound(qint64(0), bytes, size());
+}
+
+qint64 SlabRingBuffer::read(char* dest, qint64 maxLength)
+{
+    qint64 total = 0;
+    while (total < maxLength && !isEmpty()) {
+        qint64 contiguous = 0;
+        const char* src = readPointer(&contiguous);
+        qint64 chunk = qMin(contiguous, maxLength - total);
+        std::memcpy(dest + total, src, static_cast<size_t>(chunk));
+        consume(chunk);
+        total += chunk;
+    }
+    return total;
+}
+
+QByteArray SlabRingBuffer::read(qint64 maxLength)
+{
+    QByteArray result;
+    qint64 length = qMin(maxLength, size());
+    if (length <= 0) {
+        return result;
+    }
+
+    result.resize(static_cast<int>(length));
+    read(result.data(), length);
+    return result;
+}
+
+void SlabRingBuffer::clear()
+{
+    m_head = 0;
+    m_tail = 0;
+}
+
+void SlabRingBuffer::dropOldestSlab()
+{
+    // Discard up to the end of the slab the head currently sits in
+    qint64 bytes = qMin(size(), m_slabSize - (m_head % m_slabSize));
+    m_head += bytes;
+    m_droppedBytes += bytes;
+}
@@ -0,0 +1,85 @@
+#ifndef SLAB_RING_BUFFER_H
+#define SLAB_RING_BUFFER_H
+
+#include <QByteArray>
+#include <QtGlobal>
+#include <vector>
+
+/**
+ * @brief Fixed-capacity byte ring built from preallocated slabs
+ *
+ * All memory is allocated once in the constructor; the buffer never grows.
+ * Producers obtain a contiguous region with writePointer() (never larger than
+ * the rest of the current slab), fill it directly, e.g. with
+ * QIODevice::read(char*, qint64), and then commit() the bytes.
+ *
+ * When the buffer is full the overflow policy decides what happens:
+ * - Backpressure: writePointer() returns nullptr and the producer must stop
+ * - Overwrite: the oldest slab is discarded to make room
+ *
+ * Not thread-safe; producer and consumer must run on the same thread.
+ */
+class SlabRingBuffer {
+public:
+    enum class OverflowPolicy {
+        Backpressure,   // Refuse new data until the consumer catches up
+        Overwrite       // Drop the oldest data
+    };
+
+    static constexpr int DEFAULT_SLAB_SIZE = 4096;
+    static constexpr int DEFAULT_SLAB_COUNT = 64;
+
+    explicit SlabRingBuffer(int slabSize = DEFAULT_SLAB_SIZE, int slabCount = DEFAULT_SLAB_COUNT,
+                            OverflowPolicy policy = OverflowPolicy::Backpressure);
+
+    // Geometry
+    int slabSize() const { return m_slabSize; }
+    int slabCount() const { return m_slabCount; }
+    qint64 capacity() const { return static_cast<qint64>(m_storage.size()); }
+
+    // Fill level
+    qint64 size() const { return m_tail - m_head; }
+    qint64 freeSpace() const { return capacity() - size(); }
+    bool isEmpty() const { return m_head == m_tail; }
+    bool isFull() const { return size() == capacity(); }
+
+    // Policy
+    OverflowPolicy policy() const { return m_policy; }
+    void setPolicy(OverflowPolicy policy) { m_policy = policy; }
+
+    // Producer
+    char* writePointer(qint64* contiguous);
+    void commit(qint64 bytes);
+    qint64 write(const char* data, qint64 length);
+
+    // Consumer
+    const char* readPointer(qint64* contiguous) const;
+    void consume(qint64 bytes);
+    qint64 read(char* dest, qint64 maxLength);
+    QByteArray read(qint64 maxLength);
+    QByteArray readAll() { return read(size()); }
+    char at(qint64 offset) const { return m_storage[static_cast<size_t>((m_head + offset) % capacity())]; }
+    void clear();
+
+    // Statistics
+    qint64 highWaterMark() const { return m_highWaterMark; }
+    void resetHighWaterMark() { m_highWaterMark = size(); }
+    qint64 droppedBytes() const { return m_droppedBytes; }
+
+private:
+    std::vector<char> m_storage;
+    int m_slabSize;
+    int m_slabCount;
+    OverflowPolicy m_policy;
+
+    // Monotonic byte positions; the storage index is position % capacity
+    qint64 m_head;
+    qint64 m_tail;
+
+    qint64 m_highWaterMark;
+    qint64 m_droppedBytes;
+
+    void dropOldestSlab();
+};
+
+#endif // SLAB_RING_BUFFER_H
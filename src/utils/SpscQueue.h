@@ -0,0 +1,103 @@
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <optional>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Bounded lock-free single-producer/single-consumer queue
+ *
+ * Used to hand completed data from an I/O worker thread to the thread that
+ * owns the consuming object without taking a lock or posting one event per
+ * item. Exactly one thread may push and exactly one thread may pop.
+ * The capacity is rounded up to the next power of two.
+ *
+ * Empty slots hold no T, so neither the queue nor a pop ever constructs a
+ * default T (for Message that would mean a new UUID and a clock read).
+ */
+template <typename T> class SpscQueue {
+public:
+    explicit SpscQueue(std::size_t capacity = 4096) : m_slots(roundUpPow2(capacity)), m_mask(m_slots.size() - 1) {}
+
+    SpscQueue(const SpscQueue &) = delete;
+    SpscQueue &operator=(const SpscQueue &) = delete;
+
+    // Producer side
+    bool tryPush(const T &value) {
+        const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_headCache == m_slots.size()) {
+            m_headCache = m_head.load(std::memory_order_acquire);
+            if (tail - m_headCache == m_slots.size()) {
+                return false;
+            }
+        }
+        m_slots[tail & m_mask].emplace(value);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool tryPush(T &&value) {
+        const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_headCache == m_slots.size()) {
+            m_headCache = m_head.load(std::memory_order_acquire);
+            if (tail - m_headCache == m_slots.size()) {
+                return false;
+            }
+        }
+        m_slots[tail & m_mask].emplace(std::move(value));
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side
+    bool tryPop(T &value) {
+        const std::size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tailCache) {
+            m_tailCache = m_tail.load(std::memory_order_acquire);
+            if (head == m_tailCache) {
+                return false;
+            }
+        }
+        std::optional<T> &slot = m_slots[head & m_mask];
+        value = std::move(*slot);
+        slot.reset();
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Approximate when called concurrently with push/pop
+    std::size_t size() const {
+        return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+    }
+    bool isEmpty() const { return size() == 0; }
+    // Exact on the producer thread: the consumer can only make room
+    bool isFull() const { return size() >= m_slots.size(); }
+    std::size_t capacity() const { return m_slots.size(); }
+
+private:
+    static constexpr std::size_t CACHE_LINE = 64;
+
+    static std::size_t roundUpPow2(std::size_t n) {
+        std::size_t size = 2;
+        while (size < n) {
+            size <<= 1;
+        }
+        return size;
+    }
+
+    std::vector<std::optional<T>> m_slots;
+    const std::size_t m_mask;
+
+    // Consumer-owned
+    alignas(CACHE_LINE) std::atomic<std::size_t> m_head{0};
+    std::size_t m_tailCache = 0;
+
+    // Producer-owned
+    alignas(CACHE_LINE) std::atomic<std::size_t> m_tail{0};
+    std::size_t m_headCache = 0;
+};
+
+#endif // SPSC_QUEUE_H
@@ -1,5 +1,48 @@
 #include "TimeUtils.h"
 #include <QCoreApplication>
+#include <chrono>
+
+namespace {
+const qint64 NS_PER_MS = 1000000;
+
+// Wall time and monotonic time sampled together; timestamps are offsets from here
+struct ClockAnchor {
+    qint64 wallNs;
+    std::chrono::steady_clock::time_point steady;
+};
+
+const ClockAnchor& clockAnchor()
+{
+    static const ClockAnchor anchor = {
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count(),
+        std::chrono::steady_clock::now()
+    };
+    return anchor;
+}
+}
+
+qint64 TimeUtils::timestampNs()
+{
+    const ClockAnchor& anchor = clockAnchor();
+    return anchor.wallNs + std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - anchor.steady).count();
+}
+
+QDateTime TimeUtils::toDateTime(qint64 timestampNs)
+{
+    // Floor division, so times before 1970 round towards the past like positive ones do
+    qint64 msecs = timestampNs / NS_PER_MS;
+    if (timestampNs % NS_PER_MS < 0) {
+        msecs--;
+    }
+    return QDateTime::fromMSecsSinceEpoch(msecs);
+}
+
+qint64 TimeUtils::fromDateTime(const QDateTime& dateTime)
+{
+    return dateTime.toMSecsSinceEpoch() * NS_PER_MS;
+}
 
 QString TimeUtils::formatChatTime(const QDateTime& timestamp)
 {
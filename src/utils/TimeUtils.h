@@ -5,10 +5,36 @@
 #include <QDateTime>
 
 /**
- * @brief Utility functions for time formatting
+ * @brief Utility functions for timestamps and time formatting
+ *
+ * Timestamps are nanoseconds since the Unix epoch, taken from the monotonic
+ * clock: the wall time is read once when the first timestamp is taken and
+ * the monotonic clock advances it from there. Intervals between timestamps
+ * are exact and never jump when the system time is changed; the price is
+ * that a clock adjustment after start-up is not reflected until restart.
  */
 class TimeUtils {
 public:
+    /**
+     * @brief Current timestamp, cheap enough to take on every read
+     * @return Nanoseconds since the Unix epoch
+     */
+    static qint64 timestampNs();
+    
+    /**
+     * @brief Convert a timestamp to local wall time, for display
+     * @param timestampNs Nanoseconds since the Unix epoch
+     * @return Date and time with millisecond resolution
+     */
+    static QDateTime toDateTime(qint64 timestampNs);
+    
+    /**
+     * @brief Convert wall time to a timestamp
+     * @param dateTime The date and time to convert
+     * @return Nanoseconds since the Unix epoch
+     */
+    static qint64 fromDateTime(const QDateTime& dateTime);
+    
     /**
      * @brief Format timestamp for display in chat
      * @param timestamp The timestamp to format
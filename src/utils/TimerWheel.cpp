@@ -0,0 +1,176 @@
+#include "TimerWheel.h"
+
+namespace {
+// Ticks covered by all levels together
+const qint64 WHEEL_RANGE = qint64(1) << (TimerWheel::SLOT_BITS * TimerWheel::LEVELS);
+}
+
+TimerWheel::TimerWheel(qint64 startTick)
+    : m_slots(LEVELS * SLOTS)
+    , m_levelEntries()
+    , m_generation(0)
+    , m_current(startTick)
+{
+}
+
+std::vector<TimerWheel::Entry>& TimerWheel::slot(int level, qint64 tick)
+{
+    int index = static_cast<int>((tick >> (level * SLOT_BITS)) & (SLOTS - 1));
+    return m_slots[static_cast<size_t>(level * SLOTS + index)];
+}
+
+const std::vector<TimerWheel::Entry>& TimerWheel::slot(int level, qint64 tick) const
+{
+    int index = static_cast<int>((tick >> (level * SLOT_BITS)) & (SLOTS - 1));
+    return m_slots[static_cast<size_t>(level * SLOTS + index)];
+}
+
+std::vector<TimerWheel::Entry> TimerWheel::takeSlot(int level, qint64 tick)
+{
+    std::vector<Entry> entries;
+    entries.swap(slot(level, tick));
+    m_levelEntries[level] -= static_cast<int>(entries.size());
+    return entries;
+}
+
+bool TimerWheel::isLive(const Entry& entry) const
+{
+    auto it = m_live.constFind(entry.id);
+    return it != m_live.constEnd() && it.value() == entry.generation;
+}
+
+void TimerWheel::schedule(quint64 id, qint64 deadlineTick)
+{
+    Entry entry = {id, ++m_generation, deadlineTick};
+    m_live.insert(id, entry.generation);
+    place(entry, m_current + 1);
+}
+
+bool TimerWheel::cancel(quint64 id)
+{
+    return m_live.remove(id) > 0;
+}
+
+void TimerWheel::clear()
+{
+    for (std::vector<Entry>& entries : m_slots) {
+        entries.clear();
+    }
+    for (int& count : m_levelEntries) {
+        count = 0;
+    }
+    m_live.clear();
+}
+
+void TimerWheel::place(const Entry& entry, qint64 earliestTick)
+{
+    // Overdue timers go into the slot of the earliest tick still to be processed
+    qint64 target = qMax(entry.deadline, earliestTick);
+
+    // Too far out for the wheel: park in the last level and place again when it cascades
+    qint64 delta = qMin(target - earliestTick, WHEEL_RANGE - 1);
+    target = earliestTick + delta;
+
+    int level = 0;
+    while (level < LEVELS - 1 && delta >= (qint64(1) << ((level + 1) * SLOT_BITS))) {
+        level++;
+    }
+    slot(level, target).push_back(entry);
+    m_levelEntries[level]++;
+}
+
+void TimerWheel::cascade(int level, qint64 tick)
+{
+    const std::vector<Entry> entries = takeSlot(level, tick);
+    for (const Entry& entry : entries) {
+        if (isLive(entry)) {
+            place(entry, tick);
+        }
+    }
+}
+
+void TimerWheel::advance(qint64 tick, QVector<quint64>* expired)
+{
+    if (m_live.isEmpty()) {
+        m_current = qMax(m_current, tick);
+        return;
+    }
+
+    while (m_current < tick) {
+        // Nothing happens before the next slot boundary of the lowest level holding entries
+        int lowest = 0;
+        while (lowest < LEVELS - 1 && m_levelEntries[lowest] == 0) {
+            lowest++;
+        }
+        if (lowest > 0) {
+            int shift = lowest * SLOT_BITS;
+            qint64 boundary = ((m_current >> shift) + 1) << shift;
+            if (boundary > tick) {
+                m_current = tick;
+                break;
+            }
+            m_current = boundary - 1;
+        }
+
+        qint64 next = m_current + 1;
+
+        // Higher levels first, so their timers can land in the slot processed below
+        for (int level = LEVELS - 1; level > 0; --level) {
+            qint64 mask = (qint64(1) << (level * SLOT_BITS)) - 1;
+            if ((next & mask) == 0) {
+                cascade(level, next);
+            }
+        }
+
+        const std::vector<Entry> entries = takeSlot(0, next);
+        m_current = next;
+        for (const Entry& entry : entries) {
+            if (!isLive(entry)) {
+                continue;
+            }
+            if (entry.deadline > next) {
+                // Parked beyond the wheel's range; not due yet
+                place(entry, next + 1);
+                continue;
+            }
+            m_live.remove(entry.id);
+            expired->append(entry.id);
+        }
+
+        if (m_live.isEmpty()) {
+            m_current = tick;
+        }
+    }
+}
+
+qint64 TimerWheel::nextWakeTick() const
+{
+    if (m_live.isEmpty()) {
+        return -1;
+    }
+
+    // Level 0 holds the exact deadlines of the next 64 ticks
+    for (qint64 tick = m_current + 1; tick <= m_current + SLOTS; ++tick) {
+        for (const Entry& entry : slot(0, tick)) {
+            if (isLive(entry)) {
+                return tick;
+            }
+        }
+    }
+
+    // Otherwise wake for the first cascade that has something to move
+    qint64 wake = -1;
+    for (int level = 1; level < LEVELS; ++level) {
+        int shift = level * SLOT_BITS;
+        for (qint64 k = 1; k <= SLOTS; ++k) {
+            qint64 start = ((m_current >> shift) + k) << shift;
+            if (!slot(level, start).empty()) {
+                if (wake < 0 || start < wake) {
+                    wake = start;
+                }
+                break;
+            }
+        }
+    }
+    return wake;
+}
@@ -0,0 +1,71 @@
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <QHash>
+#include <QVector>
+#include <QtGlobal>
+#include <vector>
+
+/**
+ * @brief Hierarchical timer wheel keyed by integer ids
+ *
+ * Time is counted in abstract ticks. Four levels of 64 slots cover 2^24
+ * ticks (about 4.6 hours at 1 ms per tick); a timer further out than that is
+ * parked in the last level and placed again as time comes closer. Each
+ * level's slots span 64 times the ticks of the level below. When time
+ * reaches a slot of a higher level, its timers cascade down to a finer
+ * level. A timer therefore costs O(1) to schedule and at most one move per
+ * level, however many timers there are, and advance() skips stretches of
+ * empty levels instead of visiting every tick.
+ *
+ * Scheduling an id that is already scheduled replaces its deadline;
+ * cancelled and replaced entries are dropped lazily when their slot comes up.
+ *
+ * Not thread-safe.
+ */
+class TimerWheel {
+public:
+    static constexpr int SLOT_BITS = 6;
+    static constexpr int SLOTS = 1 << SLOT_BITS;
+    static constexpr int LEVELS = 4;
+
+    explicit TimerWheel(qint64 startTick = 0);
+
+    qint64 currentTick() const { return m_current; }
+    int size() const { return m_live.size(); }
+    bool isEmpty() const { return m_live.isEmpty(); }
+    bool isScheduled(quint64 id) const { return m_live.contains(id); }
+
+    // A deadline at or before currentTick() expires on the next advance()
+    void schedule(quint64 id, qint64 deadlineTick);
+    bool cancel(quint64 id);
+    void clear();
+
+    // Moves time forward to `tick` and appends the expired ids, tick by tick
+    void advance(qint64 tick, QVector<quint64>* expired);
+
+    // Earliest tick at which advance() has work to do (an expiry or a cascade); -1 if empty
+    qint64 nextWakeTick() const;
+
+private:
+    struct Entry {
+        quint64 id;
+        quint64 generation;
+        qint64 deadline;
+    };
+
+    std::vector<std::vector<Entry>> m_slots;
+    int m_levelEntries[LEVELS];         // Entries per level, including dead ones
+    QHash<quint64, quint64> m_live;     // id -> generation of its current entry
+    quint64 m_generation;
+    qint64 m_current;
+
+    std::vector<Entry>& slot(int level, qint64 tick);
+    const std::vector<Entry>& slot(int level, qint64 tick) const;
+    bool isLive(const Entry& entry) const;
+    void place(const Entry& entry, qint64 earliestTick);
+    void cascade(int level, qint64 tick);
+    std::vector<Entry> takeSlot(int level, qint64 tick);
+};
+
+#endif // TIMER_WHEEL_H
@@ -0,0 +1,313 @@
+#include "Trace.h"
+#include <QCoreApplication>
+#include <QFile>
+#include <QThread>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+// Written to the file in pieces of about this size
+const int WRITE_CHUNK_SIZE = 1 << 20;
+
+struct TraceEvent {
+    const char* name;
+    qint64 startNs;
+    qint64 endNs;
+    qint64 count;
+    const char* unit;
+};
+
+// One per thread that has recorded a span; only that thread writes to it
+struct ThreadBuffer {
+    int tid = 0;
+    QString threadName;
+    std::vector<TraceEvent> events;
+    std::atomic<int> count{0};
+    std::atomic<qint64> dropped{0};
+    std::atomic<int> generation{-1};
+};
+
+// Buffers live until exit, so the spans of finished threads are still written
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+};
+
+Registry& registry()
+{
+    static Registry instance;
+    return instance;
+}
+
+// Bumped by every start(); a buffer from an older recording is reset by its own thread
+std::atomic<int> currentGeneration{0};
+std::atomic<qint64> recordingStartNs{0};
+thread_local ThreadBuffer* threadBuffer = nullptr;
+
+// Identifies the watched thread by the address of a thread-local
+thread_local char threadMarker;
+std::atomic<const char*> watchedThread{nullptr};
+
+// Only the watched thread writes; other threads read consistent copies (seqlock)
+struct OperationSlot {
+    std::atomic<unsigned> sequence{0};
+    std::atomic<const char*> name{nullptr};
+    std::atomic<qint64> startNs{0};
+    std::atomic<qint64> durationNs{-1};
+    std::atomic<qint64> count{-1};
+    std::atomic<const char*> unit{nullptr};
+};
+
+OperationSlot operationSlot;
+thread_local int operationDepth = 0;
+
+void publishOperation(const char* name, qint64 startNs, qint64 durationNs, qint64 count, const char* unit)
+{
+    unsigned sequence = operationSlot.sequence.load(std::memory_order_relaxed);
+    operationSlot.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    operationSlot.name.store(name, std::memory_order_relaxed);
+    operationSlot.startNs.store(startNs, std::memory_order_relaxed);
+    operationSlot.durationNs.store(durationNs, std::memory_order_relaxed);
+    operationSlot.count.store(count, std::memory_order_relaxed);
+    operationSlot.unit.store(unit, std::memory_order_relaxed);
+    operationSlot.sequence.store(sequence + 2, std::memory_order_release);
+}
+
+QString currentThreadName(int tid)
+{
+    QThread* thread = QThread::currentThread();
+    QCoreApplication* app = QCoreApplication::instance();
+    if (app && thread == app->thread()) {
+        return QStringLiteral("main");
+    }
+    if (thread && !thread->objectName().isEmpty()) {
+        return thread->objectName();
+    }
+    return QString("thread %1").arg(tid);
+}
+
+ThreadBuffer* registerThread()
+{
+    std::unique_ptr<ThreadBuffer> buffer(new ThreadBuffer);
+    buffer->events.resize(Trace::EVENTS_PER_THREAD);
+
+    Registry& instance = registry();
+    std::lock_guard<std::mutex> lock(instance.mutex);
+    buffer->tid = static_cast<int>(instance.buffers.size()) + 1;
+    buffer->threadName = currentThreadName(buffer->tid);
+    instance.buffers.push_back(std::move(buffer));
+    return instance.buffers.back().get();
+}
+
+// Buffers holding spans of the current recording, with the number of spans in each
+std::vector<std::pair<ThreadBuffer*, int>> snapshot()
+{
+    int generation = currentGeneration.load(std::memory_order_acquire);
+    std::vector<std::pair<ThreadBuffer*, int>> buffers;
+
+    Registry& instance = registry();
+    std::lock_guard<std::mutex> lock(instance.mutex);
+    for (const auto& buffer : instance.buffers) {
+        if (buffer->generation.load(std::memory_order_acquire) == generation) {
+            buffers.emplace_back(buffer.get(), buffer->count.load(std::memory_order_acquire));
+        }
+    }
+    return buffers;
+}
+
+QByteArray jsonString(const QString& value)
+{
+    QByteArray escaped = value.toUtf8();
+    escaped.replace('\\', "\\\\").replace('"', "\\\"");
+    return '"' + escaped + '"';
+}
+
+// Microseconds since the start of the recording, as Chrome expects
+QByteArray microseconds(qint64 ns)
+{
+    return QByteArray::number(ns / 1000.0, 'f', 3);
+}
+}
+
+QString TraceOperation::describe() const
+{
+    if (!name) {
+        return QString();
+    }
+    QString text = QString::fromLatin1(name);
+    if (count >= 0 && unit) {
+        text += QString(", %1 %2").arg(count).arg(QString::fromLatin1(unit));
+    }
+    return text;
+}
+
+std::atomic<bool> Trace::s_recording{false};
+
+bool Trace::isAvailable()
+{
+#ifdef SERIALCHAT_TRACING
+    return true;
+#else
+    return false;
+#endif
+}
+
+void Trace::start()
+{
+    recordingStartNs.store(TimeUtils::timestampNs(), std::memory_order_relaxed);
+    currentGeneration.fetch_add(1, std::memory_order_acq_rel);
+    s_recording.store(true, std::memory_order_release);
+}
+
+void Trace::stop()
+{
+    s_recording.store(false, std::memory_order_release);
+}
+
+qint64 Trace::eventCount()
+{
+    qint64 total = 0;
+    for (const auto& entry : snapshot()) {
+        total += entry.second;
+    }
+    return total;
+}
+
+qint64 Trace::droppedCount()
+{
+    qint64 total = 0;
+    for (const auto& entry : snapshot()) {
+        total += entry.first->dropped.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+void Trace::record(const char* name, qint64 startNs, qint64 endNs, qint64 count, const char* unit)
+{
+    if (!threadBuffer) {
+        threadBuffer = registerThread();
+    }
+    ThreadBuffer* buffer = threadBuffer;
+
+    // First span of a new recording on this thread: forget the previous one
+    int generation = currentGeneration.load(std::memory_order_acquire);
+    if (buffer->generation.load(std::memory_order_relaxed) != generation) {
+        buffer->count.store(0, std::memory_order_relaxed);
+        buffer->dropped.store(0, std::memory_order_relaxed);
+        buffer->generation.store(generation, std::memory_order_release);
+    }
+
+    int index = buffer->count.load(std::memory_order_relaxed);
+    if (index >= EVENTS_PER_THREAD) {
+        buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    buffer->events[static_cast<size_t>(index)] = {name, startNs, endNs, count, unit};
+    buffer->count.store(index + 1, std::memory_order_release);
+}
+
+bool Trace::writeChromeJson(const QString& path, QString* error)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        if (error) {
+            *error = file.errorString();
+        }
+        return false;
+    }
+
+    const std::vector<std::pair<ThreadBuffer*, int>> buffers = snapshot();
+    const qint64 originNs = recordingStartNs.load(std::memory_order_relaxed);
+    const QByteArray pid = QByteArray::number(QCoreApplication::applicationPid());
+    qint64 dropped = 0;
+
+    QByteArray out;
+    out.reserve(WRITE_CHUNK_SIZE + 4096);
+    out += "{\"traceEvents\":[\n";
+    out += "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" + pid + ",\"tid\":0,\"args\":{\"name\":" +
+           jsonString(QCoreApplication::applicationName().isEmpty() ? QStringLiteral("SerialChat")
+                                                                    : QCoreApplication::applicationName()) +
+           "}}";
+
+    for (const auto& entry : buffers) {
+        const ThreadBuffer* buffer = entry.first;
+        const QByteArray tid = QByteArray::number(buffer->tid);
+        dropped += buffer->dropped.load(std::memory_order_relaxed);
+
+        out += ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" + pid + ",\"tid\":" + tid +
+               ",\"args\":{\"name\":" + jsonString(buffer->threadName) + "}}";
+        for (int i = 0; i < entry.second; ++i) {
+            const TraceEvent& event = buffer->events[static_cast<size_t>(i)];
+            // Names are literals from TRACE_SCOPE and need no escaping
+            out += ",\n{\"name\":\"";
+            out += event.name;
+            out += "\",\"ph\":\"X\",\"ts\":" + microseconds(event.startNs - originNs) +
+                   ",\"dur\":" + microseconds(event.endNs - event.startNs) + ",\"pid\":" + pid + ",\"tid\":" + tid;
+            if (event.unit) {
+                out += ",\"args\":{\"";
+                out += event.unit;
+                out += "\":" + QByteArray::number(event.count) + "}";
+            }
+            out += "}";
+            if (out.size() >= WRITE_CHUNK_SIZE) {
+                file.write(out);
+                out.clear();
+            }
+        }
+    }
+
+    out += "\n],\"displayTimeUnit\":\"ns\",\"otherData\":{\"droppedEvents\":" + QByteArray::number(dropped) + "}}\n";
+    if (file.write(out) != out.size() || !file.flush()) {
+        if (error) {
+            *error = file.errorString();
+        }
+        return false;
+    }
+    return true;
+}
+
+void Trace::watchCurrentThread()
+{
+    operationDepth = 0;
+    watchedThread.store(&threadMarker, std::memory_order_relaxed);
+}
+
+bool Trace::isWatchedThread()
+{
+    return watchedThread.load(std::memory_order_relaxed) == &threadMarker;
+}
+
+TraceOperation Trace::watchedOperation()
+{
+    TraceOperation operation;
+    unsigned before = 0;
+    unsigned after = 0;
+    do {
+        before = operationSlot.sequence.load(std::memory_order_acquire);
+        operation.name = operationSlot.name.load(std::memory_order_relaxed);
+        operation.startNs = operationSlot.startNs.load(std::memory_order_relaxed);
+        operation.durationNs = operationSlot.durationNs.load(std::memory_order_relaxed);
+        operation.count = operationSlot.count.load(std::memory_order_relaxed);
+        operation.unit = operationSlot.unit.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        after = operationSlot.sequence.load(std::memory_order_relaxed);
+    } while ((before & 1) != 0 || before != after);
+    return operation;
+}
+
+void Trace::enterOperation(const char* name, qint64 startNs, qint64 count, const char* unit)
+{
+    // Nested spans are part of the outermost one
+    if (operationDepth++ == 0) {
+        publishOperation(name, startNs, -1, count, unit);
+    }
+}
+
+void Trace::leaveOperation(const char* name, qint64 startNs, qint64 endNs, qint64 count, const char* unit)
+{
+    if (operationDepth > 0 && --operationDepth == 0) {
+        publishOperation(name, startNs, endNs - startNs, count, unit);
+    }
+}
@@ -0,0 +1,137 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include "TimeUtils.h"
+#include <QString>
+#include <QtGlobal>
+#include <atomic>
+
+/**
+ * @brief The outermost span a watched thread is in, or last finished
+ */
+struct TraceOperation {
+    const char* name = nullptr;
+    qint64 startNs = 0;
+    qint64 durationNs = -1;     // -1 while the span is still open
+    qint64 count = -1;          // Size of the work, from TRACE_SCOPE_COUNT
+    const char* unit = nullptr;
+
+    bool isValid() const { return name != nullptr; }
+    bool isRunning() const { return durationNs < 0; }
+
+    // "ChatWidget::loadMessages", "ChatWidget::loadMessages, 8000 bubbles"
+    QString describe() const;
+};
+
+/**
+ * @brief Scoped trace spans, written out as Chrome trace-event JSON
+ *
+ * TRACE_SCOPE("Class::method") records the time from the macro to the end
+ * of the enclosing block; TRACE_SCOPE_COUNT() also notes how much work the
+ * span covers ("bubbles", "messages"). Without SERIALCHAT_TRACING (CMake
+ * option ENABLE_TRACING) the macros compile to nothing. In traced builds a
+ * span costs one relaxed atomic load while recording is off, and two clock
+ * reads plus a store into the calling thread's own buffer while it is on:
+ * no lock and no allocation after a thread's first span.
+ *
+ * Every thread keeps up to EVENTS_PER_THREAD spans per recording; later ones
+ * are only counted as dropped. writeChromeJson() may run while other threads
+ * keep recording and sees every span completed before the call. The result
+ * opens in chrome://tracing and ui.perfetto.dev.
+ *
+ * Independently of recording, one thread (the GUI thread) can be watched:
+ * its outermost open span is published so that StallWatchdog can name the
+ * operation that blocks the event loop.
+ *
+ * Names and units must be string literals: only the pointer is stored.
+ */
+class Trace {
+public:
+    static constexpr int EVENTS_PER_THREAD = 1 << 16;
+
+    // Whether TRACE_SCOPE was compiled in
+    static bool isAvailable();
+
+    // Clears every thread's spans and starts recording
+    static void start();
+    static void stop();
+    static bool isRecording() { return s_recording.load(std::memory_order_relaxed); }
+
+    // Spans of the current recording
+    static qint64 eventCount();
+    static qint64 droppedCount();
+
+    static void record(const char* name, qint64 startNs, qint64 endNs, qint64 count = -1,
+                       const char* unit = nullptr);
+    static bool writeChromeJson(const QString& path, QString* error = nullptr);
+
+    // Publishes the calling thread's operations from now on, instead of any other thread's
+    static void watchCurrentThread();
+    static bool isWatchedThread();
+
+    // The watched thread's outermost open span, or the last one it finished; from any thread
+    static TraceOperation watchedOperation();
+
+    // Called by TraceScope on the watched thread
+    static void enterOperation(const char* name, qint64 startNs, qint64 count, const char* unit);
+    static void leaveOperation(const char* name, qint64 startNs, qint64 endNs, qint64 count, const char* unit);
+
+private:
+    static std::atomic<bool> s_recording;
+};
+
+/**
+ * @brief Records one span from construction to destruction
+ */
+class TraceScope {
+public:
+    explicit TraceScope(const char* name, qint64 count = -1, const char* unit = nullptr)
+        : m_name(name)
+        , m_count(count)
+        , m_unit(unit)
+        , m_recording(Trace::isRecording())
+        , m_watched(Trace::isWatchedThread())
+        , m_startNs(m_recording || m_watched ? TimeUtils::timestampNs() : 0)
+    {
+        if (m_watched) {
+            Trace::enterOperation(m_name, m_startNs, m_count, m_unit);
+        }
+    }
+
+    ~TraceScope()
+    {
+        if (!m_recording && !m_watched) {
+            return;
+        }
+        qint64 endNs = TimeUtils::timestampNs();
+        if (m_recording) {
+            Trace::record(m_name, m_startNs, endNs, m_count, m_unit);
+        }
+        if (m_watched) {
+            Trace::leaveOperation(m_name, m_startNs, endNs, m_count, m_unit);
+        }
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* m_name;
+    qint64 m_count;
+    const char* m_unit;
+    bool m_recording;
+    bool m_watched;
+    qint64 m_startNs;
+};
+
+#ifdef SERIALCHAT_TRACING
+#define TRACE_CONCAT_IMPL(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_IMPL(a, b)
+#define TRACE_SCOPE(name) TraceScope TRACE_CONCAT(traceScope, __LINE__)(name)
+#define TRACE_SCOPE_COUNT(name, count, unit) TraceScope TRACE_CONCAT(traceScope, __LINE__)(name, count, unit)
+#else
+#define TRACE_SCOPE(name) static_cast<void>(0)
+#define TRACE_SCOPE_COUNT(name, count, unit) static_cast<void>(0)
+#endif
+
+#endif // TRACE_H
@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include "AhoCorasick.h"
+#include <QPair>
+#include <QVector>
+#include <algorithm>
+
+class AhoCorasickTest : public ::testing::Test {
+protected:
+    AhoCorasick matcher;
+
+    // (pattern, end offset) of every match, scanning the chunks one after another
+    QVector<QPair<int, int>> scanChunks(const QList<QByteArray>& chunks)
+    {
+        QVector<QPair<int, int>> matches;
+        int state = AhoCorasick::ROOT;
+        int offset = 0;
+        for (const QByteArray& chunk : chunks) {
+            state = matcher.scan(state, chunk.constData(), chunk.size(),
+                                 [&](int pattern, int end) { matches.append(qMakePair(pattern, offset + end)); });
+            offset += chunk.size();
+        }
+        return matches;
+    }
+
+    // Every occurrence of every pattern, the slow way
+    QVector<QPair<int, int>> naiveMatches(const QByteArray& text)
+    {
+        QVector<QPair<int, int>> matches;
+        for (int end = 1; end <= text.size(); ++end) {
+            for (int p = 0; p < matcher.patternCount(); ++p) {
+                QByteArray pattern = matcher.pattern(p);
+                if (end >= pattern.size() && text.mid(end - pattern.size(), pattern.size()) == pattern) {
+                    matches.append(qMakePair(p, end));
+                }
+            }
+        }
+        return matches;
+    }
+};
+
+TEST_F(AhoCorasickTest, FindsOverlappingPatterns) {
+    matcher.addPattern("he");
+    matcher.addPattern("she");
+    matcher.addPattern("his");
+    matcher.addPattern("hers");
+    matcher.build();
+
+    QVector<QPair<int, int>> matches = scanChunks({"ushers"});
+    QVector<QPair<int, int>> expected = {qMakePair(1, 4), qMakePair(0, 4), qMakePair(3, 6)};
+    EXPECT_EQ(matches, expected);
+}
+
+TEST_F(AhoCorasickTest, MatchesSpanChunks) {
+    matcher.addPattern("AT+RST\r");
+    matcher.build();
+
+    QVector<QPair<int, int>> matches = scanChunks({"xxAT", "+R", "S", "T\ryyAT+RST\r"});
+    QVector<QPair<int, int>> expected = {qMakePair(0, 9), qMakePair(0, 18)};
+    EXPECT_EQ(matches, expected);
+}
+
+TEST_F(AhoCorasickTest, BinaryAndDuplicatePatterns) {
+    EXPECT_EQ(matcher.addPattern(QByteArray()), -1);
+    EXPECT_EQ(matcher.addPattern(QByteArray("\x00\xFF", 2)), 0);
+    EXPECT_EQ(matcher.addPattern(QByteArray("\x00\xFF", 2)), 1);
+    EXPECT_EQ(matcher.addPattern(QByteArray("\xFF", 1)), 2);
+    matcher.build();
+
+    QVector<QPair<int, int>> matches = scanChunks({QByteArray("\x01\x00\xFF", 3)});
+    QVector<QPair<int, int>> expected = {qMakePair(0, 3), qMakePair(1, 3), qMakePair(2, 3)};
+    EXPECT_EQ(matches, expected);
+}
+
+TEST_F(AhoCorasickTest, AgreesWithNaiveSearch) {
+    // Small alphabet so patterns overlap a lot
+    quint32 seed = 12345;
+    auto next = [&seed]() {
+        seed = seed * 1103515245 + 12345;
+        return static_cast<int>((seed >> 16) & 0x7FFF);
+    };
+
+    for (int round = 0; round < 50; ++round) {
+        matcher.clear();
+        int patterns = 1 + next() % 30;
+        for (int i = 0; i < patterns; ++i) {
+            QByteArray pattern;
+            int length = 1 + next() % 5;
+            for (int j = 0; j < length; ++j) {
+                pattern.append(static_cast<char>('a' + next() % 3));
+            }
+            matcher.addPattern(pattern);
+        }
+        matcher.build();
+
+        QByteArray text;
+        QList<QByteArray> chunks;
+        while (text.size() < 300) {
+            QByteArray chunk;
+            int length = 1 + next() % 8;
+            for (int j = 0; j < length; ++j) {
+                chunk.append(static_cast<char>('a' + next() % 3));
+            }
+            text.append(chunk);
+            chunks.append(chunk);
+        }
+
+        QVector<QPair<int, int>> matches = scanChunks(chunks);
+        QVector<QPair<int, int>> expected = naiveMatches(text);
+        std::sort(matches.begin(), matches.end());
+        std::sort(expected.begin(), expected.end());
+        ASSERT_EQ(matches, expected) << "round " << round;
+    }
+}
+
+TEST_F(AhoCorasickTest, EmptyMatcherMatchesNothing) {
+    EXPECT_TRUE(matcher.isBuilt());
+    EXPECT_EQ(matcher.stateCount(), 1);
+    EXPECT_TRUE(scanChunks({"anything"}).isEmpty());
+}
@@ -0,0 +1,163 @@
+#include <gtest/gtest.h>
+#include "AutoResponder.h"
+#include "SerialPortManager.h"
+#include "TestSupport.h"
+
+// The TCP server plays the host talking to the emulated device
+class AutoResponderTest : public TcpDeviceTest {
+protected:
+    QByteArray replies;
+    QByteArray delivered;
+
+    SerialPortUser* createUser(const QList<AutoReplyRule>& rules, FramingMode framing = FramingMode::None)
+    {
+        SerialPortInfo info = deviceInfo("device");
+        info.setFraming(FramingConfig(framing));
+        info.setAutoReplies(rules);
+
+        SerialPortUser* user = connectDevice(info);
+        if (!user) {
+            return nullptr;
+        }
+        QObject::connect(peer, &QTcpSocket::readyRead, [this]() { replies.append(peer->readAll()); });
+        QObject::connect(user, &SerialPortUser::dataReceived,
+                         [this](const QByteArray& data) { delivered.append(data); });
+        return user;
+    }
+
+    // Writes one chunk and waits until the port has read all of it, so the next chunk is a separate read
+    bool sendChunk(const QByteArray& chunk)
+    {
+        int expected = delivered.size() + chunk.size();
+        peer->write(chunk);
+        return waitUntil([&]() { return delivered.size() >= expected; });
+    }
+};
+
+TEST_F(AutoResponderTest, RepliesToPatterns) {
+    SerialPortUser* user = createUser({AutoReplyRule("AT\r", "OK\r"), AutoReplyRule("PING", "PONG")});
+    ASSERT_NE(user, nullptr);
+    EXPECT_EQ(user->autoResponder()->activeRuleCount(), 2);
+
+    ASSERT_TRUE(sendChunk("AT\r"));
+    ASSERT_TRUE(waitUntil([&]() { return replies == "OK\r"; }));
+
+    // Both rules in one read, each answered in order
+    ASSERT_TRUE(sendChunk("xPINGyAT\r"));
+    ASSERT_TRUE(waitUntil([&]() { return replies == "OK\rPONGOK\r"; }));
+    EXPECT_EQ(user->autoResponder()->matchCount(), 3);
+    EXPECT_EQ(user->autoResponder()->hitCount(0), 2);
+    EXPECT_EQ(user->autoResponder()->hitCount(1), 1);
+}
+
+TEST_F(AutoResponderTest, MatchesAcrossReads) {
+    SerialPortUser* user = createUser({AutoReplyRule("PING", "PONG")});
+    ASSERT_NE(user, nullptr);
+
+    ASSERT_TRUE(sendChunk("PI"));
+    ASSERT_TRUE(sendChunk("N"));
+    EXPECT_TRUE(replies.isEmpty());
+    ASSERT_TRUE(sendChunk("G"));
+    ASSERT_TRUE(waitUntil([&]() { return replies == "PONG"; }));
+}
+
+TEST_F(AutoResponderTest, FramedPortMatchesWithinFrames) {
+    SerialPortUser* user = createUser({AutoReplyRule("PING", "PONG\n")}, FramingMode::Delimiter);
+    ASSERT_NE(user, nullptr);
+
+    // Split by the delimiter: the halves are two frames, not one pattern
+    peer->write("PI\nNG\nPING\n");
+    ASSERT_TRUE(waitUntil([&]() { return replies == "PONG\n"; }));
+    EXPECT_EQ(user->autoResponder()->matchCount(), 1);
+}
+
+TEST_F(AutoResponderTest, ChecksumIsAppendedAndVerified) {
+    // Modbus RTU: read holding register 0 of slave 1, answered with exception 2
+    QByteArray request = QByteArray::fromHex("010300000001");
+    QByteArray exception = QByteArray::fromHex("018302");
+    SerialPortUser* user = createUser({AutoReplyRule(request, exception)}, FramingMode::IdleGap);
+    ASSERT_NE(user, nullptr);
+    portManager->setPortChecksum("device", ChecksumType::Crc16Modbus);
+
+    QList<ChecksumStatus> statuses;
+    QObject::connect(user, &SerialPortUser::messageReceived,
+                     [&](const Message& message) { statuses.append(message.checksumStatus()); });
+
+    ASSERT_TRUE(sendChunk(QByteArray::fromHex("010300000001840A")));
+    ASSERT_TRUE(waitUntil([&]() { return replies == Checksum::append(ChecksumType::Crc16Modbus, exception); }));
+    ASSERT_TRUE(waitUntil([&]() { return user->autoResponder()->replyCount() == 1; }));
+
+    // A corrupted frame is flagged and left unanswered
+    ASSERT_TRUE(sendChunk(QByteArray::fromHex("010300000001840B")));
+    ASSERT_TRUE(waitUntil([&]() { return statuses.size() == 2; }));
+    EXPECT_EQ(statuses.at(0), ChecksumStatus::Valid);
+    EXPECT_EQ(statuses.at(1), ChecksumStatus::Invalid);
+    EXPECT_EQ(user->autoResponder()->matchCount(), 1);
+}
+
+TEST_F(AutoResponderTest, ManyRules) {
+    QList<AutoReplyRule> rules;
+    for (int i = 0; i < 500; ++i) {
+        QByteArray id = QByteArray::number(i).rightJustified(3, '0');
+        rules.append(AutoReplyRule("Q" + id + ";", "R" + id + ";"));
+    }
+    SerialPortUser* user = createUser(rules);
+    ASSERT_NE(user, nullptr);
+    EXPECT_EQ(user->autoResponder()->activeRuleCount(), 500);
+
+    peer->write("Q007;Q499;Q123;Q500;");
+    ASSERT_TRUE(waitUntil([&]() { return replies == "R007;R499;R123;"; }));
+}
+
+TEST_F(AutoResponderTest, LatencyIsMeasured) {
+    SerialPortUser* user = createUser({AutoReplyRule("?", "!")});
+    ASSERT_NE(user, nullptr);
+
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_TRUE(sendChunk("?"));
+    }
+    ASSERT_TRUE(waitUntil([&]() { return user->autoResponder()->replyCount() == 5; }));
+
+    const LatencyHistogram& latency = user->autoResponder()->latency();
+    EXPECT_EQ(latency.count(), 5);
+    EXPECT_GT(latency.min(), 0);
+    EXPECT_LT(latency.max(), 1000LL * 1000000);
+
+    PortMetricsSnapshot metrics = user->metrics();
+    EXPECT_EQ(metrics.autoReplies, 5);
+    EXPECT_GT(metrics.autoReplyP50Ns, 0);
+    EXPECT_GE(metrics.autoReplyP99Ns, metrics.autoReplyP50Ns);
+
+    user->autoResponder()->resetStatistics();
+    EXPECT_EQ(user->autoResponder()->replyCount(), 0);
+    EXPECT_EQ(user->autoResponder()->latency().count(), 0);
+}
+
+TEST_F(AutoResponderTest, RulesFollowSettings) {
+    AutoReplyRule disabled("B", "2");
+    disabled.setEnabled(false);
+    SerialPortUser* user = createUser({AutoReplyRule("A", "1"), disabled});
+    ASSERT_NE(user, nullptr);
+    EXPECT_EQ(user->autoResponder()->activeRuleCount(), 1);
+
+    ASSERT_TRUE(sendChunk("AB"));
+    ASSERT_TRUE(waitUntil([&]() { return replies == "1"; }));
+
+    // Settings without auto replies switch the responder off
+    SerialPortInfo info = user->info();
+    info.setRemark("no replies");
+    info.setAutoReplies({});
+    user->setInfo(info);
+    EXPECT_EQ(user->autoResponder()->activeRuleCount(), 0);
+}
+
+TEST_F(AutoResponderTest, ClosedPortCountsFailures) {
+    SerialPortInfo info("offline");
+    info.setAutoReplies({AutoReplyRule("A", "1")});
+    SerialPortUser* user = portManager->createUser(info);
+
+    user->autoResponder()->process(Message("offline", "AAA", MessageDirection::Received));
+    EXPECT_EQ(user->autoResponder()->matchCount(), 3);
+    EXPECT_EQ(user->autoResponder()->failedCount(), 3);
+    EXPECT_EQ(user->autoResponder()->replyCount(), 0);
+}
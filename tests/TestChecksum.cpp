@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+#include "Checksum.h"
+
+class ChecksumTest : public ::testing::Test {
+protected:
+    // The standard check input of the CRC catalogue
+    const QByteArray check = QByteArray("123456789");
+
+    // Bytes that exercise every bit position
+    QByteArray pattern(int size, int seed = 0)
+    {
+        QByteArray data(size, Qt::Uninitialized);
+        quint32 state = 0x12345678u + seed;
+        for (int i = 0; i < size; ++i) {
+            state = state * 1103515245u + 12345u;
+            data[i] = static_cast<char>(state >> 24);
+        }
+        return data;
+    }
+};
+
+TEST_F(ChecksumTest, CheckValues) {
+    EXPECT_EQ(Checksum::xor8(check.constData(), check.size()), 0x31);
+    EXPECT_EQ(Checksum::lrc8(check.constData(), check.size()), 0x23);
+    EXPECT_EQ(Checksum::crc8(check.constData(), check.size()), 0xF4);
+    EXPECT_EQ(Checksum::crc16Modbus(check.constData(), check.size()), 0x4B37);
+    EXPECT_EQ(Checksum::crc32(check.constData(), check.size()), 0xCBF43926u);
+    EXPECT_EQ(Checksum::crc32Portable(check.constData(), check.size()), 0xCBF43926u);
+}
+
+TEST_F(ChecksumTest, EmptyInput) {
+    EXPECT_EQ(Checksum::crc16Modbus(nullptr, 0), 0xFFFF);
+    EXPECT_EQ(Checksum::crc32(nullptr, 0), 0u);
+    EXPECT_EQ(Checksum::compute(ChecksumType::Crc32, QByteArray()), QByteArray(4, '\0'));
+}
+
+TEST_F(ChecksumTest, ChainedComputation) {
+    QByteArray data = pattern(1000);
+    for (int split : {0, 1, 7, 8, 63, 64, 500, 999, 1000}) {
+        const char* p = data.constData();
+        int rest = data.size() - split;
+        EXPECT_EQ(Checksum::crc32(p + split, rest, Checksum::crc32(p, split)),
+                  Checksum::crc32(p, data.size())) << split;
+        EXPECT_EQ(Checksum::crc16Modbus(p + split, rest, Checksum::crc16Modbus(p, split)),
+                  Checksum::crc16Modbus(p, data.size())) << split;
+        EXPECT_EQ(Checksum::crc8(p + split, rest, Checksum::crc8(p, split)),
+                  Checksum::crc8(p, data.size())) << split;
+        EXPECT_EQ(Checksum::lrc8(p + split, rest, Checksum::lrc8(p, split)),
+                  Checksum::lrc8(p, data.size())) << split;
+    }
+}
+
+TEST_F(ChecksumTest, AcceleratedMatchesPortable) {
+    // Lengths around the folding block sizes and unaligned starts
+    QByteArray data = pattern(4096 + 16, 1);
+    for (int offset = 0; offset < 16; offset += 3) {
+        for (int size = 0; size <= 600; ++size) {
+            const char* p = data.constData() + offset;
+            ASSERT_EQ(Checksum::crc32(p, size), Checksum::crc32Portable(p, size))
+                << "offset " << offset << " size " << size;
+        }
+        const char* p = data.constData() + offset;
+        EXPECT_EQ(Checksum::crc32(p, 4096), Checksum::crc32Portable(p, 4096));
+        EXPECT_EQ(Checksum::crc32(p, 4096, 0xDEADBEEFu), Checksum::crc32Portable(p, 4096, 0xDEADBEEFu));
+    }
+}
+
+TEST_F(ChecksumTest, ModbusFrame) {
+    // Read holding register 0 of slave 1
+    QByteArray request = QByteArray::fromHex("010300000001");
+    QByteArray frame = Checksum::append(ChecksumType::Crc16Modbus, request);
+    EXPECT_EQ(frame, QByteArray::fromHex("010300000001840A"));
+    EXPECT_TRUE(Checksum::verify(ChecksumType::Crc16Modbus, frame));
+}
+
+TEST_F(ChecksumTest, AppendAndVerify) {
+    const ChecksumType types[] = {ChecksumType::Xor8, ChecksumType::Lrc8, ChecksumType::Crc8,
+                                  ChecksumType::Crc16Modbus, ChecksumType::Crc32};
+    QByteArray payload = pattern(37, 2);
+    for (ChecksumType type : types) {
+        QByteArray frame = Checksum::append(type, payload);
+        ASSERT_EQ(frame.size(), payload.size() + Checksum::size(type)) << Checksum::name(type).toStdString();
+        EXPECT_TRUE(frame.startsWith(payload));
+        EXPECT_TRUE(Checksum::verify(type, frame)) << Checksum::name(type).toStdString();
+
+        QByteArray corrupted = frame;
+        corrupted[5] = static_cast<char>(corrupted[5] ^ 0x10);
+        EXPECT_FALSE(Checksum::verify(type, corrupted)) << Checksum::name(type).toStdString();
+
+        // Too short to hold a checksum
+        EXPECT_FALSE(Checksum::verify(type, frame.left(Checksum::size(type) - 1)));
+    }
+}
+
+TEST_F(ChecksumTest, NoneLeavesDataAlone) {
+    QByteArray payload("hello");
+    EXPECT_EQ(Checksum::size(ChecksumType::None), 0);
+    EXPECT_EQ(Checksum::append(ChecksumType::None, payload), payload);
+    EXPECT_TRUE(Checksum::verify(ChecksumType::None, payload));
+}
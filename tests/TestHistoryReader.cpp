@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+#include "HistoryReader.h"
+#include "DataPersistence.h"
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+
+class HistoryReaderTest : public ::testing::Test {
+protected:
+    QTemporaryDir dir;
+
+    QString writeFile(const QString& name, const QByteArray& content)
+    {
+        QString path = dir.filePath(name);
+        QFile file(path);
+        file.open(QIODevice::WriteOnly);
+        file.write(content);
+        return path;
+    }
+
+    static QJsonArray toArray(const QList<Message>& messages)
+    {
+        QJsonArray array;
+        for (const Message& message : messages) {
+            array.append(message.toJson());
+        }
+        return array;
+    }
+
+    static QList<Message> readAll(HistoryReader& reader)
+    {
+        QList<Message> messages;
+        Message message;
+        while (reader.readNext(message)) {
+            messages.append(message);
+        }
+        return messages;
+    }
+};
+
+TEST_F(HistoryReaderTest, ReadsSavedPortHistory) {
+    DataPersistence persistence;
+    persistence.setDataDirectory(dir.path());
+
+    QList<Message> saved;
+    saved.append(Message("COM1", "hello", MessageDirection::Received, 1000000000LL));
+    saved.append(Message("COM1", QByteArray("\x00\x7B\x22", 3), MessageDirection::Sent, 1500000000LL));
+    ASSERT_TRUE(persistence.saveMessages("COM1", saved));
+
+    HistoryReader reader;
+    ASSERT_TRUE(reader.open(dir.filePath("messages/COM1.json")));
+    QList<Message> read = readAll(reader);
+    EXPECT_FALSE(reader.hasError());
+    EXPECT_TRUE(reader.atEnd());
+    ASSERT_EQ(read.size(), 2);
+    for (int i = 0; i < read.size(); ++i) {
+        EXPECT_EQ(read.at(i).id(), saved.at(i).id());
+        EXPECT_EQ(read.at(i).data(), saved.at(i).data());
+        EXPECT_EQ(read.at(i).direction(), saved.at(i).direction());
+        EXPECT_EQ(read.at(i).timestampNs(), saved.at(i).timestampNs());
+    }
+    EXPECT_EQ(reader.messagesRead(), 2);
+    EXPECT_EQ(reader.bytesRead(), reader.size());
+}
+
+TEST_F(HistoryReaderTest, ReadsExportedHistoryForOnePort) {
+    QJsonObject ports;
+    ports["A"] = toArray({Message("A", "a1", MessageDirection::Received), Message("A", "a2", MessageDirection::Sent)});
+    ports["B"] = toArray({Message("B", "b1", MessageDirection::Received)});
+    QJsonObject group;
+    group["name"] = "group";
+    group["messages"] = toArray({Message("A", "g1", MessageDirection::Received)});
+    QJsonObject groups;
+    groups["g1"] = group;
+    QJsonObject root;
+    root["exportTime"] = "2026-01-01T00:00:00";
+    root["groupMessages"] = groups;
+    root["portMessages"] = ports;
+    QString path = writeFile("export.json", QJsonDocument(root).toJson(QJsonDocument::Indented));
+
+    // Group messages are copies of port messages and never replayed
+    HistoryReader reader;
+    ASSERT_TRUE(reader.open(path));
+    QList<Message> all = readAll(reader);
+    ASSERT_EQ(all.size(), 3);
+    EXPECT_EQ(all.at(0).data(), "a1");
+    EXPECT_EQ(all.at(2).data(), "b1");
+
+    ASSERT_TRUE(reader.open(path, "A"));
+    QList<Message> portA = readAll(reader);
+    ASSERT_EQ(portA.size(), 2);
+    EXPECT_EQ(portA.at(1).data(), "a2");
+    EXPECT_FALSE(reader.hasError());
+}
+
+TEST_F(HistoryReaderTest, StreamsMessagesAcrossBlocks) {
+    // Data full of JSON syntax, and enough messages to span many read blocks
+    QList<Message> saved;
+    for (int i = 0; i < 3000; ++i) {
+        QByteArray data = "{\"[" + QByteArray::number(i) + "]\\}";
+        Message message("COM2", data, MessageDirection::Received, 1000000000LL + i);
+        message.setChunks({{0, 0}, {2, 1000}});
+        saved.append(message);
+    }
+    QString path = writeFile("large.json", QJsonDocument(toArray(saved)).toJson(QJsonDocument::Compact));
+
+    HistoryReader reader;
+    ASSERT_TRUE(reader.open(path, "COM2"));
+    int count = 0;
+    Message message;
+    while (reader.readNext(message)) {
+        ASSERT_EQ(message.data(), saved.at(count).data());
+        ASSERT_EQ(message.chunkCount(), 2);
+        count++;
+    }
+    EXPECT_FALSE(reader.hasError()) << reader.errorString().toStdString();
+    EXPECT_EQ(count, saved.size());
+    EXPECT_GT(reader.size(), 64 * 1024);
+}
+
+TEST_F(HistoryReaderTest, ReportsTruncatedFile) {
+    QList<Message> saved;
+    for (int i = 0; i < 10; ++i) {
+        saved.append(Message("COM3", QByteArray::number(i), MessageDirection::Received));
+    }
+    QByteArray content = QJsonDocument(toArray(saved)).toJson(QJsonDocument::Indented);
+    QString path = writeFile("truncated.json", content.left(content.size() * 3 / 4));
+
+    // Complete messages before the cut are still returned
+    HistoryReader reader;
+    ASSERT_TRUE(reader.open(path));
+    QList<Message> read = readAll(reader);
+    EXPECT_GE(read.size(), 5);
+    EXPECT_LT(read.size(), 10);
+    EXPECT_TRUE(reader.hasError());
+    EXPECT_TRUE(reader.atEnd());
+}
+
+TEST_F(HistoryReaderTest, MissingFile) {
+    HistoryReader reader;
+    EXPECT_FALSE(reader.open(dir.filePath("missing.json")));
+    EXPECT_TRUE(reader.hasError());
+    EXPECT_FALSE(reader.isOpen());
+
+    Message message;
+    EXPECT_FALSE(reader.readNext(message));
+}
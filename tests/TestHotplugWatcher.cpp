@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+#include "HotplugWatcher.h"
+#include "TestSupport.h"
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QThread>
+
+namespace {
+bool writeFile(const QString& path, const QByteArray& content)
+{
+    QFile file(path);
+    return file.open(QIODevice::WriteOnly) && file.write(content) == content.size();
+}
+}
+
+// Fake /dev and /sys/class/tty trees, so devices can be "plugged in" without hardware
+class HotplugWatcherTest : public ::testing::Test {
+protected:
+    QTemporaryDir root;
+    QString deviceDir;
+    QString sysfsDir;
+    HotplugWatcher* watcher;
+    QList<QStringList> batches;
+
+    void SetUp() override {
+        ASSERT_TRUE(root.isValid());
+        deviceDir = root.filePath("dev");
+        sysfsDir = root.filePath("sys");
+        ASSERT_TRUE(QDir().mkpath(deviceDir));
+        ASSERT_TRUE(QDir().mkpath(sysfsDir));
+
+        watcher = new HotplugWatcher(deviceDir, sysfsDir);
+        QObject::connect(watcher, &HotplugWatcher::devicesChanged,
+                         [this](const QStringList& names) { batches.append(names); });
+    }
+
+    void TearDown() override {
+        delete watcher;
+    }
+
+    // sysfs entry of a USB adapter; the USB attributes sit on the device directory itself
+    void addSysfsDevice(const QString& name)
+    {
+        QString device = sysfsDir + "/" + name + "/device";
+        ASSERT_TRUE(QDir().mkpath(device));
+        ASSERT_TRUE(writeFile(device + "/idVendor", "0403\n"));
+        ASSERT_TRUE(writeFile(device + "/idProduct", "6001\n"));
+        ASSERT_TRUE(writeFile(device + "/product", "FT232R USB UART\n"));
+        ASSERT_TRUE(writeFile(device + "/manufacturer", "FTDI\n"));
+        ASSERT_TRUE(writeFile(device + "/serial", "A50285BI\n"));
+    }
+
+    QStringList allNames() const
+    {
+        QStringList names;
+        for (const QStringList& batch : batches) {
+            names.append(batch);
+        }
+        return names;
+    }
+};
+
+TEST_F(HotplugWatcherTest, ProbeReadsUsbAttributes) {
+    addSysfsDevice("ttyUSB0");
+    ASSERT_TRUE(writeFile(deviceDir + "/ttyUSB0", QByteArray()));
+
+    PortDescriptor port;
+    ASSERT_TRUE(watcher->probe("ttyUSB0", &port));
+    EXPECT_EQ(port.portName, "ttyUSB0");
+    EXPECT_EQ(port.systemLocation, deviceDir + "/ttyUSB0");
+    EXPECT_EQ(port.description, "FT232R USB UART");
+    EXPECT_EQ(port.manufacturer, "FTDI");
+    EXPECT_EQ(port.serialNumber, "A50285BI");
+    EXPECT_EQ(port.vendorId, 0x0403);
+    EXPECT_EQ(port.productId, 0x6001);
+}
+
+TEST_F(HotplugWatcherTest, ProbeRejectsNodesWithoutDevice) {
+    // A virtual terminal: node in /dev, no backing device
+    ASSERT_TRUE(writeFile(deviceDir + "/tty1", QByteArray()));
+    ASSERT_TRUE(QDir().mkpath(sysfsDir + "/tty1"));
+
+    PortDescriptor port;
+    EXPECT_FALSE(watcher->probe("tty1", &port));
+    EXPECT_FALSE(watcher->probe("ttyUSB9", &port));
+}
+
+TEST_F(HotplugWatcherTest, ReportsAddedAndRemovedNodes) {
+    ASSERT_TRUE(watcher->start());
+    EXPECT_TRUE(watcher->isActive());
+
+    addSysfsDevice("ttyACM0");
+    ASSERT_TRUE(writeFile(deviceDir + "/ttyACM0", QByteArray()));
+    ASSERT_TRUE(waitUntil([&]() { return allNames().contains("ttyACM0"); }));
+
+    PortDescriptor port;
+    EXPECT_TRUE(watcher->probe("ttyACM0", &port));
+
+    batches.clear();
+    ASSERT_TRUE(QFile::remove(deviceDir + "/ttyACM0"));
+    ASSERT_TRUE(waitUntil([&]() { return allNames().contains("ttyACM0"); }));
+    EXPECT_FALSE(watcher->probe("ttyACM0", &port));
+}
+
+TEST_F(HotplugWatcherTest, BurstIsReportedOnce) {
+    ASSERT_TRUE(watcher->start());
+
+    // Node creation followed by udev fixing permissions: one settled batch
+    ASSERT_TRUE(writeFile(deviceDir + "/ttyUSB1", QByteArray()));
+    QFile::setPermissions(deviceDir + "/ttyUSB1", QFileDevice::ReadOwner | QFileDevice::WriteOwner);
+    ASSERT_TRUE(waitUntil([&]() { return !batches.isEmpty(); }));
+
+    QThread::msleep(100);
+    QCoreApplication::processEvents();
+    ASSERT_EQ(batches.size(), 1);
+    EXPECT_EQ(batches.first(), QStringList{"ttyUSB1"});
+}
+
+TEST_F(HotplugWatcherTest, FollowsByIdLinks) {
+    ASSERT_TRUE(QDir().mkpath(deviceDir + "/serial/by-id"));
+    ASSERT_TRUE(watcher->start());
+
+    ASSERT_TRUE(QFile::link("../../ttyUSB2", deviceDir + "/serial/by-id/usb-FTDI_FT232R-if00-port0"));
+    ASSERT_TRUE(waitUntil([&]() { return allNames().contains("ttyUSB2"); }));
+}
+
+TEST_F(HotplugWatcherTest, StopEndsNotifications) {
+    ASSERT_TRUE(watcher->start());
+    watcher->stop();
+    EXPECT_FALSE(watcher->isActive());
+
+    ASSERT_TRUE(writeFile(deviceDir + "/ttyUSB3", QByteArray()));
+    QThread::msleep(100);
+    QCoreApplication::processEvents();
+    EXPECT_TRUE(batches.isEmpty());
+}
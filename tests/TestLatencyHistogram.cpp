@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+#include "LatencyHistogram.h"
+
+class LatencyHistogramTest : public ::testing::Test {
+protected:
+    LatencyHistogram histogram;
+};
+
+TEST_F(LatencyHistogramTest, EmptyHistogram) {
+    EXPECT_EQ(histogram.count(), 0);
+    EXPECT_EQ(histogram.min(), 0);
+    EXPECT_EQ(histogram.max(), 0);
+    EXPECT_EQ(histogram.percentile(50), 0);
+    EXPECT_DOUBLE_EQ(histogram.mean(), 0.0);
+}
+
+TEST_F(LatencyHistogramTest, BucketsCoverValues) {
+    // Every value lies within its bucket, and the bucket is at most 12.5% wide
+    for (qint64 value : {0LL, 1LL, 7LL, 8LL, 15LL, 16LL, 1000LL, 123456789LL, 1LL << 40, (1LL << 62) + 5}) {
+        int index = LatencyHistogram::bucketIndex(value);
+        ASSERT_LT(index, histogram.bucketCount());
+        qint64 lower = LatencyHistogram::bucketLowerBound(index);
+        EXPECT_LE(lower, value);
+        if (index + 1 < histogram.bucketCount()) {
+            qint64 next = LatencyHistogram::bucketLowerBound(index + 1);
+            EXPECT_GT(next, value);
+            EXPECT_LE(next - lower, qMax(qint64(1), lower / 8));
+        }
+    }
+}
+
+TEST_F(LatencyHistogramTest, RecordsSummary) {
+    histogram.record(1000);
+    histogram.record(2000);
+    histogram.record(3000);
+
+    EXPECT_EQ(histogram.count(), 3);
+    EXPECT_EQ(histogram.min(), 1000);
+    EXPECT_EQ(histogram.max(), 3000);
+    EXPECT_DOUBLE_EQ(histogram.mean(), 2000.0);
+}
+
+TEST_F(LatencyHistogramTest, PercentilesWithinResolution) {
+    for (qint64 i = 1; i <= 1000; ++i) {
+        histogram.record(i * 1000);
+    }
+
+    qint64 median = histogram.percentile(50);
+    EXPECT_GE(median, 500000);
+    EXPECT_LE(median, 500000 * 9 / 8);
+
+    qint64 p99 = histogram.percentile(99);
+    EXPECT_GE(p99, 990000);
+    EXPECT_LE(p99, 1000000);
+    EXPECT_EQ(histogram.percentile(100), 1000000);
+}
+
+TEST_F(LatencyHistogramTest, MergeAndClear) {
+    LatencyHistogram other;
+    histogram.record(10);
+    other.record(5);
+    other.record(20);
+
+    histogram.merge(other);
+    EXPECT_EQ(histogram.count(), 3);
+    EXPECT_EQ(histogram.min(), 5);
+    EXPECT_EQ(histogram.max(), 20);
+
+    histogram.clear();
+    EXPECT_EQ(histogram.count(), 0);
+    EXPECT_EQ(histogram.percentile(90), 0);
+}
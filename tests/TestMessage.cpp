@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include "Message.h"
+#include "TimeUtils.h"
 
 class MessageTest : public ::testing::Test {
 protected:
@@ -82,6 +83,83 @@ TEST_F(MessageTest, JsonSerialization) {
     EXPECT_EQ(restored.direction(), original.direction());
 }
 
+TEST_F(MessageTest, ChunkSerialization) {
+    Message original("COM3", "abcdef", MessageDirection::Received);
+    EXPECT_EQ(original.chunkCount(), 0);
+    EXPECT_FALSE(original.toJson().contains("chunks"));
+    
+    original.setChunks({{0, 0}, {2, 1500000}, {5, 9000000000LL}});
+    Message restored = Message::fromJson(original.toJson());
+    
+    ASSERT_EQ(restored.chunkCount(), 3);
+    EXPECT_EQ(restored.chunks().at(1).byteOffset, 2);
+    EXPECT_EQ(restored.chunks().at(1).timeOffsetNs, 1500000);
+    EXPECT_EQ(restored.chunks().at(2).timeOffsetNs, 9000000000LL);
+}
+
+TEST_F(MessageTest, ChecksumStatusSerialization) {
+    Message original("COM3", "abc", MessageDirection::Received);
+    EXPECT_EQ(original.checksumStatus(), ChecksumStatus::Unchecked);
+    EXPECT_FALSE(original.toJson().contains("checksum"));
+    
+    original.setChecksumStatus(ChecksumStatus::Invalid);
+    Message restored = Message::fromJson(original.toJson());
+    EXPECT_EQ(restored.checksumStatus(), ChecksumStatus::Invalid);
+}
+
+TEST_F(MessageTest, DecodedRecords) {
+    Message original("COM3", QByteArray::fromHex("0106000100FF"), MessageDirection::Received);
+    EXPECT_EQ(original.displayText(MessageFormat::Decoded), original.toHex());
+    EXPECT_FALSE(original.toJson().contains("records"));
+    
+    DecodedRecord record("Modbus RTU", "Slave 1 Write Single Register response");
+    record.addField("Address", "1");
+    record.addField("Value", "255");
+    record.setValid(false);
+    original.setRecords({record});
+    EXPECT_EQ(original.displayText(MessageFormat::Decoded),
+              "Modbus RTU: Slave 1 Write Single Register response (bad checksum)\n"
+              "  Address: 1\n"
+              "  Value: 255");
+    
+    Message restored = Message::fromJson(original.toJson());
+    ASSERT_EQ(restored.recordCount(), 1);
+    EXPECT_EQ(restored.records().at(0), record);
+    EXPECT_FALSE(restored.records().at(0).isValid());
+}
+
+TEST_F(MessageTest, TimestampKeepsNanoseconds) {
+    qint64 stamp = 1767225600123456789LL;
+    Message original("COM3", "data", MessageDirection::Received, stamp);
+    EXPECT_EQ(original.timestampNs(), stamp);
+    EXPECT_EQ(original.timestamp().toMSecsSinceEpoch(), 1767225600123LL);
+    
+    Message restored = Message::fromJson(original.toJson());
+    EXPECT_EQ(restored.timestampNs(), stamp);
+}
+
+TEST_F(MessageTest, LegacyJsonTimestamp) {
+    // History saved before nanosecond timestamps only has the ISO date
+    QDateTime saved(QDate(2026, 1, 5), QTime(14, 30, 15));
+    QJsonObject json = Message("COM3", "data", MessageDirection::Received).toJson();
+    json.remove("timestampNs");
+    json["timestamp"] = saved.toString(Qt::ISODate);
+    
+    Message restored = Message::fromJson(json);
+    EXPECT_EQ(restored.timestamp(), saved);
+}
+
+TEST_F(MessageTest, TimestampsFollowMonotonicClock) {
+    qint64 before = TimeUtils::timestampNs();
+    Message first("COM1", "a", MessageDirection::Received);
+    Message second("COM1", "b", MessageDirection::Received);
+    qint64 after = TimeUtils::timestampNs();
+    
+    EXPECT_LE(before, first.timestampNs());
+    EXPECT_LE(first.timestampNs(), second.timestampNs());
+    EXPECT_LE(second.timestampNs(), after);
+}
+
 TEST_F(MessageTest, EqualityOperator) {
     Message msg1("COM1", "data", MessageDirection::Sent);
     Message msg2("COM1", "data", MessageDirection::Sent);
@@ -0,0 +1,334 @@
+#include <gtest/gtest.h>
+#include "MessageManager.h"
+#include "Rfc2217Codec.h"
+#include "SerialPortManager.h"
+#include "TestSupport.h"
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QNetworkDatagram>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QThread>
+#include <QUdpSocket>
+
+namespace {
+// Collects bytes from a listener-side socket until at least `size` have arrived
+QByteArray readAtLeast(QIODevice* device, int size)
+{
+    QByteArray received;
+    waitUntil([&]() {
+        received.append(device->readAll());
+        return received.size() >= size;
+    });
+    return received;
+}
+}
+
+class NetworkTransportTest : public ::testing::Test {
+protected:
+    SerialPortManager* portManager;
+    MessageManager* messageManager;
+
+    void SetUp() override {
+        portManager = new SerialPortManager();
+        messageManager = new MessageManager();
+
+        // Same wiring as MainWindow
+        QObject::connect(portManager, &SerialPortManager::userMessageReceived, messageManager,
+                         [this](const QString&, const Message& message) { messageManager->addMessage(message); });
+    }
+
+    void TearDown() override {
+        delete messageManager;
+        delete portManager;
+    }
+
+    SerialPortUser* connectEndpoint(const QString& name, const TransportConfig& transport)
+    {
+        SerialPortInfo info(name);
+        info.setTransport(transport);
+        info.setFraming(FramingConfig(FramingMode::Delimiter));
+        portManager->createUser(info);
+        if (!portManager->connectPort(name)) {
+            return nullptr;
+        }
+        return portManager->getUser(name);
+    }
+
+    static TransportConfig endpoint(TransportType type, const QString& address, int port = 0)
+    {
+        TransportConfig config(type);
+        config.setAddress(address);
+        config.setPort(port);
+        return config;
+    }
+};
+
+TEST_F(NetworkTransportTest, TcpExchangesFrames) {
+    QTcpServer server;
+    ASSERT_TRUE(server.listen(QHostAddress::LocalHost));
+
+    SerialPortUser* user = connectEndpoint("bridge", endpoint(TransportType::Tcp, "127.0.0.1", server.serverPort()));
+    ASSERT_NE(user, nullptr);
+    EXPECT_TRUE(user->isOnline());
+
+    ASSERT_TRUE(waitUntil([&]() { return server.hasPendingConnections(); }));
+    QTcpSocket* peer = server.nextPendingConnection();
+
+    peer->write("hello\nworld\n");
+    ASSERT_TRUE(waitUntil([&]() { return messageManager->messageCount("bridge") == 2; }));
+    QList<Message> messages = messageManager->getMessages("bridge");
+    EXPECT_EQ(messages.at(0).data(), QByteArray("hello"));
+    EXPECT_EQ(messages.at(1).data(), QByteArray("world"));
+
+    ASSERT_TRUE(user->sendData("ping"));
+    EXPECT_EQ(readAtLeast(peer, 4), QByteArray("ping"));
+}
+
+TEST_F(NetworkTransportTest, TcpRemoteCloseTakesPortOffline) {
+    QTcpServer server;
+    ASSERT_TRUE(server.listen(QHostAddress::LocalHost));
+
+    SerialPortUser* user = connectEndpoint("bridge", endpoint(TransportType::Tcp, "127.0.0.1", server.serverPort()));
+    ASSERT_NE(user, nullptr);
+    ASSERT_TRUE(waitUntil([&]() { return server.hasPendingConnections(); }));
+    QTcpSocket* peer = server.nextPendingConnection();
+
+    peer->disconnectFromHost();
+    EXPECT_TRUE(waitUntil([&]() { return !user->isOnline(); }));
+}
+
+TEST_F(NetworkTransportTest, TcpConnectFailureIsReported) {
+    // Grab a free port, then stop listening on it
+    QTcpServer server;
+    ASSERT_TRUE(server.listen(QHostAddress::LocalHost));
+    quint16 port = server.serverPort();
+    server.close();
+
+    SerialPortInfo info("bridge");
+    info.setTransport(endpoint(TransportType::Tcp, "127.0.0.1", port));
+    portManager->createUser(info);
+
+    EXPECT_FALSE(portManager->connectPort("bridge"));
+    EXPECT_FALSE(portManager->getUser("bridge")->errorString().isEmpty());
+}
+
+TEST_F(NetworkTransportTest, PendingConnectLeavesThreadFree) {
+    ASSERT_TRUE(portManager->setIoThreadCount(1));
+    QTcpServer server;
+    ASSERT_TRUE(server.listen(QHostAddress::LocalHost));
+
+    // TEST-NET-1 is never routed; its connect stays pending on the only I/O thread
+    SerialPortInfo info("unreachable");
+    info.setTransport(endpoint(TransportType::Tcp, "192.0.2.1", 9));
+    SerialPortUser* unreachable = portManager->createUser(info);
+    int finished = 0;
+    QObject::connect(unreachable, &SerialPortUser::connectFinished, [&finished](bool) { finished++; });
+    unreachable->connectAsync();
+
+    QElapsedTimer elapsed;
+    elapsed.start();
+    SerialPortUser* user = connectEndpoint("bridge", endpoint(TransportType::Tcp, "127.0.0.1", server.serverPort()));
+    ASSERT_NE(user, nullptr);
+    EXPECT_LT(elapsed.elapsed(), 1000);
+
+    // Disconnecting cancels the pending connect
+    unreachable->disconnect();
+    ASSERT_TRUE(waitUntil([&finished]() { return finished == 1; }));
+    EXPECT_FALSE(unreachable->isOnline());
+}
+
+TEST_F(NetworkTransportTest, Rfc2217ConfiguresAndEscapes) {
+    QTcpServer server;
+    ASSERT_TRUE(server.listen(QHostAddress::LocalHost));
+
+    SerialPortUser* user = connectEndpoint("remote", endpoint(TransportType::Rfc2217, "127.0.0.1", server.serverPort()));
+    ASSERT_NE(user, nullptr);
+    ASSERT_TRUE(waitUntil([&]() { return server.hasPendingConnections(); }));
+    QTcpSocket* peer = server.nextPendingConnection();
+
+    // The handshake carries the port's baud rate (115200)
+    Rfc2217Codec expected;
+    QByteArray handshake = expected.handshake(user->info());
+    EXPECT_EQ(readAtLeast(peer, handshake.size()), handshake);
+
+    // Negotiation and escaped 0xFF inside the data stream
+    QByteArray incoming("a");
+    incoming.append(static_cast<char>(0xFF));
+    incoming.append(static_cast<char>(0xFF));
+    incoming.append("b");
+    incoming.append(static_cast<char>(0xFF));
+    incoming.append(static_cast<char>(0xFD));
+    incoming.append(static_cast<char>(0x01));
+    incoming.append("c\n");
+    peer->write(incoming);
+
+    ASSERT_TRUE(waitUntil([&]() { return messageManager->messageCount("remote") == 1; }));
+    EXPECT_EQ(messageManager->getMessages("remote").at(0).data(), QByteArray("a\xFF" "bc"));
+
+    // The refused option is answered before the payload goes out escaped
+    ASSERT_TRUE(user->sendData(QByteArray("\xFF", 1)));
+    QByteArray answer = readAtLeast(peer, 5);
+    EXPECT_EQ(answer, QByteArray("\xFF\xFC\x01\xFF\xFF", 5));
+}
+
+TEST_F(NetworkTransportTest, UdpKeepsDatagramBoundaries) {
+    QUdpSocket peer;
+    ASSERT_TRUE(peer.bind(QHostAddress::LocalHost, 0));
+
+    SerialPortUser* user = connectEndpoint("sensor", endpoint(TransportType::Udp, "127.0.0.1", peer.localPort()));
+    ASSERT_NE(user, nullptr);
+
+    ASSERT_TRUE(user->sendData("one"));
+    ASSERT_TRUE(user->sendData("two"));
+
+    QList<QNetworkDatagram> datagrams;
+    ASSERT_TRUE(waitUntil([&]() {
+        while (peer.hasPendingDatagrams()) {
+            datagrams.append(peer.receiveDatagram());
+        }
+        return datagrams.size() >= 2;
+    }));
+    EXPECT_EQ(datagrams.at(0).data(), QByteArray("one"));
+    EXPECT_EQ(datagrams.at(1).data(), QByteArray("two"));
+
+    // Reply to wherever the port sent from
+    peer.writeDatagram(datagrams.at(0).makeReply("pong\n"));
+    ASSERT_TRUE(waitUntil([&]() { return messageManager->messageCount("sensor") == 1; }));
+    EXPECT_EQ(messageManager->getMessages("sensor").at(0).data(), QByteArray("pong"));
+}
+
+TEST_F(NetworkTransportTest, UnixSocketExchangesFrames) {
+    QLocalServer server;
+    QString name = QString("serialchat-test-%1").arg(QCoreApplication::applicationPid());
+    QLocalServer::removeServer(name);
+    ASSERT_TRUE(server.listen(name));
+
+    SerialPortUser* user = connectEndpoint("sim", endpoint(TransportType::UnixSocket, server.fullServerName()));
+    ASSERT_NE(user, nullptr);
+    ASSERT_TRUE(waitUntil([&]() { return server.hasPendingConnections(); }));
+    QLocalSocket* peer = server.nextPendingConnection();
+
+    peer->write("status\n");
+    ASSERT_TRUE(waitUntil([&]() { return messageManager->messageCount("sim") == 1; }));
+    EXPECT_EQ(messageManager->getMessages("sim").at(0).data(), QByteArray("status"));
+
+    ASSERT_TRUE(user->sendData("ok"));
+    EXPECT_EQ(readAtLeast(peer, 2), QByteArray("ok"));
+}
+
+TEST_F(NetworkTransportTest, FramesAreStampedAtReadTime) {
+    QTcpServer server;
+    ASSERT_TRUE(server.listen(QHostAddress::LocalHost));
+
+    SerialPortUser* user = connectEndpoint("bridge", endpoint(TransportType::Tcp, "127.0.0.1", server.serverPort()));
+    ASSERT_NE(user, nullptr);
+    ASSERT_TRUE(waitUntil([&]() { return server.hasPendingConnections(); }));
+    QTcpSocket* peer = server.nextPendingConnection();
+
+    // Both frames arrive in one read and share its timestamp
+    peer->write("one\ntwo\n");
+    ASSERT_TRUE(waitUntil([&]() { return messageManager->messageCount("bridge") == 2; }));
+
+    // The GUI thread is busy for a while before the next frame is even sent
+    QThread::msleep(50);
+    peer->write("three\n");
+    ASSERT_TRUE(waitUntil([&]() { return messageManager->messageCount("bridge") == 3; }));
+
+    QList<Message> messages = messageManager->getMessages("bridge");
+    EXPECT_EQ(messages.at(0).timestampNs(), messages.at(1).timestampNs());
+    EXPECT_GE(messages.at(2).timestampNs() - messages.at(1).timestampNs(), 50000000);
+}
+
+TEST_F(NetworkTransportTest, TrafficIsCounted) {
+    QTcpServer server;
+    ASSERT_TRUE(server.listen(QHostAddress::LocalHost));
+
+    SerialPortUser* user = connectEndpoint("bridge", endpoint(TransportType::Tcp, "127.0.0.1", server.serverPort()));
+    ASSERT_NE(user, nullptr);
+    ASSERT_TRUE(waitUntil([&]() { return server.hasPendingConnections(); }));
+    QTcpSocket* peer = server.nextPendingConnection();
+
+    peer->write("one\ntwo\nthree\n");
+    ASSERT_TRUE(waitUntil([&]() { return messageManager->messageCount("bridge") == 3; }));
+    ASSERT_TRUE(user->sendData("ping"));
+    EXPECT_EQ(readAtLeast(peer, 4), QByteArray("ping"));
+    ASSERT_TRUE(waitUntil([&]() { return user->metrics().txFrames == 1; }));
+
+    PortMetricsSnapshot metrics = user->metrics();
+    EXPECT_EQ(metrics.portName, "bridge");
+    EXPECT_EQ(metrics.status, PortStatus::Online);
+    EXPECT_EQ(metrics.rxBytes, 14);
+    EXPECT_EQ(metrics.rxFrames, 3);
+    EXPECT_EQ(metrics.txBytes, 4);
+    EXPECT_GE(metrics.txQueuePeak, 1);
+
+    // Rates appear once the worker has sampled
+    ASSERT_TRUE(waitUntil([&]() { return user->metrics().rxByteRate.oneSecond > 0; }));
+
+    QList<PortMetricsSnapshot> snapshots = portManager->metricsSnapshot();
+    ASSERT_EQ(snapshots.size(), 1);
+    EXPECT_EQ(snapshots.first().rxBytes, 14);
+
+    // Totals stay readable after a disconnect, rates do not
+    user->disconnect();
+    metrics = user->metrics();
+    EXPECT_EQ(metrics.rxBytes, 14);
+    EXPECT_DOUBLE_EQ(metrics.rxByteRate.oneSecond, 0.0);
+}
+
+TEST_F(NetworkTransportTest, BulkConnectReportsEveryPort) {
+    QTcpServer first;
+    QTcpServer second;
+    QTcpServer closed;
+    ASSERT_TRUE(first.listen(QHostAddress::LocalHost));
+    ASSERT_TRUE(second.listen(QHostAddress::LocalHost));
+    ASSERT_TRUE(closed.listen(QHostAddress::LocalHost));
+    quint16 closedPort = closed.serverPort();
+    closed.close();
+
+    const QList<QPair<QString, quint16>> endpoints = {
+        {"first", first.serverPort()}, {"second", second.serverPort()}, {"refused", closedPort}};
+    for (const auto& entry : endpoints) {
+        SerialPortInfo info(entry.first);
+        info.setTransport(endpoint(TransportType::Tcp, "127.0.0.1", entry.second));
+        portManager->createUser(info);
+    }
+
+    QList<PortConnectResult> results;
+    int completions = 0;
+    QObject::connect(portManager, &SerialPortManager::portsConnected,
+                     [&](const QList<PortConnectResult>& batch, qint64) {
+                         results = batch;
+                         completions++;
+                     });
+
+    ASSERT_TRUE(portManager->connectPorts({"first", "second", "refused"}));
+    EXPECT_FALSE(portManager->connectPorts({"first"}));
+    ASSERT_TRUE(waitUntil([&]() { return completions == 1; }));
+    EXPECT_FALSE(portManager->isBulkConnectPending());
+
+    // Results keep the requested order
+    ASSERT_EQ(results.size(), 3);
+    EXPECT_EQ(results.at(0).portName, "first");
+    EXPECT_TRUE(results.at(0).ok);
+    EXPECT_TRUE(results.at(1).ok);
+    EXPECT_FALSE(results.at(2).ok);
+    EXPECT_FALSE(results.at(2).error.isEmpty());
+    for (const PortConnectResult& result : results) {
+        EXPECT_GT(result.completedNs, 0);
+    }
+    EXPECT_TRUE(portManager->getUser("first")->isOnline());
+    EXPECT_TRUE(portManager->getUser("second")->isOnline());
+
+    // A port that is already online completes at once
+    ASSERT_TRUE(portManager->connectPorts({"first"}));
+    EXPECT_EQ(completions, 2);
+    EXPECT_TRUE(results.at(0).ok);
+
+    portManager->disconnectPorts({"first", "second"});
+    EXPECT_FALSE(portManager->getUser("first")->isOnline());
+    EXPECT_FALSE(portManager->getUser("second")->isOnline());
+}
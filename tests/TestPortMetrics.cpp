@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+#include "PortMetrics.h"
+#include <cmath>
+
+namespace {
+const qint64 NS_PER_SECOND = 1000000000;
+const qint64 SAMPLE_INTERVAL_NS = 250000000;
+}
+
+class RateMeterTest : public ::testing::Test {
+protected:
+    RateMeter meter;
+
+    // Feeds a constant rate for the given number of samples, starting at `count`
+    qint64 feed(qint64 count, qint64* now, double perSecond, int samples)
+    {
+        for (int i = 0; i < samples; ++i) {
+            *now += SAMPLE_INTERVAL_NS;
+            count += static_cast<qint64>(perSecond * SAMPLE_INTERVAL_NS / NS_PER_SECOND);
+            meter.update(count, *now);
+        }
+        return count;
+    }
+};
+
+TEST_F(RateMeterTest, FirstSampleSeedsAllAverages) {
+    meter.reset(0, 0);
+    meter.update(500, NS_PER_SECOND / 2);
+
+    RateAverages averages = meter.averages();
+    EXPECT_DOUBLE_EQ(averages.oneSecond, 1000.0);
+    EXPECT_DOUBLE_EQ(averages.tenSeconds, 1000.0);
+    EXPECT_DOUBLE_EQ(averages.oneMinute, 1000.0);
+}
+
+TEST_F(RateMeterTest, ConstantRateIsStable) {
+    qint64 now = 0;
+    meter.reset(0, now);
+    feed(0, &now, 4000.0, 100);
+
+    RateAverages averages = meter.averages();
+    EXPECT_NEAR(averages.oneSecond, 4000.0, 1e-6);
+    EXPECT_NEAR(averages.tenSeconds, 4000.0, 1e-6);
+    EXPECT_NEAR(averages.oneMinute, 4000.0, 1e-6);
+}
+
+TEST_F(RateMeterTest, ShortWindowReactsFirst) {
+    qint64 now = 0;
+    meter.reset(0, now);
+    qint64 count = feed(0, &now, 1000.0, 40);
+
+    // One second of silence: the 1 s average falls to 1/e, the others barely move
+    feed(count, &now, 0.0, 4);
+    RateAverages averages = meter.averages();
+    EXPECT_NEAR(averages.oneSecond, 1000.0 * std::exp(-1.0), 1e-6);
+    EXPECT_NEAR(averages.tenSeconds, 1000.0 * std::exp(-0.1), 1e-6);
+    EXPECT_NEAR(averages.oneMinute, 1000.0 * std::exp(-1.0 / 60), 1e-6);
+}
+
+TEST_F(RateMeterTest, UnevenIntervalsAreWeightedByTime) {
+    // Two half-second samples and one one-second sample at the same rate decay alike
+    RateMeter other;
+    meter.reset(0, 0);
+    other.reset(0, 0);
+    meter.update(0, NS_PER_SECOND);
+    other.update(0, NS_PER_SECOND);
+
+    meter.update(500, NS_PER_SECOND * 3 / 2);
+    meter.update(1000, NS_PER_SECOND * 2);
+    other.update(1000, NS_PER_SECOND * 2);
+    EXPECT_NEAR(meter.averages().tenSeconds, other.averages().tenSeconds, 1e-9);
+}
+
+TEST_F(RateMeterTest, ResetClearsAverages) {
+    meter.reset(0, 0);
+    meter.update(1000, NS_PER_SECOND);
+    meter.reset(1000, NS_PER_SECOND);
+    EXPECT_DOUBLE_EQ(meter.averages().oneSecond, 0.0);
+
+    meter.update(1000, 2 * NS_PER_SECOND);
+    EXPECT_DOUBLE_EQ(meter.averages().oneSecond, 0.0);
+}
+
+class PortMetricsTest : public ::testing::Test {
+protected:
+    PortMetrics metrics;
+
+    void SetUp() override {
+        metrics.reset(0);
+    }
+};
+
+TEST_F(PortMetricsTest, CountsAndPeaks) {
+    metrics.countReceived(100);
+    metrics.countReceived(50);
+    metrics.countReceivedFrame();
+    metrics.countSent(7);
+    metrics.countSentFrame();
+    metrics.countSentFrame();
+    metrics.recordReceiveQueue(3);
+    metrics.recordReceiveQueue(1);
+    metrics.recordTransmitQueue(12);
+
+    LineErrorCounts errors;
+    errors.parity = 1;
+    errors.framing = 2;
+    errors.overrun = 3;
+    metrics.setLineErrors(errors);
+
+    PortMetricsSnapshot snapshot;
+    metrics.snapshot(&snapshot);
+    EXPECT_EQ(snapshot.rxBytes, 150);
+    EXPECT_EQ(snapshot.rxFrames, 1);
+    EXPECT_EQ(snapshot.txBytes, 7);
+    EXPECT_EQ(snapshot.txFrames, 2);
+    EXPECT_EQ(snapshot.rxQueuePeak, 3);
+    EXPECT_EQ(snapshot.txQueuePeak, 12);
+    EXPECT_EQ(snapshot.lineErrors.parity, 1);
+    EXPECT_EQ(snapshot.lineErrors.framing, 2);
+    EXPECT_EQ(snapshot.lineErrors.overrun, 3);
+
+    metrics.reset(0);
+    metrics.snapshot(&snapshot);
+    EXPECT_EQ(snapshot.rxBytes, 0);
+    EXPECT_EQ(snapshot.txQueuePeak, 0);
+    EXPECT_EQ(snapshot.lineErrors.overrun, 0);
+}
+
+TEST_F(PortMetricsTest, SampleDerivesRates) {
+    metrics.countReceived(2000);
+    metrics.countReceivedFrame();
+    metrics.countSent(500);
+    metrics.sample(NS_PER_SECOND);
+
+    PortMetricsSnapshot snapshot;
+    metrics.snapshot(&snapshot);
+    EXPECT_DOUBLE_EQ(snapshot.rxByteRate.oneSecond, 2000.0);
+    EXPECT_DOUBLE_EQ(snapshot.rxFrameRate.oneSecond, 1.0);
+    EXPECT_DOUBLE_EQ(snapshot.txByteRate.oneSecond, 500.0);
+    EXPECT_DOUBLE_EQ(snapshot.txFrameRate.oneSecond, 0.0);
+}
+
+TEST_F(PortMetricsTest, LineErrorsSubtractAndAdd) {
+    LineErrorCounts base;
+    base.parity = 1;
+    base.overrun = 2;
+    LineErrorCounts now;
+    now.parity = 4;
+    now.framing = 1;
+    now.overrun = 2;
+
+    LineErrorCounts delta = now - base;
+    EXPECT_EQ(delta.parity, 3);
+    EXPECT_EQ(delta.framing, 1);
+    EXPECT_EQ(delta.overrun, 0);
+
+    LineErrorCounts sum = delta + base;
+    EXPECT_EQ(sum.parity, now.parity);
+    EXPECT_EQ(sum.framing, now.framing);
+}
@@ -0,0 +1,180 @@
+#include <gtest/gtest.h>
+#include "Checksum.h"
+#include "ModbusRtuDecoder.h"
+#include "NmeaDecoder.h"
+#include "SlipDecoder.h"
+
+class ProtocolDecoderTest : public ::testing::Test {
+protected:
+    // Feed data one byte at a time to exercise units split across reads
+    static QVector<DecodedRecord> feedBytewise(ProtocolDecoder& decoder, const QByteArray& data)
+    {
+        QVector<DecodedRecord> records;
+        for (int i = 0; i < data.size(); ++i) {
+            decoder.feed(data.constData() + i, 1, records);
+        }
+        return records;
+    }
+
+    static QVector<DecodedRecord> feedAll(ProtocolDecoder& decoder, const QByteArray& data)
+    {
+        QVector<DecodedRecord> records;
+        decoder.feed(data, records);
+        return records;
+    }
+
+    static QByteArray modbus(const char* hex)
+    {
+        return Checksum::append(ChecksumType::Crc16Modbus, QByteArray::fromHex(hex));
+    }
+};
+
+TEST_F(ProtocolDecoderTest, Factory) {
+    EXPECT_EQ(ProtocolDecoder::create(DecoderType::None, MessageDirection::Received), nullptr);
+
+    const DecoderType types[] = {DecoderType::ModbusRtu, DecoderType::Nmea0183, DecoderType::Slip};
+    for (DecoderType type : types) {
+        ProtocolDecoder* decoder = ProtocolDecoder::create(type, MessageDirection::Sent);
+        ASSERT_NE(decoder, nullptr);
+        EXPECT_EQ(decoder->type(), type);
+        EXPECT_EQ(decoder->direction(), MessageDirection::Sent);
+        delete decoder;
+    }
+}
+
+TEST_F(ProtocolDecoderTest, ModbusRequestAndResponse) {
+    // Read two holding registers from address 0x006B of slave 17
+    ModbusRtuDecoder master(MessageDirection::Sent);
+    QVector<DecodedRecord> requests = feedAll(master, modbus("1103006B0002"));
+    ASSERT_EQ(requests.size(), 1);
+    EXPECT_EQ(requests.at(0).protocol(), "Modbus RTU");
+    EXPECT_EQ(requests.at(0).summary(), "Slave 17 Read Holding Registers request");
+    EXPECT_EQ(requests.at(0).field("Address"), "107");
+    EXPECT_EQ(requests.at(0).field("Quantity"), "2");
+
+    ModbusRtuDecoder slave(MessageDirection::Received);
+    QVector<DecodedRecord> responses = feedAll(slave, modbus("110304022B0064"));
+    ASSERT_EQ(responses.size(), 1);
+    EXPECT_EQ(responses.at(0).summary(), "Slave 17 Read Holding Registers response");
+    EXPECT_EQ(responses.at(0).field("Registers"), "555 100");
+}
+
+TEST_F(ProtocolDecoderTest, ModbusFramesSplitAcrossReads) {
+    ModbusRtuDecoder decoder;
+    QByteArray stream = modbus("01050013FF00") + modbus("010F0013000A02CD01") + modbus("018302");
+    QVector<DecodedRecord> records = feedBytewise(decoder, stream);
+
+    // Received traffic: write responses echo address and quantity
+    ASSERT_EQ(records.size(), 3);
+    EXPECT_EQ(records.at(0).field("Value"), "ON");
+    EXPECT_EQ(records.at(1).summary(), "Slave 1 Write Multiple Coils request");
+    EXPECT_EQ(records.at(1).field("Values"), "1 0 1 1 0 0 1 1 1 0");
+    EXPECT_EQ(records.at(2).summary(), "Slave 1 Read Holding Registers exception");
+    EXPECT_EQ(records.at(2).field("Exception"), "2 (Illegal Data Address)");
+    EXPECT_EQ(decoder.recordCount(), 3);
+    EXPECT_EQ(decoder.errorCount(), 0);
+}
+
+TEST_F(ProtocolDecoderTest, ModbusResynchronises) {
+    ModbusRtuDecoder decoder;
+    QByteArray frame = modbus("0106000100FF");
+    QByteArray corrupted = frame;
+    corrupted[4] = static_cast<char>(corrupted[4] ^ 0x01);
+
+    QVector<DecodedRecord> records = feedAll(decoder, QByteArray::fromHex("FFFE") + corrupted + frame);
+    ASSERT_EQ(records.size(), 1);
+    EXPECT_EQ(records.at(0).field("Value"), "255");
+    EXPECT_GE(decoder.errorCount(), 1);
+}
+
+TEST_F(ProtocolDecoderTest, ModbusFinishDropsPartialFrame) {
+    ModbusRtuDecoder decoder;
+    QVector<DecodedRecord> records = feedAll(decoder, modbus("0103000A0001").left(5));
+    EXPECT_TRUE(records.isEmpty());
+    EXPECT_EQ(decoder.finish(records), 0);
+    EXPECT_EQ(decoder.errorCount(), 1);
+
+    // The next frame starts clean
+    records = feedAll(decoder, modbus("0103000A0001"));
+    EXPECT_EQ(records.size(), 1);
+}
+
+TEST_F(ProtocolDecoderTest, NmeaSentences) {
+    NmeaDecoder decoder;
+    QByteArray stream = "noise$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*47\r\n"
+                        "$GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W*6A\r\n";
+    QVector<DecodedRecord> records = feedBytewise(decoder, stream);
+    ASSERT_EQ(records.size(), 2);
+
+    const DecodedRecord& gga = records.at(0);
+    EXPECT_EQ(gga.protocol(), "NMEA 0183");
+    EXPECT_TRUE(gga.isValid());
+    EXPECT_EQ(gga.summary(), "GPGGA Fix data");
+    EXPECT_EQ(gga.field("Talker"), "GP");
+    EXPECT_EQ(gga.field("Time"), "12:35:19");
+    EXPECT_EQ(gga.field("Latitude"), "48.117300 N");
+    EXPECT_EQ(gga.field("Longitude"), "11.516667 E");
+    EXPECT_EQ(gga.field("Satellites"), "08");
+    EXPECT_EQ(gga.field("Altitude"), "545.4 M");
+
+    const DecodedRecord& rmc = records.at(1);
+    EXPECT_TRUE(rmc.isValid());
+    EXPECT_EQ(rmc.field("Speed"), "022.4 kn");
+    EXPECT_EQ(rmc.field("Date"), "1994-03-23");
+}
+
+TEST_F(ProtocolDecoderTest, NmeaChecksumMismatch) {
+    NmeaDecoder decoder;
+    QVector<DecodedRecord> records = feedAll(decoder, "$GPGLL,4916.45,N,12311.12,W,225444,A*00\r\n");
+    ASSERT_EQ(records.size(), 1);
+    EXPECT_FALSE(records.at(0).isValid());
+    EXPECT_EQ(records.at(0).field("Latitude"), "49.274167 N");
+}
+
+TEST_F(ProtocolDecoderTest, NmeaFinishCompletesFramedSentence) {
+    // Delimiter framing has already stripped CR/LF
+    NmeaDecoder decoder;
+    QVector<DecodedRecord> records = feedAll(decoder, "$PGRME,15.0,M,45.0,M,25.0,M");
+    EXPECT_TRUE(records.isEmpty());
+    ASSERT_EQ(decoder.finish(records), 1);
+    EXPECT_EQ(records.at(0).field("Talker"), "P");
+    EXPECT_EQ(records.at(0).field("1"), "15.0");
+}
+
+TEST_F(ProtocolDecoderTest, NmeaTruncatedSentence) {
+    NmeaDecoder decoder;
+    QVector<DecodedRecord> records = feedAll(decoder, "$GPGGA,1235$GPGLL,4916.45,N,12311.12,W,225444,A\r\n");
+    ASSERT_EQ(records.size(), 1);
+    EXPECT_EQ(records.at(0).summary(), "GPGLL Geographic position");
+    EXPECT_EQ(decoder.errorCount(), 1);
+}
+
+TEST_F(ProtocolDecoderTest, SlipFrames) {
+    SlipDecoder decoder;
+    QByteArray stream = QByteArray::fromHex("C00102DBDC03DBDDC0C0C0");
+    QVector<DecodedRecord> records = feedBytewise(decoder, stream);
+    ASSERT_EQ(records.size(), 1);
+    EXPECT_EQ(records.at(0).protocol(), "SLIP");
+    EXPECT_EQ(records.at(0).field("Length"), "5");
+    EXPECT_EQ(records.at(0).field("Payload"), "01 02 C0 03 DB");
+}
+
+TEST_F(ProtocolDecoderTest, SlipIpv4Header) {
+    // UDP from 10.0.0.1 to 10.0.0.2, 28 bytes
+    QByteArray packet = QByteArray::fromHex("4500001C00000000401100000A0000010A000002"
+                                            "1F901F900008" "0000");
+    SlipDecoder decoder;
+    QVector<DecodedRecord> records = feedAll(decoder, packet + QByteArray::fromHex("C0"));
+    ASSERT_EQ(records.size(), 1);
+    EXPECT_EQ(records.at(0).summary(), "28 bytes, IPv4 UDP 10.0.0.1 > 10.0.0.2");
+    EXPECT_EQ(records.at(0).field("TTL"), "64");
+    EXPECT_EQ(records.at(0).field("Total length"), "28");
+}
+
+TEST_F(ProtocolDecoderTest, SlipInvalidEscape) {
+    SlipDecoder decoder;
+    QVector<DecodedRecord> records = feedAll(decoder, QByteArray::fromHex("0102DB05C00304C0"));
+    ASSERT_EQ(records.size(), 1);
+    EXPECT_EQ(records.at(0).field("Payload"), "03 04");
+    EXPECT_EQ(decoder.errorCount(), 1);
+}
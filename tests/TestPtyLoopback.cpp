@@ -0,0 +1,196 @@
+#include <gtest/gtest.h>
+#include "ChatGroup.h"
+#include "MessageManager.h"
+#include "SerialPortManager.h"
+#include "TestSupport.h"
+#include <QCoreApplication>
+#include <QThread>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+// The device side of a loopback port
+class PeerDevice {
+public:
+    explicit PeerDevice(const QString& path)
+        : m_fd(::open(path.toLocal8Bit().constData(), O_RDWR | O_NOCTTY | O_NONBLOCK))
+    {
+    }
+
+    ~PeerDevice()
+    {
+        if (m_fd >= 0) {
+            ::close(m_fd);
+        }
+    }
+
+    bool isOpen() const { return m_fd >= 0; }
+
+    bool write(const QByteArray& data)
+    {
+        return writeSome(data.constData(), data.size()) == data.size();
+    }
+
+    // Returns how much the pty accepted; its input queue is only a few KiB
+    int writeSome(const char* data, int size)
+    {
+        ssize_t written = ::write(m_fd, data, static_cast<size_t>(size));
+        return written > 0 ? static_cast<int>(written) : 0;
+    }
+
+    // Collects bytes until at least `size` have arrived, then waits briefly for extras
+    QByteArray read(int size)
+    {
+        QByteArray received;
+        waitUntil([&]() {
+            poll(received);
+            return received.size() >= size;
+        });
+        QThread::msleep(20);
+        QCoreApplication::processEvents();
+        poll(received);
+        return received;
+    }
+
+private:
+    int m_fd;
+
+    void poll(QByteArray& received)
+    {
+        char buffer[4096];
+        ssize_t bytesRead = 0;
+        while ((bytesRead = ::read(m_fd, buffer, sizeof(buffer))) > 0) {
+            received.append(buffer, static_cast<int>(bytesRead));
+        }
+    }
+};
+}
+
+class PtyLoopbackTest : public ::testing::Test {
+protected:
+    SerialPortManager* portManager;
+    MessageManager* messageManager;
+
+    void SetUp() override {
+        portManager = new SerialPortManager();
+        messageManager = new MessageManager();
+
+        // Same wiring as MainWindow
+        QObject::connect(portManager, &SerialPortManager::userMessageReceived, messageManager,
+                         [this](const QString&, const Message& message) { messageManager->addMessage(message); });
+    }
+
+    void TearDown() override {
+        delete messageManager;
+        delete portManager;
+    }
+
+    SerialPortUser* connectLoopback(const QString& name)
+    {
+        SerialPortInfo info(name);
+        info.setTransport(TransportConfig(TransportType::Pty));
+        info.setFraming(FramingConfig(FramingMode::Delimiter));
+        portManager->createUser(info);
+        if (!portManager->connectPort(name)) {
+            return nullptr;
+        }
+        return portManager->getUser(name);
+    }
+};
+
+TEST_F(PtyLoopbackTest, ConnectCreatesPeerDevice) {
+    SerialPortUser* user = connectLoopback("loop0");
+    ASSERT_NE(user, nullptr);
+
+    EXPECT_TRUE(user->isOnline());
+    EXPECT_TRUE(user->peerName().startsWith("/dev/pts/"));
+    EXPECT_TRUE(portManager->hasFriend("loop0"));
+    EXPECT_EQ(portManager->onlineCount(), 1);
+
+    portManager->disconnectPort("loop0");
+    EXPECT_FALSE(user->isOnline());
+    EXPECT_TRUE(user->peerName().isEmpty());
+}
+
+TEST_F(PtyLoopbackTest, ReceivedDataReachesMessageManager) {
+    SerialPortUser* user = connectLoopback("loop0");
+    ASSERT_NE(user, nullptr);
+    PeerDevice peer(user->peerName());
+    ASSERT_TRUE(peer.isOpen());
+
+    ASSERT_TRUE(peer.write("hello\nworld\n"));
+    ASSERT_TRUE(waitUntil([&]() { return messageManager->messageCount("loop0") == 2; }));
+
+    QList<Message> messages = messageManager->getMessages("loop0");
+    EXPECT_EQ(messages.at(0).data(), QByteArray("hello"));
+    EXPECT_EQ(messages.at(1).data(), QByteArray("world"));
+    EXPECT_EQ(messages.at(0).direction(), MessageDirection::Received);
+}
+
+TEST_F(PtyLoopbackTest, SentDataReachesPeer) {
+    SerialPortUser* user = connectLoopback("loop0");
+    ASSERT_NE(user, nullptr);
+    PeerDevice peer(user->peerName());
+    ASSERT_TRUE(peer.isOpen());
+
+    int sent = 0;
+    QObject::connect(user, &SerialPortUser::messageSent, [&]() { sent++; });
+
+    ASSERT_TRUE(user->sendData("ping"));
+    EXPECT_EQ(peer.read(4), QByteArray("ping"));
+    EXPECT_TRUE(waitUntil([&]() { return sent == 1; }));
+}
+
+TEST_F(PtyLoopbackTest, ChatGroupForwardsToOtherMembers) {
+    SerialPortUser* source = connectLoopback("loop0");
+    SerialPortUser* first = connectLoopback("loop1");
+    SerialPortUser* second = connectLoopback("loop2");
+    ASSERT_NE(source, nullptr);
+    ASSERT_NE(first, nullptr);
+    ASSERT_NE(second, nullptr);
+
+    ChatGroupInfo info("Bus");
+    info.addMember("loop0");
+    info.addMember("loop1");
+    info.addMember("loop2");
+    ChatGroup group(info, portManager);
+
+    PeerDevice sourcePeer(source->peerName());
+    PeerDevice firstPeer(first->peerName());
+    PeerDevice secondPeer(second->peerName());
+
+    ASSERT_TRUE(sourcePeer.write("status?\n"));
+
+    // Each other member gets the frame exactly once
+    EXPECT_EQ(firstPeer.read(7), QByteArray("status?"));
+    EXPECT_EQ(secondPeer.read(7), QByteArray("status?"));
+    EXPECT_EQ(group.messageHistory().size(), 1);
+    EXPECT_EQ(messageManager->messageCount("loop0"), 1);
+}
+
+TEST_F(PtyLoopbackTest, ManyFramesKeepOrder) {
+    SerialPortUser* user = connectLoopback("loop0");
+    ASSERT_NE(user, nullptr);
+    PeerDevice peer(user->peerName());
+    ASSERT_TRUE(peer.isOpen());
+
+    const int count = 500;
+    QByteArray burst;
+    for (int i = 0; i < count; ++i) {
+        burst.append(QByteArray("frame ") + QByteArray::number(i) + '\n');
+    }
+
+    // The pty input queue is small, so feed it while the port drains it
+    int offset = 0;
+    ASSERT_TRUE(waitUntil([&]() {
+        if (offset < burst.size()) {
+            offset += peer.writeSome(burst.constData() + offset, burst.size() - offset);
+        }
+        return messageManager->messageCount("loop0") == count;
+    }));
+
+    QList<Message> messages = messageManager->getMessages("loop0");
+    for (int i = 0; i < count; ++i) {
+        ASSERT_EQ(messages.at(i).data(), QByteArray("frame ") + QByteArray::number(i));
+    }
+}
@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+#include "ReconnectSupervisor.h"
+#include "SerialPortManager.h"
+#include "TestSupport.h"
+
+// The TCP server stands in for a device that can be "unplugged" by dropping the connection
+class ReconnectSupervisorTest : public TcpDeviceTest {
+protected:
+    SerialPortUser* connectBridge(bool autoReconnect = true)
+    {
+        SerialPortInfo info = deviceInfo("bridge");
+        info.setAutoReconnect(autoReconnect);
+
+        SerialPortUser* user = portManager->createUser(info);
+        user->reconnectSupervisor()->setBackoff(10, 100);
+        user->reconnectSupervisor()->setJitter(0.0);
+        if (!portManager->connectPort("bridge")) {
+            return nullptr;
+        }
+        acceptPeer();
+        return user;
+    }
+
+    void dropConnection()
+    {
+        peer->disconnectFromHost();
+        peer = nullptr;
+    }
+};
+
+TEST_F(ReconnectSupervisorTest, BackoffDoublesUpToLimit) {
+    SerialPortUser user;
+    ReconnectSupervisor* supervisor = user.reconnectSupervisor();
+    supervisor->setBackoff(100, 1000);
+
+    EXPECT_EQ(supervisor->backoffDelayMs(1), 100);
+    EXPECT_EQ(supervisor->backoffDelayMs(2), 200);
+    EXPECT_EQ(supervisor->backoffDelayMs(3), 400);
+    EXPECT_EQ(supervisor->backoffDelayMs(4), 800);
+    EXPECT_EQ(supervisor->backoffDelayMs(5), 1000);
+    EXPECT_EQ(supervisor->backoffDelayMs(50), 1000);
+}
+
+TEST_F(ReconnectSupervisorTest, JitterStaysWithinFraction) {
+    SerialPortUser user;
+    ReconnectSupervisor* supervisor = user.reconnectSupervisor();
+    supervisor->setBackoff(1000, 1000);
+    supervisor->setJitter(0.25);
+
+    QList<int> delays;
+    QObject::connect(supervisor, &ReconnectSupervisor::retryScheduled,
+                     [&](int, int delayMs) { delays.append(delayMs); });
+
+    // Every loss schedules a first retry; cancel it before it fires
+    for (int i = 0; i < 20; ++i) {
+        emit user.connectionLost("lost");
+        supervisor->cancel();
+    }
+    ASSERT_EQ(delays.size(), 20);
+    for (int delay : delays) {
+        EXPECT_GE(delay, 750);
+        EXPECT_LE(delay, 1250);
+    }
+}
+
+TEST_F(ReconnectSupervisorTest, ReconnectsAfterConnectionLoss) {
+    SerialPortUser* user = connectBridge();
+    ASSERT_NE(user, nullptr);
+
+    dropConnection();
+    ASSERT_TRUE(waitUntil([&]() { return user->isReconnecting(); }));
+    EXPECT_EQ(user->status(), PortStatus::Reconnecting);
+
+    ASSERT_TRUE(waitUntil([&]() { return user->isOnline(); }));
+    ASSERT_TRUE(acceptPeer());
+    EXPECT_EQ(user->reconnectSupervisor()->reconnectCount(), 1);
+    EXPECT_FALSE(user->reconnectSupervisor()->isRetrying());
+}
+
+TEST_F(ReconnectSupervisorTest, QueuedDataIsSentAfterReconnect) {
+    SerialPortUser* user = connectBridge();
+    ASSERT_NE(user, nullptr);
+    quint16 port = server.serverPort();
+
+    // Nothing listens while the connection is down, so attempts fail
+    server.close();
+    dropConnection();
+    ASSERT_TRUE(waitUntil([&]() { return user->isReconnecting(); }));
+    EXPECT_TRUE(user->sendData("queued\n"));
+    ASSERT_TRUE(waitUntil([&]() { return user->reconnectSupervisor()->attempts() >= 2; }));
+    EXPECT_TRUE(user->isReconnecting());
+
+    ASSERT_TRUE(server.listen(QHostAddress::LocalHost, port));
+    ASSERT_TRUE(waitUntil([&]() { return user->isOnline(); }));
+    ASSERT_TRUE(acceptPeer());
+
+    QByteArray received;
+    EXPECT_TRUE(waitUntil([&]() {
+        received.append(peer->readAll());
+        return received == "queued\n";
+    }));
+    EXPECT_GT(user->reconnectSupervisor()->totalDowntimeMs(), 0);
+}
+
+TEST_F(ReconnectSupervisorTest, RemovedDeviceWaitsForHotplug) {
+    SerialPortUser* user = connectBridge();
+    ASSERT_NE(user, nullptr);
+    ReconnectSupervisor* supervisor = user->reconnectSupervisor();
+
+    supervisor->deviceRemoved();
+    dropConnection();
+    ASSERT_TRUE(waitUntil([&]() { return user->isReconnecting(); }));
+
+    // No timer-driven attempts while the device is away
+    QThread::msleep(100);
+    QCoreApplication::processEvents();
+    EXPECT_EQ(supervisor->attempts(), 0);
+
+    // The attempt is asynchronous, but starts right away
+    supervisor->deviceAdded();
+    EXPECT_EQ(supervisor->attempts(), 1);
+    ASSERT_TRUE(waitUntil([&]() { return user->isOnline(); }));
+    EXPECT_EQ(supervisor->attempts(), 1);
+    EXPECT_FALSE(supervisor->isRetrying());
+}
+
+TEST_F(ReconnectSupervisorTest, AttemptDoesNotBlockCaller) {
+    // TEST-NET-1 is never routed, so a blocking connect would wait for the full timeout
+    TransportConfig transport(TransportType::Tcp);
+    transport.setAddress("192.0.2.1");
+    transport.setPort(9);
+    SerialPortInfo info("unreachable");
+    info.setTransport(transport);
+    info.setAutoReconnect(true);
+    SerialPortUser* user = portManager->createUser(info);
+    ReconnectSupervisor* supervisor = user->reconnectSupervisor();
+
+    emit user->connectionLost("lost");
+    QElapsedTimer elapsed;
+    elapsed.start();
+    supervisor->deviceAdded();
+    EXPECT_LT(elapsed.elapsed(), 500);
+    EXPECT_EQ(supervisor->attempts(), 1);
+    supervisor->cancel();
+}
+
+TEST_F(ReconnectSupervisorTest, DisconnectStopsRetrying) {
+    SerialPortUser* user = connectBridge();
+    ASSERT_NE(user, nullptr);
+
+    server.close();
+    dropConnection();
+    ASSERT_TRUE(waitUntil([&]() { return user->isReconnecting(); }));
+
+    portManager->disconnectPort("bridge");
+    EXPECT_EQ(user->status(), PortStatus::Offline);
+    EXPECT_FALSE(user->reconnectSupervisor()->isRetrying());
+    EXPECT_FALSE(user->sendData("late"));
+}
+
+TEST_F(ReconnectSupervisorTest, DisabledAutoReconnectReportsError) {
+    SerialPortUser* user = connectBridge(false);
+    ASSERT_NE(user, nullptr);
+
+    dropConnection();
+    ASSERT_TRUE(waitUntil([&]() { return user->status() == PortStatus::Error; }));
+    EXPECT_FALSE(user->reconnectSupervisor()->isRetrying());
+}
@@ -0,0 +1,196 @@
+#include <gtest/gtest.h>
+#include "ReplayEngine.h"
+#include "SerialPortManager.h"
+#include "TestSupport.h"
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QTemporaryDir>
+
+namespace {
+const qint64 MS = 1000000;
+}
+
+// The TCP server stands in for the device the capture is replayed to
+class ReplayEngineTest : public TcpDeviceTest {
+protected:
+    ReplayEngine* engine = nullptr;
+    QByteArray received;
+    QTemporaryDir dir;
+    bool finished;
+    ReplayReport report;
+
+    void SetUp() override {
+        ASSERT_NO_FATAL_FAILURE(TcpDeviceTest::SetUp());
+        engine = new ReplayEngine(portManager);
+        finished = false;
+        QObject::connect(engine, &ReplayEngine::finished, [this](const ReplayReport& result) {
+            finished = true;
+            report = result;
+        });
+    }
+
+    void TearDown() override {
+        delete engine;
+        TcpDeviceTest::TearDown();
+    }
+
+    bool connectPort(const QString& portName)
+    {
+        if (!connectDevice(deviceInfo(portName))) {
+            return false;
+        }
+        QObject::connect(peer, &QTcpSocket::readyRead, [this]() { received.append(peer->readAll()); });
+        return true;
+    }
+
+    QString writeHistory(const QList<Message>& messages)
+    {
+        QJsonArray array;
+        for (const Message& message : messages) {
+            array.append(message.toJson());
+        }
+        QString path = dir.filePath("capture.json");
+        QFile file(path);
+        file.open(QIODevice::WriteOnly);
+        file.write(QJsonDocument(array).toJson(QJsonDocument::Indented));
+        return path;
+    }
+
+    // Received messages "A", "B", ... recorded gapMs apart, each followed by a sent poll
+    QString writeCapture(int count, qint64 gapMs)
+    {
+        QList<Message> messages;
+        qint64 start = 1767225600000000000LL;
+        for (int i = 0; i < count; ++i) {
+            qint64 at = start + i * gapMs * MS;
+            messages.append(Message("capture", QByteArray(1, static_cast<char>('A' + i)), MessageDirection::Received, at));
+            messages.append(Message("capture", "?", MessageDirection::Sent, at + MS));
+        }
+        return writeHistory(messages);
+    }
+};
+
+TEST_F(ReplayEngineTest, OriginalTimingKeepsRecordedGaps) {
+    ASSERT_TRUE(connectPort("bench"));
+    QString path = writeCapture(5, 50);
+
+    QElapsedTimer elapsed;
+    elapsed.start();
+    ASSERT_TRUE(engine->start(path, "capture", "bench"));
+    EXPECT_TRUE(engine->isRunning());
+    ASSERT_TRUE(waitUntil([&]() { return finished; }));
+    qint64 elapsedMs = elapsed.elapsed();
+
+    ASSERT_TRUE(waitUntil([&]() { return received.size() == 5; }));
+    EXPECT_EQ(received, "ABCDE");
+    EXPECT_TRUE(report.completed);
+    EXPECT_EQ(report.messageCount, 5);
+    EXPECT_EQ(report.writeCount, 5);
+    EXPECT_EQ(report.byteCount, 5);
+    EXPECT_EQ(report.targetDurationNs, 200 * MS);
+    EXPECT_GE(report.actualDurationNs, 200 * MS);
+    EXPECT_GE(elapsedMs, 200);
+
+    // Every write is measured against its own target, so lateness stays small
+    EXPECT_EQ(report.lateness.count(), 5);
+    EXPECT_LT(report.lateness.max(), 50 * MS);
+    EXPECT_LT(report.endDriftNs, 50 * MS);
+    EXPECT_FALSE(report.summary().isEmpty());
+}
+
+TEST_F(ReplayEngineTest, ScaledTimingDividesGaps) {
+    ASSERT_TRUE(connectPort("bench"));
+    QString path = writeCapture(5, 100);
+
+    ReplayOptions options;
+    options.timing = ReplayTiming::Scaled;
+    options.speed = 10.0;
+    ASSERT_TRUE(engine->start(path, "capture", "bench", options));
+    ASSERT_TRUE(waitUntil([&]() { return finished; }));
+
+    EXPECT_TRUE(report.completed);
+    EXPECT_EQ(report.writeCount, 5);
+    EXPECT_EQ(report.targetDurationNs, 40 * MS);
+    EXPECT_GE(report.actualDurationNs, 40 * MS);
+    EXPECT_LT(report.actualDurationNs, 400 * MS);
+}
+
+TEST_F(ReplayEngineTest, BurstIgnoresRecordedGaps) {
+    ASSERT_TRUE(connectPort("bench"));
+    QString path = writeCapture(5, 1000);
+
+    ReplayOptions options;
+    options.timing = ReplayTiming::Burst;
+    ASSERT_TRUE(engine->start(path, "capture", "bench", options));
+    ASSERT_TRUE(waitUntil([&]() { return finished; }, 1000));
+
+    EXPECT_TRUE(report.completed);
+    EXPECT_EQ(report.writeCount, 5);
+    EXPECT_EQ(report.lateness.count(), 0);
+    ASSERT_TRUE(waitUntil([&]() { return received.size() == 5; }));
+    EXPECT_EQ(received, "ABCDE");
+}
+
+TEST_F(ReplayEngineTest, DirectionSelectsMessages) {
+    ASSERT_TRUE(connectPort("bench"));
+    QString path = writeCapture(3, 10);
+
+    ReplayOptions options;
+    options.timing = ReplayTiming::Burst;
+    options.direction = ReplayDirection::Sent;
+    ASSERT_TRUE(engine->start(path, "capture", "bench", options));
+    ASSERT_TRUE(waitUntil([&]() { return finished; }));
+    ASSERT_TRUE(waitUntil([&]() { return received.size() == 3; }));
+    EXPECT_EQ(received, "???");
+
+    finished = false;
+    received.clear();
+    options.direction = ReplayDirection::Both;
+    ASSERT_TRUE(engine->start(path, QString(), "bench", options));
+    ASSERT_TRUE(waitUntil([&]() { return finished; }));
+    ASSERT_TRUE(waitUntil([&]() { return received.size() == 6; }));
+    EXPECT_EQ(received, "A?B?C?");
+}
+
+TEST_F(ReplayEngineTest, CoalescedMessageIsReplayedAsItsReads) {
+    ASSERT_TRUE(connectPort("bench"));
+    Message merged("capture", "head-tail", MessageDirection::Received, 1767225600000000000LL);
+    merged.setChunks({{0, 0}, {5, 30 * MS}});
+    QString path = writeHistory({merged});
+
+    ASSERT_TRUE(engine->start(path, "capture", "bench"));
+    ASSERT_TRUE(waitUntil([&]() { return finished; }));
+    EXPECT_EQ(report.messageCount, 1);
+    EXPECT_EQ(report.writeCount, 2);
+    EXPECT_EQ(report.targetDurationNs, 30 * MS);
+    ASSERT_TRUE(waitUntil([&]() { return received.size() == 9; }));
+    EXPECT_EQ(received, "head-tail");
+}
+
+TEST_F(ReplayEngineTest, StopAndFailures) {
+    ASSERT_TRUE(connectPort("bench"));
+    QString path = writeCapture(5, 1000);
+
+    // Unknown target and missing file are refused up front
+    EXPECT_FALSE(engine->start(path, "capture", "nowhere"));
+    EXPECT_FALSE(engine->start(dir.filePath("missing.json"), "capture", "bench"));
+    EXPECT_FALSE(engine->isRunning());
+
+    ASSERT_TRUE(engine->start(path, "capture", "bench"));
+    EXPECT_FALSE(engine->start(path, "capture", "bench"));
+    ASSERT_TRUE(waitUntil([&]() { return received.size() == 1; }));
+    engine->stop();
+    EXPECT_TRUE(finished);
+    EXPECT_FALSE(engine->isRunning());
+    EXPECT_FALSE(report.completed);
+    EXPECT_EQ(report.writeCount, 1);
+
+    // A target that goes away ends the replay with an error
+    finished = false;
+    ASSERT_TRUE(engine->start(path, "capture", "bench"));
+    portManager->disconnectPort("bench");
+    ASSERT_TRUE(waitUntil([&]() { return finished; }, 3000));
+    EXPECT_FALSE(report.completed);
+    EXPECT_FALSE(report.error.isEmpty());
+}
@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+#include "Rfc2217Codec.h"
+
+class Rfc2217CodecTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+    }
+
+    void TearDown() override {
+    }
+
+    static QByteArray bytes(std::initializer_list<int> values) {
+        QByteArray data;
+        for (int value : values) {
+            data.append(static_cast<char>(value));
+        }
+        return data;
+    }
+
+    // Feed data one byte at a time to exercise commands split across reads
+    static void decodeBytewise(Rfc2217Codec& codec, const QByteArray& data, QByteArray& payload, QByteArray& reply) {
+        for (int i = 0; i < data.size(); ++i) {
+            codec.decode(data.constData() + i, 1, payload, reply);
+        }
+    }
+};
+
+TEST_F(Rfc2217CodecTest, EncodeDoublesIac) {
+    QByteArray data = bytes({0x01, 0xFF, 0x02, 0xFF});
+
+    EXPECT_EQ(Rfc2217Codec::encode(data.constData(), data.size()), bytes({0x01, 0xFF, 0xFF, 0x02, 0xFF, 0xFF}));
+    EXPECT_EQ(Rfc2217Codec::encode("abc", 3), QByteArray("abc"));
+}
+
+TEST_F(Rfc2217CodecTest, HandshakeConfiguresPort) {
+    SerialPortInfo info("remote");
+    info.setBaudRate(115200);
+    info.setDataBits(QSerialPort::Data7);
+    info.setParity(QSerialPort::EvenParity);
+    info.setStopBits(QSerialPort::TwoStop);
+    info.setFlowControl(QSerialPort::HardwareControl);
+
+    Rfc2217Codec codec;
+    QByteArray handshake = codec.handshake(info);
+
+    EXPECT_TRUE(handshake.contains(bytes({255, 251, 44})));
+    EXPECT_TRUE(handshake.contains(bytes({255, 250, 44, 1, 0x00, 0x01, 0xC2, 0x00, 255, 240})));
+    EXPECT_TRUE(handshake.contains(bytes({255, 250, 44, 2, 7, 255, 240})));
+    EXPECT_TRUE(handshake.contains(bytes({255, 250, 44, 3, 3, 255, 240})));
+    EXPECT_TRUE(handshake.contains(bytes({255, 250, 44, 4, 2, 255, 240})));
+    EXPECT_TRUE(handshake.contains(bytes({255, 250, 44, 5, 3, 255, 240})));
+}
+
+TEST_F(Rfc2217CodecTest, HandshakeEscapesBaudRate) {
+    SerialPortInfo info("remote");
+    info.setBaudRate(255);
+
+    Rfc2217Codec codec;
+    EXPECT_TRUE(codec.handshake(info).contains(bytes({255, 250, 44, 1, 0, 0, 0, 255, 255, 255, 240})));
+}
+
+TEST_F(Rfc2217CodecTest, DecodeUnescapesPayload) {
+    Rfc2217Codec codec;
+    QByteArray payload;
+    QByteArray reply;
+
+    QByteArray data = bytes({'a', 255, 255, 'b'});
+    codec.decode(data.constData(), data.size(), payload, reply);
+
+    EXPECT_EQ(payload, bytes({'a', 255, 'b'}));
+    EXPECT_TRUE(reply.isEmpty());
+}
+
+TEST_F(Rfc2217CodecTest, DecodeStripsCommandsSplitAcrossReads) {
+    Rfc2217Codec codec;
+    QByteArray payload;
+    QByteArray reply;
+
+    // NOP, a subnegotiation with an escaped 0xFF, and data around them
+    QByteArray data = bytes({'x', 255, 241, 'y', 255, 250, 44, 106, 255, 255, 255, 240, 'z'});
+    decodeBytewise(codec, data, payload, reply);
+
+    EXPECT_EQ(payload, QByteArray("xyz"));
+    EXPECT_TRUE(reply.isEmpty());
+}
+
+TEST_F(Rfc2217CodecTest, AnswersOptionRequests) {
+    Rfc2217Codec codec;
+    QByteArray payload;
+    QByteArray reply;
+
+    // Accepted and refused options, each in both directions
+    QByteArray data = bytes({255, 253, 0, 255, 251, 3, 255, 253, 1, 255, 251, 24});
+    codec.decode(data.constData(), data.size(), payload, reply);
+
+    EXPECT_TRUE(payload.isEmpty());
+    EXPECT_EQ(reply, bytes({255, 251, 0, 255, 253, 3, 255, 252, 1, 255, 254, 24}));
+}
+
+TEST_F(Rfc2217CodecTest, DoesNotAcknowledgeEnabledOptions) {
+    Rfc2217Codec codec;
+    codec.handshake(SerialPortInfo("remote"));
+    QByteArray payload;
+    QByteArray reply;
+
+    // Server confirms what the handshake offered; nothing needs to be said
+    QByteArray data = bytes({255, 253, 0, 255, 253, 44, 255, 251, 3});
+    codec.decode(data.constData(), data.size(), payload, reply);
+
+    EXPECT_TRUE(reply.isEmpty());
+}
+
+TEST_F(Rfc2217CodecTest, RecordsServerBaudRate) {
+    Rfc2217Codec codec;
+    QByteArray payload;
+    QByteArray reply;
+
+    EXPECT_EQ(codec.serverBaudRate(), 0u);
+
+    QByteArray data = bytes({255, 250, 44, 101, 0x00, 0x00, 0x25, 0x80, 255, 240});
+    decodeBytewise(codec, data, payload, reply);
+
+    EXPECT_EQ(codec.serverBaudRate(), 9600u);
+    EXPECT_TRUE(payload.isEmpty());
+}
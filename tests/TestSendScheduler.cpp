@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#include "SendScheduler.h"
+#include "SerialPortManager.h"
+#include "TestSupport.h"
+
+// The TCP server stands in for the device and counts what arrives
+class SendSchedulerTest : public TcpDeviceTest {
+protected:
+    SendScheduler* scheduler;
+    QByteArray received;
+
+    void SetUp() override {
+        ASSERT_NO_FATAL_FAILURE(TcpDeviceTest::SetUp());
+        scheduler = portManager->sendScheduler();
+    }
+
+    bool connectPort(const QString& portName)
+    {
+        if (!connectDevice(deviceInfo(portName))) {
+            return false;
+        }
+        QObject::connect(peer, &QTcpSocket::readyRead, [this]() { received.append(peer->readAll()); });
+        return true;
+    }
+};
+
+TEST_F(SendSchedulerTest, SendsPeriodically) {
+    ASSERT_TRUE(connectPort("bus"));
+
+    quint64 id = scheduler->addJob("bus", "P", 20);
+    EXPECT_EQ(scheduler->activeCount(), 1);
+
+    // The first send is immediate, then one every 20 ms
+    ASSERT_TRUE(waitUntil([&]() { return received.count('P') >= 10; }));
+    SendJob job = scheduler->job(id);
+    EXPECT_EQ(job.portName, "bus");
+    EXPECT_TRUE(job.active);
+    EXPECT_GE(job.sentCount, 10);
+    EXPECT_EQ(job.failedCount, 0);
+}
+
+TEST_F(SendSchedulerTest, DeadlinesDoNotDrift) {
+    ASSERT_TRUE(connectPort("bus"));
+
+    QElapsedTimer elapsed;
+    elapsed.start();
+    quint64 id = scheduler->addJob("bus", "D", 10);
+    runFor(500);
+    scheduler->stopJob(id);
+
+    // Drift would lose a little on every period; absolute deadlines keep the count
+    SendJob job = scheduler->job(id);
+    qint64 expected = elapsed.elapsed() / 10 + 1;
+    EXPECT_GE(job.sentCount + job.missedCount, expected - 2);
+    EXPECT_LE(job.sentCount + job.missedCount, expected + 1);
+}
+
+TEST_F(SendSchedulerTest, StartStopAndChangeAtRuntime) {
+    ASSERT_TRUE(connectPort("bus"));
+
+    quint64 slow = scheduler->addJob("bus", "S", 1000, false);
+    quint64 fast = scheduler->addJob("bus", "F", 10);
+    EXPECT_FALSE(scheduler->job(slow).active);
+    EXPECT_EQ(scheduler->activeCount(), 1);
+    ASSERT_TRUE(waitUntil([&]() { return received.count('F') >= 5; }));
+
+    // Stopped jobs stay silent
+    EXPECT_TRUE(scheduler->stopJob(fast));
+    runFor(50);
+    received.clear();
+    runFor(100);
+    EXPECT_EQ(received.count('F'), 0);
+    EXPECT_EQ(received.count('S'), 0);
+
+    // New data and interval apply from the next period on
+    EXPECT_TRUE(scheduler->setData(slow, "T"));
+    EXPECT_TRUE(scheduler->startJob(slow));
+    ASSERT_TRUE(waitUntil([&]() { return received.count('T') == 1; }));
+    EXPECT_TRUE(scheduler->setInterval(slow, 10));
+    EXPECT_EQ(scheduler->job(slow).intervalMs, 10);
+    ASSERT_TRUE(waitUntil([&]() { return received.count('T') >= 5; }));
+
+    EXPECT_TRUE(scheduler->removeJob(slow));
+    EXPECT_FALSE(scheduler->removeJob(slow));
+    EXPECT_FALSE(scheduler->startJob(slow));
+    EXPECT_EQ(scheduler->jobs().size(), 1);
+}
+
+TEST_F(SendSchedulerTest, MissedDeadlinesAreCounted) {
+    ASSERT_TRUE(connectPort("bus"));
+
+    QList<qint64> missed;
+    QObject::connect(scheduler, &SendScheduler::deadlinesMissed,
+                     [&](quint64, qint64 periods) { missed.append(periods); });
+    quint64 id = scheduler->addJob("bus", "M", 10);
+    ASSERT_TRUE(waitUntil([&]() { return scheduler->job(id).sentCount >= 2; }));
+
+    // A blocked event loop: the overdue periods are skipped, not sent in a burst
+    QThread::msleep(105);
+    qint64 sentBefore = scheduler->job(id).sentCount;
+    ASSERT_TRUE(waitUntil([&]() { return !missed.isEmpty(); }));
+
+    SendJob job = scheduler->job(id);
+    EXPECT_GE(missed.first(), 9);
+    EXPECT_EQ(job.missedCount, scheduler->totalMissedCount());
+    EXPECT_GE(job.missedCount, 9);
+    EXPECT_LE(job.sentCount - sentBefore, 2);
+    EXPECT_GE(job.maxLatenessNs, 90 * 1000000LL);
+
+    scheduler->resetCounters();
+    EXPECT_EQ(scheduler->totalMissedCount(), 0);
+}
+
+TEST_F(SendSchedulerTest, ClosedPortCountsFailures) {
+    quint64 id = scheduler->addJob("nowhere", "X", 10);
+    ASSERT_TRUE(waitUntil([&]() { return scheduler->job(id).failedCount >= 3; }));
+    EXPECT_EQ(scheduler->job(id).sentCount, 0);
+}
+
+TEST_F(SendSchedulerTest, RemovingPortDropsItsJobs) {
+    ASSERT_TRUE(connectPort("bus"));
+    scheduler->addJob("bus", "A", 50);
+    scheduler->addJob("bus", "B", 50);
+    quint64 other = scheduler->addJob("other", "C", 50, false);
+
+    portManager->removeUser("bus");
+    EXPECT_EQ(scheduler->activeCount(), 0);
+    ASSERT_EQ(scheduler->jobs().size(), 1);
+    EXPECT_EQ(scheduler->jobs().first().id, other);
+}
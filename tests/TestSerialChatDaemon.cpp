@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+#include "DataPersistence.h"
+#include "SerialChatDaemon.h"
+#include "TestSupport.h"
+#include <QTemporaryDir>
+
+// The daemon runs over a temporary data directory whose friend list holds the TCP device
+class SerialChatDaemonTest : public TcpDeviceTest {
+protected:
+    QTemporaryDir dir;
+    DataPersistence persistence;
+
+    void SetUp() override {
+        ASSERT_NO_FATAL_FAILURE(TcpDeviceTest::SetUp());
+        ASSERT_TRUE(dir.isValid());
+        persistence.setDataDirectory(dir.path());
+        ASSERT_TRUE(persistence.saveFriendList({deviceInfo("device")}));
+    }
+
+    // One daemon run from start to shutdown, receiving `data` from the device
+    void runDaemon(const QByteArray& data)
+    {
+        DaemonOptions options;
+        options.dataDirectory = dir.path();
+        options.saveIntervalSec = 0;
+        SerialChatDaemon daemon(options);
+        ASSERT_TRUE(daemon.start());
+        ASSERT_TRUE(acceptPeer());
+
+        peer->write(data);
+        MessageManager* messages = daemon.messageManager();
+        ASSERT_TRUE(waitUntil([&]() { return receivedData(messages->getMessages("device")) == data; }));
+        daemon.shutdown();
+    }
+
+    static QByteArray receivedData(const QList<Message>& messages)
+    {
+        QByteArray data;
+        for (const Message& message : messages) {
+            data.append(message.data());
+        }
+        return data;
+    }
+};
+
+TEST_F(SerialChatDaemonTest, SavesReceivedMessages) {
+    ASSERT_NO_FATAL_FAILURE(runDaemon("first"));
+
+    QList<Message> saved = persistence.loadMessages("device");
+    ASSERT_FALSE(saved.isEmpty());
+    EXPECT_EQ(receivedData(saved), "first");
+    EXPECT_EQ(saved.first().direction(), MessageDirection::Received);
+}
+
+TEST_F(SerialChatDaemonTest, RestartKeepsEarlierHistory) {
+    // History saved by the GUI, longer than MessageManager keeps in memory
+    QList<Message> earlier;
+    for (int i = 0; i < 1500; ++i) {
+        earlier.append(Message("device", QByteArray::number(i), MessageDirection::Received));
+    }
+    ASSERT_TRUE(persistence.saveMessages("device", earlier));
+
+    ASSERT_NO_FATAL_FAILURE(runDaemon("first"));
+    ASSERT_NO_FATAL_FAILURE(runDaemon("second"));
+
+    QList<Message> saved = persistence.loadMessages("device");
+    ASSERT_GE(saved.size(), 1502);
+    EXPECT_EQ(saved.first().data(), "0");
+    EXPECT_EQ(saved.at(1499).data(), "1499");
+    EXPECT_EQ(receivedData(saved.mid(1500)), "firstsecond");
+}
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include "SerialPortInfo.h"
+#include "TimeUtils.h"
 
 class SerialPortInfoTest : public ::testing::Test {
 protected:
@@ -20,6 +21,8 @@ TEST_F(SerialPortInfoTest, DefaultConstructor) {
     EXPECT_EQ(info.stopBits(), QSerialPort::OneStop);
     EXPECT_EQ(info.parity(), QSerialPort::NoParity);
     EXPECT_EQ(info.flowControl(), QSerialPort::NoFlowControl);
+    EXPECT_EQ(info.transport().type(), TransportType::QtSerialPort);
+    EXPECT_TRUE(info.autoReconnect());
     EXPECT_EQ(info.status(), PortStatus::Offline);
 }
 
@@ -87,6 +90,26 @@ TEST_F(SerialPortInfoTest, JsonSerialization) {
     original.setDataBits(QSerialPort::Data7);
     original.setStopBits(QSerialPort::TwoStop);
     original.setParity(QSerialPort::OddParity);
+    TransportConfig transport(TransportType::Termios);
+    transport.setVmin(16);
+    transport.setVtime(2);
+    transport.setLowLatency(false);
+    original.setTransport(transport);
+    original.setReceiveBufferSize(16384);
+    original.setOverflowPolicy(SlabRingBuffer::OverflowPolicy::Overwrite);
+    FramingConfig framing(FramingMode::Delimiter);
+    framing.setDelimiter("\r\n");
+    framing.setKeepDelimiter(true);
+    original.setFraming(framing);
+    original.setCoalesceWindowMs(10);
+    original.setCoalesceMaxBytes(4096);
+    original.setTransmitQueueDepth(32);
+    original.setTransmitPolicy(TransmitPolicy::Block);
+    PacingConfig pacing;
+    pacing.setInterFrameGapUs(3500);
+    pacing.setMaxUtilization(80);
+    original.setPacing(pacing);
+    original.setAutoReconnect(false);
     original.updateLastActiveTime();
     
     QJsonObject json = original.toJson();
@@ -98,6 +121,17 @@ TEST_F(SerialPortInfoTest, JsonSerialization) {
     EXPECT_EQ(restored.dataBits(), original.dataBits());
     EXPECT_EQ(restored.stopBits(), original.stopBits());
     EXPECT_EQ(restored.parity(), original.parity());
+    EXPECT_EQ(restored.transport(), transport);
+    EXPECT_EQ(restored.receiveBufferSize(), 16384);
+    EXPECT_EQ(restored.overflowPolicy(), SlabRingBuffer::OverflowPolicy::Overwrite);
+    EXPECT_EQ(restored.framing(), framing);
+    EXPECT_EQ(restored.framing().delimiter(), QByteArray("\r\n"));
+    EXPECT_EQ(restored.coalesceWindowMs(), 10);
+    EXPECT_EQ(restored.coalesceMaxBytes(), 4096);
+    EXPECT_EQ(restored.transmitQueueDepth(), 32);
+    EXPECT_EQ(restored.transmitPolicy(), TransmitPolicy::Block);
+    EXPECT_EQ(restored.pacing(), pacing);
+    EXPECT_FALSE(restored.autoReconnect());
     // Status is not serialized (always offline after load)
     EXPECT_EQ(restored.status(), PortStatus::Offline);
 }
@@ -119,10 +153,86 @@ TEST_F(SerialPortInfoTest, LastActiveTime) {
     info.updateLastActiveTime();
     EXPECT_TRUE(info.lastActiveTime().isValid());
     
-    QDateTime before = QDateTime::currentDateTime();
+    // Taken from the monotonic timestamp clock, not the wall clock
+    QDateTime before = TimeUtils::toDateTime(TimeUtils::timestampNs());
     info.updateLastActiveTime();
-    QDateTime after = QDateTime::currentDateTime();
+    QDateTime after = TimeUtils::toDateTime(TimeUtils::timestampNs());
     
     EXPECT_TRUE(info.lastActiveTime() >= before);
     EXPECT_TRUE(info.lastActiveTime() <= after);
+    
+    // A message's timestamp can be passed on as is
+    QDateTime saved(QDate(2026, 1, 5), QTime(14, 30, 15));
+    info.updateLastActiveTime(TimeUtils::fromDateTime(saved));
+    EXPECT_EQ(info.lastActiveTime(), saved);
+}
+
+TEST_F(SerialPortInfoTest, CharacterTime) {
+    SerialPortInfo info("COM1");
+    info.setBaudRate(9600);
+    
+    // 8N1: start + 8 data + 1 stop
+    EXPECT_DOUBLE_EQ(info.bitsPerCharacter(), 10.0);
+    EXPECT_EQ(info.characterTimeNs(), 1041667);
+    
+    // 7E2: start + 7 data + parity + 2 stop
+    info.setDataBits(QSerialPort::Data7);
+    info.setParity(QSerialPort::EvenParity);
+    info.setStopBits(QSerialPort::TwoStop);
+    EXPECT_DOUBLE_EQ(info.bitsPerCharacter(), 11.0);
+    
+    info.setStopBits(QSerialPort::OneAndHalfStop);
+    EXPECT_DOUBLE_EQ(info.bitsPerCharacter(), 10.5);
+}
+
+TEST_F(SerialPortInfoTest, NetworkTransport) {
+    TransportConfig transport(TransportType::Udp);
+    transport.setAddress("10.0.0.5");
+    transport.setPort(4001);
+    transport.setLocalPort(4002);
+    
+    EXPECT_TRUE(transport.isNetwork());
+    EXPECT_FALSE(TransportConfig(TransportType::Termios).isNetwork());
+    EXPECT_EQ(transport.endpoint(), "udp://10.0.0.5:4001");
+    
+    TransportConfig restored = TransportConfig::fromJson(transport.toJson());
+    EXPECT_EQ(restored, transport);
+    EXPECT_EQ(restored.localPort(), 4002);
+    
+    transport.setType(TransportType::UnixSocket);
+    transport.setAddress("/tmp/sim.sock");
+    EXPECT_EQ(transport.endpoint(), "unix:/tmp/sim.sock");
+}
+
+TEST_F(SerialPortInfoTest, AutoReplies) {
+    SerialPortInfo original("COM5");
+    EXPECT_TRUE(original.autoReplies().isEmpty());
+
+    AutoReplyRule disabled(QByteArray("\x05\x00", 2), "\x06");
+    disabled.setEnabled(false);
+    original.setAutoReplies({AutoReplyRule("AT\r", "OK\r"), disabled});
+
+    SerialPortInfo restored = SerialPortInfo::fromJson(original.toJson());
+    ASSERT_EQ(restored.autoReplies().size(), 2);
+    EXPECT_EQ(restored.autoReplies(), original.autoReplies());
+    EXPECT_EQ(restored.autoReplies().at(1).pattern(), QByteArray("\x05\x00", 2));
+    EXPECT_FALSE(restored.autoReplies().at(1).isEnabled());
+}
+
+TEST_F(SerialPortInfoTest, Checksum) {
+    SerialPortInfo original("COM6");
+    EXPECT_EQ(original.checksum(), ChecksumType::None);
+
+    original.setChecksum(ChecksumType::Crc16Modbus);
+    SerialPortInfo restored = SerialPortInfo::fromJson(original.toJson());
+    EXPECT_EQ(restored.checksum(), ChecksumType::Crc16Modbus);
+}
+
+TEST_F(SerialPortInfoTest, Decoder) {
+    SerialPortInfo original("COM7");
+    EXPECT_EQ(original.decoder(), DecoderType::None);
+
+    original.setDecoder(DecoderType::Nmea0183);
+    SerialPortInfo restored = SerialPortInfo::fromJson(original.toJson());
+    EXPECT_EQ(restored.decoder(), DecoderType::Nmea0183);
 }
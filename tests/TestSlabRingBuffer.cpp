@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+#include "SlabRingBuffer.h"
+
+class SlabRingBufferTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+    }
+
+    void TearDown() override {
+    }
+};
+
+TEST_F(SlabRingBufferTest, DefaultConstruction) {
+    SlabRingBuffer ring;
+
+    EXPECT_EQ(ring.capacity(), qint64(SlabRingBuffer::DEFAULT_SLAB_SIZE) * SlabRingBuffer::DEFAULT_SLAB_COUNT);
+    EXPECT_TRUE(ring.isEmpty());
+    EXPECT_EQ(ring.policy(), SlabRingBuffer::OverflowPolicy::Backpressure);
+    EXPECT_EQ(ring.highWaterMark(), 0);
+}
+
+TEST_F(SlabRingBufferTest, WriteAndRead) {
+    SlabRingBuffer ring(4, 4);
+
+    EXPECT_EQ(ring.write("Hello", 5), 5);
+    EXPECT_EQ(ring.size(), 5);
+    EXPECT_EQ(ring.at(1), 'e');
+
+    char out[8] = {0};
+    EXPECT_EQ(ring.read(out, 3), 3);
+    EXPECT_STREQ(out, "Hel");
+    EXPECT_EQ(ring.readAll(), QByteArray("lo"));
+    EXPECT_TRUE(ring.isEmpty());
+}
+
+TEST_F(SlabRingBufferTest, WritePointerStaysWithinSlab) {
+    SlabRingBuffer ring(4, 4);
+    ring.write("ab", 2);
+
+    qint64 contiguous = 0;
+    char* dest = ring.writePointer(&contiguous);
+    ASSERT_NE(dest, nullptr);
+    EXPECT_EQ(contiguous, 2);
+
+    dest[0] = 'c';
+    ring.commit(1);
+    EXPECT_EQ(ring.readAll(), QByteArray("abc"));
+}
+
+TEST_F(SlabRingBufferTest, WrapsAround) {
+    SlabRingBuffer ring(4, 2);
+
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_EQ(ring.write("xyz", 3), 3);
+        EXPECT_EQ(ring.read(3), QByteArray("xyz"));
+    }
+    EXPECT_EQ(ring.highWaterMark(), 3);
+}
+
+TEST_F(SlabRingBufferTest, BackpressureRefusesWhenFull) {
+    SlabRingBuffer ring(4, 2, SlabRingBuffer::OverflowPolicy::Backpressure);
+
+    EXPECT_EQ(ring.write("0123456789", 10), 8);
+    EXPECT_TRUE(ring.isFull());
+
+    qint64 contiguous = -1;
+    EXPECT_EQ(ring.writePointer(&contiguous), nullptr);
+    EXPECT_EQ(contiguous, 0);
+    EXPECT_EQ(ring.droppedBytes(), 0);
+    EXPECT_EQ(ring.readAll(), QByteArray("01234567"));
+}
+
+TEST_F(SlabRingBufferTest, OverwriteDropsOldestSlab) {
+    SlabRingBuffer ring(4, 2, SlabRingBuffer::OverflowPolicy::Overwrite);
+
+    EXPECT_EQ(ring.write("0123456789", 10), 10);
+    EXPECT_EQ(ring.droppedBytes(), 4);
+    EXPECT_EQ(ring.readAll(), QByteArray("456789"));
+}
+
+TEST_F(SlabRingBufferTest, HighWaterMark) {
+    SlabRingBuffer ring(4, 4);
+
+    ring.write("0123456", 7);
+    ring.read(5);
+    ring.write("78", 2);
+    EXPECT_EQ(ring.highWaterMark(), 7);
+
+    ring.resetHighWaterMark();
+    EXPECT_EQ(ring.highWaterMark(), 4);
+}
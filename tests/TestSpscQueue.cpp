@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+#include "SpscQueue.h"
+#include <thread>
+
+namespace {
+// Counts default constructions and live instances
+struct Tracked {
+    static int defaultConstructed;
+    static int alive;
+    int value = 0;
+
+    Tracked() { defaultConstructed++; alive++; }
+    explicit Tracked(int v) : value(v) { alive++; }
+    Tracked(const Tracked& other) : value(other.value) { alive++; }
+    Tracked& operator=(const Tracked& other) = default;
+    ~Tracked() { alive--; }
+};
+
+int Tracked::defaultConstructed = 0;
+int Tracked::alive = 0;
+}
+
+class SpscQueueTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+    }
+
+    void TearDown() override {
+    }
+};
+
+TEST_F(SpscQueueTest, CapacityRoundsUpToPowerOfTwo) {
+    SpscQueue<int> queue(100);
+
+    EXPECT_EQ(queue.capacity(), 128u);
+    EXPECT_TRUE(queue.isEmpty());
+}
+
+TEST_F(SpscQueueTest, PushPopPreservesOrder) {
+    SpscQueue<int> queue(8);
+
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_TRUE(queue.tryPush(i));
+    }
+    EXPECT_EQ(queue.size(), 5u);
+
+    int value = -1;
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_TRUE(queue.tryPop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_FALSE(queue.tryPop(value));
+}
+
+TEST_F(SpscQueueTest, PushFailsWhenFull) {
+    SpscQueue<int> queue(4);
+
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(queue.tryPush(i));
+    }
+    EXPECT_FALSE(queue.tryPush(99));
+
+    int value = -1;
+    EXPECT_TRUE(queue.tryPop(value));
+    EXPECT_TRUE(queue.tryPush(4));
+}
+
+TEST_F(SpscQueueTest, WrapsAround) {
+    SpscQueue<int> queue(4);
+    int value = -1;
+
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_TRUE(queue.tryPush(i));
+        ASSERT_TRUE(queue.tryPop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_TRUE(queue.isEmpty());
+}
+
+TEST_F(SpscQueueTest, SlotsHoldNoDefaultValues) {
+    Tracked::defaultConstructed = 0;
+    Tracked::alive = 0;
+    {
+        SpscQueue<Tracked> queue(1024);
+        EXPECT_EQ(Tracked::alive, 0);
+
+        Tracked value(0);
+        for (int i = 1; i <= 10; ++i) {
+            ASSERT_TRUE(queue.tryPush(Tracked(i)));
+            ASSERT_TRUE(queue.tryPop(value));
+            EXPECT_EQ(value.value, i);
+        }
+
+        // Only `value` is left; popped slots were emptied
+        EXPECT_EQ(Tracked::alive, 1);
+    }
+    EXPECT_EQ(Tracked::defaultConstructed, 0);
+    EXPECT_EQ(Tracked::alive, 0);
+}
+
+TEST_F(SpscQueueTest, ConcurrentProducerConsumer) {
+    SpscQueue<int> queue(64);
+    const int count = 100000;
+
+    std::thread producer([&]() {
+        for (int i = 0; i < count; ++i) {
+            while (!queue.tryPush(i)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    int expected = 0;
+    int value = -1;
+    while (expected < count) {
+        if (queue.tryPop(value)) {
+            ASSERT_EQ(value, expected);
+            expected++;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    producer.join();
+    EXPECT_TRUE(queue.isEmpty());
+}
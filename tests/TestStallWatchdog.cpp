@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+#include "StallWatchdog.h"
+#include "TestSupport.h"
+
+namespace {
+const qint64 MS = 1000000;
+}
+
+class StallWatchdogTest : public ::testing::Test {
+protected:
+    StallWatchdog watchdog;
+
+    void SetUp() override {
+        watchdog.setThresholdMs(100);
+        watchdog.start();
+        runFor(50);
+    }
+};
+
+TEST_F(StallWatchdogTest, ThresholdHasMinimum) {
+    watchdog.setThresholdMs(1);
+    EXPECT_EQ(watchdog.thresholdMs(), StallWatchdog::MIN_THRESHOLD_MS);
+}
+
+TEST_F(StallWatchdogTest, ResponsiveLoopHasNoStalls) {
+    runFor(300);
+    EXPECT_EQ(watchdog.stallCount(), 0);
+    EXPECT_TRUE(watchdog.recentStalls().isEmpty());
+}
+
+TEST_F(StallWatchdogTest, StallNamesTracedOperation) {
+    QList<StallReport> reports;
+    QObject::connect(&watchdog, &StallWatchdog::stallDetected,
+                     [&reports](const StallReport& report) { reports.append(report); });
+
+    {
+        TraceScope scope("Test::block", 42, "items");
+        TraceScope nested("Test::nested");
+        QThread::msleep(400);
+    }
+    ASSERT_TRUE(waitUntil([&reports]() { return !reports.isEmpty(); }));
+    runFor(100);
+
+    ASSERT_EQ(reports.size(), 1);
+    const StallReport& report = reports.first();
+    EXPECT_GE(report.durationNs, 250 * MS);
+    EXPECT_EQ(report.operation, QString("Test::block, 42 items"));
+    EXPECT_GT(report.operationNs, 0);
+    EXPECT_TRUE(report.summary().contains("Test::block, 42 items"));
+
+    EXPECT_EQ(watchdog.stallCount(), 1);
+    EXPECT_EQ(watchdog.maxStallNs(), report.durationNs);
+    EXPECT_EQ(watchdog.histogram().count(), 1);
+    EXPECT_EQ(watchdog.recentStalls().size(), 1);
+
+    watchdog.reset();
+    EXPECT_EQ(watchdog.stallCount(), 0);
+    EXPECT_EQ(watchdog.histogram().count(), 0);
+}
+
+TEST_F(StallWatchdogTest, StallOutsideTracedCodeNamesLastOperation) {
+    {
+        TraceScope scope("Test::before");
+    }
+    QThread::msleep(400);
+    ASSERT_TRUE(waitUntil([this]() { return watchdog.stallCount() > 0; }));
+
+    StallReport report = watchdog.recentStalls().last();
+    EXPECT_TRUE(report.operation.isEmpty());
+    EXPECT_EQ(report.lastOperation, QString("Test::before"));
+}
+
+TEST_F(StallWatchdogTest, StoppedWatchdogReportsNothing) {
+    watchdog.stop();
+    EXPECT_FALSE(watchdog.isRunning());
+    QThread::msleep(300);
+    runFor(100);
+    EXPECT_EQ(watchdog.stallCount(), 0);
+}
@@ -0,0 +1,247 @@
+#include <gtest/gtest.h>
+#include "StreamFramer.h"
+
+class StreamFramerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+    }
+
+    void TearDown() override {
+    }
+
+    // Feed data one byte at a time to exercise frames split across reads
+    static QVector<QByteArray> feedBytewise(StreamFramer& framer, const QByteArray& data) {
+        QVector<QByteArray> frames;
+        for (int i = 0; i < data.size(); ++i) {
+            framer.feed(data.constData() + i, 1, frames);
+        }
+        return frames;
+    }
+};
+
+TEST_F(StreamFramerTest, NoneEmitsEachChunk) {
+    StreamFramer framer;
+    QVector<QByteArray> frames;
+
+    EXPECT_EQ(framer.feed(QByteArray("abc"), frames), 1);
+    EXPECT_EQ(framer.feed(QByteArray("de"), frames), 1);
+    ASSERT_EQ(frames.size(), 2);
+    EXPECT_EQ(frames.at(0), QByteArray("abc"));
+    EXPECT_EQ(frames.at(1), QByteArray("de"));
+}
+
+TEST_F(StreamFramerTest, DelimiterSplitsAndJoins) {
+    FramingConfig config(FramingMode::Delimiter);
+    config.setDelimiter("\r\n");
+    StreamFramer framer(config);
+    QVector<QByteArray> frames;
+
+    framer.feed(QByteArray("one\r\ntwo\r"), frames);
+    ASSERT_EQ(frames.size(), 1);
+    EXPECT_EQ(frames.at(0), QByteArray("one"));
+    EXPECT_TRUE(framer.hasPartialFrame());
+
+    framer.feed(QByteArray("\nthree\r\n\r\n"), frames);
+    ASSERT_EQ(frames.size(), 3);
+    EXPECT_EQ(frames.at(1), QByteArray("two"));
+    EXPECT_EQ(frames.at(2), QByteArray("three"));
+    EXPECT_FALSE(framer.hasPartialFrame());
+}
+
+TEST_F(StreamFramerTest, DelimiterKeepDelimiter) {
+    FramingConfig config(FramingMode::Delimiter);
+    config.setKeepDelimiter(true);
+    StreamFramer framer(config);
+
+    QVector<QByteArray> frames = feedBytewise(framer, "a\nb\n");
+    ASSERT_EQ(frames.size(), 2);
+    EXPECT_EQ(frames.at(0), QByteArray("a\n"));
+    EXPECT_EQ(frames.at(1), QByteArray("b\n"));
+}
+
+TEST_F(StreamFramerTest, DelimiterOversizedFrameIsEmitted) {
+    FramingConfig config(FramingMode::Delimiter);
+    config.setMaxFrameSize(4);
+    StreamFramer framer(config);
+    QVector<QByteArray> frames;
+
+    framer.feed(QByteArray("abcdef\n"), frames);
+    ASSERT_EQ(frames.size(), 2);
+    EXPECT_EQ(frames.at(0), QByteArray("abcd"));
+    EXPECT_EQ(frames.at(1), QByteArray("ef"));
+    EXPECT_EQ(framer.oversizedCount(), 1);
+}
+
+TEST_F(StreamFramerTest, FixedLength) {
+    FramingConfig config(FramingMode::FixedLength);
+    config.setFrameLength(3);
+    StreamFramer framer(config);
+    QVector<QByteArray> frames;
+
+    framer.feed(QByteArray("abcdefg"), frames);
+    ASSERT_EQ(frames.size(), 2);
+    EXPECT_EQ(frames.at(0), QByteArray("abc"));
+    EXPECT_EQ(frames.at(1), QByteArray("def"));
+    EXPECT_EQ(framer.partialSize(), 1);
+}
+
+TEST_F(StreamFramerTest, LengthPrefixBigEndian) {
+    FramingConfig config(FramingMode::LengthPrefix);
+    config.setLengthOffset(1);
+    config.setLengthSize(2);
+    StreamFramer framer(config);
+
+    // Header: 0xAA, length 0x0003; then a second frame with an empty payload
+    QByteArray stream = QByteArray::fromHex("AA0003010203" "AA0000");
+    QVector<QByteArray> frames = feedBytewise(framer, stream);
+    ASSERT_EQ(frames.size(), 2);
+    EXPECT_EQ(frames.at(0), QByteArray::fromHex("AA0003010203"));
+    EXPECT_EQ(frames.at(1), QByteArray::fromHex("AA0000"));
+}
+
+TEST_F(StreamFramerTest, LengthPrefixLittleEndianWithAdjustment) {
+    FramingConfig config(FramingMode::LengthPrefix);
+    config.setLengthSize(2);
+    config.setLengthBigEndian(false);
+    config.setLengthAdjustment(-2);
+    StreamFramer framer(config);
+    QVector<QByteArray> frames;
+
+    // Length field counts itself
+    framer.feed(QByteArray::fromHex("0400AABB0300CC"), frames);
+    ASSERT_EQ(frames.size(), 2);
+    EXPECT_EQ(frames.at(0), QByteArray::fromHex("0400AABB"));
+    EXPECT_EQ(frames.at(1), QByteArray::fromHex("0300CC"));
+}
+
+TEST_F(StreamFramerTest, LengthPrefixResyncsOnBadHeader) {
+    FramingConfig config(FramingMode::LengthPrefix);
+    config.setMaxFrameSize(8);
+    StreamFramer framer(config);
+    QVector<QByteArray> frames;
+
+    framer.feed(QByteArray::fromHex("FF02AABB"), frames);
+    ASSERT_EQ(frames.size(), 1);
+    EXPECT_EQ(frames.at(0), QByteArray::fromHex("02AABB"));
+    EXPECT_EQ(framer.errorCount(), 1);
+}
+
+TEST_F(StreamFramerTest, LengthPrefixHeaderMustFitFrame) {
+    FramingConfig config(FramingMode::LengthPrefix);
+    config.setLengthOffset(2);
+    config.setLengthSize(2);
+    config.setMaxFrameSize(3);
+    EXPECT_FALSE(config.isValid());
+    EXPECT_FALSE(config.validationError().isEmpty());
+
+    // The framer still makes room for the header instead of resyncing forever
+    StreamFramer framer(config);
+    QVector<QByteArray> frames;
+    framer.feed(QByteArray::fromHex("AABB0000"), frames);
+    ASSERT_EQ(frames.size(), 1);
+    EXPECT_EQ(frames.at(0), QByteArray::fromHex("AABB0000"));
+    EXPECT_EQ(framer.errorCount(), 0);
+
+    config.setMaxFrameSize(4);
+    EXPECT_TRUE(config.isValid());
+    config.setMaxFrameSize(3);
+    config.setMode(FramingMode::Delimiter);
+    EXPECT_TRUE(config.isValid());
+}
+
+TEST_F(StreamFramerTest, IdleGapEmitsOnFlush) {
+    StreamFramer framer(FramingConfig(FramingMode::IdleGap));
+    QVector<QByteArray> frames;
+
+    EXPECT_EQ(framer.feed(QByteArray("ab"), frames), 0);
+    EXPECT_EQ(framer.feed(QByteArray("cd"), frames), 0);
+    EXPECT_TRUE(framer.hasPartialFrame());
+
+    EXPECT_EQ(framer.flush(frames), 1);
+    ASSERT_EQ(frames.size(), 1);
+    EXPECT_EQ(frames.at(0), QByteArray("abcd"));
+    EXPECT_EQ(framer.flush(frames), 0);
+}
+
+TEST_F(StreamFramerTest, SlipDecodesEscapes) {
+    StreamFramer framer(FramingConfig(FramingMode::Slip));
+
+    QByteArray stream = QByteArray::fromHex("C0" "01DBDC02DBDD03" "C0" "C0" "04C0");
+    QVector<QByteArray> frames = feedBytewise(framer, stream);
+    ASSERT_EQ(frames.size(), 2);
+    EXPECT_EQ(frames.at(0), QByteArray::fromHex("01C002DB03"));
+    EXPECT_EQ(frames.at(1), QByteArray::fromHex("04"));
+    EXPECT_EQ(framer.errorCount(), 0);
+}
+
+TEST_F(StreamFramerTest, SlipDropsOversizedFrame) {
+    FramingConfig config(FramingMode::Slip);
+    config.setMaxFrameSize(2);
+    StreamFramer framer(config);
+    QVector<QByteArray> frames;
+
+    framer.feed(QByteArray::fromHex("010203C00405C0"), frames);
+    ASSERT_EQ(frames.size(), 1);
+    EXPECT_EQ(frames.at(0), QByteArray::fromHex("0405"));
+    EXPECT_EQ(framer.oversizedCount(), 1);
+}
+
+TEST_F(StreamFramerTest, CobsDecodes) {
+    StreamFramer framer(FramingConfig(FramingMode::Cobs));
+    QVector<QByteArray> frames;
+
+    // 11 22 00 33 encodes to 03 11 22 02 33; a lone 00 encodes to 01 01
+    framer.feed(QByteArray::fromHex("031122023300" "010100"), frames);
+    ASSERT_EQ(frames.size(), 2);
+    EXPECT_EQ(frames.at(0), QByteArray::fromHex("11220033"));
+    EXPECT_EQ(frames.at(1), QByteArray::fromHex("00"));
+}
+
+TEST_F(StreamFramerTest, CobsLongBlock) {
+    StreamFramer framer(FramingConfig(FramingMode::Cobs));
+
+    // 254 non-zero bytes need a 0xFF block with no implied zero
+    QByteArray payload(254, '\x01');
+    QByteArray stream;
+    stream.append('\xFF');
+    stream.append(payload);
+    stream.append('\x01');
+    stream.append('\0');
+
+    QVector<QByteArray> frames = feedBytewise(framer, stream);
+    ASSERT_EQ(frames.size(), 1);
+    EXPECT_EQ(frames.at(0), payload);
+}
+
+TEST_F(StreamFramerTest, CobsEmptyFramesAreCounted) {
+    StreamFramer framer(FramingConfig(FramingMode::Cobs));
+    QVector<QByteArray> frames;
+
+    // A leading resync zero, an encoded empty frame, then a real one
+    framer.feed(QByteArray::fromHex("00" "0100" "021100"), frames);
+    ASSERT_EQ(frames.size(), 1);
+    EXPECT_EQ(frames.at(0), QByteArray::fromHex("11"));
+    EXPECT_EQ(framer.emptyFrameCount(), 2);
+    EXPECT_EQ(framer.frameCount(), 1);
+    EXPECT_EQ(framer.errorCount(), 0);
+}
+
+TEST_F(StreamFramerTest, CobsTruncatedBlockIsError) {
+    StreamFramer framer(FramingConfig(FramingMode::Cobs));
+    QVector<QByteArray> frames;
+
+    framer.feed(QByteArray::fromHex("0411" "00" "021100"), frames);
+    ASSERT_EQ(frames.size(), 1);
+    EXPECT_EQ(frames.at(0), QByteArray::fromHex("11"));
+    EXPECT_EQ(framer.errorCount(), 1);
+}
+
+TEST_F(StreamFramerTest, SetConfigResets) {
+    StreamFramer framer(FramingConfig(FramingMode::IdleGap));
+    QVector<QByteArray> frames;
+
+    framer.feed(QByteArray("partial"), frames);
+    framer.setConfig(FramingConfig(FramingMode::Delimiter));
+    EXPECT_FALSE(framer.hasPartialFrame());
+    EXPECT_EQ(framer.mode(), FramingMode::Delimiter);
+}
@@ -0,0 +1,92 @@
+#ifndef TEST_SUPPORT_H
+#define TEST_SUPPORT_H
+
+#include <gtest/gtest.h>
+#include "SerialPortManager.h"
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QThread>
+#include <functional>
+
+const int WAIT_TIMEOUT_MS = 5000;
+
+// Runs the event loop until the condition holds or the timeout expires
+inline bool waitUntil(const std::function<bool()>& condition, int timeoutMs = WAIT_TIMEOUT_MS)
+{
+    QElapsedTimer timer;
+    timer.start();
+    while (!condition()) {
+        if (timer.elapsed() > timeoutMs) {
+            return false;
+        }
+        QCoreApplication::processEvents();
+        QThread::msleep(1);
+    }
+    return true;
+}
+
+// Keeps the event loop running for the given time
+inline void runFor(int ms)
+{
+    QElapsedTimer timer;
+    timer.start();
+    waitUntil([&]() { return timer.elapsed() >= ms; }, ms + WAIT_TIMEOUT_MS);
+}
+
+/**
+ * @brief Fixture where a local TCP server plays the device at the other end of a port
+ *
+ * Fixtures deriving from it call TcpDeviceTest::SetUp() and TearDown() from
+ * their own, and delete anything that uses portManager before TearDown().
+ */
+class TcpDeviceTest : public ::testing::Test {
+protected:
+    SerialPortManager* portManager;
+    QTcpServer server;
+    QTcpSocket* peer;
+
+    void SetUp() override {
+        portManager = new SerialPortManager();
+        peer = nullptr;
+        ASSERT_TRUE(server.listen(QHostAddress::LocalHost));
+    }
+
+    void TearDown() override {
+        delete portManager;
+    }
+
+    // A port whose transport connects to the server
+    SerialPortInfo deviceInfo(const QString& portName) const
+    {
+        TransportConfig transport(TransportType::Tcp);
+        transport.setAddress("127.0.0.1");
+        transport.setPort(server.serverPort());
+        SerialPortInfo info(portName);
+        info.setTransport(transport);
+        return info;
+    }
+
+    // Waits for the port to connect and takes the device side as peer
+    bool acceptPeer()
+    {
+        if (!waitUntil([&]() { return server.hasPendingConnections(); })) {
+            return false;
+        }
+        peer = server.nextPendingConnection();
+        return true;
+    }
+
+    // Creates the port, opens it and accepts its connection; nullptr on failure
+    SerialPortUser* connectDevice(const SerialPortInfo& info)
+    {
+        SerialPortUser* user = portManager->createUser(info);
+        if (!portManager->connectPort(info.portName()) || !acceptPeer()) {
+            return nullptr;
+        }
+        return user;
+    }
+};
+
+#endif // TEST_SUPPORT_H
@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+#include "TimerWheel.h"
+
+class TimerWheelTest : public ::testing::Test {
+protected:
+    TimerWheel wheel;
+    QVector<quint64> expired;
+
+    // Advances one tick at a time and records when each id expired
+    QHash<quint64, qint64> runUntil(qint64 tick)
+    {
+        QHash<quint64, qint64> expiredAt;
+        while (wheel.currentTick() < tick) {
+            expired.clear();
+            wheel.advance(wheel.currentTick() + 1, &expired);
+            for (quint64 id : expired) {
+                expiredAt.insert(id, wheel.currentTick());
+            }
+        }
+        return expiredAt;
+    }
+};
+
+TEST_F(TimerWheelTest, ExpiresInTickOrder) {
+    wheel.schedule(1, 30);
+    wheel.schedule(2, 10);
+    wheel.schedule(3, 20);
+    EXPECT_EQ(wheel.size(), 3);
+
+    wheel.advance(25, &expired);
+    EXPECT_EQ(expired, (QVector<quint64>{2, 3}));
+    EXPECT_EQ(wheel.size(), 1);
+
+    expired.clear();
+    wheel.advance(30, &expired);
+    EXPECT_EQ(expired, QVector<quint64>{1});
+    EXPECT_TRUE(wheel.isEmpty());
+}
+
+TEST_F(TimerWheelTest, CascadesAcrossLevels) {
+    // One deadline per level, including ones right on a slot boundary
+    const QVector<qint64> deadlines = {1, 63, 64, 65, 4095, 4096, 4097, 262143, 262144, 300000};
+    for (int i = 0; i < deadlines.size(); ++i) {
+        wheel.schedule(i, deadlines.at(i));
+    }
+
+    QHash<quint64, qint64> expiredAt = runUntil(300000);
+    ASSERT_EQ(expiredAt.size(), deadlines.size());
+    for (int i = 0; i < deadlines.size(); ++i) {
+        EXPECT_EQ(expiredAt.value(i), deadlines.at(i)) << "timer " << i;
+    }
+}
+
+TEST_F(TimerWheelTest, LargeStepsExpireEverything) {
+    for (quint64 id = 0; id < 1000; ++id) {
+        wheel.schedule(id, 1 + id * 997);
+    }
+
+    wheel.advance(500000, &expired);
+    EXPECT_EQ(expired.size(), 502);
+    wheel.advance(1000000, &expired);
+    EXPECT_EQ(expired.size(), 1000);
+    for (int i = 1; i < expired.size(); ++i) {
+        EXPECT_LT(expired.at(i - 1), expired.at(i));
+    }
+}
+
+TEST_F(TimerWheelTest, CancelAndReschedule) {
+    wheel.schedule(1, 10);
+    wheel.schedule(2, 10);
+    EXPECT_TRUE(wheel.cancel(1));
+    EXPECT_FALSE(wheel.cancel(1));
+    EXPECT_FALSE(wheel.isScheduled(1));
+
+    // Rescheduling replaces the earlier deadline
+    wheel.schedule(2, 5000);
+    wheel.advance(100, &expired);
+    EXPECT_TRUE(expired.isEmpty());
+    EXPECT_TRUE(wheel.isScheduled(2));
+
+    wheel.advance(5000, &expired);
+    EXPECT_EQ(expired, QVector<quint64>{2});
+}
+
+TEST_F(TimerWheelTest, OverdueExpiresOnNextAdvance) {
+    wheel.advance(1000, &expired);
+    wheel.schedule(7, 400);
+    EXPECT_EQ(wheel.nextWakeTick(), 1001);
+
+    wheel.advance(1001, &expired);
+    EXPECT_EQ(expired, QVector<quint64>{7});
+}
+
+TEST_F(TimerWheelTest, NextWakeTick) {
+    EXPECT_EQ(wheel.nextWakeTick(), -1);
+
+    wheel.schedule(1, 40);
+    EXPECT_EQ(wheel.nextWakeTick(), 40);
+
+    // Beyond level 0 the wheel wakes at the cascade that brings the timer closer
+    wheel.cancel(1);
+    wheel.schedule(2, 1000);
+    qint64 wake = wheel.nextWakeTick();
+    EXPECT_GT(wake, 0);
+    EXPECT_LE(wake, 1000);
+
+    QHash<quint64, qint64> expiredAt;
+    while (!wheel.isEmpty()) {
+        expired.clear();
+        wheel.advance(wheel.nextWakeTick(), &expired);
+        for (quint64 id : expired) {
+            expiredAt.insert(id, wheel.currentTick());
+        }
+    }
+    EXPECT_EQ(expiredAt.value(2), 1000);
+}
+
+TEST_F(TimerWheelTest, FarDeadlinesAreParked) {
+    const qint64 far = (qint64(1) << 24) * 3 + 12345;
+    wheel.schedule(1, far);
+
+    // Parked timers only wake the wheel for the occasional cascade
+    int wakeUps = 0;
+    while (wheel.nextWakeTick() < far) {
+        wheel.advance(wheel.nextWakeTick(), &expired);
+        wakeUps++;
+    }
+    EXPECT_TRUE(expired.isEmpty());
+    EXPECT_TRUE(wheel.isScheduled(1));
+    EXPECT_LT(wakeUps, 1000);
+
+    wheel.advance(far, &expired);
+    EXPECT_EQ(expired, QVector<quint64>{1});
+}
@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+#include "Trace.h"
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+#include <thread>
+
+class TraceTest : public ::testing::Test {
+protected:
+    QTemporaryDir dir;
+
+    void TearDown() override {
+        Trace::stop();
+    }
+
+    QJsonArray writeEvents()
+    {
+        QString path = dir.filePath("trace.json");
+        QString error;
+        EXPECT_TRUE(Trace::writeChromeJson(path, &error)) << error.toStdString();
+        QFile file(path);
+        file.open(QIODevice::ReadOnly);
+        QJsonParseError parseError;
+        QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &parseError);
+        EXPECT_EQ(parseError.error, QJsonParseError::NoError) << parseError.errorString().toStdString();
+        return doc.object()["traceEvents"].toArray();
+    }
+
+    static QJsonObject findEvent(const QJsonArray& events, const QString& name)
+    {
+        for (const QJsonValue& value : events) {
+            if (value.toObject()["name"].toString() == name) {
+                return value.toObject();
+            }
+        }
+        return QJsonObject();
+    }
+};
+
+TEST_F(TraceTest, NothingRecordedWhenStopped) {
+    Trace::start();
+    Trace::stop();
+    EXPECT_FALSE(Trace::isRecording());
+    {
+        TraceScope scope("idle");
+    }
+    EXPECT_EQ(Trace::eventCount(), 0);
+}
+
+TEST_F(TraceTest, ScopesBecomeCompleteEvents) {
+    Trace::start();
+    EXPECT_TRUE(Trace::isRecording());
+    {
+        TraceScope outer("outer");
+        TraceScope inner("inner");
+    }
+    Trace::stop();
+    EXPECT_EQ(Trace::eventCount(), 2);
+
+    QJsonArray events = writeEvents();
+    QJsonObject outer = findEvent(events, "outer");
+    QJsonObject inner = findEvent(events, "inner");
+    ASSERT_FALSE(outer.isEmpty());
+    ASSERT_FALSE(inner.isEmpty());
+    EXPECT_EQ(outer["ph"].toString(), "X");
+    EXPECT_EQ(outer["tid"].toInt(), inner["tid"].toInt());
+    EXPECT_GE(outer["ts"].toDouble(), 0.0);
+    EXPECT_LE(outer["ts"].toDouble(), inner["ts"].toDouble());
+    EXPECT_GE(outer["dur"].toDouble(), inner["dur"].toDouble());
+    EXPECT_FALSE(findEvent(events, "process_name").isEmpty());
+}
+
+TEST_F(TraceTest, ThreadsKeepTheirOwnSpans) {
+    Trace::start();
+    std::thread worker([]() {
+        for (int i = 0; i < 100; ++i) {
+            TraceScope scope("worker");
+        }
+    });
+    {
+        TraceScope scope("caller");
+    }
+    worker.join();
+    Trace::stop();
+    EXPECT_EQ(Trace::eventCount(), 101);
+
+    // Each thread is named once and its spans carry its own tid
+    QJsonArray events = writeEvents();
+    int threadNames = 0;
+    for (const QJsonValue& value : events) {
+        threadNames += value.toObject()["name"].toString() == "thread_name" ? 1 : 0;
+    }
+    EXPECT_GE(threadNames, 2);
+    EXPECT_NE(findEvent(events, "worker")["tid"].toInt(), findEvent(events, "caller")["tid"].toInt());
+}
+
+TEST_F(TraceTest, FullBufferDropsAndStartClears) {
+    Trace::start();
+    for (int i = 0; i < Trace::EVENTS_PER_THREAD + 10; ++i) {
+        Trace::record("span", i, i + 1);
+    }
+    EXPECT_EQ(Trace::eventCount(), Trace::EVENTS_PER_THREAD);
+    EXPECT_EQ(Trace::droppedCount(), 10);
+
+    Trace::start();
+    Trace::record("again", 0, 1);
+    EXPECT_EQ(Trace::eventCount(), 1);
+    EXPECT_EQ(Trace::droppedCount(), 0);
+}
+
+TEST_F(TraceTest, UnwritablePath) {
+    QString error;
+    EXPECT_FALSE(Trace::writeChromeJson(dir.filePath("missing/trace.json"), &error));
+    EXPECT_FALSE(error.isEmpty());
+}
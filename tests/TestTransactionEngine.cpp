@@ -0,0 +1,266 @@
+#include <gtest/gtest.h>
+#include "SerialPortManager.h"
+#include "TransactionEngine.h"
+#include "TestSupport.h"
+
+// The TCP server plays a device answering "<address>?" with "<address>=<value>"
+class TransactionEngineTest : public TcpDeviceTest {
+protected:
+    QByteArray pending;
+    QList<QByteArray> queries;
+    std::function<void(const QByteArray&)> device;
+    QList<TransactionResult> results;
+
+    void SetUp() override {
+        ASSERT_NO_FATAL_FAILURE(TcpDeviceTest::SetUp());
+
+        // Answers every query at once unless a test installs its own behaviour
+        device = [this](const QByteArray& query) { reply(query.left(2) + "=42"); };
+    }
+
+    // `configure` adjusts the port settings before it connects
+    TransactionEngine* createEngine(const std::function<void(SerialPortInfo&)>& configure = nullptr)
+    {
+        SerialPortInfo info = deviceInfo("bus");
+        info.setFraming(FramingConfig(FramingMode::Delimiter));
+        if (configure) {
+            configure(info);
+        }
+
+        SerialPortUser* user = connectDevice(info);
+        if (!user) {
+            return nullptr;
+        }
+        QObject::connect(peer, &QTcpSocket::readyRead, [this]() {
+            pending.append(peer->readAll());
+            int end = 0;
+            while ((end = pending.indexOf('\n')) >= 0) {
+                QByteArray query = pending.left(end);
+                pending.remove(0, end + 1);
+                queries.append(query);
+                device(query);
+            }
+        });
+
+        auto* engine = new TransactionEngine(user);
+        engine->setMatcher(ResponseMatchers::sameField(0, 2));
+        QObject::connect(engine, &TransactionEngine::transactionFinished,
+                         [this](const TransactionResult& result) { results.append(result); });
+        return engine;
+    }
+
+    void reply(const QByteArray& response)
+    {
+        peer->write(response + "\n");
+    }
+};
+
+TEST_F(TransactionEngineTest, MatchersCompareFields) {
+    ResponseMatcher matcher = ResponseMatchers::sameField(1, 2);
+    EXPECT_TRUE(matcher("\x01\x03\x10", "\x07\x03\x10\x20"));
+    EXPECT_FALSE(matcher("\x01\x03\x10", "\x07\x83\x10"));
+    EXPECT_FALSE(matcher("\x01\x03\x10", "\x07"));
+    EXPECT_TRUE(ResponseMatchers::any()("a", "b"));
+}
+
+TEST_F(TransactionEngineTest, StopAndWaitCompletesInOrder) {
+    TransactionEngine* engine = createEngine();
+    ASSERT_NE(engine, nullptr);
+
+    quint64 first = engine->submit("01?\n");
+    engine->submit("02?\n");
+    engine->submit("03?\n");
+    EXPECT_EQ(engine->inFlightCount(), 1);
+    EXPECT_EQ(engine->queuedCount(), 2);
+
+    ASSERT_TRUE(waitUntil([&]() { return results.size() == 3; }));
+    EXPECT_EQ(results.at(0).id, first);
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_EQ(results.at(i).status, TransactionStatus::Completed);
+        EXPECT_EQ(results.at(i).response, QByteArray::number(i + 1).rightJustified(2, '0') + "=42");
+        EXPECT_GT(results.at(i).latencyNs, 0);
+    }
+    EXPECT_EQ(engine->completedCount(), 3);
+    EXPECT_EQ(engine->latency().count(), 3);
+    EXPECT_EQ(engine->inFlightCount(), 0);
+}
+
+TEST_F(TransactionEngineTest, WindowPipelinesRequests) {
+    TransactionEngine* engine = createEngine();
+    ASSERT_NE(engine, nullptr);
+    engine->setWindow(4);
+
+    // The device only answers once all four queries are in, newest first
+    device = [this](const QByteArray&) {
+        if (queries.size() == 4) {
+            for (int i = 3; i >= 0; --i) {
+                reply(queries.at(i).left(2) + "=ok");
+            }
+        }
+    };
+
+    for (const char* query : {"01?\n", "02?\n", "03?\n", "04?\n"}) {
+        engine->submit(query);
+    }
+    EXPECT_EQ(engine->inFlightCount(), 4);
+
+    ASSERT_TRUE(waitUntil([&]() { return results.size() == 4; }));
+    for (const TransactionResult& result : results) {
+        EXPECT_EQ(result.status, TransactionStatus::Completed);
+        EXPECT_EQ(result.response.left(2), result.request.left(2));
+    }
+    EXPECT_EQ(results.first().request, QByteArray("04?\n"));
+    EXPECT_EQ(engine->unmatchedCount(), 0);
+}
+
+TEST_F(TransactionEngineTest, FullTransmitQueueKeepsRequestsQueued) {
+    TransactionEngine* engine = createEngine([](SerialPortInfo& info) { info.setTransmitQueueDepth(2); });
+    ASSERT_NE(engine, nullptr);
+    engine->setWindow(16);
+
+    for (int i = 1; i <= 16; ++i) {
+        engine->submit(QByteArray::number(i).rightJustified(2, '0') + "?\n");
+    }
+
+    ASSERT_TRUE(waitUntil([&]() { return results.size() == 16; }));
+    for (const TransactionResult& result : results) {
+        EXPECT_EQ(result.status, TransactionStatus::Completed);
+    }
+    EXPECT_EQ(engine->failedCount(), 0);
+    EXPECT_EQ(queries.size(), 16);
+}
+
+TEST_F(TransactionEngineTest, TimeoutStartsWhenWritten) {
+    // Pacing holds every request back for 50 ms, so the last one is written long after it was queued
+    TransactionEngine* engine = createEngine([](SerialPortInfo& info) {
+        PacingConfig pacing;
+        pacing.setInterFrameGapUs(50000);
+        info.setPacing(pacing);
+    });
+    ASSERT_NE(engine, nullptr);
+    engine->setWindow(4);
+    engine->setDefaultTimeout(100);
+
+    for (int i = 1; i <= 4; ++i) {
+        engine->submit(QByteArray::number(i).rightJustified(2, '0') + "?\n");
+    }
+
+    ASSERT_TRUE(waitUntil([&]() { return results.size() == 4; }));
+    for (const TransactionResult& result : results) {
+        EXPECT_EQ(result.status, TransactionStatus::Completed);
+        EXPECT_LT(result.latencyNs, 100000000);
+    }
+    EXPECT_EQ(engine->timeoutCount(), 0);
+}
+
+TEST_F(TransactionEngineTest, MissingReplyTimesOut) {
+    TransactionEngine* engine = createEngine();
+    ASSERT_NE(engine, nullptr);
+
+    // Device 02 is not on the bus
+    device = [this](const QByteArray& query) {
+        if (!query.startsWith("02")) {
+            reply(query.left(2) + "=42");
+        }
+    };
+
+    QElapsedTimer elapsed;
+    elapsed.start();
+    engine->submit("01?\n");
+    engine->submit("02?\n", 50);
+    engine->submit("03?\n");
+
+    ASSERT_TRUE(waitUntil([&]() { return results.size() == 3; }));
+    EXPECT_GE(elapsed.elapsed(), 50);
+    EXPECT_EQ(results.at(0).status, TransactionStatus::Completed);
+    EXPECT_EQ(results.at(1).status, TransactionStatus::TimedOut);
+    EXPECT_GE(results.at(1).latencyNs, 50000000);
+    EXPECT_FALSE(results.at(1).error.isEmpty());
+    EXPECT_EQ(results.at(2).status, TransactionStatus::Completed);
+    EXPECT_EQ(engine->timeoutCount(), 1);
+    EXPECT_EQ(engine->latency().count(), 2);
+}
+
+TEST_F(TransactionEngineTest, UnsolicitedFramesAreUnmatched) {
+    TransactionEngine* engine = createEngine();
+    ASSERT_NE(engine, nullptr);
+
+    QList<QByteArray> unmatched;
+    QObject::connect(engine, &TransactionEngine::unmatchedResponse,
+                     [&](const QByteArray& response) { unmatched.append(response); });
+
+    reply("99=alarm");
+    ASSERT_TRUE(waitUntil([&]() { return unmatched.size() == 1; }));
+    EXPECT_EQ(unmatched.first(), QByteArray("99=alarm"));
+    EXPECT_EQ(engine->unmatchedCount(), 1);
+    EXPECT_TRUE(results.isEmpty());
+}
+
+TEST_F(TransactionEngineTest, CycleKeepsPolling) {
+    TransactionEngine* engine = createEngine();
+    ASSERT_NE(engine, nullptr);
+    engine->setWindow(2);
+    engine->setCycle({"01?\n", "02?\n", "03?\n"});
+    EXPECT_TRUE(queries.isEmpty());
+
+    engine->start();
+    ASSERT_TRUE(waitUntil([&]() { return engine->completedCount() >= 30; }));
+    engine->stop();
+    ASSERT_TRUE(waitUntil([&]() { return engine->inFlightCount() == 0; }));
+
+    // Round-robin: each address was polled about equally often
+    int polls = queries.size();
+    EXPECT_EQ(queries.count("01?"), (polls + 2) / 3);
+    EXPECT_EQ(queries.count("03?"), polls / 3);
+
+    // Nothing more is sent once stopped
+    QThread::msleep(20);
+    QCoreApplication::processEvents();
+    EXPECT_EQ(queries.size(), polls);
+    EXPECT_GT(engine->latency().percentile(99), 0);
+}
+
+TEST_F(TransactionEngineTest, ClosedPortFailsRequests) {
+    TransactionEngine* engine = createEngine();
+    ASSERT_NE(engine, nullptr);
+    portManager->disconnectPort("bus");
+
+    engine->submit("01?\n");
+    ASSERT_EQ(results.size(), 1);
+    EXPECT_EQ(results.first().status, TransactionStatus::Failed);
+    EXPECT_EQ(engine->failedCount(), 1);
+}
+
+TEST_F(TransactionEngineTest, CyclePausesUntilReconnect) {
+    TransactionEngine* engine = createEngine();
+    ASSERT_NE(engine, nullptr);
+    portManager->disconnectPort("bus");
+
+    // Only the first poll fails; the cycle then waits for the port
+    engine->setCycle({"01?\n"});
+    engine->start();
+    runFor(50);
+    ASSERT_EQ(results.size(), 1);
+    EXPECT_EQ(results.first().status, TransactionStatus::Failed);
+
+    ASSERT_TRUE(portManager->connectPort("bus"));
+    ASSERT_TRUE(acceptPeer());
+    ASSERT_TRUE(waitUntil([&]() { return peer->bytesAvailable() > 0; }));
+    EXPECT_EQ(peer->readLine(), QByteArray("01?\n"));
+    engine->stop();
+}
+
+TEST_F(TransactionEngineTest, CancelFinishesEverything) {
+    TransactionEngine* engine = createEngine();
+    ASSERT_NE(engine, nullptr);
+    device = [](const QByteArray&) {};
+
+    engine->submit("01?\n");
+    engine->submit("02?\n");
+    engine->cancelAll();
+    ASSERT_EQ(results.size(), 2);
+    EXPECT_EQ(results.at(0).status, TransactionStatus::Failed);
+    EXPECT_EQ(results.at(1).status, TransactionStatus::Failed);
+    EXPECT_EQ(engine->inFlightCount(), 0);
+    EXPECT_EQ(engine->queuedCount(), 0);
+}
@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+#include "TransmitPacer.h"
+
+class TransmitPacerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+    }
+
+    void TearDown() override {
+    }
+
+    // 1 us per character keeps the arithmetic readable
+    static constexpr qint64 CHARACTER_NS = 1000;
+};
+
+TEST_F(TransmitPacerTest, DisabledByDefault) {
+    TransmitPacer pacer;
+    pacer.configure(PacingConfig(), CHARACTER_NS);
+
+    EXPECT_FALSE(pacer.isEnabled());
+    EXPECT_EQ(pacer.delayNs(0), 0);
+    EXPECT_EQ(pacer.releasable(0, 100), 100);
+    EXPECT_EQ(pacer.wireTimeNs(10), 10 * CHARACTER_NS);
+}
+
+TEST_F(TransmitPacerTest, InterByteDelay) {
+    PacingConfig config;
+    config.setInterByteDelayUs(100);
+    TransmitPacer pacer;
+    pacer.configure(config, CHARACTER_NS);
+
+    ASSERT_TRUE(pacer.isEnabled());
+    EXPECT_EQ(pacer.releasable(0, 10), 1);
+
+    pacer.commit(0, 1, false);
+    // One character on the wire, then 100 us idle
+    EXPECT_EQ(pacer.delayNs(0), 101000);
+    EXPECT_EQ(pacer.delayNs(50000), 51000);
+    EXPECT_EQ(pacer.delayNs(101000), 0);
+}
+
+TEST_F(TransmitPacerTest, InterFrameGap) {
+    PacingConfig config;
+    config.setInterFrameGapUs(500);
+    TransmitPacer pacer;
+    pacer.configure(config, CHARACTER_NS);
+
+    EXPECT_EQ(pacer.releasable(0, 10), 10);
+    pacer.commit(0, 10, true);
+    EXPECT_EQ(pacer.delayNs(0), 510000);
+    EXPECT_EQ(pacer.delayNs(510000), 0);
+}
+
+TEST_F(TransmitPacerTest, GapOnlyAfterEndOfFrame) {
+    PacingConfig config;
+    config.setInterFrameGapUs(500);
+    TransmitPacer pacer;
+    pacer.configure(config, CHARACTER_NS);
+
+    pacer.commit(0, 4, false);
+    EXPECT_EQ(pacer.delayNs(0), 0);
+}
+
+TEST_F(TransmitPacerTest, UtilizationLimit) {
+    PacingConfig config;
+    config.setMaxUtilization(50);
+    TransmitPacer pacer;
+    pacer.configure(config, CHARACTER_NS);
+
+    // At 50% every byte costs two character times; 1 ms of lookahead holds 500 bytes
+    qint64 first = pacer.releasable(0, 100000);
+    EXPECT_EQ(first, 500);
+    pacer.commit(0, first, false);
+    EXPECT_EQ(pacer.delayNs(0), 2000);
+
+    // Over a long run the average rate converges on the limit
+    qint64 now = 0;
+    qint64 released = first;
+    while (now < 100000000) {
+        now += qMax(qint64(1000), pacer.delayNs(now));
+        qint64 bytes = pacer.releasable(now, 100000);
+        pacer.commit(now, bytes, false);
+        released += bytes;
+    }
+    double utilization = double(pacer.wireTimeNs(released)) / now;
+    EXPECT_NEAR(utilization, 0.5, 0.02);
+}
+
+TEST_F(TransmitPacerTest, ResetClearsSchedule) {
+    PacingConfig config;
+    config.setInterByteDelayUs(100);
+    TransmitPacer pacer;
+    pacer.configure(config, CHARACTER_NS);
+
+    pacer.commit(0, 1, false);
+    ASSERT_GT(pacer.delayNs(0), 0);
+    pacer.reset();
+    EXPECT_EQ(pacer.delayNs(0), 0);
+}